@@ -1,9 +1,87 @@
 #version 450
 
+// feature toggles (see ShaderFeature)
+layout(constant_id = 0) const bool FEATURE_VERTEX_COLOR = true;
+layout(constant_id = 1) const bool FEATURE_GRAYSCALE = false;
+layout(constant_id = 2) const bool FEATURE_CLUSTERED_LIGHTING = false;
+layout(constant_id = 3) const bool FEATURE_OVERDRAW_VIEW = false;
+
+const uint MAX_LIGHTS_PER_CLUSTER = 128; // matches ClusteredLighting::MAX_LIGHTS_PER_CLUSTER
+const vec3 AMBIENT_LIGHT = vec3(0.05);
+// added per shaded fragment in the overdraw view, red saturates after 8 layers, green after 16, blue after 32
+const vec3 OVERDRAW_STEP = vec3(1.0, 0.5, 0.25) * 0.125;
+
+struct Light
+{
+    vec4 positionRadius; // xyz: world position, w: radius
+    vec4 colorIntensity;
+};
+
+// light clusters (see cluster_binning.comp)
+layout(std140, set = 0, binding = 0) uniform ClusterParams
+{
+    mat4 view;
+    mat4 inverseProjection;
+    uvec4 gridSize; // xyz: cluster count per axis, w: light count
+    vec4 screen; // xy: size in pixels, z: near plane, w: far plane
+} params;
+layout(std430, set = 0, binding = 1) readonly buffer Lights { Light lights[]; };
+layout(std430, set = 0, binding = 2) readonly buffer ClusterLightCounts { uint clusterLightCounts[]; };
+layout(std430, set = 0, binding = 3) readonly buffer ClusterLightIndices { uint clusterLightIndices[]; };
+
 layout(location = 0) in vec3 fragColor;
 
 layout(location = 0) out vec4 outColor;
 
+// only the lights binned into the cluster of this fragment are evaluated
+//> the surface is assumed to face the camera
+vec3 shadeClustered(vec3 albedo)
+{
+    // view position from depth
+    vec2 ndc = gl_FragCoord.xy / params.screen.xy * 2.0 - 1.0;
+    vec4 viewPosition = params.inverseProjection * vec4(ndc, gl_FragCoord.z, 1.0);
+    viewPosition /= viewPosition.w;
+
+    // find cluster
+    float nearPlane = params.screen.z;
+    float farPlane = params.screen.w;
+    float slice = log(max(-viewPosition.z, nearPlane) / nearPlane) / log(farPlane / nearPlane) * float(params.gridSize.z);
+    uvec3 cluster = uvec3(
+        min(uvec2(gl_FragCoord.xy / params.screen.xy * vec2(params.gridSize.xy)), params.gridSize.xy - 1),
+        min(uint(slice), params.gridSize.z - 1));
+    uint clusterIndex = cluster.x + params.gridSize.x * (cluster.y + params.gridSize.y * cluster.z);
+
+    // accumulate lights
+    vec3 normal = vec3(0.0, 0.0, 1.0);
+    vec3 lighting = AMBIENT_LIGHT;
+    uint count = clusterLightCounts[clusterIndex];
+    for (uint i = 0; i < count; ++i)
+    {
+        Light light = lights[clusterLightIndices[clusterIndex * MAX_LIGHTS_PER_CLUSTER + i]];
+        vec3 toLight = (params.view * vec4(light.positionRadius.xyz, 1.0)).xyz - viewPosition.xyz;
+        float lightDistance = length(toLight);
+
+        float falloff = clamp(1.0 - pow(lightDistance / light.positionRadius.w, 2.0), 0.0, 1.0);
+        float attenuation = falloff * falloff / (1.0 + lightDistance * lightDistance);
+        float diffuse = max(dot(normal, toLight / max(lightDistance, 1e-4)), 0.0);
+        lighting += light.colorIntensity.rgb * light.colorIntensity.a * attenuation * diffuse;
+    }
+
+    return albedo * lighting;
+}
+
 void main() {
-    outColor = vec4(fragColor, 1.0);
+    if (FEATURE_OVERDRAW_VIEW)
+    {
+        outColor = vec4(OVERDRAW_STEP, 1.0);
+        return;
+    }
+
+    vec3 color = FEATURE_VERTEX_COLOR ? fragColor : vec3(1.0);
+    if (FEATURE_CLUSTERED_LIGHTING)
+        color = shadeClustered(color);
+    if (FEATURE_GRAYSCALE)
+        color = vec3(dot(color, vec3(0.299, 0.587, 0.114)));
+
+    outColor = vec4(color, 1.0);
 }
\ No newline at end of file
@@ -1,7 +1,31 @@
 #version 450
 
+// frame data ring, matches 'ViewConstants' & 'DrawConstants' in frame_data_ring.h
+layout(set = 1, binding = 0) uniform ViewConstants {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+} viewConstants;
+
+struct DrawConstants {
+    mat4 world;
+    vec4 color;
+};
+
+layout(std430, set = 1, binding = 1) readonly buffer Draws {
+    DrawConstants draws[];
+};
+
+// index of the first draw constants of the batch, draws are offset by their instance index
+layout(push_constant) uniform DrawBatch {
+    uint firstDraw;
+} batch;
+
 layout(location = 0) out vec3 fragColor;
 
+// the depth prepass & the shading pass are separate pipelines, the equal test needs the same depth from both
+invariant gl_Position;
+
 vec2 positions[3] = vec2[](
     vec2(0.0, -0.5),
     vec2(0.5, 0.5),
@@ -15,6 +39,7 @@ vec3 colors[3] = vec3[](
 );
 
 void main() {
-    gl_Position = vec4(positions[gl_VertexIndex], 0.0, 1.0);
-    fragColor = colors[gl_VertexIndex];
+    DrawConstants draw = draws[batch.firstDraw + gl_InstanceIndex];
+    gl_Position = viewConstants.viewProjection * draw.world * vec4(positions[gl_VertexIndex], 0.0, 1.0);
+    fragColor = colors[gl_VertexIndex] * draw.color.rgb;
 }
@@ -0,0 +1,16 @@
+#version 450
+
+// soft round particle, blended additively
+
+layout(location = 0) in vec2 inUv;
+layout(location = 1) in vec4 inColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    float falloff = 1.0 - dot(inUv, inUv);
+    if (falloff <= 0.0)
+        discard;
+
+    outColor = vec4(inColor.rgb * inColor.a * falloff * falloff, 0.0);
+}
@@ -0,0 +1,56 @@
+#version 450
+
+// camera facing particle quads (see ParticleSystem)
+//> one instance per alive particle, the instance indexes the alive list written by the simulate pass
+//> six vertices per quad, no vertex input
+
+struct Particle
+{
+    vec4 positionAge; // xyz: world position, w: age in seconds
+    vec4 velocityLifetime; // xyz: world velocity, w: lifetime in seconds
+};
+
+layout(std140, binding = 0) uniform ParticleParams
+{
+    mat4 viewProjection;
+    mat4 inverseViewProjection;
+    vec4 cameraRight;
+    vec4 cameraUp;
+    vec4 emitterPositionRadius;
+    vec4 emitterVelocitySpread;
+    vec4 colorStart;
+    vec4 colorEnd;
+    vec4 gravityDrag;
+    vec4 noise;
+    vec4 lifetimeSize; // x: min lifetime, y: max lifetime, z: start size, w: end size
+    vec4 collision;
+    vec4 time;
+    uvec4 counts; // x: emit request, y: capacity, z: seed
+} params;
+layout(std430, binding = 1) readonly buffer Particles { Particle particles[]; };
+layout(std430, binding = 3) readonly buffer AliveLists { uint aliveIndices[]; };
+
+layout(push_constant) uniform Constants
+{
+    uint list; // alive list written by the simulate pass of this frame
+} constants;
+
+layout(location = 0) out vec2 outUv;
+layout(location = 1) out vec4 outColor;
+
+const vec2 corners[6] = vec2[](
+    vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0),
+    vec2(-1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0));
+
+void main() {
+    Particle particle = particles[aliveIndices[constants.list * params.counts.y + gl_InstanceIndex]];
+    float lifeFraction = clamp(particle.positionAge.w / particle.velocityLifetime.w, 0.0, 1.0);
+    float size = mix(params.lifetimeSize.z, params.lifetimeSize.w, lifeFraction);
+
+    vec2 corner = corners[gl_VertexIndex];
+    vec3 position = particle.positionAge.xyz + (params.cameraRight.xyz * corner.x + params.cameraUp.xyz * corner.y) * size;
+
+    outUv = corner;
+    outColor = mix(params.colorStart, params.colorEnd, lifeFraction);
+    gl_Position = params.viewProjection * vec4(position, 1.0);
+}
@@ -0,0 +1,54 @@
+#version 450
+
+// upscales the render area of the dynamic resolution target to the output (see DynamicResolution)
+
+const uint FILTER_BILINEAR = 0;
+const uint FILTER_SHARPEN = 1;
+
+layout(binding = 0) uniform sampler2D sceneColor;
+
+layout(push_constant) uniform Constants
+{
+    vec2 uvScale; // render extent / target extent
+    vec2 texelSize; // 1 / target extent
+    float sharpness; // 0: soft, 1: sharp
+    uint filter;
+} constants;
+
+layout(location = 0) in vec2 inUv;
+
+layout(location = 0) out vec4 outColor;
+
+// texels outside of the render area hold stale content, samples are clamped half a texel inside
+vec3 sampleScene(vec2 uv)
+{
+    vec2 maxUv = constants.uvScale - constants.texelSize * 0.5;
+    return texture(sceneColor, clamp(uv, constants.texelSize * 0.5, maxUv)).rgb;
+}
+
+// contrast adaptive sharpening over the cross neighborhood
+//> the negative lobe weakens where the neighborhood already has contrast, so edges do not ring
+vec3 sharpen(vec2 uv, vec3 center)
+{
+    vec3 north = sampleScene(uv + vec2(0.0, -constants.texelSize.y));
+    vec3 south = sampleScene(uv + vec2(0.0, constants.texelSize.y));
+    vec3 east = sampleScene(uv + vec2(constants.texelSize.x, 0.0));
+    vec3 west = sampleScene(uv + vec2(-constants.texelSize.x, 0.0));
+
+    vec3 minColor = min(center, min(min(north, south), min(east, west)));
+    vec3 maxColor = max(center, max(max(north, south), max(east, west)));
+
+    vec3 amplitude = sqrt(clamp(min(minColor, 1.0 - maxColor) / max(maxColor, vec3(1e-4)), 0.0, 1.0));
+    vec3 weight = -amplitude * mix(0.125, 0.2, constants.sharpness);
+
+    return clamp((center + (north + south + east + west) * weight) / (1.0 + 4.0 * weight), 0.0, 1.0);
+}
+
+void main() {
+    vec2 uv = inUv * constants.uvScale;
+    vec3 color = sampleScene(uv);
+    if (constants.filter == FILTER_SHARPEN)
+        color = sharpen(uv, color);
+
+    outColor = vec4(color, 1.0);
+}
@@ -0,0 +1,12 @@
+#version 450
+
+// fullscreen triangle, no vertex input
+//> covers the screen with uv [0, 1], the parts outside are clipped
+
+layout(location = 0) out vec2 outUv;
+
+void main() {
+    vec2 uv = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+    outUv = uv;
+    gl_Position = vec4(uv * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -0,0 +1,24 @@
+# function to copy the runtime assets into the build tree
+#> every file below 'ASSETS_DIR' apart from the shader directory, which 'CompileShaders' fills
+function(CopyAssets TARGET_NAME ASSETS_DIR OUTPUT_DIR)
+    file(GLOB_RECURSE ASSET_SOURCES CONFIGURE_DEPENDS
+            RELATIVE ${ASSETS_DIR}
+            ${ASSETS_DIR}/*)
+
+    set(ASSET_COPIES "")
+    foreach(ASSET_SOURCE ${ASSET_SOURCES})
+        if (ASSET_SOURCE MATCHES "^shaders/")
+            continue()
+        endif()
+        set(ASSET_COPY ${OUTPUT_DIR}/${ASSET_SOURCE})
+        add_custom_command(
+                OUTPUT ${ASSET_COPY}
+                COMMAND ${CMAKE_COMMAND} -E copy ${ASSETS_DIR}/${ASSET_SOURCE} ${ASSET_COPY}
+                DEPENDS ${ASSETS_DIR}/${ASSET_SOURCE}
+                COMMENT "copying asset ${ASSET_SOURCE}")
+        list(APPEND ASSET_COPIES ${ASSET_COPY})
+    endforeach()
+
+    add_custom_target(${TARGET_NAME}Assets DEPENDS ${ASSET_COPIES})
+    add_dependencies(${TARGET_NAME} ${TARGET_NAME}Assets)
+endfunction()
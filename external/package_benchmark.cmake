@@ -0,0 +1,14 @@
+# function to find google benchmark
+function(FindPackage_Benchmark TARGET_NAME)
+    FetchContent_Declare(external_benchmark
+            GIT_REPOSITORY    https://github.com/google/benchmark
+            GIT_TAG           v1.8.3)
+
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+
+    FetchContent_MakeAvailable(external_benchmark)
+
+    target_link_libraries(${TARGET_NAME} PRIVATE benchmark::benchmark)
+endfunction()
\ No newline at end of file
@@ -0,0 +1,32 @@
+# function to compile glsl shaders to spir-v
+#> outputs are written to 'OUTPUT_DIR' as '<file>.spv', the source tree stays clean
+#> glslc (vulkan sdk) is required, there are no prebuilt binaries that could go stale against their sources
+function(CompileShaders TARGET_NAME SHADER_DIR OUTPUT_DIR)
+    find_program(GLSLC_EXECUTABLE glslc
+            HINTS $ENV{VULKAN_SDK}/Bin $ENV{VULKAN_SDK}/bin)
+
+    if (NOT GLSLC_EXECUTABLE)
+        message(FATAL_ERROR "not found glslc, install the vulkan sdk or set VULKAN_SDK to compile the shaders")
+    endif()
+
+    file(GLOB SHADER_SOURCES CONFIGURE_DEPENDS
+            ${SHADER_DIR}/*.vert
+            ${SHADER_DIR}/*.frag
+            ${SHADER_DIR}/*.comp)
+
+    set(SHADER_BINARIES "")
+    foreach(SHADER_SOURCE ${SHADER_SOURCES})
+        get_filename_component(SHADER_NAME ${SHADER_SOURCE} NAME)
+        set(SHADER_BINARY ${OUTPUT_DIR}/${SHADER_NAME}.spv)
+        add_custom_command(
+                OUTPUT ${SHADER_BINARY}
+                COMMAND ${CMAKE_COMMAND} -E make_directory ${OUTPUT_DIR}
+                COMMAND ${GLSLC_EXECUTABLE} ${SHADER_SOURCE} -o ${SHADER_BINARY}
+                DEPENDS ${SHADER_SOURCE}
+                COMMENT "compiling shader ${SHADER_SOURCE}")
+        list(APPEND SHADER_BINARIES ${SHADER_BINARY})
+    endforeach()
+
+    add_custom_target(${TARGET_NAME}Shaders DEPENDS ${SHADER_BINARIES})
+    add_dependencies(${TARGET_NAME} ${TARGET_NAME}Shaders)
+endfunction()
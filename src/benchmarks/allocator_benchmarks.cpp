@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+#include "vulkan_host_allocator.h"
+#include <cstdlib>
+#include <vector>
+
+// allocation pattern: 'range(0)' live allocations of mixed small sizes, freed in allocation order
+static constexpr size_t ALLOCATION_SIZES[] = {24, 48, 96, 200, 512, 1000, 3000};
+
+static void BM_VulkanHostAllocator_AllocateFree(benchmark::State& state)
+{
+    VulkanHostAllocator allocator;
+    std::vector<void*> allocations(state.range(0));
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < allocations.size(); ++i)
+            allocations[i] = allocator.Allocate(ALLOCATION_SIZES[i % std::size(ALLOCATION_SIZES)], 8, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+        for (void* allocation : allocations)
+            allocator.Free(allocation);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VulkanHostAllocator_AllocateFree)->Range(64, 16 << 10);
+
+static void BM_Malloc_AllocateFree(benchmark::State& state)
+{
+    std::vector<void*> allocations(state.range(0));
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < allocations.size(); ++i)
+            allocations[i] = std::malloc(ALLOCATION_SIZES[i % std::size(ALLOCATION_SIZES)]);
+        for (void* allocation : allocations)
+            std::free(allocation);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Malloc_AllocateFree)->Range(64, 16 << 10);
@@ -0,0 +1,5 @@
+#include <benchmark/benchmark.h>
+
+// entry point for all benchmarks
+//> json output: --benchmark_out=<file> --benchmark_out_format=json (see target 'ArcticBenchmarksJson')
+BENCHMARK_MAIN();
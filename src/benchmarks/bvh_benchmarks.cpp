@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <vector>
+#include "bvh.h"
+#include "shared_job_system.h"
+
+namespace
+{
+    // small boxes spread over a square kilometer, like entities of an open level
+    std::vector<Aabb> makeBounds(size_t count)
+    {
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> height(0.0f, 20.0f);
+        std::uniform_real_distribution<float> size(0.5f, 4.0f);
+
+        std::vector<Aabb> bounds(count);
+        for (auto& box : bounds)
+        {
+            glm::vec3 center(position(random), height(random), position(random));
+            glm::vec3 extent(size(random));
+            box.min = center - extent;
+            box.max = center + extent;
+        }
+        return bounds;
+    }
+
+    void insertAll(Bvh& bvh, const std::vector<Aabb>& bounds)
+    {
+        for (size_t i = 0; i < bounds.size(); ++i)
+            bvh.Insert(bounds[i], static_cast<uint32_t>(i));
+    }
+
+    Frustum makeFrustum()
+    {
+        glm::mat4 projection = glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(100.0f, 0.0f, 100.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        return Frustum::FromViewProjection(projection * view);
+    }
+}
+
+static void BM_Bvh_Build(benchmark::State& state)
+{
+    Bvh bvh;
+    insertAll(bvh, makeBounds(state.range(0)));
+
+    for (auto _ : state)
+        bvh.Rebuild();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Bvh_Build)->Range(1 << 10, 1 << 18);
+
+static void BM_Bvh_Refit(benchmark::State& state)
+{
+    Bvh bvh;
+    std::vector<Aabb> bounds = makeBounds(state.range(0));
+    insertAll(bvh, bounds);
+    bvh.Rebuild();
+
+    // jitter in place, the tree quality stays the same
+    float offset = 0.01f;
+    for (auto _ : state)
+    {
+        offset = -offset;
+        for (uint32_t i = 0; i < bounds.size(); ++i)
+        {
+            bounds[i].min.x += offset;
+            bounds[i].max.x += offset;
+            bvh.Move(i, bounds[i]);
+        }
+        bvh.Update();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Bvh_Refit)->Range(1 << 10, 1 << 18);
+
+// reference: testing every box
+static void BM_Bvh_FrustumLinear(benchmark::State& state)
+{
+    std::vector<Aabb> bounds = makeBounds(state.range(0));
+    Frustum frustum = makeFrustum();
+    std::vector<uint32_t> results;
+
+    for (auto _ : state)
+    {
+        results.clear();
+        for (uint32_t i = 0; i < bounds.size(); ++i)
+        {
+            if (frustum.Intersects(bounds[i]))
+                results.push_back(i);
+        }
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Bvh_FrustumLinear)->Range(1 << 10, 1 << 18);
+
+static void BM_Bvh_Frustum(benchmark::State& state)
+{
+    Bvh bvh;
+    insertAll(bvh, makeBounds(state.range(0)));
+    bvh.Rebuild();
+    Frustum frustum = makeFrustum();
+    std::vector<uint32_t> results;
+
+    for (auto _ : state)
+    {
+        results.clear();
+        bvh.QueryFrustum(frustum, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["visible"] = static_cast<double>(results.size());
+}
+BENCHMARK(BM_Bvh_Frustum)->Range(1 << 10, 1 << 18);
+
+// picking: 1024 rays from the camera, batched on the job system
+static void BM_Bvh_Rays(benchmark::State& state)
+{
+    JobSystem& jobSystem = GetSharedJobSystem();
+    Bvh bvh;
+    insertAll(bvh, makeBounds(state.range(0)));
+    bvh.Rebuild();
+
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+    std::vector<Ray> rays(1024);
+    for (auto& ray : rays)
+    {
+        ray.origin = glm::vec3(0.0f, 10.0f, 0.0f);
+        ray.direction = glm::normalize(glm::vec3(direction(random), -0.2f, direction(random)));
+    }
+    std::vector<Bvh::RayHit> hits;
+
+    for (auto _ : state)
+    {
+        bvh.QueryRays(rays, hits, jobSystem);
+        benchmark::DoNotOptimize(hits.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(rays.size()));
+}
+BENCHMARK(BM_Bvh_Rays)->Range(1 << 10, 1 << 18);
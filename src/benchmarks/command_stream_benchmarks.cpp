@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+#include "command_stream.h"
+
+// records a frame of 'range(0)' draws
+static void recordFrame(CommandStream& stream, int64_t drawCount)
+{
+    stream.Reset();
+    stream.BeginRenderPass({{0.0f, 0.0f, 0.0f, 1.0f}});
+    stream.SetViewport({0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 1.0f});
+    stream.SetScissor({0, 0, 1280, 720});
+    for (int64_t i = 0; i < drawCount; ++i)
+    {
+        stream.BindPipeline({static_cast<uint32_t>(i & 3)});
+        stream.Draw({3, 1, 0, static_cast<uint32_t>(i)});
+    }
+    stream.EndRenderPass();
+}
+
+static void BM_CommandStream_Record(benchmark::State& state)
+{
+    CommandStream stream;
+    for (auto _ : state)
+    {
+        recordFrame(stream, state.range(0));
+        benchmark::DoNotOptimize(stream.GetData().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CommandStream_Record)->Range(64, 64 << 10);
+
+static void BM_CommandStream_Read(benchmark::State& state)
+{
+    CommandStream stream;
+    recordFrame(stream, state.range(0));
+
+    for (auto _ : state)
+    {
+        CommandStream::Reader reader(stream.GetData());
+        CommandType type;
+        uint32_t vertexCount = 0;
+        while (reader.Next(type))
+        {
+            switch (type)
+            {
+                case CommandType::BeginRenderPass: reader.Read<CommandBeginRenderPass>(); break;
+                case CommandType::BindPipeline: reader.Read<CommandBindPipeline>(); break;
+                case CommandType::SetViewport: reader.Read<CommandSetViewport>(); break;
+                case CommandType::SetScissor: reader.Read<CommandSetScissor>(); break;
+                case CommandType::Draw: vertexCount += reader.Read<CommandDraw>().vertexCount; break;
+                case CommandType::MultiDraw: reader.Skip(reader.Read<CommandMultiDraw>().drawCount * sizeof(CommandDraw)); break;
+                default: break;
+            }
+        }
+        benchmark::DoNotOptimize(vertexCount);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CommandStream_Read)->Range(64, 64 << 10);
@@ -0,0 +1,21 @@
+#include <benchmark/benchmark.h>
+#include "utilities/file_utility.h"
+#include "utilities/application.h"
+
+static void BM_FileUtility_ReadBinaryFile(benchmark::State& state)
+{
+    std::string path = Application::AssetsPath + "/shaders/first_shader.vert.spv";
+    std::vector<char> buffer;
+
+    for (auto _ : state)
+    {
+        if (!FileUtility::ReadBinaryFile(path, buffer))
+        {
+            state.SkipWithError("failed to read file");
+            break;
+        }
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(buffer.size()));
+}
+BENCHMARK(BM_FileUtility_ReadBinaryFile);
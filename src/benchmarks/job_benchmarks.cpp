@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <vector>
+#include "utilities/job_system.h"
+#include "utilities/task.h"
+#include "shared_job_system.h"
+
+namespace
+{
+    const uint32_t ELEMENT_COUNT = 1 << 20;
+
+    Task<uint32_t> hop(JobSystem& jobSystem, uint32_t value)
+    {
+        co_await jobSystem.SwitchTo(JobQueue::Worker);
+        co_return value + 1;
+    }
+
+    Task<void> chain(JobSystem& jobSystem, std::atomic<uint32_t>& doneCount)
+    {
+        uint32_t value = co_await hop(jobSystem, 0);
+        benchmark::DoNotOptimize(value);
+        doneCount.fetch_add(1, std::memory_order_release);
+    }
+}
+
+static void BM_Jobs_SerialFor(benchmark::State& state)
+{
+    std::vector<float> values(ELEMENT_COUNT, 1.0f);
+
+    for (auto _ : state)
+    {
+        for (auto& value : values)
+            value = value * 1.0001f + 0.5f;
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * ELEMENT_COUNT);
+}
+BENCHMARK(BM_Jobs_SerialFor);
+
+static void BM_Jobs_ParallelFor(benchmark::State& state)
+{
+    JobSystem& jobSystem = GetSharedJobSystem();
+    std::vector<float> values(ELEMENT_COUNT, 1.0f);
+    const auto batchSize = static_cast<uint32_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        jobSystem.ParallelFor(ELEMENT_COUNT, batchSize, [&values](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+                values[i] = values[i] * 1.0001f + 0.5f;
+        });
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * ELEMENT_COUNT);
+}
+BENCHMARK(BM_Jobs_ParallelFor)->Arg(1024)->Arg(16384)->Arg(65536);
+
+// cost of scheduling a coroutine onto a worker and back
+static void BM_Jobs_CoroutineHop(benchmark::State& state)
+{
+    JobSystem& jobSystem = GetSharedJobSystem();
+    const uint32_t taskCount = 1024;
+
+    for (auto _ : state)
+    {
+        std::atomic<uint32_t> doneCount = 0;
+        for (uint32_t i = 0; i < taskCount; ++i)
+            RunDetached(chain(jobSystem, doneCount));
+        while (doneCount.load(std::memory_order_acquire) < taskCount)
+            std::this_thread::yield();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * taskCount);
+}
+BENCHMARK(BM_Jobs_CoroutineHop);
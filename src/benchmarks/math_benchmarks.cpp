@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+static void BM_Math_TransformPoints(benchmark::State& state)
+{
+    std::vector<glm::vec4> points(state.range(0), glm::vec4(1.0f, 2.0f, 3.0f, 1.0f));
+    std::vector<glm::vec4> results(points.size());
+    glm::mat4 transform = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f) *
+                          glm::lookAt(glm::vec3(0.0f, 2.0f, -5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < points.size(); ++i)
+            results[i] = transform * points[i];
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Math_TransformPoints)->Range(256, 256 << 10);
+
+static void BM_Math_MultiplyMatrices(benchmark::State& state)
+{
+    std::vector<glm::mat4> locals(state.range(0), glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 0.0f, 0.0f)));
+    std::vector<glm::mat4> worlds(locals.size());
+    glm::mat4 parent = glm::rotate(glm::mat4(1.0f), 0.5f, glm::vec3(0.0f, 1.0f, 0.0f));
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < locals.size(); ++i)
+            worlds[i] = parent * locals[i];
+        benchmark::DoNotOptimize(worlds.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Math_MultiplyMatrices)->Range(256, 64 << 10);
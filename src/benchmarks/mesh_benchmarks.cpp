@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "mesh_cooker.h"
+#include "mesh_lod_selector.h"
+#include "shared_job_system.h"
+
+namespace
+{
+    // closed torus, 'segments' x 'segments / 2' quads
+    MeshData makeTorus(uint32_t segments)
+    {
+        const uint32_t rings = segments / 2;
+        const float twoPi = 6.2831853f;
+
+        MeshData mesh;
+        for (uint32_t i = 0; i < segments; ++i)
+        {
+            for (uint32_t j = 0; j < rings; ++j)
+            {
+                float u = static_cast<float>(i) * twoPi / static_cast<float>(segments);
+                float v = static_cast<float>(j) * twoPi / static_cast<float>(rings);
+                glm::vec3 normal(std::cos(v) * std::cos(u), std::cos(v) * std::sin(u), std::sin(v));
+                glm::vec3 position(2.0f * std::cos(u), 2.0f * std::sin(u), 0.0f);
+                mesh.vertices.push_back({position + normal * 0.5f, normal});
+            }
+        }
+        for (uint32_t i = 0; i < segments; ++i)
+        {
+            for (uint32_t j = 0; j < rings; ++j)
+            {
+                uint32_t a = i * rings + j;
+                uint32_t b = (i + 1) % segments * rings + j;
+                uint32_t c = (i + 1) % segments * rings + (j + 1) % rings;
+                uint32_t d = i * rings + (j + 1) % rings;
+                mesh.indices.insert(mesh.indices.end(), {a, b, c, a, c, d});
+            }
+        }
+        mesh.lods = {{0, static_cast<uint32_t>(mesh.indices.size()), 0.0f}};
+        return mesh;
+    }
+
+    // instances spread over a square kilometer around the camera
+    std::vector<MeshLodSelector::Instance> makeInstances(const MeshData& mesh, size_t count)
+    {
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+
+        std::vector<MeshLodSelector::Instance> instances(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            glm::vec3 center(position(random), 0.0f, position(random));
+            instances[i] = {glm::vec4(center, mesh.boundingSphere.w), mesh.lods.data(),
+                            static_cast<uint32_t>(mesh.lods.size()), static_cast<uint32_t>(i), 0};
+        }
+        return instances;
+    }
+}
+
+static void BM_MeshCooker_GenerateLods(benchmark::State& state)
+{
+    MeshData torus = makeTorus(static_cast<uint32_t>(state.range(0)));
+    const size_t triangleCount = torus.indices.size() / 3;
+
+    for (auto _ : state)
+    {
+        MeshData mesh = torus;
+        MeshCooker::GenerateLods(mesh, {});
+        benchmark::DoNotOptimize(mesh.lods.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * triangleCount));
+}
+BENCHMARK(BM_MeshCooker_GenerateLods)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+static void BM_MeshLod_Select(benchmark::State& state)
+{
+    MeshData mesh = makeTorus(256);
+    MeshCooker::GenerateLods(mesh, {});
+    std::vector<MeshLodSelector::Instance> instances = makeInstances(mesh, state.range(0));
+
+    MeshLodSelector selector;
+    selector.SetCamera(glm::vec3(0.0f, 2.0f, 0.0f), 1.0f, 1080.0f, 1000.0f);
+    JobSystem* jobSystem = state.range(1) != 0 ? &GetSharedJobSystem() : nullptr;
+
+    for (auto _ : state)
+        selector.Select(instances, jobSystem);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["trianglePercent"] = 100.0 * static_cast<double>(selector.GetStats().triangleCount) /
+                                   static_cast<double>(selector.GetStats().fullTriangleCount);
+}
+BENCHMARK(BM_MeshLod_Select)->ArgsProduct({{1 << 12, 1 << 16}, {0, 1}});
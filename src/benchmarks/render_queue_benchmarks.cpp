@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "render_queue.h"
+#include "utilities/radix_sort.h"
+#include "shared_job_system.h"
+
+namespace
+{
+    // random keys shaped like render queue keys (few pipelines, materials & meshes, random depth)
+    std::vector<uint64_t> makeKeys(size_t count)
+    {
+        std::mt19937 random(42);
+        std::uniform_int_distribution<uint32_t> pipeline(0, 7);
+        std::uniform_int_distribution<uint32_t> material(0, 255);
+        std::uniform_int_distribution<uint32_t> mesh(0, 63);
+        std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+
+        std::vector<uint64_t> keys(count);
+        for (auto& key : keys)
+            key = RenderQueue::MakeKey(DrawPass::Opaque, pipeline(random), static_cast<uint16_t>(material(random)),
+                                       static_cast<uint16_t>(mesh(random)), depth(random));
+        return keys;
+    }
+}
+
+static void BM_Sort_StdSort(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    const std::vector<uint64_t> source = makeKeys(count);
+    std::vector<std::pair<uint64_t, uint32_t>> pairs(count);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; ++i)
+            pairs[i] = {source[i], static_cast<uint32_t>(i)};
+        std::sort(pairs.begin(), pairs.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        benchmark::DoNotOptimize(pairs.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Sort_StdSort)->Range(1 << 10, 1 << 20);
+
+static void BM_Sort_Radix(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    const std::vector<uint64_t> source = makeKeys(count);
+    std::vector<uint64_t> keys(count);
+    std::vector<uint32_t> values(count);
+    RadixSorter sorter;
+
+    for (auto _ : state)
+    {
+        keys = source;
+        std::iota(values.begin(), values.end(), 0u);
+        sorter.Sort(keys.data(), values.data(), static_cast<uint32_t>(count));
+        benchmark::DoNotOptimize(keys.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Sort_Radix)->Range(1 << 10, 1 << 20);
+
+static void BM_Sort_RadixParallel(benchmark::State& state)
+{
+    JobSystem& jobSystem = GetSharedJobSystem();
+    const auto count = static_cast<size_t>(state.range(0));
+    const std::vector<uint64_t> source = makeKeys(count);
+    std::vector<uint64_t> keys(count);
+    std::vector<uint32_t> values(count);
+    RadixSorter sorter;
+
+    for (auto _ : state)
+    {
+        keys = source;
+        std::iota(values.begin(), values.end(), 0u);
+        sorter.Sort(keys.data(), values.data(), static_cast<uint32_t>(count), &jobSystem);
+        benchmark::DoNotOptimize(keys.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Sort_RadixParallel)->Range(1 << 10, 1 << 20);
+
+// submit, sort & record a frame of 'range(0)' draws
+static void BM_RenderQueue_Frame(benchmark::State& state)
+{
+    JobSystem& jobSystem = GetSharedJobSystem();
+    const auto count = static_cast<size_t>(state.range(0));
+    const std::vector<uint64_t> keys = makeKeys(count);
+    RenderQueue queue;
+    CommandStream stream;
+
+    for (auto _ : state)
+    {
+        queue.Reset();
+        for (size_t i = 0; i < count; ++i)
+            queue.Submit(keys[i], {36, 0, static_cast<uint32_t>(i)});
+        queue.Sort(&jobSystem);
+
+        stream.Reset();
+        queue.Record(stream);
+        benchmark::DoNotOptimize(stream.GetData().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["draws"] = static_cast<double>(queue.GetStats().drawCount);
+    state.counters["pipelineChanges"] = static_cast<double>(queue.GetStats().pipelineChangeCount);
+}
+BENCHMARK(BM_RenderQueue_Frame)->Range(1 << 10, 1 << 16);
@@ -0,0 +1,25 @@
+#ifndef ARCTIC_SHARED_JOB_SYSTEM_H
+#define ARCTIC_SHARED_JOB_SYSTEM_H
+
+#include "utilities/job_system.h"
+
+// started on first use, threads are shared by all benchmarks
+inline JobSystem& GetSharedJobSystem()
+{
+    struct SharedJobSystem
+    {
+        JobSystem jobSystem;
+
+        SharedJobSystem() {
+            jobSystem.Initialize();
+        }
+        ~SharedJobSystem() {
+            jobSystem.Shutdown();
+        }
+    };
+
+    static SharedJobSystem shared;
+    return shared.jobSystem;
+}
+
+#endif //ARCTIC_SHARED_JOB_SYSTEM_H
@@ -0,0 +1,75 @@
+#include "mesh_cooker.h"
+#include "scene_cooker.h"
+#include <charconv>
+#include <cmath>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "usage: ArcticCook <input.obj> <output.mesh> [max error]" << std::endl;
+        std::cout << "       ArcticCook <input.scn> <output.scene>" << std::endl;
+    }
+
+    int cookScene(const std::string& inputPath, const std::string& outputPath)
+    {
+        SceneDescription scene;
+        if (!SceneCooker::LoadText(inputPath, scene) || !scene.Save(outputPath))
+            return 1;
+
+        std::cout << "info: cook:" << std::endl;
+        std::cout << std::format("\t{} entities, {} assets", scene.entities.size(), scene.assets.size()) << std::endl;
+        return 0;
+    }
+}
+
+// cooks a wavefront obj into a '.mesh' with a generated lod chain, or a text scene into a '.scene'
+//> usage: ArcticCook <input.obj> <output.mesh> [max error]
+//>        ArcticCook <input.scn> <output.scene>
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (std::string(argv[1]).ends_with(".scn"))
+        return cookScene(argv[1], argv[2]);
+
+    MeshCooker::LodSettings settings;
+    if (argc > 3)
+    {
+        //> the whole argument has to be a finite, non-negative number
+        std::string_view argument = argv[3];
+        auto [end, error] = std::from_chars(argument.data(), argument.data() + argument.size(), settings.maxError);
+        if (error != std::errc() || end != argument.data() + argument.size() || !std::isfinite(settings.maxError) || settings.maxError < 0.0f)
+        {
+            std::cout << std::format("error: cook: invalid max error \"{}\"!", argument) << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    MeshData mesh;
+    if (!MeshCooker::LoadObj(argv[1], mesh))
+        return 1;
+    MeshCooker::GenerateLods(mesh, settings);
+    if (!mesh.Save(argv[2]))
+        return 1;
+
+    std::cout << "info: cook:" << std::endl;
+    std::cout << std::format("\t{} vertices, radius {:.3f}", mesh.vertices.size(), mesh.boundingSphere.w) << std::endl;
+    for (size_t i = 0; i < mesh.lods.size(); ++i)
+    {
+        std::cout << std::format("\tlod {}: {} triangles, error {:.5f}",
+                                 i,
+                                 mesh.lods[i].indexCount / 3,
+                                 mesh.lods[i].error) << std::endl;
+    }
+    return 0;
+}
@@ -1,16 +1,84 @@
 #ifndef ARCTIC_ARCTIC_ENGINE_H
 #define ARCTIC_ARCTIC_ENGINE_H
 
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "particle_emitter.h"
+
 class VulkanLoader;
+class JobSystem;
+class SimulationLoop;
+class Scene;
+class Broadphase;
 
+// ARCTIC_SERVER: built without renderer (no glfw, no vulkan), 'run' only ticks the simulation
 class ArcticEngine
 {
 public:
-    void initialize();
-    void run();
+    static constexpr double DEFAULT_TICK_RATE = 60.0; // hz
+    static constexpr uint32_t INVALID_BOUNDS = UINT32_MAX;
+
+    void initialize(double tickRate = DEFAULT_TICK_RATE);
+    // server: stops after 'tickLimit' ticks (zero: no limit)
+    void run(uint64_t tickLimit = 0);
     void cleanup();
+
+    // called at the fixed tick rate with the fixed delta time
+    void setTickCallback(std::function<void(double deltaTime)> callback);
+    // signal safe, 'run' returns after the current tick or frame
+    void requestStop();
+    void printStats() const;
+
+    // map a '.scene' file, replaces the loaded scene (see 'ArcticCook' to convert text scenes)
+    bool loadScene(const std::string& path);
+
+    // overlapping bounds of moving objects (e.g. bodies or triggers), pairs report the user data of both
+    //> changes are applied by 'updateOverlaps', e.g. once per tick, queries see the bounds of the last one
+    //> returns 'INVALID_BOUNDS' when the bounds are not finite or inverted
+    uint32_t insertBounds(const float min[3], const float max[3], uint32_t userData);
+    void moveBounds(uint32_t bounds, const float min[3], const float max[3]);
+    void removeBounds(uint32_t bounds);
+    void updateOverlaps();
+    // pairs of the last update, added & removed ones are the difference to the update before
+    //> read them before inserting new bounds, those can reuse the ids of removed ones
+    void getOverlaps(std::vector<std::pair<uint32_t, uint32_t>>& overlaps) const;
+    void getOverlapChanges(std::vector<std::pair<uint32_t, uint32_t>>& added,
+                           std::vector<std::pair<uint32_t, uint32_t>>& removed) const;
+    // user data of all bounds overlapping the box, appended
+    void queryBounds(const float min[3], const float max[3], std::vector<uint32_t>& results) const;
+
+#ifndef ARCTIC_SERVER
+    // capture the next frames to a file (see 'ArcticReplay')
+    void capture(const std::string& path, uint32_t frameCount);
+
+    // write the stats of the next frames to a file, one json object per frame
+    //> draw, instance & triangle counts, cpu & gpu time, shader invocations per pass
+    void dumpStats(const std::string& path, uint32_t frameCount);
+
+    // shade every fragment with a constant blended additively, brighter pixels were shaded more often
+    void setOverdrawView(bool isEnabled);
+
+    // gpu particle system, simulated in compute & drawn on top of the scene
+    //> returns zero when particles are not available or creation failed
+    uint32_t createParticleSystem(const std::string& name, uint32_t capacity, const ParticleEmitter& emitter);
+    void destroyParticleSystem(uint32_t particleSystem);
+    void setParticleEmitter(uint32_t particleSystem, const ParticleEmitter& emitter);
+
+    // replay a capture headless and report timings
+    //> standalone: does not require 'initialize'
+    bool replay(const std::string& path, uint32_t iterations);
+#endif
 private:
+    JobSystem* jobSystem;
+    SimulationLoop* simulationLoop;
+    Scene* scene = nullptr;
+    Broadphase* broadphase;
+#ifndef ARCTIC_SERVER
     VulkanLoader* vulkanLoader;
+#endif
 };
 
 #endif //ARCTIC_ARCTIC_ENGINE_H
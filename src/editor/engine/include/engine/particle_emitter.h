@@ -0,0 +1,29 @@
+#ifndef ARCTIC_PARTICLE_EMITTER_H
+#define ARCTIC_PARTICLE_EMITTER_H
+
+// emitter settings of a particle system, uploaded every frame
+//> plain arrays, so the public headers do not depend on glm
+struct ParticleEmitter
+{
+    float position[3] = {0.0f, 0.0f, 0.0f};
+    float radius = 0.1f; // spawn sphere
+    float velocity[3] = {0.0f, 1.0f, 0.0f};
+    float velocitySpread = 0.5f; // random speed added in any direction
+    float colorStart[4] = {1.0f, 0.6f, 0.2f, 1.0f};
+    float colorEnd[4] = {0.2f, 0.1f, 0.4f, 0.0f};
+    float gravity[3] = {0.0f, -9.81f, 0.0f};
+    float drag = 0.1f;
+    float noiseStrength = 0.0f; // curl noise acceleration, zero disables it
+    float noiseFrequency = 1.0f;
+    float noiseSpeed = 0.5f;
+    float minLifetime = 1.0f; // seconds
+    float maxLifetime = 2.0f;
+    float startSize = 0.02f; // world units
+    float endSize = 0.01f;
+    float emitRate = 1000.0f; // particles per second
+    bool enableCollision = true; // with the depth buffer of the previous frame
+    float restitution = 0.5f;
+    float collisionThickness = 0.25f; // world units behind a surface that still collide
+};
+
+#endif //ARCTIC_PARTICLE_EMITTER_H
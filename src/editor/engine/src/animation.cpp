@@ -0,0 +1,553 @@
+#include "animation.h"
+#include "utilities/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <xmmintrin.h>
+
+namespace
+{
+    const float SQRT_2 = 1.41421356f;
+    const uint32_t MAX_FRAME_COUNT = 1u << 16; // key frames are 16-bit
+
+    // greedy linear key reduction
+    //> a key is only added when interpolating from the last key to the next frame would leave the tolerance
+    //> for any frame in between, so the result reproduces every raw sample within it
+    std::vector<uint32_t> reduceKeys(const std::vector<glm::vec4>& values, float tolerance, bool isRotation)
+    {
+        auto interpolate = [isRotation](const glm::vec4& a, const glm::vec4& b, float alpha) {
+            glm::vec4 value = a + (b - a) * alpha;
+            return isRotation ? value / std::sqrt(glm::dot(value, value)) : value;
+        };
+        auto isWithinTolerance = [tolerance](const glm::vec4& a, const glm::vec4& b) {
+            glm::vec4 difference = a - b;
+            return std::max(std::max(std::abs(difference.x), std::abs(difference.y)),
+                            std::max(std::abs(difference.z), std::abs(difference.w))) <= tolerance;
+        };
+
+        const auto frameCount = static_cast<uint32_t>(values.size());
+
+        // constant channel
+        bool isConstant = true;
+        for (uint32_t frame = 1; isConstant && frame < frameCount; ++frame)
+            isConstant = isWithinTolerance(values[0], values[frame]);
+        if (isConstant)
+            return {0};
+
+        std::vector<uint32_t> keys = {0};
+        uint32_t start = 0;
+        for (uint32_t end = 2; end < frameCount; ++end)
+        {
+            // check every frame between the last key & the candidate
+            bool isCovered = true;
+            for (uint32_t frame = start + 1; isCovered && frame < end; ++frame)
+            {
+                float alpha = static_cast<float>(frame - start) / static_cast<float>(end - start);
+                isCovered = isWithinTolerance(interpolate(values[start], values[end], alpha), values[frame]);
+            }
+            if (!isCovered)
+            {
+                start = end - 1;
+                keys.push_back(start);
+            }
+        }
+        keys.push_back(frameCount - 1);
+        return keys;
+    }
+
+    // affine product, rows of 'a' weight the rows of 'b'
+    AffineMatrix multiply(const AffineMatrix& a, const AffineMatrix& b)
+    {
+        const __m128 b0 = _mm_loadu_ps(&b.rows[0].x);
+        const __m128 b1 = _mm_loadu_ps(&b.rows[1].x);
+        const __m128 b2 = _mm_loadu_ps(&b.rows[2].x);
+
+        AffineMatrix result;
+        for (int i = 0; i < 3; ++i)
+        {
+            const glm::vec4& row = a.rows[i];
+            __m128 value = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(row.x), b0),
+                                                 _mm_mul_ps(_mm_set1_ps(row.y), b1)),
+                                      _mm_add_ps(_mm_mul_ps(_mm_set1_ps(row.z), b2),
+                                                 _mm_set_ps(row.w, 0.0f, 0.0f, 0.0f)));
+            _mm_storeu_ps(&result.rows[i].x, value);
+        }
+        return result;
+    }
+
+    // nlerp of four quaternions, 'to' is flipped onto the hemisphere of 'from'
+    void nlerp4(const float* fromX, const float* fromY, const float* fromZ, const float* fromW,
+                const float* toX, const float* toY, const float* toZ, const float* toW,
+                __m128 alpha,
+                float* resultX, float* resultY, float* resultZ, float* resultW)
+    {
+        __m128 ax = _mm_load_ps(fromX), ay = _mm_load_ps(fromY), az = _mm_load_ps(fromZ), aw = _mm_load_ps(fromW);
+        __m128 bx = _mm_load_ps(toX), by = _mm_load_ps(toY), bz = _mm_load_ps(toZ), bw = _mm_load_ps(toW);
+
+        // shorter arc: negate 'to' where the dot product is negative
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+        __m128 sign = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+        bx = _mm_xor_ps(bx, sign);
+        by = _mm_xor_ps(by, sign);
+        bz = _mm_xor_ps(bz, sign);
+        bw = _mm_xor_ps(bw, sign);
+
+        __m128 x = _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(bx, ax), alpha));
+        __m128 y = _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(by, ay), alpha));
+        __m128 z = _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(bz, az), alpha));
+        __m128 w = _mm_add_ps(aw, _mm_mul_ps(_mm_sub_ps(bw, aw), alpha));
+
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                                          _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+        __m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSquared));
+        _mm_store_ps(resultX, _mm_mul_ps(x, inverseLength));
+        _mm_store_ps(resultY, _mm_mul_ps(y, inverseLength));
+        _mm_store_ps(resultZ, _mm_mul_ps(z, inverseLength));
+        _mm_store_ps(resultW, _mm_mul_ps(w, inverseLength));
+    }
+
+    void lerp4(const float* from, const float* to, __m128 alpha, float* result)
+    {
+        __m128 a = _mm_load_ps(from);
+        _mm_store_ps(result, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(to), a), alpha)));
+    }
+
+    void setLane(JointTransform4& group, uint32_t lane, const JointTransform& transform)
+    {
+        group.rotationX[lane] = transform.rotation.x;
+        group.rotationY[lane] = transform.rotation.y;
+        group.rotationZ[lane] = transform.rotation.z;
+        group.rotationW[lane] = transform.rotation.w;
+        group.translationX[lane] = transform.translation.x;
+        group.translationY[lane] = transform.translation.y;
+        group.translationZ[lane] = transform.translation.z;
+        group.scaleX[lane] = transform.scale.x;
+        group.scaleY[lane] = transform.scale.y;
+        group.scaleZ[lane] = transform.scale.z;
+    }
+}
+
+#pragma region animation_matrix
+
+AffineMatrix AffineMatrix::Identity()
+{
+    return {{glm::vec4(1.0f, 0.0f, 0.0f, 0.0f),
+             glm::vec4(0.0f, 1.0f, 0.0f, 0.0f),
+             glm::vec4(0.0f, 0.0f, 1.0f, 0.0f)}};
+}
+
+AffineMatrix AffineMatrix::FromTransform(const JointTransform& transform)
+{
+    const glm::vec4& q = transform.rotation;
+    const glm::vec3& s = transform.scale;
+    const glm::vec3& t = transform.translation;
+    return {{glm::vec4((1.0f - 2.0f * (q.y * q.y + q.z * q.z)) * s.x, 2.0f * (q.x * q.y - q.w * q.z) * s.y, 2.0f * (q.x * q.z + q.w * q.y) * s.z, t.x),
+             glm::vec4(2.0f * (q.x * q.y + q.w * q.z) * s.x, (1.0f - 2.0f * (q.x * q.x + q.z * q.z)) * s.y, 2.0f * (q.y * q.z - q.w * q.x) * s.z, t.y),
+             glm::vec4(2.0f * (q.x * q.z - q.w * q.y) * s.x, 2.0f * (q.y * q.z + q.w * q.x) * s.y, (1.0f - 2.0f * (q.x * q.x + q.y * q.y)) * s.z, t.z)}};
+}
+
+AffineMatrix AffineMatrix::Inverse() const
+{
+    // inverse of the 3x3 part by cofactors, the translation is moved through it
+    const glm::vec4* m = rows;
+    float c00 = m[1].y * m[2].z - m[1].z * m[2].y;
+    float c01 = m[1].z * m[2].x - m[1].x * m[2].z;
+    float c02 = m[1].x * m[2].y - m[1].y * m[2].x;
+    float determinant = m[0].x * c00 + m[0].y * c01 + m[0].z * c02;
+    if (std::abs(determinant) < 1e-12f)
+        return Identity();
+    float inverseDeterminant = 1.0f / determinant;
+
+    AffineMatrix inverse;
+    inverse.rows[0] = glm::vec4(c00, m[0].z * m[2].y - m[0].y * m[2].z, m[0].y * m[1].z - m[0].z * m[1].y, 0.0f) * inverseDeterminant;
+    inverse.rows[1] = glm::vec4(c01, m[0].x * m[2].z - m[0].z * m[2].x, m[0].z * m[1].x - m[0].x * m[1].z, 0.0f) * inverseDeterminant;
+    inverse.rows[2] = glm::vec4(c02, m[0].y * m[2].x - m[0].x * m[2].y, m[0].x * m[1].y - m[0].y * m[1].x, 0.0f) * inverseDeterminant;
+    for (auto& row : inverse.rows)
+        row.w = -(row.x * m[0].w + row.y * m[1].w + row.z * m[2].w);
+    return inverse;
+}
+
+#pragma endregion animation_matrix
+
+#pragma region animation_skeleton
+
+bool Skeleton::Initialize(std::vector<int32_t> jointParents, std::vector<JointTransform> jointBindPose)
+{
+    const auto jointCount = static_cast<uint32_t>(jointParents.size());
+    if (jointCount == 0 || jointCount > MAX_JOINT_COUNT || jointBindPose.size() != jointCount)
+    {
+        ARCTIC_LOG_ERROR(General, "invalid skeleton with {} joints!", jointCount);
+        return false;
+    }
+    for (uint32_t joint = 0; joint < jointCount; ++joint)
+    {
+        if (jointParents[joint] < -1 || jointParents[joint] >= static_cast<int32_t>(joint))
+        {
+            ARCTIC_LOG_ERROR(General, "skeleton joint {} is not sorted after its parent!", joint);
+            return false;
+        }
+    }
+
+    parents = std::move(jointParents);
+    bindPose = std::move(jointBindPose);
+
+    // invert the model space bind pose
+    std::vector<AffineMatrix> modelMatrices(jointCount);
+    inverseBindMatrices.resize(jointCount);
+    for (uint32_t joint = 0; joint < jointCount; ++joint)
+    {
+        AffineMatrix local = AffineMatrix::FromTransform(bindPose[joint]);
+        modelMatrices[joint] = parents[joint] < 0 ? local : multiply(modelMatrices[parents[joint]], local);
+        inverseBindMatrices[joint] = modelMatrices[joint].Inverse();
+    }
+    return true;
+}
+
+#pragma endregion animation_skeleton
+
+#pragma region animation_clip
+
+bool AnimationClip::Compress(const RawAnimationClip& raw, const ClipCompressionSettings& settings)
+{
+    if (raw.frameCount == 0 || raw.frameCount > MAX_FRAME_COUNT ||
+        raw.jointCount == 0 || raw.jointCount > Skeleton::MAX_JOINT_COUNT ||
+        raw.sampleRate <= 0.0f || raw.samples.size() != static_cast<size_t>(raw.frameCount) * raw.jointCount)
+    {
+        ARCTIC_LOG_ERROR(General, "invalid raw clip with {} frames & {} joints!", raw.frameCount, raw.jointCount);
+        return false;
+    }
+
+    sampleRate = raw.sampleRate;
+    frameCount = raw.frameCount;
+    jointCount = raw.jointCount;
+    duration = static_cast<float>(frameCount - 1) / sampleRate;
+    rawSize = raw.samples.size() * sizeof(JointTransform);
+
+    channels.assign(static_cast<size_t>(jointCount) * ChannelCount, {});
+    keyFrames.clear();
+    rotationKeys.clear();
+    vectorKeys.clear();
+
+    std::vector<glm::vec4> values(frameCount);
+    for (uint32_t joint = 0; joint < jointCount; ++joint)
+    {
+        auto sample = [&](uint32_t frame) -> const JointTransform& {
+            return raw.samples[static_cast<size_t>(frame) * jointCount + joint];
+        };
+
+        // rotation
+        //> normalized & kept on one hemisphere, so neighboring keys interpolate along the shorter arc
+        for (uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            glm::vec4 rotation = sample(frame).rotation;
+            rotation = rotation / std::sqrt(glm::dot(rotation, rotation));
+            if (frame > 0 && glm::dot(rotation, values[frame - 1]) < 0.0f)
+                rotation = rotation * -1.0f;
+            values[frame] = rotation;
+        }
+        Channel& rotationChannel = channels[joint * ChannelCount + ChannelRotation];
+        rotationChannel.firstFrame = static_cast<uint32_t>(keyFrames.size());
+        rotationChannel.firstValue = static_cast<uint32_t>(rotationKeys.size());
+        for (uint32_t frame : reduceKeys(values, settings.rotationTolerance, true))
+        {
+            keyFrames.push_back(static_cast<uint16_t>(frame));
+            rotationKeys.push_back(quantize(values[frame]));
+        }
+        rotationChannel.keyCount = static_cast<uint32_t>(keyFrames.size()) - rotationChannel.firstFrame;
+
+        // translation & scale
+        //> quantized within the range of the channel
+        for (ChannelType type : {ChannelTranslation, ChannelScale})
+        {
+            glm::vec3 minValue(std::numeric_limits<float>::max());
+            glm::vec3 maxValue(-std::numeric_limits<float>::max());
+            for (uint32_t frame = 0; frame < frameCount; ++frame)
+            {
+                glm::vec3 value = type == ChannelTranslation ? sample(frame).translation : sample(frame).scale;
+                minValue = glm::min(minValue, value);
+                maxValue = glm::max(maxValue, value);
+                values[frame] = glm::vec4(value, 0.0f);
+            }
+
+            Channel& channel = channels[joint * ChannelCount + type];
+            channel.rangeMin = minValue;
+            channel.rangeExtent = maxValue - minValue;
+            channel.firstFrame = static_cast<uint32_t>(keyFrames.size());
+            channel.firstValue = static_cast<uint32_t>(vectorKeys.size());
+            float tolerance = type == ChannelTranslation ? settings.translationTolerance : settings.scaleTolerance;
+            for (uint32_t frame : reduceKeys(values, tolerance, false))
+            {
+                keyFrames.push_back(static_cast<uint16_t>(frame));
+                vectorKeys.push_back(quantize(glm::vec3(values[frame]), channel));
+            }
+            channel.keyCount = static_cast<uint32_t>(keyFrames.size()) - channel.firstFrame;
+        }
+    }
+    return true;
+}
+
+uint64_t AnimationClip::GetCompressedSize() const
+{
+    return channels.size() * sizeof(Channel) +
+           keyFrames.size() * sizeof(uint16_t) +
+           rotationKeys.size() * sizeof(QuantizedQuaternion) +
+           vectorKeys.size() * sizeof(QuantizedVector);
+}
+
+void AnimationClip::Sample(float time, bool isLooping, Pose& pose) const
+{
+    const uint32_t groupCount = (jointCount + 3) / 4;
+    pose.resize(groupCount);
+
+    // time to frame
+    if (isLooping && duration > 0.0f)
+    {
+        time = std::fmod(time, duration);
+        if (time < 0.0f)
+            time += duration;
+    }
+    float frame = std::clamp(time * sampleRate, 0.0f, static_cast<float>(frameCount - 1));
+
+    // decode keys of four joints, then interpolate them together
+    alignas(16) JointTransform4 from{};
+    alignas(16) JointTransform4 to{};
+    alignas(16) float alphas[ChannelCount][4] = {};
+    for (uint32_t group = 0; group < groupCount; ++group)
+    {
+        for (uint32_t lane = 0; lane < 4; ++lane)
+        {
+            uint32_t joint = group * 4 + lane;
+            if (joint >= jointCount)
+            {
+                setLane(from, lane, {});
+                setLane(to, lane, {});
+                continue;
+            }
+
+            JointTransform a, b;
+            uint32_t key0, key1;
+
+            const Channel& rotation = channels[joint * ChannelCount + ChannelRotation];
+            findKeys(rotation, frame, key0, key1, alphas[ChannelRotation][lane]);
+            a.rotation = dequantize(rotationKeys[rotation.firstValue + key0]);
+            b.rotation = dequantize(rotationKeys[rotation.firstValue + key1]);
+
+            const Channel& translation = channels[joint * ChannelCount + ChannelTranslation];
+            findKeys(translation, frame, key0, key1, alphas[ChannelTranslation][lane]);
+            a.translation = dequantize(vectorKeys[translation.firstValue + key0], translation);
+            b.translation = dequantize(vectorKeys[translation.firstValue + key1], translation);
+
+            const Channel& scale = channels[joint * ChannelCount + ChannelScale];
+            findKeys(scale, frame, key0, key1, alphas[ChannelScale][lane]);
+            a.scale = dequantize(vectorKeys[scale.firstValue + key0], scale);
+            b.scale = dequantize(vectorKeys[scale.firstValue + key1], scale);
+
+            setLane(from, lane, a);
+            setLane(to, lane, b);
+        }
+
+        JointTransform4& result = pose[group];
+        nlerp4(from.rotationX, from.rotationY, from.rotationZ, from.rotationW,
+               to.rotationX, to.rotationY, to.rotationZ, to.rotationW,
+               _mm_load_ps(alphas[ChannelRotation]),
+               result.rotationX, result.rotationY, result.rotationZ, result.rotationW);
+
+        __m128 translationAlpha = _mm_load_ps(alphas[ChannelTranslation]);
+        lerp4(from.translationX, to.translationX, translationAlpha, result.translationX);
+        lerp4(from.translationY, to.translationY, translationAlpha, result.translationY);
+        lerp4(from.translationZ, to.translationZ, translationAlpha, result.translationZ);
+
+        __m128 scaleAlpha = _mm_load_ps(alphas[ChannelScale]);
+        lerp4(from.scaleX, to.scaleX, scaleAlpha, result.scaleX);
+        lerp4(from.scaleY, to.scaleY, scaleAlpha, result.scaleY);
+        lerp4(from.scaleZ, to.scaleZ, scaleAlpha, result.scaleZ);
+    }
+}
+
+void AnimationClip::findKeys(const Channel& channel, float frame, uint32_t& key0, uint32_t& key1, float& alpha) const
+{
+    // single key or before the first
+    const uint16_t* frames = keyFrames.data() + channel.firstFrame;
+    if (channel.keyCount == 1 || frame <= frames[0])
+    {
+        key0 = key1 = 0;
+        alpha = 0.0f;
+        return;
+    }
+
+    // first key after the frame
+    const uint16_t* next = std::upper_bound(frames, frames + channel.keyCount, frame, [](float value, uint16_t keyFrame) {
+        return value < static_cast<float>(keyFrame);
+    });
+    if (next == frames + channel.keyCount)
+    {
+        key0 = key1 = channel.keyCount - 1;
+        alpha = 0.0f;
+        return;
+    }
+
+    key1 = static_cast<uint32_t>(next - frames);
+    key0 = key1 - 1;
+    alpha = (frame - frames[key0]) / static_cast<float>(frames[key1] - frames[key0]);
+}
+
+AnimationClip::QuantizedQuaternion AnimationClip::quantize(const glm::vec4& rotation)
+{
+    // drop the largest component, it is restored from the unit length
+    //> the sign is flipped so the dropped one is positive, q & -q are the same rotation
+    const float components[4] = {rotation.x, rotation.y, rotation.z, rotation.w};
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i)
+    {
+        if (std::abs(components[i]) > std::abs(components[largest]))
+            largest = i;
+    }
+    float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+    //> the others are within +-1/sqrt(2)
+    QuantizedQuaternion result{};
+    for (uint32_t i = 0, slot = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+        float normalized = std::clamp((components[i] * sign * SQRT_2 + 1.0f) * 0.5f, 0.0f, 1.0f);
+        result.values[slot++] = static_cast<uint16_t>(std::lround(normalized * 32767.0f));
+    }
+    result.values[0] |= static_cast<uint16_t>((largest & 1) << 15);
+    result.values[1] |= static_cast<uint16_t>((largest >> 1) << 15);
+    return result;
+}
+
+glm::vec4 AnimationClip::dequantize(const QuantizedQuaternion& rotation)
+{
+    uint32_t largest = (rotation.values[0] >> 15) | ((rotation.values[1] >> 15) << 1);
+
+    float components[4];
+    float sumSquared = 0.0f;
+    for (uint32_t i = 0, slot = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+        float normalized = static_cast<float>(rotation.values[slot++] & 0x7FFF) / 32767.0f;
+        components[i] = (normalized * 2.0f - 1.0f) / SQRT_2;
+        sumSquared += components[i] * components[i];
+    }
+    components[largest] = std::sqrt(std::max(1.0f - sumSquared, 0.0f));
+    return {components[0], components[1], components[2], components[3]};
+}
+
+AnimationClip::QuantizedVector AnimationClip::quantize(const glm::vec3& value, const Channel& channel)
+{
+    QuantizedVector result{};
+    for (int i = 0; i < 3; ++i)
+    {
+        float normalized = channel.rangeExtent[i] > 0.0f ? (value[i] - channel.rangeMin[i]) / channel.rangeExtent[i] : 0.0f;
+        result.values[i] = static_cast<uint16_t>(std::lround(std::clamp(normalized, 0.0f, 1.0f) * 65535.0f));
+    }
+    return result;
+}
+
+glm::vec3 AnimationClip::dequantize(const QuantizedVector& value, const Channel& channel)
+{
+    return channel.rangeMin + channel.rangeExtent * glm::vec3(static_cast<float>(value.values[0]) / 65535.0f,
+                                                              static_cast<float>(value.values[1]) / 65535.0f,
+                                                              static_cast<float>(value.values[2]) / 65535.0f);
+}
+
+#pragma endregion animation_clip
+
+#pragma region animation_pose
+
+void PoseUtility::SetBindPose(const Skeleton& skeleton, Pose& pose)
+{
+    pose.resize(skeleton.GetGroupCount());
+    for (uint32_t joint = 0; joint < pose.size() * 4; ++joint)
+        setLane(pose[joint / 4], joint % 4, joint < skeleton.GetJointCount() ? skeleton.bindPose[joint] : JointTransform{});
+}
+
+void PoseUtility::Blend(const Pose& from, const Pose& to, float weight, Pose& result)
+{
+    const size_t groupCount = std::min(from.size(), to.size());
+    result.resize(groupCount);
+
+    const __m128 alpha = _mm_set1_ps(weight);
+    for (size_t group = 0; group < groupCount; ++group)
+    {
+        const JointTransform4& a = from[group];
+        const JointTransform4& b = to[group];
+        JointTransform4& c = result[group];
+
+        nlerp4(a.rotationX, a.rotationY, a.rotationZ, a.rotationW,
+               b.rotationX, b.rotationY, b.rotationZ, b.rotationW,
+               alpha,
+               c.rotationX, c.rotationY, c.rotationZ, c.rotationW);
+        lerp4(a.translationX, b.translationX, alpha, c.translationX);
+        lerp4(a.translationY, b.translationY, alpha, c.translationY);
+        lerp4(a.translationZ, b.translationZ, alpha, c.translationZ);
+        lerp4(a.scaleX, b.scaleX, alpha, c.scaleX);
+        lerp4(a.scaleY, b.scaleY, alpha, c.scaleY);
+        lerp4(a.scaleZ, b.scaleZ, alpha, c.scaleZ);
+    }
+}
+
+void PoseUtility::ComputeSkinningMatrices(const Skeleton& skeleton,
+                                          const Pose& pose,
+                                          std::vector<AffineMatrix>& modelMatrices,
+                                          AffineMatrix* skinningMatrices)
+{
+    const uint32_t jointCount = skeleton.GetJointCount();
+    modelMatrices.resize(static_cast<size_t>(skeleton.GetGroupCount()) * 4);
+
+    // local matrices, four joints at once
+    //> rotation times scale per column, translation in w; transposed from lanes to rows on store
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    for (uint32_t group = 0; group < skeleton.GetGroupCount(); ++group)
+    {
+        const JointTransform4& transform = pose[group];
+        __m128 x = _mm_load_ps(transform.rotationX), y = _mm_load_ps(transform.rotationY);
+        __m128 z = _mm_load_ps(transform.rotationZ), w = _mm_load_ps(transform.rotationW);
+        __m128 sx = _mm_load_ps(transform.scaleX), sy = _mm_load_ps(transform.scaleY), sz = _mm_load_ps(transform.scaleZ);
+
+        __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+        __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+        __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+        __m128 row0[4] = {_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+                          _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+                          _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+                          _mm_load_ps(transform.translationX)};
+        __m128 row1[4] = {_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+                          _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+                          _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+                          _mm_load_ps(transform.translationY)};
+        __m128 row2[4] = {_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx),
+                          _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy),
+                          _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+                          _mm_load_ps(transform.translationZ)};
+
+        _MM_TRANSPOSE4_PS(row0[0], row0[1], row0[2], row0[3]);
+        _MM_TRANSPOSE4_PS(row1[0], row1[1], row1[2], row1[3]);
+        _MM_TRANSPOSE4_PS(row2[0], row2[1], row2[2], row2[3]);
+        for (uint32_t lane = 0; lane < 4; ++lane)
+        {
+            AffineMatrix& local = modelMatrices[group * 4 + lane];
+            _mm_storeu_ps(&local.rows[0].x, row0[lane]);
+            _mm_storeu_ps(&local.rows[1].x, row1[lane]);
+            _mm_storeu_ps(&local.rows[2].x, row2[lane]);
+        }
+    }
+
+    // model space & skinning matrices
+    //> parents come first, their model matrix is final when a child reads it
+    for (uint32_t joint = 0; joint < jointCount; ++joint)
+    {
+        int32_t parent = skeleton.parents[joint];
+        if (parent >= 0)
+            modelMatrices[joint] = multiply(modelMatrices[parent], modelMatrices[joint]);
+        skinningMatrices[joint] = multiply(modelMatrices[joint], skeleton.inverseBindMatrices[joint]);
+    }
+}
+
+#pragma endregion animation_pose
@@ -0,0 +1,174 @@
+#ifndef ARCTIC_ANIMATION_H
+#define ARCTIC_ANIMATION_H
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// local transform of a joint relative to its parent
+struct JointTransform
+{
+    glm::vec4 rotation{0.0f, 0.0f, 0.0f, 1.0f}; // quaternion xyzw
+    glm::vec3 translation{0.0f};
+    glm::vec3 scale{1.0f};
+};
+
+// affine 3x4 matrix, rows of a column vector transform (xyz: rotation & scale, w: translation)
+struct AffineMatrix
+{
+    glm::vec4 rows[3];
+
+    static AffineMatrix Identity();
+    static AffineMatrix FromTransform(const JointTransform& transform);
+    AffineMatrix Inverse() const;
+};
+
+// local transforms of four joints, struct of arrays so one sse register holds a channel of all four
+//> poses are stored in groups of four, the lanes past the joint count are padding
+struct alignas(16) JointTransform4
+{
+    float rotationX[4];
+    float rotationY[4];
+    float rotationZ[4];
+    float rotationW[4];
+    float translationX[4];
+    float translationY[4];
+    float translationZ[4];
+    float scaleX[4];
+    float scaleY[4];
+    float scaleZ[4];
+};
+using Pose = std::vector<JointTransform4>;
+
+// joint hierarchy with its bind pose
+//> joints are sorted parents first, so model space transforms are built in one pass
+struct Skeleton
+{
+    static constexpr uint32_t MAX_JOINT_COUNT = 256; // skin influences store 8-bit joint indices
+
+    std::vector<int32_t> parents; // -1 for roots
+    std::vector<JointTransform> bindPose;
+    std::vector<AffineMatrix> inverseBindMatrices; // model space to joint space, built by 'Initialize'
+
+    // returns false when the hierarchy is not sorted or too large
+    bool Initialize(std::vector<int32_t> jointParents, std::vector<JointTransform> jointBindPose);
+
+    uint32_t GetJointCount() const {
+        return static_cast<uint32_t>(parents.size());
+    }
+    uint32_t GetGroupCount() const {
+        return (GetJointCount() + 3) / 4;
+    }
+};
+
+// clip as authored: every joint sampled at a fixed rate
+struct RawAnimationClip
+{
+    float sampleRate = 30.0f; // hz
+    uint32_t frameCount = 0;
+    uint32_t jointCount = 0;
+    std::vector<JointTransform> samples; // frame major: samples[frame * jointCount + joint]
+};
+
+// max error a removed key may introduce, rotations in quaternion components, the rest in their units
+struct ClipCompressionSettings
+{
+    float rotationTolerance = 0.0005f;
+    float translationTolerance = 0.0001f;
+    float scaleTolerance = 0.0001f;
+};
+
+// compressed animation clip
+//> every joint has a rotation, translation & scale channel holding only the keys needed to stay within tolerance
+//> of the raw samples, constant channels keep a single key (greedy linear key reduction)
+//> rotations are stored as smallest three quaternions: three 15-bit components & the index of the dropped one (6 bytes)
+//> translations & scales are 16-bit per component within the channel's range
+//> sampling decodes the two keys around the time per channel & interpolates four joints at once
+class AnimationClip
+{
+public:
+    bool Compress(const RawAnimationClip& raw, const ClipCompressionSettings& settings = {});
+
+    // local transforms at 'time' seconds, clamped or wrapped, into a pose of the clip's joint count
+    void Sample(float time, bool isLooping, Pose& pose) const;
+
+    float GetDuration() const {
+        return duration;
+    }
+    uint32_t GetJointCount() const {
+        return jointCount;
+    }
+    uint32_t GetKeyCount() const {
+        return static_cast<uint32_t>(keyFrames.size());
+    }
+    uint64_t GetRawSize() const {
+        return rawSize;
+    }
+    uint64_t GetCompressedSize() const;
+
+private:
+    enum ChannelType : uint32_t
+    {
+        ChannelRotation,
+        ChannelTranslation,
+        ChannelScale,
+        ChannelCount
+    };
+
+    struct Channel
+    {
+        uint32_t firstFrame; // into 'keyFrames'
+        uint32_t firstValue; // into 'rotationKeys' or 'vectorKeys'
+        uint32_t keyCount;
+        glm::vec3 rangeMin; // translation & scale only
+        glm::vec3 rangeExtent;
+    };
+
+    struct QuantizedQuaternion
+    {
+        uint16_t values[3]; // 15 bits each, the top bits of the first two hold the dropped component
+    };
+
+    struct QuantizedVector
+    {
+        uint16_t values[3];
+    };
+
+    float sampleRate = 30.0f;
+    float duration = 0.0f;
+    uint32_t frameCount = 0;
+    uint32_t jointCount = 0;
+    uint64_t rawSize = 0;
+
+    std::vector<Channel> channels; // joint major: channels[joint * ChannelCount + type]
+    std::vector<uint16_t> keyFrames; // frame of every key, ascending per channel
+    std::vector<QuantizedQuaternion> rotationKeys;
+    std::vector<QuantizedVector> vectorKeys; // translations & scales
+
+    static QuantizedQuaternion quantize(const glm::vec4& rotation);
+    static glm::vec4 dequantize(const QuantizedQuaternion& rotation);
+    static QuantizedVector quantize(const glm::vec3& value, const Channel& channel);
+    static glm::vec3 dequantize(const QuantizedVector& value, const Channel& channel);
+
+    // keys around 'frame', relative to the first key of the channel
+    void findKeys(const Channel& channel, float frame, uint32_t& key0, uint32_t& key1, float& alpha) const;
+};
+
+// pose operations, sse over groups of four joints
+class PoseUtility
+{
+public:
+    static void SetBindPose(const Skeleton& skeleton, Pose& pose);
+
+    // normalized lerp, the shorter arc is taken per joint
+    static void Blend(const Pose& from, const Pose& to, float weight, Pose& result);
+
+    // model space transforms times inverse bind matrices, ready for skinning
+    //> 'modelMatrices' is scratch, kept by the caller so per frame calls don't allocate
+    static void ComputeSkinningMatrices(const Skeleton& skeleton,
+                                        const Pose& pose,
+                                        std::vector<AffineMatrix>& modelMatrices,
+                                        AffineMatrix* skinningMatrices);
+};
+
+#endif //ARCTIC_ANIMATION_H
@@ -1,28 +1,225 @@
+#ifndef ARCTIC_SERVER
 #include <GLFW/glfw3.h>
 #include "vulkan_loader.h"
+#endif
+#include "utilities/job_system.h"
+#include "simulation_loop.h"
+#include "scene.h"
+#include "broadphase.h"
 #include "engine/arctic_engine.h"
+#include <cmath>
 
-void ArcticEngine::run()
+namespace
 {
+    // returns false when the box is not finite or inverted
+    bool toAabb(const float min[3], const float max[3], Aabb& bounds)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            if (!std::isfinite(min[i]) || !std::isfinite(max[i]) || min[i] > max[i])
+                return false;
+        }
+        bounds.min = glm::vec3(min[0], min[1], min[2]);
+        bounds.max = glm::vec3(max[0], max[1], max[2]);
+        return true;
+    }
+
+    void toUserDataPairs(const Broadphase& broadphase,
+                         const std::vector<Broadphase::Pair>& pairs,
+                         std::vector<std::pair<uint32_t, uint32_t>>& userDataPairs)
+    {
+        userDataPairs.clear();
+        userDataPairs.reserve(pairs.size());
+        for (const Broadphase::Pair& pair : pairs)
+            userDataPairs.emplace_back(broadphase.GetUserData(pair.proxyA), broadphase.GetUserData(pair.proxyB));
+    }
+}
+
+void ArcticEngine::run(uint64_t tickLimit)
+{
+#ifdef ARCTIC_SERVER
+    // tick until stopped
+    //> sleeps between ticks
+    simulationLoop->Run(tickLimit);
+#else
     // loop while no close window
+    //> the simulation ticks at its fixed rate, independent of the frame rate
     auto window = vulkanLoader->GetWindow();
-    while (!glfwWindowShouldClose(window))
+    while (!glfwWindowShouldClose(window) && !simulationLoop->IsStopRequested())
     {
         glfwPollEvents();
+        simulationLoop->Advance();
         vulkanLoader->Draw();
     }
+#endif
 }
 
-void ArcticEngine::initialize()
+void ArcticEngine::initialize(double tickRate)
 {
+    // start jobs
+    jobSystem = new JobSystem();
+    jobSystem->Initialize();
+
+    // start simulation
+    simulationLoop = new SimulationLoop();
+    simulationLoop->Initialize(tickRate, nullptr);
+
+    // start overlaps
+    broadphase = new Broadphase();
+    broadphase->Initialize();
+
+#ifndef ARCTIC_SERVER
     // load vulkan
-    vulkanLoader = new VulkanLoader();
+    vulkanLoader = new VulkanLoader(*jobSystem);
     vulkanLoader->Load();
+#endif
 }
 
 void ArcticEngine::cleanup()
 {
+#ifndef ARCTIC_SERVER
+    // cleanup vulkan
+    vulkanLoader->Cleanup();
+    delete vulkanLoader;
+#endif
+
+    delete simulationLoop;
+    delete broadphase;
+    delete scene;
+
+    // stop jobs
+    jobSystem->Shutdown();
+    delete jobSystem;
+}
+
+void ArcticEngine::setTickCallback(std::function<void(double deltaTime)> callback)
+{
+    simulationLoop->SetTickFunc(std::move(callback));
+}
+
+void ArcticEngine::requestStop()
+{
+    simulationLoop->RequestStop();
+}
+
+void ArcticEngine::printStats() const
+{
+    simulationLoop->PrintStats();
+    if (broadphase->GetStats().proxyCount > 0)
+        broadphase->PrintStats();
+    if (scene != nullptr)
+        scene->PrintStats();
+}
+
+bool ArcticEngine::loadScene(const std::string& path)
+{
+    if (scene == nullptr)
+        scene = new Scene();
+    return scene->Load(path);
+}
+
+uint32_t ArcticEngine::insertBounds(const float min[3], const float max[3], uint32_t userData)
+{
+    Aabb bounds;
+    if (!toAabb(min, max, bounds))
+        return INVALID_BOUNDS;
+    return broadphase->Insert(bounds, userData);
+}
+
+void ArcticEngine::moveBounds(uint32_t bounds, const float min[3], const float max[3])
+{
+    Aabb box;
+    if (toAabb(min, max, box))
+        broadphase->Move(bounds, box);
+}
+
+void ArcticEngine::removeBounds(uint32_t bounds)
+{
+    broadphase->Remove(bounds);
+}
+
+void ArcticEngine::updateOverlaps()
+{
+    broadphase->Update(jobSystem);
+}
+
+void ArcticEngine::getOverlaps(std::vector<std::pair<uint32_t, uint32_t>>& overlaps) const
+{
+    toUserDataPairs(*broadphase, broadphase->GetPairs(), overlaps);
+}
+
+void ArcticEngine::getOverlapChanges(std::vector<std::pair<uint32_t, uint32_t>>& added,
+                                     std::vector<std::pair<uint32_t, uint32_t>>& removed) const
+{
+    toUserDataPairs(*broadphase, broadphase->GetAddedPairs(), added);
+    toUserDataPairs(*broadphase, broadphase->GetRemovedPairs(), removed);
+}
+
+void ArcticEngine::queryBounds(const float min[3], const float max[3], std::vector<uint32_t>& results) const
+{
+    Aabb bounds;
+    if (toAabb(min, max, bounds))
+        broadphase->QueryAabb(bounds, results);
+}
+
+#ifndef ARCTIC_SERVER
+
+void ArcticEngine::capture(const std::string& path, uint32_t frameCount)
+{
+    vulkanLoader->BeginCapture(path, frameCount);
+}
+
+void ArcticEngine::dumpStats(const std::string& path, uint32_t frameCount)
+{
+    vulkanLoader->BeginStatsDump(path, frameCount);
+}
+
+void ArcticEngine::setOverdrawView(bool isEnabled)
+{
+    vulkanLoader->SetOverdrawView(isEnabled);
+}
+
+uint32_t ArcticEngine::createParticleSystem(const std::string& name, uint32_t capacity, const ParticleEmitter& emitter)
+{
+    return vulkanLoader->CreateParticleSystem(name, capacity, emitter).GetValue();
+}
+
+void ArcticEngine::destroyParticleSystem(uint32_t particleSystem)
+{
+    vulkanLoader->DestroyParticleSystem(ParticleSystemHandle::FromValue(particleSystem));
+}
+
+void ArcticEngine::setParticleEmitter(uint32_t particleSystem, const ParticleEmitter& emitter)
+{
+    vulkanLoader->SetParticleEmitter(ParticleSystemHandle::FromValue(particleSystem), emitter);
+}
+
+bool ArcticEngine::replay(const std::string& path, uint32_t iterations)
+{
+    // load capture
+    CommandCapture capture;
+    if (!capture.Load(path))
+        return false;
+
+    // start jobs
+    jobSystem = new JobSystem();
+    jobSystem->Initialize();
+
+    // load vulkan without window
+    vulkanLoader = new VulkanLoader(*jobSystem);
+    bool isLoaded = vulkanLoader->LoadHeadless(capture);
+    if (isLoaded)
+        vulkanLoader->Replay(capture, iterations);
+
     // cleanup vulkan
+    //> also after a failed load, only the created objects are destroyed
     vulkanLoader->Cleanup();
     delete vulkanLoader;
+
+    // stop jobs
+    jobSystem->Shutdown();
+    delete jobSystem;
+    return isLoaded;
 }
+
+#endif
@@ -0,0 +1,146 @@
+#include "asset_cache.h"
+
+AssetCache::Pin::Pin(Pin&& other) noexcept : cache(other.cache), entry(other.entry)
+{
+    other.cache = nullptr;
+}
+
+AssetCache::Pin& AssetCache::Pin::operator=(Pin&& other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        cache = other.cache;
+        entry = other.entry;
+        other.cache = nullptr;
+    }
+    return *this;
+}
+
+void AssetCache::Pin::Release()
+{
+    if (cache == nullptr)
+        return;
+
+    std::lock_guard lock(cache->mutex);
+    cache->unpin(entry);
+    cache = nullptr;
+}
+
+void AssetCache::SetBudget(uint64_t bytes)
+{
+    std::lock_guard lock(mutex);
+    budget = bytes;
+    evict(0);
+}
+
+AssetCache::Pin AssetCache::Find(const std::string& id, AssetType type)
+{
+    std::lock_guard lock(mutex);
+    auto it = entryIds.find(id);
+    if (it == entryIds.end() || it->second->type != type)
+    {
+        ++missCount;
+        return {};
+    }
+
+    ++hitCount;
+    pin(*it->second);
+    return {this, it->second};
+}
+
+AssetCache::Pin AssetCache::Insert(const std::string& id, AssetType type, std::unique_ptr<const CachedAssetData> data, uint64_t size)
+{
+    std::lock_guard lock(mutex);
+
+    // keep existing
+    //> the manager loads a path once at a time, so this is only hit after a type mismatch
+    auto it = entryIds.find(id);
+    if (it != entryIds.end())
+    {
+        if (it->second->type != type)
+            return {};
+        pin(*it->second);
+        return {this, it->second};
+    }
+
+    // make room
+    evict(size);
+    if (usedBytes + size > budget)
+    {
+        ++rejectedCount;
+        return {};
+    }
+
+    // insert as most recently used
+    entries.push_front({id, type, std::move(data), size, 0});
+    entryIds.emplace(id, entries.begin());
+    usedBytes += size;
+    ++insertCount;
+
+    pin(entries.front());
+    return {this, entries.begin()};
+}
+
+void AssetCache::Clear()
+{
+    std::lock_guard lock(mutex);
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        if (it->pinCount > 0)
+        {
+            ++it;
+            continue;
+        }
+        usedBytes -= it->size;
+        entryIds.erase(it->id);
+        it = entries.erase(it);
+    }
+}
+
+AssetCache::Stats AssetCache::GetStats() const
+{
+    std::lock_guard lock(mutex);
+    Stats stats{};
+    stats.hitCount = hitCount;
+    stats.missCount = missCount;
+    stats.insertCount = insertCount;
+    stats.evictionCount = evictionCount;
+    stats.rejectedCount = rejectedCount;
+    stats.usedBytes = usedBytes;
+    stats.pinnedBytes = pinnedBytes;
+    stats.budgetBytes = budget;
+    stats.entryCount = static_cast<uint32_t>(entries.size());
+    return stats;
+}
+
+void AssetCache::pin(Entry& entry)
+{
+    if (entry.pinCount++ == 0)
+        pinnedBytes += entry.size;
+}
+
+void AssetCache::unpin(EntryList::iterator entry)
+{
+    // refresh age
+    //> the entry was in use until now
+    entries.splice(entries.begin(), entries, entry);
+    if (--entry->pinCount == 0)
+        pinnedBytes -= entry->size;
+}
+
+void AssetCache::evict(uint64_t requiredBytes)
+{
+    //> stops early when only pinned bytes would be left
+    for (auto it = entries.end(); it != entries.begin() && usedBytes + requiredBytes > budget && usedBytes > pinnedBytes;)
+    {
+        --it;
+        if (it->pinCount > 0)
+            continue;
+
+        usedBytes -= it->size;
+        entryIds.erase(it->id);
+        it = entries.erase(it);
+        ++evictionCount;
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef ARCTIC_ASSET_CACHE_H
+#define ARCTIC_ASSET_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+enum class AssetType : uint8_t;
+
+// decoded cpu side data of an asset, immutable once cached
+struct CachedAssetData
+{
+    virtual ~CachedAssetData() = default;
+};
+
+// decoded assets by id (path) under a byte budget, least recently used entries are evicted first
+//> a pinned entry is in use & never evicted, its pin refreshes its age when released
+//> an entry that does not fit once every unpinned entry is evicted is rejected, pinned bytes can fill the budget
+//> thread safe, the data of a pinned entry is read without locking
+class AssetCache
+{
+    struct Entry
+    {
+        std::string id;
+        AssetType type;
+        std::unique_ptr<const CachedAssetData> data;
+        uint64_t size; // bytes
+        uint32_t pinCount;
+    };
+    using EntryList = std::list<Entry>;
+
+public:
+    static constexpr uint64_t DEFAULT_BUDGET = 64ull << 20; // bytes
+
+    struct Stats
+    {
+        uint64_t hitCount;
+        uint64_t missCount;
+        uint64_t insertCount;
+        uint64_t evictionCount;
+        uint64_t rejectedCount; // did not fit next to the pinned entries
+        uint64_t usedBytes;
+        uint64_t pinnedBytes;
+        uint64_t budgetBytes;
+        uint32_t entryCount;
+    };
+
+    // keeps an entry from being evicted, released on destruction
+    class Pin
+    {
+    public:
+        Pin() = default;
+        Pin(Pin&& other) noexcept;
+        Pin& operator=(Pin&& other) noexcept;
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+        ~Pin() {
+            Release();
+        }
+
+        void Release();
+
+        template<typename T>
+        const T* Get() const {
+            return cache ? static_cast<const T*>(entry->data.get()) : nullptr;
+        }
+        explicit operator bool() const {
+            return cache != nullptr;
+        }
+
+    private:
+        friend class AssetCache;
+
+        AssetCache* cache = nullptr;
+        EntryList::iterator entry;
+
+        Pin(AssetCache* cache, EntryList::iterator entry) : cache(cache), entry(entry) {}
+    };
+
+    // evicts unpinned entries until the used bytes fit
+    void SetBudget(uint64_t bytes);
+
+    // pinned entry of the id, empty on a miss or when cached with another type
+    Pin Find(const std::string& id, AssetType type);
+    // pinned new entry, an entry already cached for the id is kept & returned instead, empty when rejected
+    Pin Insert(const std::string& id, AssetType type, std::unique_ptr<const CachedAssetData> data, uint64_t size);
+
+    // drops every unpinned entry
+    void Clear();
+
+    Stats GetStats() const;
+
+private:
+    mutable std::mutex mutex;
+    EntryList entries; // most recently used first
+    std::unordered_map<std::string, EntryList::iterator> entryIds;
+    uint64_t budget = DEFAULT_BUDGET;
+    uint64_t usedBytes = 0;
+    uint64_t pinnedBytes = 0;
+
+    // stats
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+    uint64_t insertCount = 0;
+    uint64_t evictionCount = 0;
+    uint64_t rejectedCount = 0;
+
+    // under the lock
+    void pin(Entry& entry);
+    void unpin(EntryList::iterator entry);
+    void evict(uint64_t requiredBytes); // from the least recently used end, until 'requiredBytes' fit
+};
+
+#endif //ARCTIC_ASSET_CACHE_H
@@ -0,0 +1,745 @@
+#include "asset_manager.h"
+#include "vulkan_utility.h"
+#include "utilities/file_utility.h"
+#include "utilities/application.h"
+#include "utilities/logger.h"
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    const uint32_t SPIRV_MAGIC = 0x07230203;
+
+    bool findShaderStage(const std::string& path, VkShaderStageFlagBits& stage)
+    {
+        const std::pair<const char*, VkShaderStageFlagBits> suffixes[] = {
+                {".vert.spv", VK_SHADER_STAGE_VERTEX_BIT},
+                {".frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT},
+                {".comp.spv", VK_SHADER_STAGE_COMPUTE_BIT}
+        };
+        for (const auto& [suffix, suffixStage] : suffixes)
+        {
+            if (path.ends_with(suffix))
+            {
+                stage = suffixStage;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // binary ppm: "P6 <width> <height> <max value>" followed by rgb bytes, '#' starts a comment
+    bool decodePpm(const std::vector<char>& file, VkExtent2D& extent, std::vector<uint8_t>& pixels)
+    {
+        size_t offset = 0;
+        auto readToken = [&](std::string& token)
+        {
+            token.clear();
+            while (offset < file.size())
+            {
+                char c = file[offset];
+                if (c == '#')
+                {
+                    while (offset < file.size() && file[offset] != '\n')
+                        ++offset;
+                }
+                else if (std::isspace(static_cast<unsigned char>(c)))
+                {
+                    ++offset;
+                    if (!token.empty())
+                        return true;
+                }
+                else
+                {
+                    token.push_back(c);
+                    ++offset;
+                }
+            }
+            return !token.empty();
+        };
+
+        std::string magic, width, height, maxValue;
+        if (!readToken(magic) || magic != "P6" ||
+            !readToken(width) || !readToken(height) ||
+            !readToken(maxValue) || maxValue != "255")
+            return false;
+
+        auto parse = [](const std::string& token, uint32_t& value)
+        {
+            auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+            return error == std::errc() && end == token.data() + token.size();
+        };
+        if (!parse(width, extent.width) || !parse(height, extent.height))
+            return false;
+
+        size_t pixelCount = static_cast<size_t>(extent.width) * extent.height;
+        if (pixelCount == 0 || file.size() - offset < pixelCount * 3)
+            return false;
+
+        // expand to rgba
+        pixels.resize(pixelCount * 4);
+        const auto* source = reinterpret_cast<const uint8_t*>(file.data() + offset);
+        for (size_t i = 0; i < pixelCount; ++i)
+        {
+            pixels[i * 4 + 0] = source[i * 3 + 0];
+            pixels[i * 4 + 1] = source[i * 3 + 1];
+            pixels[i * 4 + 2] = source[i * 3 + 2];
+            pixels[i * 4 + 3] = 255;
+        }
+        return true;
+    }
+
+    // decoded data kept by the cache
+    struct CachedShader : CachedAssetData
+    {
+        VkShaderStageFlagBits stage;
+        std::vector<char> code;
+        ShaderReflection reflection;
+    };
+
+    struct CachedTexture : CachedAssetData
+    {
+        VkExtent2D extent;
+        std::vector<uint8_t> pixels;
+    };
+
+    struct CachedMaterial : CachedAssetData
+    {
+        std::vector<std::pair<AssetType, std::string>> dependencies;
+    };
+
+    struct CachedMesh : CachedAssetData
+    {
+        MeshData data;
+    };
+}
+
+void AssetManager::Initialize(JobSystem& jobs)
+{
+    jobSystem = &jobs;
+}
+
+bool AssetManager::InitializeDevice(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        const VkAllocationCallbacks* allocator,
+        VkQueue uploadQueue,
+        uint32_t uploadQueueFamilyIndex,
+        DeletionQueue& deletions)
+{
+    vkPhysicalDevice = physicalDevice;
+    vkDevice = device;
+    vkAllocator = allocator;
+    vkUploadQueue = uploadQueue;
+    deletionQueue = &deletions;
+
+    // create upload command pool
+    //> only used from the main thread
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = uploadQueueFamilyIndex;
+
+    VkResult result = vkCreateCommandPool(vkDevice, &poolInfo, vkAllocator, &vkUploadCommandPool);
+    if (result != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Assets, "failed to create upload command pool!");
+        return false;
+    }
+
+    // create upload fence
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    result = vkCreateFence(vkDevice, &fenceInfo, vkAllocator, &vkUploadFence);
+    if (result != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Assets, "failed to create upload fence!");
+        return false;
+    }
+    return true;
+}
+
+void AssetManager::Cleanup()
+{
+    if (vkDevice == VK_NULL_HANDLE)
+        return;
+
+    // finish loads in flight
+    while (loadingCount.load(std::memory_order_acquire) > 0)
+    {
+        Update();
+        std::this_thread::yield();
+    }
+
+    // release everything
+    Update();
+    for (const auto& [path, asset] : assets)
+    {
+        if (asset->refCount.load() > 0)
+            ARCTIC_LOG_WARNING(Assets, "{} is still referenced at cleanup", path);
+    }
+    //> dependencies are dropped first, materials would release already destroyed assets otherwise
+    for (const auto& [path, asset] : assets)
+    {
+        if (asset->GetType() != AssetType::Material)
+            continue;
+        auto* material = static_cast<MaterialAsset*>(asset);
+        material->shaders.clear();
+        material->textures.clear();
+    }
+    for (const auto& [path, asset] : assets)
+        destroyAsset(asset);
+    assets.clear();
+    cache.Clear();
+
+    vkDestroyFence(vkDevice, vkUploadFence, vkAllocator);
+    vkDestroyCommandPool(vkDevice, vkUploadCommandPool, vkAllocator);
+}
+
+Asset* AssetManager::request(const std::string& path, AssetType type)
+{
+    ++requestCount;
+
+    Asset* asset = nullptr;
+    {
+        std::lock_guard lock(assetsMutex);
+
+        // deduplicate
+        auto it = assets.find(path);
+        if (it != assets.end())
+        {
+            ++deduplicatedCount;
+            if (it->second->GetType() != type)
+            {
+                ARCTIC_LOG_ERROR(Assets, "{} requested with a different type!", path);
+                return nullptr;
+            }
+            //> referenced under the lock, 'Update' could release it otherwise
+            it->second->refCount.fetch_add(1, std::memory_order_relaxed);
+            return it->second;
+        }
+
+        // create
+        switch (type)
+        {
+            case AssetType::Shader: asset = new ShaderAsset(path); break;
+            case AssetType::Texture: asset = new TextureAsset(path); break;
+            case AssetType::Material: asset = new MaterialAsset(path); break;
+            case AssetType::Mesh: asset = new MeshAsset(path); break;
+        }
+        asset->refCount = 1;
+        assets.emplace(path, asset);
+    }
+
+    // start loading
+    //> the coroutine runs until its first suspension (the switch to the io threads)
+    ++loadingCount;
+    loadAsset(asset);
+    return asset;
+}
+
+void AssetManager::Update()
+{
+    // run uploads
+    //> uploads can queue new uploads (e.g. a material finishing on the main thread), those run next update
+    std::vector<std::coroutine_handle<>> uploads;
+    {
+        std::lock_guard lock(uploadMutex);
+        uploads.swap(uploadQueue);
+    }
+    for (auto handle : uploads)
+        handle.resume();
+
+    // submit the copies they recorded
+    //> one submit & fence wait for all uploads of this update, the uploads finish afterwards
+    isUploadSubmitted = submitUploads();
+    std::vector<std::coroutine_handle<>> waiters;
+    waiters.swap(uploadWaiters);
+    for (auto handle : waiters)
+        handle.resume();
+
+    // release assets without handles
+    //> repeat while releasing frees dependencies
+    std::lock_guard lock(assetsMutex);
+    bool isReleased = true;
+    while (isReleased)
+    {
+        isReleased = false;
+        for (auto it = assets.begin(); it != assets.end();)
+        {
+            Asset* asset = it->second;
+            if (asset->refCount.load(std::memory_order_acquire) == 0 && !asset->isLoading.load(std::memory_order_acquire))
+            {
+                it = assets.erase(it);
+                destroyAsset(asset);
+                ++releasedCount;
+                isReleased = true;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
+
+bool AssetManager::Wait(const Asset& asset)
+{
+    while (asset.GetState() == AssetState::Loading)
+    {
+        Update();
+        std::this_thread::yield();
+    }
+    return asset.IsReady();
+}
+
+AssetManager::Stats AssetManager::GetStats() const
+{
+    Stats stats{};
+    stats.requestCount = requestCount;
+    stats.deduplicatedCount = deduplicatedCount;
+    stats.readyCount = readyCount;
+    stats.failedCount = failedCount;
+    stats.releasedCount = releasedCount;
+    stats.bytesRead = bytesRead;
+    stats.cache = cache.GetStats();
+    {
+        std::lock_guard lock(assetsMutex);
+        stats.liveCount = static_cast<uint32_t>(assets.size());
+    }
+    return stats;
+}
+
+void AssetManager::PrintStats() const
+{
+    Stats stats = GetStats();
+    std::cout << "info: assets:" << std::endl;
+    std::cout << std::format("\trequests {} (deduplicated {}), ready {}, failed {}, released {}, live {}, read {} KB",
+                             stats.requestCount,
+                             stats.deduplicatedCount,
+                             stats.readyCount,
+                             stats.failedCount,
+                             stats.releasedCount,
+                             stats.liveCount,
+                             stats.bytesRead / 1024) << std::endl;
+    std::cout << std::format("\tcache: hits {}, misses {}, inserts {}, evictions {}, rejected {}, entries {}, {} / {} KB ({} KB pinned)",
+                             stats.cache.hitCount,
+                             stats.cache.missCount,
+                             stats.cache.insertCount,
+                             stats.cache.evictionCount,
+                             stats.cache.rejectedCount,
+                             stats.cache.entryCount,
+                             stats.cache.usedBytes / 1024,
+                             stats.cache.budgetBytes / 1024,
+                             stats.cache.pinnedBytes / 1024) << std::endl;
+}
+
+#pragma region asset_loading
+
+DetachedTask AssetManager::loadAsset(Asset* asset)
+{
+    bool isReady = false;
+    switch (asset->GetType())
+    {
+        case AssetType::Shader: isReady = co_await loadShader(static_cast<ShaderAsset&>(*asset)); break;
+        case AssetType::Texture: isReady = co_await loadTexture(static_cast<TextureAsset&>(*asset)); break;
+        case AssetType::Material: isReady = co_await loadMaterial(static_cast<MaterialAsset&>(*asset)); break;
+        case AssetType::Mesh: isReady = co_await loadMesh(static_cast<MeshAsset&>(*asset)); break;
+    }
+
+    if (!isReady)
+        ARCTIC_LOG_ERROR(Assets, "failed to load {}!", asset->GetPath());
+
+    complete(*asset, isReady);
+}
+
+Task<bool> AssetManager::readFile(const std::string& path, std::vector<char>& buffer)
+{
+    co_await jobSystem->SwitchTo(JobQueue::IO);
+
+    if (!FileUtility::ReadBinaryFile(std::format("{}/{}", Application::AssetsPath, path), buffer))
+        co_return false;
+
+    bytesRead += buffer.size();
+    co_return true;
+}
+
+Task<bool> AssetManager::loadShader(ShaderAsset& shader)
+{
+    // cached: copy decoded
+    //> pinned only while copying, the asset owns its copy
+    if (auto pin = cache.Find(shader.GetPath(), ShaderAsset::TYPE); const auto* cached = pin.Get<CachedShader>())
+    {
+        co_await jobSystem->SwitchTo(JobQueue::Worker);
+        shader.stage = cached->stage;
+        shader.code = cached->code;
+        shader.reflection = cached->reflection;
+    }
+    else
+    {
+        // read
+        if (!co_await readFile(shader.GetPath(), shader.code))
+            co_return false;
+
+        // decode: validate & reflect spir-v
+        //> the entry point has to match the stage of the file name
+        co_await jobSystem->SwitchTo(JobQueue::Worker);
+
+        uint32_t magic = 0;
+        if (shader.code.size() < sizeof(uint32_t) || shader.code.size() % sizeof(uint32_t) != 0)
+            co_return false;
+        std::memcpy(&magic, shader.code.data(), sizeof(uint32_t));
+        if (magic != SPIRV_MAGIC || !findShaderStage(shader.GetPath(), shader.stage))
+            co_return false;
+        if (!shader.reflection.Parse(shader.code) || shader.reflection.stages != static_cast<VkShaderStageFlags>(shader.stage))
+            co_return false;
+
+        auto decoded = std::make_unique<CachedShader>();
+        decoded->stage = shader.stage;
+        decoded->code = shader.code;
+        decoded->reflection = shader.reflection;
+        cache.Insert(shader.GetPath(), ShaderAsset::TYPE, std::move(decoded), shader.code.size() + sizeof(CachedShader));
+    }
+
+    // upload: create module
+    co_await switchToUpload();
+
+    VkShaderModuleCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    createInfo.codeSize = shader.code.size();
+    createInfo.pCode = reinterpret_cast<const uint32_t*>(shader.code.data());
+
+    co_return vkCreateShaderModule(vkDevice, &createInfo, vkAllocator, &shader.module) == VK_SUCCESS;
+}
+
+Task<bool> AssetManager::loadTexture(TextureAsset& texture)
+{
+    // cached: copy decoded
+    //> pinned only while copying, the asset owns its copy
+    if (auto pin = cache.Find(texture.GetPath(), TextureAsset::TYPE); const auto* cached = pin.Get<CachedTexture>())
+    {
+        co_await jobSystem->SwitchTo(JobQueue::Worker);
+        texture.extent = cached->extent;
+        texture.pixels = cached->pixels;
+    }
+    else
+    {
+        // read
+        std::vector<char> file;
+        if (!co_await readFile(texture.GetPath(), file))
+            co_return false;
+
+        // decode
+        co_await jobSystem->SwitchTo(JobQueue::Worker);
+        if (!decodePpm(file, texture.extent, texture.pixels))
+            co_return false;
+
+        auto decoded = std::make_unique<CachedTexture>();
+        decoded->extent = texture.extent;
+        decoded->pixels = texture.pixels;
+        cache.Insert(texture.GetPath(), TextureAsset::TYPE, std::move(decoded), texture.pixels.size() + sizeof(CachedTexture));
+    }
+
+    // upload
+    co_await switchToUpload();
+    bool isUploaded = uploadTexture(texture);
+    texture.pixels = {};
+    co_return co_await waitForUploads() && isUploaded;
+}
+
+Task<bool> AssetManager::loadMaterial(MaterialAsset& material)
+{
+    // cached: copy parsed dependencies
+    //> pinned only while copying
+    std::vector<std::pair<AssetType, std::string>> dependencies;
+    if (auto pin = cache.Find(material.GetPath(), MaterialAsset::TYPE); const auto* cached = pin.Get<CachedMaterial>())
+    {
+        co_await jobSystem->SwitchTo(JobQueue::Worker);
+        dependencies = cached->dependencies;
+    }
+    else
+    {
+        // read
+        std::vector<char> file;
+        if (!co_await readFile(material.GetPath(), file))
+            co_return false;
+
+        // parse
+        co_await jobSystem->SwitchTo(JobQueue::Worker);
+
+        std::istringstream stream(std::string(file.begin(), file.end()));
+        std::string line;
+        while (std::getline(stream, line))
+        {
+            std::istringstream lineStream(line);
+            std::string kind, path;
+            if (!(lineStream >> kind) || kind.starts_with('#'))
+                continue;
+            if (!(lineStream >> path))
+                co_return false;
+
+            if (kind == "shader")
+                dependencies.emplace_back(AssetType::Shader, path);
+            else if (kind == "texture")
+                dependencies.emplace_back(AssetType::Texture, path);
+            else
+                co_return false;
+        }
+
+        auto decoded = std::make_unique<CachedMaterial>();
+        decoded->dependencies = dependencies;
+        cache.Insert(material.GetPath(), MaterialAsset::TYPE, std::move(decoded), file.size() + sizeof(CachedMaterial));
+    }
+
+    // request dependencies
+    //> all dependencies are requested before waiting on any of them, so they load in parallel
+    for (const auto& [type, path] : dependencies)
+    {
+        if (type == AssetType::Shader)
+            material.shaders.push_back(Load<ShaderAsset>(path));
+        else
+            material.textures.push_back(Load<TextureAsset>(path));
+    }
+
+    // wait for dependencies
+    bool isReady = true;
+    for (const auto& shader : material.shaders)
+        isReady &= shader && co_await waitFor(*shader.Get());
+    for (const auto& texture : material.textures)
+        isReady &= texture && co_await waitFor(*texture.Get());
+    co_return isReady;
+}
+
+Task<bool> AssetManager::loadMesh(MeshAsset& mesh)
+{
+    // cached: copy decoded
+    //> pinned only while copying, the asset owns its copy
+    if (auto pin = cache.Find(mesh.GetPath(), MeshAsset::TYPE); const auto* cached = pin.Get<CachedMesh>())
+    {
+        co_await jobSystem->SwitchTo(JobQueue::Worker);
+        mesh.data = cached->data;
+    }
+    else
+    {
+        // read
+        std::vector<char> file;
+        if (!co_await readFile(mesh.GetPath(), file))
+            co_return false;
+
+        // decode: validate
+        co_await jobSystem->SwitchTo(JobQueue::Worker);
+        if (!mesh.data.Load(file))
+            co_return false;
+
+        auto decoded = std::make_unique<CachedMesh>();
+        decoded->data = mesh.data;
+        cache.Insert(mesh.GetPath(), MeshAsset::TYPE, std::move(decoded), file.size() + sizeof(CachedMesh));
+    }
+    co_return true;
+}
+
+void AssetManager::complete(Asset& asset, bool isReady)
+{
+    // publish state & take waiters
+    std::vector<std::coroutine_handle<>> waiters;
+    {
+        std::lock_guard lock(asset.waitersMutex);
+        asset.state.store(isReady ? AssetState::Ready : AssetState::Failed, std::memory_order_release);
+        waiters.swap(asset.waiters);
+    }
+    if (isReady)
+        ++readyCount;
+    else
+        ++failedCount;
+
+    // resume waiters
+    for (auto handle : waiters)
+        jobSystem->Schedule([handle]() { handle.resume(); });
+
+    asset.isLoading.store(false, std::memory_order_release);
+    --loadingCount;
+}
+
+#pragma endregion asset_loading
+
+#pragma region asset_upload
+
+bool AssetManager::uploadTexture(TextureAsset& texture)
+{
+    const VkDeviceSize size = texture.pixels.size();
+    const VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+
+    // create image
+    if (!VulkanUtility::CreateImage(vkPhysicalDevice, vkDevice, vkAllocator, texture.extent, 1, format,
+                                    VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                                    texture.image, texture.memory) ||
+        !VulkanUtility::CreateImageView(vkDevice, vkAllocator, texture.image, format,
+                                        VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, texture.view))
+        return false;
+
+    // create staging buffer
+    //> the image is destroyed right away on failure, no copy references it yet
+    VkBuffer stagingBuffer;
+    VkDeviceMemory stagingMemory;
+    VkCommandBuffer commandBuffer = recordUploadCommands();
+    if (commandBuffer == VK_NULL_HANDLE || !createStagingBuffer(texture.pixels.data(), size, stagingBuffer, stagingMemory))
+    {
+        vkDestroyImageView(vkDevice, texture.view, vkAllocator);
+        vkDestroyImage(vkDevice, texture.image, vkAllocator);
+        vkFreeMemory(vkDevice, texture.memory, vkAllocator);
+        texture.view = VK_NULL_HANDLE;
+        texture.image = VK_NULL_HANDLE;
+        texture.memory = VK_NULL_HANDLE;
+        return false;
+    }
+
+    // record copy
+
+    //> undefined -> transfer destination
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = texture.image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    VkBufferImageCopy region{};
+    region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.imageExtent = {texture.extent.width, texture.extent.height, 1};
+    vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, texture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+    //> transfer destination -> shader read
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+    return true;
+}
+
+bool AssetManager::createStagingBuffer(const void* data, VkDeviceSize size, VkBuffer& buffer, VkDeviceMemory& memory)
+{
+    if (!VulkanUtility::CreateBuffer(vkPhysicalDevice, vkDevice, vkAllocator, size,
+                                     VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                     buffer, memory))
+        return false;
+
+    void* mapped;
+    if (vkMapMemory(vkDevice, memory, 0, size, 0, &mapped) != VK_SUCCESS)
+    {
+        vkDestroyBuffer(vkDevice, buffer, vkAllocator);
+        vkFreeMemory(vkDevice, memory, vkAllocator);
+        return false;
+    }
+    std::memcpy(mapped, data, size);
+    vkUnmapMemory(vkDevice, memory);
+
+    //> kept until the batch completed
+    uploadStagingBuffers.emplace_back(buffer, memory);
+    return true;
+}
+
+VkCommandBuffer AssetManager::recordUploadCommands()
+{
+    if (vkUploadCommandBuffer != VK_NULL_HANDLE)
+        return vkUploadCommandBuffer;
+
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = vkUploadCommandPool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = 1;
+
+    VkCommandBuffer commandBuffer;
+    if (vkAllocateCommandBuffers(vkDevice, &allocInfo, &commandBuffer) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Assets, "failed to allocate upload command buffer!");
+        return VK_NULL_HANDLE;
+    }
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+    vkUploadCommandBuffer = commandBuffer;
+    return vkUploadCommandBuffer;
+}
+
+bool AssetManager::submitUploads()
+{
+    if (vkUploadCommandBuffer == VK_NULL_HANDLE)
+        return true;
+
+    vkEndCommandBuffer(vkUploadCommandBuffer);
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &vkUploadCommandBuffer;
+
+    VkResult result = vkQueueSubmit(vkUploadQueue, 1, &submitInfo, vkUploadFence);
+    if (result == VK_SUCCESS)
+    {
+        vkWaitForFences(vkDevice, 1, &vkUploadFence, VK_TRUE, UINT64_MAX);
+        vkResetFences(vkDevice, 1, &vkUploadFence);
+    }
+    else
+    {
+        ARCTIC_LOG_ERROR(Assets, "failed to submit uploads!");
+    }
+
+    // cleanup batch
+    vkFreeCommandBuffers(vkDevice, vkUploadCommandPool, 1, &vkUploadCommandBuffer);
+    vkUploadCommandBuffer = VK_NULL_HANDLE;
+    for (auto [buffer, memory] : uploadStagingBuffers)
+    {
+        vkDestroyBuffer(vkDevice, buffer, vkAllocator);
+        vkFreeMemory(vkDevice, memory, vkAllocator);
+    }
+    uploadStagingBuffers.clear();
+
+    return result == VK_SUCCESS;
+}
+
+void AssetManager::destroyAsset(Asset* asset)
+{
+    // gpu objects are deferred until the frames that could use them completed
+    switch (asset->GetType())
+    {
+        case AssetType::Shader:
+        {
+            auto* shader = static_cast<ShaderAsset*>(asset);
+            deletionQueue->Push(shader->module);
+            break;
+        }
+        case AssetType::Texture:
+        {
+            auto* texture = static_cast<TextureAsset*>(asset);
+            deletionQueue->Push(texture->view);
+            deletionQueue->Push(texture->image);
+            deletionQueue->Push(texture->memory);
+            break;
+        }
+        case AssetType::Material:
+        case AssetType::Mesh:
+            break;
+    }
+    delete asset;
+}
+
+#pragma endregion asset_upload
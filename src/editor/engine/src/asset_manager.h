@@ -0,0 +1,350 @@
+#ifndef ARCTIC_ASSET_MANAGER_H
+#define ARCTIC_ASSET_MANAGER_H
+
+#include <atomic>
+#include <coroutine>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "utilities/job_system.h"
+#include "utilities/task.h"
+#include "asset_cache.h"
+#include "mesh.h"
+#include "shader_reflection.h"
+#include "deletion_queue.h"
+
+enum class AssetType : uint8_t
+{
+    Shader,
+    Texture,
+    Material,
+    Mesh
+};
+
+enum class AssetState : uint8_t
+{
+    Loading,
+    Ready,
+    Failed
+};
+
+// base of all assets, shared by every handle to the same path
+class Asset
+{
+public:
+    virtual ~Asset() = default;
+
+    AssetType GetType() const {
+        return type;
+    }
+    const std::string& GetPath() const {
+        return path;
+    }
+    AssetState GetState() const {
+        return state.load(std::memory_order_acquire);
+    }
+    bool IsReady() const {
+        return GetState() == AssetState::Ready;
+    }
+
+protected:
+    Asset(AssetType type, std::string path) : type(type), path(std::move(path)) {}
+
+private:
+    friend class AssetManager;
+    template<typename T> friend class AssetHandle;
+
+    AssetType type;
+    std::string path;
+    std::atomic<AssetState> state = AssetState::Loading;
+    std::atomic<uint32_t> refCount = 0;
+    std::atomic<bool> isLoading = true; // cleared after the loader stopped touching the asset, state is published earlier
+
+    // coroutines waiting for this asset to finish loading
+    std::mutex waitersMutex;
+    std::vector<std::coroutine_handle<>> waiters;
+};
+
+// reference counted handle
+//> assets without handles are released by 'AssetManager::Update'
+template<typename T>
+class AssetHandle
+{
+public:
+    AssetHandle() = default;
+    explicit AssetHandle(T* asset) : asset(asset) {
+        acquire();
+    }
+    AssetHandle(const AssetHandle& other) : asset(other.asset) {
+        acquire();
+    }
+    AssetHandle(AssetHandle&& other) noexcept : asset(std::exchange(other.asset, nullptr)) {}
+    AssetHandle& operator=(AssetHandle other) noexcept
+    {
+        std::swap(asset, other.asset);
+        return *this;
+    }
+    ~AssetHandle() {
+        release();
+    }
+
+    T* Get() const {
+        return asset;
+    }
+    T* operator->() const {
+        return asset;
+    }
+    explicit operator bool() const {
+        return asset != nullptr;
+    }
+
+private:
+    friend class AssetManager;
+
+    T* asset = nullptr;
+
+    // takes over a reference acquired by the manager
+    struct AdoptReference {};
+    AssetHandle(T* asset, AdoptReference) : asset(asset) {}
+
+    void acquire()
+    {
+        if (asset)
+            asset->refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    void release()
+    {
+        if (asset)
+            asset->refCount.fetch_sub(1, std::memory_order_acq_rel);
+    }
+};
+
+// spir-v binary, the stage is taken from the file name ('<name>.<stage>.spv')
+//> the interface is reflected on load, pipelines derive their layouts & vertex input from it
+class ShaderAsset : public Asset
+{
+public:
+    static constexpr AssetType TYPE = AssetType::Shader;
+    explicit ShaderAsset(std::string path) : Asset(TYPE, std::move(path)) {}
+
+    VkShaderStageFlagBits stage = VK_SHADER_STAGE_VERTEX_BIT;
+    std::vector<char> code;
+    ShaderReflection reflection;
+    VkShaderModule module = VK_NULL_HANDLE;
+};
+
+// binary ppm (p6) image, uploaded as 'VK_FORMAT_R8G8B8A8_UNORM'
+class TextureAsset : public Asset
+{
+public:
+    static constexpr AssetType TYPE = AssetType::Texture;
+    explicit TextureAsset(std::string path) : Asset(TYPE, std::move(path)) {}
+
+    VkExtent2D extent{};
+    std::vector<uint8_t> pixels; // released after upload
+    VkImage image = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkImageView view = VK_NULL_HANDLE;
+};
+
+// text file listing the assets a material depends on, one per line:
+//> "shader shaders/first_shader.vert.spv"
+//> "texture textures/albedo.ppm"
+//> ready when all dependencies are ready
+class MaterialAsset : public Asset
+{
+public:
+    static constexpr AssetType TYPE = AssetType::Material;
+    explicit MaterialAsset(std::string path) : Asset(TYPE, std::move(path)) {}
+
+    std::vector<AssetHandle<ShaderAsset>> shaders;
+    std::vector<AssetHandle<TextureAsset>> textures;
+};
+
+// cooked mesh ('.mesh'), decoded & validated on the cpu
+//> the lod table & bounding sphere feed lod selection, nothing is uploaded to the gpu
+class MeshAsset : public Asset
+{
+public:
+    static constexpr AssetType TYPE = AssetType::Mesh;
+    explicit MeshAsset(std::string path) : Asset(TYPE, std::move(path)) {}
+
+    MeshData data;
+};
+
+// asynchronous asset loading
+//> every asset is a coroutine: read on the io threads, decode on the workers, upload on the main thread ('Update')
+//> requests for a path that is already loaded or loading return the same asset,
+//> so issuing all requests of a level upfront keeps disk and cores busy
+//> decoded data is kept in a cache after the asset is released, loading it again skips the read & decode
+class AssetManager
+{
+public:
+    struct Stats
+    {
+        uint64_t requestCount;
+        uint64_t deduplicatedCount; // requests served by an existing asset
+        uint64_t readyCount;
+        uint64_t failedCount;
+        uint64_t releasedCount;
+        uint64_t bytesRead;
+        uint32_t liveCount;
+        AssetCache::Stats cache;
+    };
+
+    // loads can be requested right after 'Initialize': they read & decode on the job threads
+    //> and park before their upload until the device is set, so file i/o overlaps device creation
+    void Initialize(JobSystem& jobSystem);
+    bool InitializeDevice(VkPhysicalDevice physicalDevice,
+                          VkDevice device,
+                          const VkAllocationCallbacks* allocator,
+                          VkQueue uploadQueue,
+                          uint32_t uploadQueueFamilyIndex,
+                          DeletionQueue& deletionQueue);
+    void Cleanup();
+
+    // byte budget of the decoded data cache, unused entries are evicted to fit
+    void SetCacheBudget(uint64_t bytes) {
+        cache.SetBudget(bytes);
+    }
+
+    // path is relative to the assets directory
+    template<typename T>
+    AssetHandle<T> Load(const std::string& path) {
+        return AssetHandle<T>(static_cast<T*>(request(path, T::TYPE)), typename AssetHandle<T>::AdoptReference{});
+    }
+
+    // main thread, after 'InitializeDevice': runs pending uploads & releases assets without handles
+    //> gpu objects of released assets go through the deletion queue, destroyed once the current frame completed
+    void Update();
+
+    // main thread, after 'InitializeDevice': blocks until the asset is loaded, returns false if it failed
+    bool Wait(const Asset& asset);
+
+    Stats GetStats() const;
+    void PrintStats() const;
+
+private:
+    JobSystem* jobSystem = nullptr;
+    VkPhysicalDevice vkPhysicalDevice = VK_NULL_HANDLE;
+    VkDevice vkDevice = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* vkAllocator = nullptr;
+    VkQueue vkUploadQueue = VK_NULL_HANDLE;
+    VkCommandPool vkUploadCommandPool = VK_NULL_HANDLE;
+    VkFence vkUploadFence = VK_NULL_HANDLE;
+    DeletionQueue* deletionQueue = nullptr; // released assets can still be used by frames in flight
+
+    // assets by path
+    mutable std::mutex assetsMutex;
+    std::unordered_map<std::string, Asset*> assets;
+    std::atomic<uint32_t> loadingCount = 0;
+
+    // decoded data by path
+    AssetCache cache;
+
+    // coroutines waiting to upload on the main thread
+    std::mutex uploadMutex;
+    std::vector<std::coroutine_handle<>> uploadQueue;
+
+    // copies recorded by the uploads of one 'Update', submitted together & waited on with one fence
+    //> main thread only
+    VkCommandBuffer vkUploadCommandBuffer = VK_NULL_HANDLE; // null until the first copy is recorded
+    std::vector<std::pair<VkBuffer, VkDeviceMemory>> uploadStagingBuffers;
+    std::vector<std::coroutine_handle<>> uploadWaiters;
+    bool isUploadSubmitted = false;
+
+    // stats
+    std::atomic<uint64_t> requestCount = 0;
+    std::atomic<uint64_t> deduplicatedCount = 0;
+    std::atomic<uint64_t> readyCount = 0;
+    std::atomic<uint64_t> failedCount = 0;
+    std::atomic<uint64_t> releasedCount = 0;
+    std::atomic<uint64_t> bytesRead = 0;
+
+    // returns the asset with one reference acquired for the caller
+    Asset* request(const std::string& path, AssetType type);
+
+    // resumes the awaiting coroutine in 'Update'
+    auto switchToUpload()
+    {
+        struct Awaiter
+        {
+            AssetManager* manager;
+
+            bool await_ready() const noexcept {
+                return false;
+            }
+            void await_suspend(std::coroutine_handle<> handle) const
+            {
+                std::lock_guard lock(manager->uploadMutex);
+                manager->uploadQueue.push_back(handle);
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this};
+    }
+
+    // resumes the awaiting coroutine in 'Update' after the copies recorded so far completed, false if their submit failed
+    auto waitForUploads()
+    {
+        struct Awaiter
+        {
+            AssetManager* manager;
+
+            bool await_ready() const noexcept {
+                return false;
+            }
+            void await_suspend(std::coroutine_handle<> handle) const {
+                manager->uploadWaiters.push_back(handle);
+            }
+            bool await_resume() const noexcept {
+                return manager->isUploadSubmitted;
+            }
+        };
+        return Awaiter{this};
+    }
+
+    // resumes the awaiting coroutine on a worker when the asset finished loading
+    auto waitFor(Asset& asset)
+    {
+        struct Awaiter
+        {
+            Asset& asset;
+
+            bool await_ready() const noexcept {
+                return asset.GetState() != AssetState::Loading;
+            }
+            bool await_suspend(std::coroutine_handle<> handle) const
+            {
+                std::lock_guard lock(asset.waitersMutex);
+                if (asset.GetState() != AssetState::Loading)
+                    return false;
+                asset.waiters.push_back(handle);
+                return true;
+            }
+            bool await_resume() const noexcept {
+                return asset.IsReady();
+            }
+        };
+        return Awaiter{asset};
+    }
+
+    DetachedTask loadAsset(Asset* asset);
+    Task<bool> loadShader(ShaderAsset& shader);
+    Task<bool> loadTexture(TextureAsset& texture);
+    Task<bool> loadMaterial(MaterialAsset& material);
+    Task<bool> loadMesh(MeshAsset& mesh);
+    Task<bool> readFile(const std::string& path, std::vector<char>& buffer);
+    void complete(Asset& asset, bool isReady);
+
+    bool uploadTexture(TextureAsset& texture);
+    bool createStagingBuffer(const void* data, VkDeviceSize size, VkBuffer& buffer, VkDeviceMemory& memory);
+    VkCommandBuffer recordUploadCommands(); // command buffer of the current batch, begun on first use
+    bool submitUploads(); // waits for completion, frees the command buffer & staging buffers
+    void destroyAsset(Asset* asset);
+};
+
+#endif //ARCTIC_ASSET_MANAGER_H
@@ -0,0 +1,95 @@
+#ifndef ARCTIC_BOUNDS_H
+#define ARCTIC_BOUNDS_H
+
+#include <algorithm>
+#include <limits>
+#include <glm/glm.hpp>
+
+// axis aligned bounding box
+//> default constructed boxes are empty (inverted), extending them with anything gives that thing
+struct Aabb
+{
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 max = glm::vec3(-std::numeric_limits<float>::max());
+
+    bool IsEmpty() const {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+    glm::vec3 GetCenter() const {
+        return (min + max) * 0.5f;
+    }
+    float GetSurfaceArea() const
+    {
+        if (IsEmpty())
+            return 0.0f;
+        glm::vec3 size = max - min;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    void Extend(const glm::vec3& point)
+    {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+    void Extend(const Aabb& other)
+    {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+
+    bool Overlaps(const Aabb& other) const
+    {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+};
+
+// six planes facing inwards (xyz: normal, w: distance)
+struct Frustum
+{
+    glm::vec4 planes[6];
+
+    // extracts the planes of a vulkan projection (depth 0..1)
+    static Frustum FromViewProjection(const glm::mat4& viewProjection)
+    {
+        auto row = [&viewProjection](int index) {
+            return glm::vec4(viewProjection[0][index], viewProjection[1][index], viewProjection[2][index], viewProjection[3][index]);
+        };
+
+        Frustum frustum{};
+        frustum.planes[0] = row(3) + row(0); // left
+        frustum.planes[1] = row(3) - row(0); // right
+        frustum.planes[2] = row(3) + row(1); // bottom
+        frustum.planes[3] = row(3) - row(1); // top
+        frustum.planes[4] = row(2); // near
+        frustum.planes[5] = row(3) - row(2); // far
+        for (auto& plane : frustum.planes)
+            plane /= glm::length(glm::vec3(plane));
+        return frustum;
+    }
+
+    // conservative: boxes crossing a corner outside of the frustum are kept
+    bool Intersects(const Aabb& bounds) const
+    {
+        for (const auto& plane : planes)
+        {
+            // test the corner furthest along the normal
+            glm::vec3 corner(plane.x > 0.0f ? bounds.max.x : bounds.min.x,
+                             plane.y > 0.0f ? bounds.max.y : bounds.min.y,
+                             plane.z > 0.0f ? bounds.max.z : bounds.min.z);
+            if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+                return false;
+        }
+        return true;
+    }
+};
+
+struct Ray
+{
+    glm::vec3 origin;
+    glm::vec3 direction;
+    float maxDistance = std::numeric_limits<float>::max();
+};
+
+#endif //ARCTIC_BOUNDS_H
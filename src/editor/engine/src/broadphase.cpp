@@ -0,0 +1,535 @@
+#include "broadphase.h"
+#include "utilities/job_system.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <xmmintrin.h>
+
+namespace
+{
+    const float INVERTED_MIN = std::numeric_limits<float>::max();
+    const float INVERTED_MAX = -std::numeric_limits<float>::max();
+
+    uint64_t makePairKey(uint32_t a, uint32_t b)
+    {
+        return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+    }
+
+    Broadphase::Pair toPair(uint64_t key)
+    {
+        return {static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key)};
+    }
+
+    const uint32_t CELL_PADDING = 4; // inverted entries after the proxies of a cell, the sse sweep reads past the end
+}
+
+void Broadphase::Initialize(float size)
+{
+    cellSize = size > 0.0f ? size : DEFAULT_CELL_SIZE;
+    inverseCellSize = 1.0f / cellSize;
+}
+
+#pragma region broadphase_proxies
+
+uint32_t Broadphase::Insert(const Aabb& bounds, uint32_t userData)
+{
+    uint32_t id;
+    if (!freeProxies.empty())
+    {
+        id = freeProxies.back();
+        freeProxies.pop_back();
+    }
+    else
+    {
+        id = static_cast<uint32_t>(proxies.size());
+        proxies.emplace_back();
+
+        // sweep arrays stay a multiple of four for the sse tests
+        //> padding has inverted bounds
+        size_t paddedSize = (proxies.size() + 3) & ~static_cast<size_t>(3);
+        for (auto* values : {&minX, &minY, &minZ})
+            values->resize(paddedSize, INVERTED_MIN);
+        for (auto* values : {&maxX, &maxY, &maxZ})
+            values->resize(paddedSize, INVERTED_MAX);
+    }
+
+    Proxy& proxy = proxies[id];
+    proxy.bounds = bounds;
+    proxy.userData = userData;
+    proxy.state = ProxyState::Active;
+    proxy.isDirty = true;
+    proxy.isLarge = false;
+    proxy.cellMinX = proxy.cellMinZ = 1;
+    proxy.cellMaxX = proxy.cellMaxZ = 0;
+    dirtyProxies.push_back(id);
+    return id;
+}
+
+void Broadphase::Remove(uint32_t proxy)
+{
+    if (proxy >= proxies.size() || proxies[proxy].state != ProxyState::Active)
+        return;
+
+    proxies[proxy].state = ProxyState::Removed;
+    removedProxies.push_back(proxy);
+    if (!proxies[proxy].isDirty)
+    {
+        proxies[proxy].isDirty = true;
+        dirtyProxies.push_back(proxy);
+    }
+}
+
+void Broadphase::Move(uint32_t proxy, const Aabb& bounds)
+{
+    if (proxy >= proxies.size() || proxies[proxy].state != ProxyState::Active)
+        return;
+
+    proxies[proxy].bounds = bounds;
+    if (!proxies[proxy].isDirty)
+    {
+        proxies[proxy].isDirty = true;
+        dirtyProxies.push_back(proxy);
+    }
+}
+
+#pragma endregion broadphase_proxies
+
+#pragma region broadphase_cells
+
+int32_t Broadphase::getCellCoordinate(float value) const
+{
+    float coordinate = std::floor(value * inverseCellSize);
+    return static_cast<int32_t>(std::clamp(coordinate, static_cast<float>(-MAX_CELL_COORDINATE), static_cast<float>(MAX_CELL_COORDINATE)));
+}
+
+uint32_t Broadphase::getCell(int32_t x, int32_t z)
+{
+    auto [it, isInserted] = cellIndices.try_emplace(packCell(x, z), static_cast<uint32_t>(cells.size()));
+    if (isInserted)
+    {
+        Cell cell{};
+        cell.x = x;
+        cell.z = z;
+        cells.push_back(std::move(cell));
+    }
+    return it->second;
+}
+
+const Broadphase::Cell* Broadphase::findCell(int32_t x, int32_t z) const
+{
+    auto it = cellIndices.find(packCell(x, z));
+    return it != cellIndices.end() ? &cells[it->second] : nullptr;
+}
+
+void Broadphase::applyChanges()
+{
+    // copy bounds & move proxies between cells
+    //> serial, only proxies crossing a cell border touch the cells here
+    for (uint32_t id : dirtyProxies)
+    {
+        Proxy& proxy = proxies[id];
+        proxy.isDirty = false;
+
+        bool isRemoved = proxy.state == ProxyState::Removed;
+        const Aabb& bounds = proxy.bounds;
+        minX[id] = isRemoved ? INVERTED_MIN : bounds.min.x;
+        minY[id] = isRemoved ? INVERTED_MIN : bounds.min.y;
+        minZ[id] = isRemoved ? INVERTED_MIN : bounds.min.z;
+        maxX[id] = isRemoved ? INVERTED_MAX : bounds.max.x;
+        maxY[id] = isRemoved ? INVERTED_MAX : bounds.max.y;
+        maxZ[id] = isRemoved ? INVERTED_MAX : bounds.max.z;
+
+        // covered cells, none when removed or large
+        int32_t newMinX = 1, newMinZ = 1, newMaxX = 0, newMaxZ = 0;
+        bool isLarge = false;
+        if (!isRemoved)
+        {
+            newMinX = getCellCoordinate(bounds.min.x);
+            newMinZ = getCellCoordinate(bounds.min.z);
+            newMaxX = getCellCoordinate(bounds.max.x);
+            newMaxZ = getCellCoordinate(bounds.max.z);
+            uint64_t cellCount = static_cast<uint64_t>(newMaxX - newMinX + 1) * static_cast<uint64_t>(newMaxZ - newMinZ + 1);
+            isLarge = cellCount > MAX_PROXY_CELL_COUNT;
+        }
+        if (isLarge)
+        {
+            newMinX = newMinZ = 1;
+            newMaxX = newMaxZ = 0;
+        }
+
+        if (isLarge != proxy.isLarge)
+        {
+            if (isLarge)
+                largeProxies.push_back(id);
+            else
+                largeProxies.erase(std::find(largeProxies.begin(), largeProxies.end(), id));
+            proxy.isLarge = isLarge;
+        }
+
+        updateCells(proxy, id, newMinX, newMinZ, newMaxX, newMaxZ);
+        proxy.cellMinX = newMinX;
+        proxy.cellMinZ = newMinZ;
+        proxy.cellMaxX = newMaxX;
+        proxy.cellMaxZ = newMaxZ;
+    }
+    dirtyProxies.clear();
+
+    // cells to sweep, in index order
+    activeCells.clear();
+    for (uint32_t index = 0; index < cells.size(); ++index)
+    {
+        if (!cells[index].proxies.empty())
+            activeCells.push_back(index);
+    }
+}
+
+void Broadphase::updateCells(const Proxy& proxy, uint32_t id, int32_t newMinX, int32_t newMinZ, int32_t newMaxX, int32_t newMaxZ)
+{
+    if (proxy.cellMinX == newMinX && proxy.cellMinZ == newMinZ && proxy.cellMaxX == newMaxX && proxy.cellMaxZ == newMaxZ)
+        return;
+
+    auto isInside = [](int32_t x, int32_t z, int32_t minCellX, int32_t minCellZ, int32_t maxCellX, int32_t maxCellZ) {
+        return x >= minCellX && x <= maxCellX && z >= minCellZ && z <= maxCellZ;
+    };
+
+    // left cells drop the proxy when they are swept next
+    for (int32_t z = proxy.cellMinZ; z <= proxy.cellMaxZ; ++z)
+    {
+        for (int32_t x = proxy.cellMinX; x <= proxy.cellMaxX; ++x)
+        {
+            if (!isInside(x, z, newMinX, newMinZ, newMaxX, newMaxZ))
+                cells[getCell(x, z)].isDirty = true;
+        }
+    }
+
+    // entered cells get the proxy appended, the sweep sorts it in
+    for (int32_t z = newMinZ; z <= newMaxZ; ++z)
+    {
+        for (int32_t x = newMinX; x <= newMaxX; ++x)
+        {
+            if (!isInside(x, z, proxy.cellMinX, proxy.cellMinZ, proxy.cellMaxX, proxy.cellMaxZ))
+                cells[getCell(x, z)].proxies.push_back(id);
+        }
+    }
+}
+
+#pragma endregion broadphase_cells
+
+#pragma region broadphase_update
+
+void Broadphase::Update(JobSystem* jobSystem)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    applyChanges();
+    collectPairs(jobSystem);
+
+    // removed proxies reported their pairs removed, the ids can be reused
+    for (uint32_t id : removedProxies)
+    {
+        proxies[id].state = ProxyState::Free;
+        freeProxies.push_back(id);
+    }
+    removedProxies.clear();
+
+    // stats
+    stats.proxyCount = static_cast<uint32_t>(proxies.size() - freeProxies.size());
+    stats.largeProxyCount = static_cast<uint32_t>(largeProxies.size());
+    stats.cellCount = static_cast<uint32_t>(activeCells.size());
+    stats.cellProxyCount = 0;
+    stats.maxCellProxyCount = 0;
+    stats.fullSortCount = 0;
+    for (uint32_t index : activeCells)
+    {
+        const Cell& cell = cells[index];
+        stats.cellProxyCount += static_cast<uint32_t>(cell.proxies.size());
+        stats.maxCellProxyCount = std::max(stats.maxCellProxyCount, static_cast<uint32_t>(cell.proxies.size()));
+        stats.fullSortCount += cell.isFullSorted ? 1 : 0;
+    }
+    stats.pairCount = static_cast<uint32_t>(pairs.size());
+    stats.addedCount = static_cast<uint32_t>(addedPairs.size());
+    stats.removedCount = static_cast<uint32_t>(removedPairs.size());
+    stats.updateTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void Broadphase::sweepCell(Cell& cell) const
+{
+    // drop proxies that left
+    if (cell.isDirty)
+    {
+        size_t count = 0;
+        for (uint32_t id : cell.proxies)
+        {
+            const Proxy& proxy = proxies[id];
+            if (cell.x >= proxy.cellMinX && cell.x <= proxy.cellMaxX && cell.z >= proxy.cellMinZ && cell.z <= proxy.cellMaxZ)
+                cell.proxies[count++] = id;
+        }
+        cell.proxies.resize(count);
+        cell.isDirty = false;
+    }
+
+    const auto count = static_cast<uint32_t>(cell.proxies.size());
+    for (auto* values : {&cell.minX, &cell.minY, &cell.minZ})
+        values->resize(count + CELL_PADDING);
+    for (auto* values : {&cell.maxX, &cell.maxY, &cell.maxZ})
+        values->resize(count + CELL_PADDING);
+
+    // refresh sort keys
+    //> the proxy bounds were applied by this update
+    uint32_t* ids = cell.proxies.data();
+    float* keys = cell.minX.data();
+    for (uint32_t i = 0; i < count; ++i)
+        keys[i] = proxies[ids[i]].bounds.min.x;
+
+    // insertion sort, close to linear while the order is coherent
+    //> teleports & new proxies can break that, past the budget the rest is sorted from scratch
+    uint64_t swapBudget = static_cast<uint64_t>(count) * SORT_SWAP_BUDGET;
+    uint64_t swapCount = 0;
+    cell.isFullSorted = false;
+    for (uint32_t i = 1; i < count && !cell.isFullSorted; ++i)
+    {
+        float key = keys[i];
+        uint32_t id = ids[i];
+        uint32_t j = i;
+        while (j > 0 && keys[j - 1] > key)
+        {
+            keys[j] = keys[j - 1];
+            ids[j] = ids[j - 1];
+            --j;
+        }
+        keys[j] = key;
+        ids[j] = id;
+
+        swapCount += i - j;
+        cell.isFullSorted = swapCount > swapBudget;
+    }
+    if (cell.isFullSorted)
+    {
+        std::vector<std::pair<float, uint32_t>> sorted(count);
+        for (uint32_t i = 0; i < count; ++i)
+            sorted[i] = {keys[i], ids[i]};
+        std::sort(sorted.begin(), sorted.end());
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            keys[i] = sorted[i].first;
+            ids[i] = sorted[i].second;
+        }
+    }
+
+    // gather the other bounds in sorted order
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const Aabb& bounds = proxies[ids[i]].bounds;
+        cell.maxX[i] = bounds.max.x;
+        cell.minY[i] = bounds.min.y;
+        cell.maxY[i] = bounds.max.y;
+        cell.minZ[i] = bounds.min.z;
+        cell.maxZ[i] = bounds.max.z;
+    }
+    for (uint32_t i = count; i < count + CELL_PADDING; ++i)
+    {
+        cell.minX[i] = cell.minY[i] = cell.minZ[i] = INVERTED_MIN;
+        cell.maxX[i] = cell.maxY[i] = cell.maxZ[i] = INVERTED_MAX;
+    }
+
+    // sweep
+    //> the candidates of a proxy are the following ones with a min x up to its max x, tested four at once
+    //> in range lanes are a prefix, the scan ends at the first group that is not fully in range
+    //> the pair belongs to the cell holding the min corner of the overlap
+    cell.pairs.clear();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const __m128 boundsMaxX = _mm_set1_ps(cell.maxX[i]);
+        const __m128 boundsMinY = _mm_set1_ps(cell.minY[i]), boundsMaxY = _mm_set1_ps(cell.maxY[i]);
+        const __m128 boundsMinZ = _mm_set1_ps(cell.minZ[i]), boundsMaxZ = _mm_set1_ps(cell.maxZ[i]);
+        for (uint32_t first = i + 1;; first += 4)
+        {
+            int rangeMask = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(&cell.minX[first]), boundsMaxX));
+            if (rangeMask == 0)
+                break;
+
+            __m128 overlapY = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&cell.minY[first]), boundsMaxY), _mm_cmpge_ps(_mm_loadu_ps(&cell.maxY[first]), boundsMinY));
+            __m128 overlapZ = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&cell.minZ[first]), boundsMaxZ), _mm_cmpge_ps(_mm_loadu_ps(&cell.maxZ[first]), boundsMinZ));
+            int mask = _mm_movemask_ps(_mm_and_ps(overlapY, overlapZ)) & rangeMask;
+            while (mask != 0)
+            {
+                uint32_t other = first + static_cast<uint32_t>(std::countr_zero(static_cast<uint32_t>(mask)));
+                mask &= mask - 1;
+                if (getCellCoordinate(keys[other]) == cell.x &&
+                    getCellCoordinate(std::max(cell.minZ[i], cell.minZ[other])) == cell.z)
+                    cell.pairs.push_back(makePairKey(ids[i], ids[other]));
+            }
+            if (rangeMask != 0xF)
+                break;
+        }
+    }
+}
+
+void Broadphase::testLargeProxy(uint32_t proxy, std::vector<uint64_t>& results) const
+{
+    // test against all proxies, four at once
+    //> pairs of two large proxies are found by the lower one
+    results.clear();
+    const __m128 boundsMinX = _mm_set1_ps(minX[proxy]), boundsMaxX = _mm_set1_ps(maxX[proxy]);
+    const __m128 boundsMinY = _mm_set1_ps(minY[proxy]), boundsMaxY = _mm_set1_ps(maxY[proxy]);
+    const __m128 boundsMinZ = _mm_set1_ps(minZ[proxy]), boundsMaxZ = _mm_set1_ps(maxZ[proxy]);
+    for (uint32_t first = 0; first < minX.size(); first += 4)
+    {
+        __m128 overlapX = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&minX[first]), boundsMaxX), _mm_cmpge_ps(_mm_loadu_ps(&maxX[first]), boundsMinX));
+        __m128 overlapY = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&minY[first]), boundsMaxY), _mm_cmpge_ps(_mm_loadu_ps(&maxY[first]), boundsMinY));
+        __m128 overlapZ = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&minZ[first]), boundsMaxZ), _mm_cmpge_ps(_mm_loadu_ps(&maxZ[first]), boundsMinZ));
+        int mask = _mm_movemask_ps(_mm_and_ps(overlapX, _mm_and_ps(overlapY, overlapZ)));
+        while (mask != 0)
+        {
+            uint32_t other = first + static_cast<uint32_t>(std::countr_zero(static_cast<uint32_t>(mask)));
+            mask &= mask - 1;
+            if (other == proxy || (proxies[other].isLarge && other < proxy))
+                continue;
+            results.push_back(makePairKey(proxy, other));
+        }
+    }
+}
+
+void Broadphase::collectPairs(JobSystem* jobSystem)
+{
+    // sweep cells & test large proxies
+    //> independent of each other, each job writes its own pair list
+    auto sweepRange = [this](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i)
+            sweepCell(cells[activeCells[i]]);
+    };
+    auto testRange = [this](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i)
+            testLargeProxy(largeProxies[i], largePairs[i]);
+    };
+
+    const auto cellCount = static_cast<uint32_t>(activeCells.size());
+    const auto largeCount = static_cast<uint32_t>(largeProxies.size());
+    largePairs.resize(largeCount);
+    if (jobSystem != nullptr && cellCount > CELL_BATCH_SIZE)
+        jobSystem->ParallelFor(cellCount, CELL_BATCH_SIZE, sweepRange);
+    else
+        sweepRange(0, cellCount);
+    if (jobSystem != nullptr && largeCount > 1)
+        jobSystem->ParallelFor(largeCount, 1, testRange);
+    else
+        testRange(0, largeCount);
+
+    // gather & sort
+    //> the order is fixed by the keys, not by which thread found a pair
+    pairKeys.clear();
+    for (uint32_t index : activeCells)
+        pairKeys.insert(pairKeys.end(), cells[index].pairs.begin(), cells[index].pairs.end());
+    for (const auto& results : largePairs)
+        pairKeys.insert(pairKeys.end(), results.begin(), results.end());
+    sortPayload.resize(pairKeys.size());
+    sorter.Sort(pairKeys.data(), sortPayload.data(), static_cast<uint32_t>(pairKeys.size()), jobSystem);
+
+    // difference to the previous update
+    addedPairs.clear();
+    removedPairs.clear();
+    size_t current = 0, previous = 0;
+    while (current < pairKeys.size() || previous < previousPairKeys.size())
+    {
+        if (previous == previousPairKeys.size() || (current < pairKeys.size() && pairKeys[current] < previousPairKeys[previous]))
+        {
+            addedPairs.push_back(toPair(pairKeys[current++]));
+        }
+        else if (current == pairKeys.size() || previousPairKeys[previous] < pairKeys[current])
+        {
+            removedPairs.push_back(toPair(previousPairKeys[previous++]));
+        }
+        else
+        {
+            ++current;
+            ++previous;
+        }
+    }
+
+    pairs.resize(pairKeys.size());
+    for (size_t i = 0; i < pairKeys.size(); ++i)
+        pairs[i] = toPair(pairKeys[i]);
+    std::swap(pairKeys, previousPairKeys);
+}
+
+#pragma endregion broadphase_update
+
+void Broadphase::QueryAabb(const Aabb& bounds, std::vector<uint32_t>& results) const
+{
+    auto isOverlapping = [this, &bounds](uint32_t proxy) {
+        return minX[proxy] <= bounds.max.x && maxX[proxy] >= bounds.min.x &&
+               minY[proxy] <= bounds.max.y && maxY[proxy] >= bounds.min.y &&
+               minZ[proxy] <= bounds.max.z && maxZ[proxy] >= bounds.min.z;
+    };
+
+    int32_t cellMinX = getCellCoordinate(bounds.min.x);
+    int32_t cellMinZ = getCellCoordinate(bounds.min.z);
+    int32_t cellMaxX = getCellCoordinate(bounds.max.x);
+    int32_t cellMaxZ = getCellCoordinate(bounds.max.z);
+    uint64_t cellCount = static_cast<uint64_t>(cellMaxX - cellMinX + 1) * static_cast<uint64_t>(cellMaxZ - cellMinZ + 1);
+
+    // large queries test every proxy
+    if (cellCount > MAX_PROXY_CELL_COUNT)
+    {
+        for (uint32_t proxy = 0; proxy < proxies.size(); ++proxy)
+        {
+            if (isOverlapping(proxy))
+                results.push_back(proxies[proxy].userData);
+        }
+        return;
+    }
+
+    // cells: proxies with a min x up to the query's max, reported by the cell holding the min corner of the overlap
+    for (int32_t z = cellMinZ; z <= cellMaxZ; ++z)
+    {
+        for (int32_t x = cellMinX; x <= cellMaxX; ++x)
+        {
+            const Cell* cell = findCell(x, z);
+            if (cell == nullptr)
+                continue;
+
+            auto count = static_cast<uint32_t>(cell->proxies.size());
+            auto end = static_cast<uint32_t>(std::upper_bound(cell->minX.begin(), cell->minX.begin() + count, bounds.max.x) - cell->minX.begin());
+            for (uint32_t i = 0; i < end; ++i)
+            {
+                if (cell->maxX[i] < bounds.min.x ||
+                    cell->minY[i] > bounds.max.y || cell->maxY[i] < bounds.min.y ||
+                    cell->minZ[i] > bounds.max.z || cell->maxZ[i] < bounds.min.z)
+                    continue;
+
+                if (getCellCoordinate(std::max(bounds.min.x, cell->minX[i])) == x &&
+                    getCellCoordinate(std::max(bounds.min.z, cell->minZ[i])) == z)
+                    results.push_back(proxies[cell->proxies[i]].userData);
+            }
+        }
+    }
+
+    // large proxies
+    for (uint32_t proxy : largeProxies)
+    {
+        if (isOverlapping(proxy))
+            results.push_back(proxies[proxy].userData);
+    }
+}
+
+void Broadphase::PrintStats() const
+{
+    std::cout << "info: broadphase:" << std::endl;
+    std::cout << std::format("\tproxies {} ({} large), cells {}, cell entries {} (max {} per cell), full sorts {}",
+                             stats.proxyCount,
+                             stats.largeProxyCount,
+                             stats.cellCount,
+                             stats.cellProxyCount,
+                             stats.maxCellProxyCount,
+                             stats.fullSortCount) << std::endl;
+    std::cout << std::format("\tpairs {}, added {}, removed {}, update {:.3f} ms",
+                             stats.pairCount,
+                             stats.addedCount,
+                             stats.removedCount,
+                             stats.updateTime) << std::endl;
+}
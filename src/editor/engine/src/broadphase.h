@@ -0,0 +1,165 @@
+#ifndef ARCTIC_BROADPHASE_H
+#define ARCTIC_BROADPHASE_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "utilities/radix_sort.h"
+#include "bounds.h"
+
+class JobSystem;
+
+// overlapping pairs of moving proxies (bounds & user data, e.g. bodies or triggers)
+//> sweep and prune per cell of a uniform grid over the ground plane (xz), sweeping along x
+//> every cell keeps its proxies sorted by min x with their bounds as structure of arrays; the order barely changes
+//> between updates, so an insertion sort restores it in close to linear time, the sweep then tests four
+//> candidates at once
+//> cells are independent and swept in parallel on the job system: a pair overlapping several cells is only
+//> reported by the cell holding the min corner of the overlap, so no pair is found twice
+//> proxies covering too many cells skip the grid and are tested against all proxies
+//> pairs are sorted by proxy, added & removed pairs are the difference to the previous update, so the events
+//> are the same on every run and thread count
+//> changes are applied by 'Update', queries see the bounds of the last one
+class Broadphase
+{
+public:
+    static constexpr uint32_t INVALID_PROXY = UINT32_MAX;
+    static constexpr float DEFAULT_CELL_SIZE = 32.0f; // world units
+    static constexpr uint32_t MAX_PROXY_CELL_COUNT = 16; // larger proxies are tested against all proxies
+    static constexpr int32_t MAX_CELL_COORDINATE = 1 << 20; // further cells are clamped onto the border
+    static constexpr uint32_t CELL_BATCH_SIZE = 4; // cells per job
+    static constexpr uint32_t SORT_SWAP_BUDGET = 8; // per proxy, an insertion sort above it falls back to a full sort
+
+    // proxyA < proxyB
+    struct Pair
+    {
+        uint32_t proxyA;
+        uint32_t proxyB;
+    };
+
+    struct Stats
+    {
+        uint32_t proxyCount;
+        uint32_t largeProxyCount; // outside of the grid
+        uint32_t cellCount; // holding proxies
+        uint32_t cellProxyCount; // summed over cells, proxies on a border count once per cell
+        uint32_t maxCellProxyCount;
+        uint32_t fullSortCount; // cells whose proxies moved too far for an insertion sort
+        uint32_t pairCount;
+        uint32_t addedCount;
+        uint32_t removedCount;
+        double updateTime; // ms
+    };
+
+    void Initialize(float cellSize = DEFAULT_CELL_SIZE);
+
+    // bounds must be finite
+    uint32_t Insert(const Aabb& bounds, uint32_t userData);
+    void Remove(uint32_t proxy);
+    void Move(uint32_t proxy, const Aabb& bounds);
+    uint32_t GetUserData(uint32_t proxy) const {
+        return proxies[proxy].userData;
+    }
+
+    // applies the changes and finds all overlapping pairs
+    //> without a job system the cells are swept on the calling thread
+    void Update(JobSystem* jobSystem);
+
+    // sorted by proxies, valid until the next 'Update'
+    //> pairs of a removed proxy are reported removed by the update after 'Remove', its id is reused after that
+    const std::vector<Pair>& GetPairs() const {
+        return pairs;
+    }
+    const std::vector<Pair>& GetAddedPairs() const {
+        return addedPairs;
+    }
+    const std::vector<Pair>& GetRemovedPairs() const {
+        return removedPairs;
+    }
+
+    // results are appended as user data
+    void QueryAabb(const Aabb& bounds, std::vector<uint32_t>& results) const;
+
+    const Stats& GetStats() const {
+        return stats;
+    }
+    void PrintStats() const;
+
+private:
+    enum class ProxyState : uint8_t
+    {
+        Free,
+        Active,
+        Removed // free after the next update
+    };
+
+    struct Proxy
+    {
+        Aabb bounds; // as of the last 'Move', copied into the sweep arrays by 'Update'
+        uint32_t userData;
+        ProxyState state;
+        bool isDirty;
+        bool isLarge;
+        int32_t cellMinX; // covered cells, empty when min > max
+        int32_t cellMinZ;
+        int32_t cellMaxX;
+        int32_t cellMaxZ;
+    };
+
+    // proxies sorted by their min x, the other bounds alongside as structure of arrays
+    //> the arrays are refreshed from the proxies every update & padded by four inverted entries for the sse sweep
+    struct Cell
+    {
+        int32_t x;
+        int32_t z;
+        std::vector<uint32_t> proxies;
+        std::vector<float> minX, maxX, minY, maxY, minZ, maxZ;
+        std::vector<uint64_t> pairs; // found by the last sweep
+        bool isDirty; // proxies left
+        bool isFullSorted; // fell back to a full sort in the last sweep
+    };
+
+    float cellSize = DEFAULT_CELL_SIZE;
+    float inverseCellSize = 1.0f / DEFAULT_CELL_SIZE;
+
+    std::vector<Proxy> proxies;
+    std::vector<uint32_t> freeProxies;
+    std::vector<uint32_t> dirtyProxies;
+    std::vector<uint32_t> removedProxies;
+    std::vector<uint32_t> largeProxies;
+
+    // sweep bounds of every proxy, structure of arrays
+    //> free & removed proxies have inverted bounds and overlap nothing
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+
+    std::vector<Cell> cells;
+    std::unordered_map<uint64_t, uint32_t> cellIndices; // packed coordinates to cell
+    std::vector<uint32_t> activeCells; // holding proxies, in cell index order
+
+    // pairs as proxyA << 32 | proxyB
+    std::vector<uint64_t> pairKeys;
+    std::vector<uint64_t> previousPairKeys;
+    std::vector<uint32_t> sortPayload;
+    std::vector<std::vector<uint64_t>> largePairs; // per large proxy
+    RadixSorter sorter;
+
+    std::vector<Pair> pairs;
+    std::vector<Pair> addedPairs;
+    std::vector<Pair> removedPairs;
+    Stats stats{};
+
+    int32_t getCellCoordinate(float value) const;
+    uint32_t getCell(int32_t x, int32_t z);
+    const Cell* findCell(int32_t x, int32_t z) const;
+    static uint64_t packCell(int32_t x, int32_t z) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+    }
+
+    void applyChanges();
+    void updateCells(const Proxy& proxy, uint32_t id, int32_t newMinX, int32_t newMinZ, int32_t newMaxX, int32_t newMaxZ);
+    void sweepCell(Cell& cell) const;
+    void testLargeProxy(uint32_t proxy, std::vector<uint64_t>& results) const;
+    void collectPairs(JobSystem* jobSystem);
+};
+
+#endif //ARCTIC_BROADPHASE_H
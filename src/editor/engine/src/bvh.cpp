@@ -0,0 +1,730 @@
+#include "bvh.h"
+#include "utilities/job_system.h"
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <iostream>
+#include <xmmintrin.h>
+
+namespace
+{
+    // sah cost of traversing a node relative to testing a primitive
+    const float NODE_COST = 1.0f;
+    const float PRIMITIVE_COST = 1.0f;
+
+    // returns one bit per child slot whose bounds intersect the frustum
+    int testFrustum(const float* minX, const float* minY, const float* minZ,
+                    const float* maxX, const float* maxY, const float* maxZ,
+                    const Frustum& frustum)
+    {
+        __m128 inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+        for (const auto& plane : frustum.planes)
+        {
+            // corner furthest along the normal, picked per plane for all children at once
+            __m128 x = _mm_load_ps(plane.x > 0.0f ? maxX : minX);
+            __m128 y = _mm_load_ps(plane.y > 0.0f ? maxY : minY);
+            __m128 z = _mm_load_ps(plane.z > 0.0f ? maxZ : minZ);
+
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)),
+                                                    _mm_mul_ps(y, _mm_set1_ps(plane.y))),
+                                         _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane.z)),
+                                                    _mm_set1_ps(plane.w)));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+        }
+        return _mm_movemask_ps(inside);
+    }
+
+    int testAabb(const float* minX, const float* minY, const float* minZ,
+                 const float* maxX, const float* maxY, const float* maxZ,
+                 const Aabb& bounds)
+    {
+        __m128 overlapX = _mm_and_ps(_mm_cmple_ps(_mm_load_ps(minX), _mm_set1_ps(bounds.max.x)),
+                                     _mm_cmpge_ps(_mm_load_ps(maxX), _mm_set1_ps(bounds.min.x)));
+        __m128 overlapY = _mm_and_ps(_mm_cmple_ps(_mm_load_ps(minY), _mm_set1_ps(bounds.max.y)),
+                                     _mm_cmpge_ps(_mm_load_ps(maxY), _mm_set1_ps(bounds.min.y)));
+        __m128 overlapZ = _mm_and_ps(_mm_cmple_ps(_mm_load_ps(minZ), _mm_set1_ps(bounds.max.z)),
+                                     _mm_cmpge_ps(_mm_load_ps(maxZ), _mm_set1_ps(bounds.min.z)));
+        return _mm_movemask_ps(_mm_and_ps(overlapX, _mm_and_ps(overlapY, overlapZ)));
+    }
+
+    // slab test of four children, writes the entry distances
+    int testRay(const float* minX, const float* minY, const float* minZ,
+                const float* maxX, const float* maxY, const float* maxZ,
+                const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance,
+                float* entryDistances)
+    {
+        __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(minX), _mm_set1_ps(origin.x)), _mm_set1_ps(inverseDirection.x));
+        __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(maxX), _mm_set1_ps(origin.x)), _mm_set1_ps(inverseDirection.x));
+        __m128 entry = _mm_min_ps(t1, t2);
+        __m128 exit = _mm_max_ps(t1, t2);
+
+        t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(minY), _mm_set1_ps(origin.y)), _mm_set1_ps(inverseDirection.y));
+        t2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(maxY), _mm_set1_ps(origin.y)), _mm_set1_ps(inverseDirection.y));
+        entry = _mm_max_ps(entry, _mm_min_ps(t1, t2));
+        exit = _mm_min_ps(exit, _mm_max_ps(t1, t2));
+
+        t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(minZ), _mm_set1_ps(origin.z)), _mm_set1_ps(inverseDirection.z));
+        t2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(maxZ), _mm_set1_ps(origin.z)), _mm_set1_ps(inverseDirection.z));
+        entry = _mm_max_ps(entry, _mm_min_ps(t1, t2));
+        exit = _mm_min_ps(exit, _mm_max_ps(t1, t2));
+
+        entry = _mm_max_ps(entry, _mm_setzero_ps());
+        exit = _mm_min_ps(exit, _mm_set1_ps(maxDistance));
+        _mm_storeu_ps(entryDistances, entry);
+
+        // inverted (empty) slots pass the slab test, they are masked out explicitly
+        __m128 isValid = _mm_cmple_ps(_mm_load_ps(minX), _mm_load_ps(maxX));
+        return _mm_movemask_ps(_mm_and_ps(isValid, _mm_cmple_ps(entry, exit)));
+    }
+
+    bool intersectRay(const Aabb& bounds, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance, float& distance)
+    {
+        glm::vec3 t1 = (bounds.min - origin) * inverseDirection;
+        glm::vec3 t2 = (bounds.max - origin) * inverseDirection;
+        glm::vec3 entry = glm::min(t1, t2);
+        glm::vec3 exit = glm::max(t1, t2);
+
+        float entryDistance = std::max(std::max(entry.x, entry.y), std::max(entry.z, 0.0f));
+        float exitDistance = std::min(std::min(exit.x, exit.y), std::min(exit.z, maxDistance));
+        if (entryDistance > exitDistance)
+            return false;
+
+        distance = entryDistance;
+        return true;
+    }
+}
+
+uint32_t Bvh::Insert(const Aabb& bounds, uint32_t userData)
+{
+    uint32_t proxy;
+    if (!freeProxies.empty())
+    {
+        proxy = freeProxies.back();
+        freeProxies.pop_back();
+    }
+    else
+    {
+        proxy = static_cast<uint32_t>(proxies.size());
+        proxies.emplace_back();
+    }
+
+    proxies[proxy] = {bounds, userData, ProxyState::Pending};
+    pendingProxies.push_back(proxy);
+    return proxy;
+}
+
+void Bvh::Remove(uint32_t proxy)
+{
+    Proxy& entry = proxies[proxy];
+    if (entry.state == ProxyState::Pending)
+    {
+        // not in the tree, free right away
+        auto it = std::find(pendingProxies.begin(), pendingProxies.end(), proxy);
+        *it = pendingProxies.back();
+        pendingProxies.pop_back();
+
+        entry.state = ProxyState::Free;
+        freeProxies.push_back(proxy);
+    }
+    else if (entry.state == ProxyState::Tree)
+    {
+        // still referenced by a leaf, freed by the next build
+        //> empty bounds shrink the leaf on the next refit
+        entry.state = ProxyState::Removed;
+        entry.bounds = Aabb{};
+        removedProxies.push_back(proxy);
+        isRefitRequired = true;
+    }
+}
+
+void Bvh::Move(uint32_t proxy, const Aabb& bounds)
+{
+    Proxy& entry = proxies[proxy];
+    entry.bounds = bounds;
+    if (entry.state == ProxyState::Tree)
+        isRefitRequired = true;
+}
+
+void Bvh::Update()
+{
+    if (isRebuildRequired())
+    {
+        Rebuild();
+        return;
+    }
+
+    if (!isRefitRequired)
+        return;
+
+    // refit & check how much the tree degraded
+    refit();
+    if (cost > buildCost * REBUILD_COST_RATIO)
+        Rebuild();
+}
+
+void Bvh::Rebuild()
+{
+    // free removed proxies
+    for (uint32_t proxy : removedProxies)
+    {
+        proxies[proxy].state = ProxyState::Free;
+        freeProxies.push_back(proxy);
+    }
+    removedProxies.clear();
+    pendingProxies.clear();
+
+    // gather primitives
+    primitives.clear();
+    centroids.resize(proxies.size());
+    for (uint32_t proxy = 0; proxy < proxies.size(); ++proxy)
+    {
+        Proxy& entry = proxies[proxy];
+        if (entry.state != ProxyState::Tree && entry.state != ProxyState::Pending)
+            continue;
+
+        entry.state = ProxyState::Tree;
+        primitives.push_back(proxy);
+        centroids[proxy] = entry.bounds.GetCenter();
+    }
+
+    nodes.clear();
+    rootBounds = Aabb{};
+    leafCount = 0;
+    depth = 0;
+    isRefitRequired = false;
+    ++buildCount;
+
+    if (primitives.empty())
+    {
+        buildCost = cost = 0.0f;
+        return;
+    }
+
+    // build binary tree
+    buildNodes.clear();
+    buildNodes.reserve(primitives.size() * 2);
+    buildRange(0, static_cast<uint32_t>(primitives.size()), 0);
+
+    // collapse into the wide tree
+    nodes.reserve(buildNodes.size() / 2 + 1);
+    rootBounds = buildNodes[0].bounds;
+    collapse(0, 0);
+
+    buildCost = cost = computeCost();
+}
+
+bool Bvh::isRebuildRequired() const
+{
+    const auto treeCount = static_cast<uint32_t>(primitives.size());
+    return pendingProxies.size() > MIN_PENDING_REBUILD_COUNT + treeCount / 8 ||
+           removedProxies.size() > treeCount / 4 ||
+           (nodes.empty() && !pendingProxies.empty());
+}
+
+uint32_t Bvh::buildRange(uint32_t first, uint32_t count, uint32_t buildDepth)
+{
+    auto index = static_cast<uint32_t>(buildNodes.size());
+    buildNodes.emplace_back();
+
+    // bounds
+    Aabb bounds;
+    Aabb centroidBounds;
+    for (uint32_t i = first; i < first + count; ++i)
+    {
+        bounds.Extend(proxies[primitives[i]].bounds);
+        centroidBounds.Extend(centroids[primitives[i]]);
+    }
+    buildNodes[index].bounds = bounds;
+
+    // leaf
+    if (count <= MAX_LEAF_SIZE)
+    {
+        buildNodes[index].first = first;
+        buildNodes[index].count = count;
+        return index;
+    }
+
+    // find the split with the lowest sah cost
+    //> centroids are binned along each axis, costs of all bin boundaries come from two sweeps
+    const glm::vec3 extent = centroidBounds.max - centroidBounds.min;
+    auto* begin = primitives.data() + first;
+    auto* end = begin + count;
+    uint32_t* split = nullptr;
+
+    if (buildDepth < MAX_DEPTH)
+    {
+        struct Bin
+        {
+            Aabb bounds;
+            uint32_t count = 0;
+        };
+
+        float bestCost = std::numeric_limits<float>::max();
+        int bestAxis = -1;
+        uint32_t bestBin = 0;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (extent[axis] <= 0.0f)
+                continue;
+
+            Bin bins[BIN_COUNT];
+            const float scale = static_cast<float>(BIN_COUNT) / extent[axis];
+            for (auto* primitive = begin; primitive != end; ++primitive)
+            {
+                auto bin = std::min(static_cast<uint32_t>((centroids[*primitive][axis] - centroidBounds.min[axis]) * scale), BIN_COUNT - 1);
+                bins[bin].bounds.Extend(proxies[*primitive].bounds);
+                ++bins[bin].count;
+            }
+
+            // right side of each boundary
+            float rightAreas[BIN_COUNT - 1];
+            uint32_t rightCounts[BIN_COUNT - 1];
+            Aabb rightBounds;
+            uint32_t rightCount = 0;
+            for (uint32_t bin = BIN_COUNT - 1; bin > 0; --bin)
+            {
+                rightBounds.Extend(bins[bin].bounds);
+                rightCount += bins[bin].count;
+                rightAreas[bin - 1] = rightBounds.GetSurfaceArea();
+                rightCounts[bin - 1] = rightCount;
+            }
+
+            // left side & cost
+            Aabb leftBounds;
+            uint32_t leftCount = 0;
+            for (uint32_t bin = 0; bin < BIN_COUNT - 1; ++bin)
+            {
+                leftBounds.Extend(bins[bin].bounds);
+                leftCount += bins[bin].count;
+                if (leftCount == 0 || rightCounts[bin] == 0)
+                    continue;
+
+                float splitCost = leftBounds.GetSurfaceArea() * static_cast<float>(leftCount) +
+                                  rightAreas[bin] * static_cast<float>(rightCounts[bin]);
+                if (splitCost < bestCost)
+                {
+                    bestCost = splitCost;
+                    bestAxis = axis;
+                    bestBin = bin;
+                }
+            }
+        }
+
+        if (bestAxis >= 0)
+        {
+            const float scale = static_cast<float>(BIN_COUNT) / extent[bestAxis];
+            const float minCentroid = centroidBounds.min[bestAxis];
+            split = std::partition(begin, end, [&](uint32_t primitive) {
+                return std::min(static_cast<uint32_t>((centroids[primitive][bestAxis] - minCentroid) * scale), BIN_COUNT - 1) <= bestBin;
+            });
+            if (split == begin || split == end)
+                split = nullptr;
+        }
+    }
+
+    // median split
+    //> too deep or all centroids in one bin
+    if (split == nullptr)
+    {
+        int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+        split = begin + count / 2;
+        std::nth_element(begin, split, end, [&](uint32_t a, uint32_t b) {
+            return centroids[a][axis] < centroids[b][axis];
+        });
+    }
+
+    auto leftCount = static_cast<uint32_t>(split - begin);
+    uint32_t left = buildRange(first, leftCount, buildDepth + 1);
+    uint32_t right = buildRange(first + leftCount, count - leftCount, buildDepth + 1);
+    buildNodes[index].first = left;
+    buildNodes[index].count = 0;
+    buildNodes[index].right = right;
+    return index;
+}
+
+uint32_t Bvh::collapse(uint32_t buildNodeIndex, uint32_t nodeDepth)
+{
+    auto nodeIndex = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+    depth = std::max(depth, nodeDepth + 1);
+
+    // gather up to four children
+    //> the inner child with the largest area is opened until the node is full
+    uint32_t children[WIDTH];
+    uint32_t childCount = 0;
+    const BuildNode& buildNode = buildNodes[buildNodeIndex];
+    if (buildNode.count > 0)
+    {
+        children[childCount++] = buildNodeIndex; // root is a leaf
+    }
+    else
+    {
+        children[childCount++] = buildNode.first;
+        children[childCount++] = buildNode.right;
+        while (childCount < WIDTH)
+        {
+            int largest = -1;
+            float largestArea = -1.0f;
+            for (uint32_t i = 0; i < childCount; ++i)
+            {
+                const BuildNode& child = buildNodes[children[i]];
+                if (child.count == 0 && child.bounds.GetSurfaceArea() > largestArea)
+                {
+                    largest = static_cast<int>(i);
+                    largestArea = child.bounds.GetSurfaceArea();
+                }
+            }
+            if (largest < 0)
+                break;
+
+            const BuildNode& opened = buildNodes[children[largest]];
+            children[largest] = opened.first;
+            children[childCount++] = opened.right;
+        }
+    }
+
+    // fill slots
+    //> children are collapsed first, the node is written afterwards as the vector may grow
+    uint32_t references[WIDTH];
+    for (uint32_t slot = 0; slot < childCount; ++slot)
+    {
+        const BuildNode& child = buildNodes[children[slot]];
+        if (child.count > 0)
+        {
+            references[slot] = encodeLeaf(child.first, child.count);
+            ++leafCount;
+        }
+        else
+        {
+            references[slot] = collapse(children[slot], nodeDepth + 1);
+        }
+    }
+
+    Node& node = nodes[nodeIndex];
+    for (uint32_t slot = 0; slot < WIDTH; ++slot)
+    {
+        if (slot < childCount)
+            setSlot(node, slot, buildNodes[children[slot]].bounds, references[slot]);
+        else
+            setSlot(node, slot, Aabb{}, EMPTY_CHILD);
+    }
+    return nodeIndex;
+}
+
+void Bvh::refit()
+{
+    // children are stored after their parents, so walking backwards visits them first
+    for (size_t index = nodes.size(); index-- > 0;)
+    {
+        Node& node = nodes[index];
+        for (uint32_t slot = 0; slot < WIDTH; ++slot)
+        {
+            uint32_t child = node.children[slot];
+            if (child == EMPTY_CHILD)
+                continue;
+
+            Aabb bounds;
+            if ((child & LEAF_BIT) != 0)
+            {
+                uint32_t first = (child & ~LEAF_BIT) >> LEAF_COUNT_BITS;
+                uint32_t count = (child & ((1u << LEAF_COUNT_BITS) - 1)) + 1;
+                for (uint32_t i = first; i < first + count; ++i)
+                    bounds.Extend(proxies[primitives[i]].bounds);
+            }
+            else
+            {
+                for (uint32_t childSlot = 0; childSlot < WIDTH; ++childSlot)
+                    bounds.Extend(getSlot(nodes[child], childSlot));
+            }
+            setSlot(node, slot, bounds, child);
+        }
+    }
+
+    rootBounds = Aabb{};
+    if (!nodes.empty())
+    {
+        for (uint32_t slot = 0; slot < WIDTH; ++slot)
+            rootBounds.Extend(getSlot(nodes[0], slot));
+    }
+
+    cost = computeCost();
+    isRefitRequired = false;
+    ++refitCount;
+}
+
+float Bvh::computeCost() const
+{
+    // expected cost of a random ray through the root: node & primitive tests weighted by the area of their bounds
+    const float rootArea = rootBounds.GetSurfaceArea();
+    if (rootArea <= 0.0f)
+        return 0.0f;
+
+    float area = rootArea * NODE_COST;
+    for (const Node& node : nodes)
+    {
+        for (uint32_t slot = 0; slot < WIDTH; ++slot)
+        {
+            uint32_t child = node.children[slot];
+            if (child == EMPTY_CHILD)
+                continue;
+
+            float slotArea = getSlot(node, slot).GetSurfaceArea();
+            if ((child & LEAF_BIT) != 0)
+                area += slotArea * static_cast<float>((child & ((1u << LEAF_COUNT_BITS) - 1)) + 1) * PRIMITIVE_COST;
+            else
+                area += slotArea * NODE_COST;
+        }
+    }
+    return area / rootArea;
+}
+
+void Bvh::setSlot(Node& node, uint32_t slot, const Aabb& bounds, uint32_t child)
+{
+    node.minX[slot] = bounds.min.x;
+    node.minY[slot] = bounds.min.y;
+    node.minZ[slot] = bounds.min.z;
+    node.maxX[slot] = bounds.max.x;
+    node.maxY[slot] = bounds.max.y;
+    node.maxZ[slot] = bounds.max.z;
+    node.children[slot] = child;
+}
+
+Aabb Bvh::getSlot(const Node& node, uint32_t slot)
+{
+    Aabb bounds;
+    bounds.min = glm::vec3(node.minX[slot], node.minY[slot], node.minZ[slot]);
+    bounds.max = glm::vec3(node.maxX[slot], node.maxY[slot], node.maxZ[slot]);
+    return bounds;
+}
+
+#pragma region queries
+
+void Bvh::QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& results) const
+{
+    for (uint32_t proxy : pendingProxies)
+    {
+        if (frustum.Intersects(proxies[proxy].bounds))
+            results.push_back(proxies[proxy].userData);
+    }
+
+    if (nodes.empty())
+        return;
+
+    uint32_t stack[STACK_SIZE];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0)
+    {
+        const Node& node = nodes[stack[--stackSize]];
+        int mask = testFrustum(node.minX, node.minY, node.minZ, node.maxX, node.maxY, node.maxZ, frustum);
+        while (mask != 0)
+        {
+            int slot = std::countr_zero(static_cast<uint32_t>(mask));
+            mask &= mask - 1;
+
+            uint32_t child = node.children[slot];
+            if ((child & LEAF_BIT) == 0)
+            {
+                stack[stackSize++] = child;
+                continue;
+            }
+
+            uint32_t first = (child & ~LEAF_BIT) >> LEAF_COUNT_BITS;
+            uint32_t count = (child & ((1u << LEAF_COUNT_BITS) - 1)) + 1;
+            for (uint32_t i = first; i < first + count; ++i)
+            {
+                const Proxy& proxy = proxies[primitives[i]];
+                if (proxy.state == ProxyState::Tree && frustum.Intersects(proxy.bounds))
+                    results.push_back(proxy.userData);
+            }
+        }
+    }
+}
+
+void Bvh::QueryAabb(const Aabb& bounds, std::vector<uint32_t>& results) const
+{
+    for (uint32_t proxy : pendingProxies)
+    {
+        if (bounds.Overlaps(proxies[proxy].bounds))
+            results.push_back(proxies[proxy].userData);
+    }
+
+    if (nodes.empty())
+        return;
+
+    uint32_t stack[STACK_SIZE];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0)
+    {
+        const Node& node = nodes[stack[--stackSize]];
+        int mask = testAabb(node.minX, node.minY, node.minZ, node.maxX, node.maxY, node.maxZ, bounds);
+        while (mask != 0)
+        {
+            int slot = std::countr_zero(static_cast<uint32_t>(mask));
+            mask &= mask - 1;
+
+            uint32_t child = node.children[slot];
+            if ((child & LEAF_BIT) == 0)
+            {
+                stack[stackSize++] = child;
+                continue;
+            }
+
+            uint32_t first = (child & ~LEAF_BIT) >> LEAF_COUNT_BITS;
+            uint32_t count = (child & ((1u << LEAF_COUNT_BITS) - 1)) + 1;
+            for (uint32_t i = first; i < first + count; ++i)
+            {
+                const Proxy& proxy = proxies[primitives[i]];
+                if (proxy.state == ProxyState::Tree && bounds.Overlaps(proxy.bounds))
+                    results.push_back(proxy.userData);
+            }
+        }
+    }
+}
+
+bool Bvh::QueryRay(const Ray& ray, RayHit& hit) const
+{
+    const glm::vec3 inverseDirection = 1.0f / ray.direction;
+    float closest = ray.maxDistance;
+    hit = {};
+
+    for (uint32_t proxy : pendingProxies)
+    {
+        float distance;
+        if (intersectRay(proxies[proxy].bounds, ray.origin, inverseDirection, closest, distance))
+        {
+            closest = distance;
+            hit = {proxies[proxy].userData, distance};
+        }
+    }
+
+    if (!nodes.empty())
+    {
+        uint32_t stack[STACK_SIZE];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            const Node& node = nodes[stack[--stackSize]];
+            float entryDistances[WIDTH];
+            int mask = testRay(node.minX, node.minY, node.minZ, node.maxX, node.maxY, node.maxZ,
+                               ray.origin, inverseDirection, closest, entryDistances);
+
+            // visit near children first
+            //> inner children are pushed far to near, leaves are tested right away
+            uint32_t innerSlots[WIDTH];
+            uint32_t innerCount = 0;
+            while (mask != 0)
+            {
+                int slot = std::countr_zero(static_cast<uint32_t>(mask));
+                mask &= mask - 1;
+
+                uint32_t child = node.children[slot];
+                if ((child & LEAF_BIT) == 0)
+                {
+                    innerSlots[innerCount++] = slot;
+                    continue;
+                }
+
+                uint32_t first = (child & ~LEAF_BIT) >> LEAF_COUNT_BITS;
+                uint32_t count = (child & ((1u << LEAF_COUNT_BITS) - 1)) + 1;
+                for (uint32_t i = first; i < first + count; ++i)
+                {
+                    const Proxy& proxy = proxies[primitives[i]];
+                    float distance;
+                    if (proxy.state == ProxyState::Tree &&
+                        intersectRay(proxy.bounds, ray.origin, inverseDirection, closest, distance))
+                    {
+                        closest = distance;
+                        hit = {proxy.userData, distance};
+                    }
+                }
+            }
+
+            std::sort(innerSlots, innerSlots + innerCount, [&entryDistances](uint32_t a, uint32_t b) {
+                return entryDistances[a] > entryDistances[b];
+            });
+            for (uint32_t i = 0; i < innerCount; ++i)
+            {
+                if (entryDistances[innerSlots[i]] <= closest)
+                    stack[stackSize++] = node.children[innerSlots[i]];
+            }
+        }
+    }
+
+    return hit.userData != INVALID_PROXY;
+}
+
+void Bvh::QueryFrustums(const std::vector<Frustum>& frustums, std::vector<std::vector<uint32_t>>& results, JobSystem& jobSystem) const
+{
+    results.resize(frustums.size());
+    jobSystem.ParallelFor(static_cast<uint32_t>(frustums.size()), QUERY_BATCH_SIZE, [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            results[i].clear();
+            QueryFrustum(frustums[i], results[i]);
+        }
+    });
+}
+
+void Bvh::QueryAabbs(const std::vector<Aabb>& bounds, std::vector<std::vector<uint32_t>>& results, JobSystem& jobSystem) const
+{
+    results.resize(bounds.size());
+    jobSystem.ParallelFor(static_cast<uint32_t>(bounds.size()), QUERY_BATCH_SIZE, [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            results[i].clear();
+            QueryAabb(bounds[i], results[i]);
+        }
+    });
+}
+
+void Bvh::QueryRays(const std::vector<Ray>& rays, std::vector<RayHit>& hits, JobSystem& jobSystem) const
+{
+    hits.resize(rays.size());
+    jobSystem.ParallelFor(static_cast<uint32_t>(rays.size()), QUERY_BATCH_SIZE, [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; ++i)
+            QueryRay(rays[i], hits[i]);
+    });
+}
+
+#pragma endregion
+
+Bvh::Stats Bvh::GetStats() const
+{
+    Stats stats{};
+    stats.proxyCount = static_cast<uint32_t>(primitives.size() - removedProxies.size() + pendingProxies.size());
+    stats.pendingCount = static_cast<uint32_t>(pendingProxies.size());
+    stats.removedCount = static_cast<uint32_t>(removedProxies.size());
+    stats.nodeCount = static_cast<uint32_t>(nodes.size());
+    stats.leafCount = leafCount;
+    stats.depth = depth;
+    stats.buildCost = buildCost;
+    stats.cost = cost;
+    stats.buildCount = buildCount;
+    stats.refitCount = refitCount;
+    return stats;
+}
+
+void Bvh::PrintStats() const
+{
+    Stats stats = GetStats();
+
+    std::cout << "info: bvh:" << std::endl;
+    std::cout << std::format("\tproxies {} (pending {}, removed {}), nodes {}, leaves {}, depth {}",
+                             stats.proxyCount,
+                             stats.pendingCount,
+                             stats.removedCount,
+                             stats.nodeCount,
+                             stats.leafCount,
+                             stats.depth) << std::endl;
+    std::cout << std::format("\tsah cost {:.2f} (build {:.2f}), builds {}, refits {}",
+                             stats.cost,
+                             stats.buildCost,
+                             stats.buildCount,
+                             stats.refitCount) << std::endl;
+}
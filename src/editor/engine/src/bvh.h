@@ -0,0 +1,153 @@
+#ifndef ARCTIC_BVH_H
+#define ARCTIC_BVH_H
+
+#include <cstdint>
+#include <vector>
+#include "bounds.h"
+
+class JobSystem;
+
+// dynamic bounding volume hierarchy over proxies (bounds & user data, e.g. entities)
+//> built top-down with binned sah, then collapsed into a 4-wide tree with the child bounds stored
+//> as structure of arrays, so one node tests its four children with a single sse instruction per component
+//> changes between 'Update' calls:
+//> - moved proxies are refit in place (bounds only, the topology is kept)
+//> - inserted proxies wait in a pending list, tested linearly, until the next rebuild
+//> - removed proxies stay in their leaf with empty bounds until the next rebuild
+//> a rebuild happens when refitting degraded the sah cost too much or too many proxies are pending / removed
+//> queries may run concurrently with each other, not with changes
+class Bvh
+{
+public:
+    static constexpr uint32_t INVALID_PROXY = UINT32_MAX;
+    static constexpr uint32_t WIDTH = 4;
+    static constexpr uint32_t MAX_LEAF_SIZE = 4;
+    static constexpr uint32_t BIN_COUNT = 16;
+    static constexpr uint32_t MAX_DEPTH = 48; // deeper ranges are split at the median, bounds the traversal stack
+    static constexpr float REBUILD_COST_RATIO = 1.5f; // refit sah cost relative to the cost after the last build
+    static constexpr uint32_t MIN_PENDING_REBUILD_COUNT = 32; // plus 1/8 of the tree
+    static constexpr uint32_t QUERY_BATCH_SIZE = 8; // queries per job
+
+    struct RayHit
+    {
+        uint32_t userData = INVALID_PROXY;
+        float distance = 0.0f;
+    };
+
+    struct Stats
+    {
+        uint32_t proxyCount;
+        uint32_t pendingCount; // inserted since the last build
+        uint32_t removedCount; // removed since the last build
+        uint32_t nodeCount;
+        uint32_t leafCount;
+        uint32_t depth;
+        float buildCost; // sah cost after the last build
+        float cost; // sah cost after the last refit
+        uint64_t buildCount;
+        uint64_t refitCount;
+    };
+
+    uint32_t Insert(const Aabb& bounds, uint32_t userData);
+    void Remove(uint32_t proxy);
+    void Move(uint32_t proxy, const Aabb& bounds);
+
+    // applies the changes: rebuild or refit
+    void Update();
+    void Rebuild();
+
+    // results are appended as user data
+    void QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& results) const;
+    void QueryAabb(const Aabb& bounds, std::vector<uint32_t>& results) const;
+    // closest proxy bounds hit by the ray
+    bool QueryRay(const Ray& ray, RayHit& hit) const;
+
+    // batched queries, spread over the job system
+    //> results are cleared first, one list / hit per query
+    void QueryFrustums(const std::vector<Frustum>& frustums, std::vector<std::vector<uint32_t>>& results, JobSystem& jobSystem) const;
+    void QueryAabbs(const std::vector<Aabb>& bounds, std::vector<std::vector<uint32_t>>& results, JobSystem& jobSystem) const;
+    void QueryRays(const std::vector<Ray>& rays, std::vector<RayHit>& hits, JobSystem& jobSystem) const;
+
+    Stats GetStats() const;
+    void PrintStats() const;
+
+private:
+    // child references: inner nodes by index, leaves as (LEAF_BIT | first primitive << 3 | count - 1)
+    static constexpr uint32_t EMPTY_CHILD = UINT32_MAX;
+    static constexpr uint32_t LEAF_BIT = 0x80000000u;
+    static constexpr uint32_t LEAF_COUNT_BITS = 3;
+    static constexpr uint32_t STACK_SIZE = (MAX_DEPTH + 32) * (WIDTH - 1) + 1; // median splits add at most 32 levels
+
+    enum class ProxyState : uint8_t
+    {
+        Free,
+        Tree,
+        Pending,
+        Removed // free after the next build, still referenced by a leaf
+    };
+
+    struct Proxy
+    {
+        Aabb bounds;
+        uint32_t userData;
+        ProxyState state;
+    };
+
+    // 128 bytes, two cache lines
+    //> empty slots have inverted bounds and fail every test
+    struct alignas(64) Node
+    {
+        float minX[WIDTH];
+        float minY[WIDTH];
+        float minZ[WIDTH];
+        float maxX[WIDTH];
+        float maxY[WIDTH];
+        float maxZ[WIDTH];
+        uint32_t children[WIDTH];
+        uint32_t padding[WIDTH];
+    };
+
+    // binary node of the sah build, collapsed into 'Node' afterwards
+    struct BuildNode
+    {
+        Aabb bounds;
+        uint32_t first; // leaf: first primitive, inner: left child
+        uint32_t count; // leaf: primitive count, inner: 0
+        uint32_t right; // inner: right child
+    };
+
+    std::vector<Proxy> proxies;
+    std::vector<uint32_t> freeProxies;
+    std::vector<uint32_t> removedProxies;
+    std::vector<uint32_t> pendingProxies;
+
+    std::vector<Node> nodes; // depth first, children after their parent
+    std::vector<uint32_t> primitives; // proxies referenced by the leaves
+    Aabb rootBounds;
+    uint32_t leafCount = 0;
+    uint32_t depth = 0;
+    bool isRefitRequired = false;
+
+    float buildCost = 0.0f;
+    float cost = 0.0f;
+    uint64_t buildCount = 0;
+    uint64_t refitCount = 0;
+
+    // build scratch
+    std::vector<BuildNode> buildNodes;
+    std::vector<glm::vec3> centroids;
+
+    bool isRebuildRequired() const;
+    void refit();
+    float computeCost() const;
+
+    uint32_t buildRange(uint32_t first, uint32_t count, uint32_t buildDepth);
+    uint32_t collapse(uint32_t buildNodeIndex, uint32_t nodeDepth);
+    static void setSlot(Node& node, uint32_t slot, const Aabb& bounds, uint32_t child);
+    static Aabb getSlot(const Node& node, uint32_t slot);
+    static uint32_t encodeLeaf(uint32_t first, uint32_t count) {
+        return LEAF_BIT | (first << LEAF_COUNT_BITS) | (count - 1);
+    }
+};
+
+#endif //ARCTIC_BVH_H
@@ -0,0 +1,299 @@
+#include "clustered_lighting.h"
+#include "vulkan_utility.h"
+#include "utilities/logger.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <iostream>
+
+bool ClusteredLighting::Initialize(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        const VkAllocationCallbacks* allocator,
+        VkExtent2D screenExtent,
+        uint32_t maxLights,
+        bool reverseZ)
+{
+    vkPhysicalDevice = physicalDevice;
+    vkDevice = device;
+    vkAllocator = allocator;
+    extent = screenExtent;
+    maxLightCount = maxLights;
+    isReverseZ = reverseZ;
+
+    SetCamera(glm::mat4(1.0f), glm::radians(60.0f), nearPlane, farPlane);
+
+    return createBuffers() &&
+           createPipeline() &&
+           createDescriptorSet();
+}
+
+void ClusteredLighting::Cleanup()
+{
+    if (vkDevice == VK_NULL_HANDLE)
+        return;
+
+    // pipeline
+    vkDestroyDescriptorPool(vkDevice, vkDescriptorPool, vkAllocator);
+    vkDestroyPipeline(vkDevice, vkPipeline, vkAllocator);
+    vkDestroyPipelineLayout(vkDevice, vkPipelineLayout, vkAllocator);
+    vkDestroyDescriptorSetLayout(vkDevice, vkDescriptorSetLayout, vkAllocator);
+
+    // buffers
+    vkDestroyBuffer(vkDevice, lightBuffer, vkAllocator);
+    vkFreeMemory(vkDevice, lightMemory, vkAllocator);
+    vkDestroyBuffer(vkDevice, paramsBuffer, vkAllocator);
+    vkFreeMemory(vkDevice, paramsMemory, vkAllocator);
+    vkDestroyBuffer(vkDevice, clusterCountBuffer, vkAllocator);
+    vkFreeMemory(vkDevice, clusterCountMemory, vkAllocator);
+    vkDestroyBuffer(vkDevice, clusterIndexBuffer, vkAllocator);
+    vkFreeMemory(vkDevice, clusterIndexMemory, vkAllocator);
+    vkDestroyBuffer(vkDevice, statsBuffer, vkAllocator);
+    vkFreeMemory(vkDevice, statsMemory, vkAllocator);
+}
+
+void ClusteredLighting::SetLights(const std::vector<Light>& lights)
+{
+    lightCount = static_cast<uint32_t>(std::min<size_t>(lights.size(), maxLightCount));
+    std::memcpy(lightMapped, lights.data(), lightCount * sizeof(Light));
+}
+
+void ClusteredLighting::SetCamera(const glm::mat4& viewMatrix, float fieldOfView, float nearDistance, float farDistance)
+{
+    //> vulkan clip space: depth from zero to one, reverse-z swaps the planes
+    view = viewMatrix;
+    nearPlane = nearDistance;
+    farPlane = farDistance;
+    float aspect = (float) extent.width / (float) extent.height;
+    projection = isReverseZ ? glm::perspectiveRH_ZO(fieldOfView, aspect, farPlane, nearPlane)
+                            : glm::perspectiveRH_ZO(fieldOfView, aspect, nearPlane, farPlane);
+}
+
+void ClusteredLighting::RecordBinning(VkCommandBuffer commandBuffer)
+{
+    // update params
+    //> the previous frame is done at this point, the mapped memory is not in use by the gpu
+    writeParams(lightCount);
+    statsLightCount = lightCount;
+
+    // reset stats
+    vkCmdFillBuffer(commandBuffer, statsBuffer, 0, sizeof(GpuStats), 0);
+
+    VkMemoryBarrier fillBarrier{};
+    fillBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    fillBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    fillBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+    //> also waits for the fragment shaders of the previous frame that read the clusters
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0, 1, &fillBarrier, 0, nullptr, 0, nullptr);
+
+    // bin lights
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, vkPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, vkPipelineLayout, 0, 1, &vkDescriptorSet, 0, nullptr);
+    vkCmdDispatch(commandBuffer, (CLUSTER_COUNT + 63) / 64, 1, 1);
+
+    // make clusters visible to fragment shaders & stats to the host
+    VkMemoryBarrier binBarrier{};
+    binBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    binBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    binBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+                         0, 1, &binBarrier, 0, nullptr, 0, nullptr);
+}
+
+void ClusteredLighting::writeParams(uint32_t paramsLightCount)
+{
+    ClusterParams params{};
+    params.view = view;
+    params.inverseProjection = glm::inverse(projection);
+    params.gridSize = glm::uvec4(GRID_SIZE_X, GRID_SIZE_Y, GRID_SIZE_Z, paramsLightCount);
+    params.screen = glm::vec4((float) extent.width, (float) extent.height, nearPlane, farPlane);
+    std::memcpy(paramsMapped, &params, sizeof(ClusterParams));
+}
+
+ClusteredLighting::Stats ClusteredLighting::GetStats() const
+{
+    GpuStats gpuStats{};
+    std::memcpy(&gpuStats, statsMapped, sizeof(GpuStats));
+
+    Stats stats{};
+    stats.lightCount = statsLightCount;
+    stats.clusterCount = CLUSTER_COUNT;
+    stats.activeClusterCount = gpuStats.activeClusterCount;
+    stats.lightIndexCount = gpuStats.lightIndexCount;
+    stats.maxClusterLightCount = gpuStats.maxClusterLightCount;
+    stats.overflowCount = gpuStats.overflowCount;
+    return stats;
+}
+
+void ClusteredLighting::PrintStats() const
+{
+    Stats stats = GetStats();
+    float averageLightCount = stats.activeClusterCount > 0 ? (float) stats.lightIndexCount / (float) stats.activeClusterCount : 0.0f;
+
+    std::cout << "info: vulkan: clustered lighting:" << std::endl;
+    std::cout << std::format("\tgrid {}x{}x{}, lights {}, max per cluster {}",
+                             GRID_SIZE_X, GRID_SIZE_Y, GRID_SIZE_Z,
+                             stats.lightCount,
+                             MAX_LIGHTS_PER_CLUSTER) << std::endl;
+    std::cout << std::format("\tactive clusters {}/{}, light indices {}, avg lights per active cluster {:.2f}, max {}, overflow {}",
+                             stats.activeClusterCount,
+                             stats.clusterCount,
+                             stats.lightIndexCount,
+                             averageLightCount,
+                             stats.maxClusterLightCount,
+                             stats.overflowCount) << std::endl;
+}
+
+bool ClusteredLighting::createBuffers()
+{
+    const VkMemoryPropertyFlags hostVisible = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    const VkDeviceSize lightSize = sizeof(Light) * std::max(maxLightCount, 1u);
+    const VkDeviceSize clusterCountSize = sizeof(uint32_t) * CLUSTER_COUNT;
+    const VkDeviceSize clusterIndexSize = sizeof(uint32_t) * CLUSTER_COUNT * MAX_LIGHTS_PER_CLUSTER;
+
+    // lights & params: written by the cpu
+    if (!VulkanUtility::CreateBuffer(vkPhysicalDevice, vkDevice, vkAllocator, lightSize,
+                                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostVisible,
+                                     lightBuffer, lightMemory) ||
+        !VulkanUtility::CreateBuffer(vkPhysicalDevice, vkDevice, vkAllocator, sizeof(ClusterParams),
+                                     VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, hostVisible,
+                                     paramsBuffer, paramsMemory))
+        return false;
+    vkMapMemory(vkDevice, lightMemory, 0, lightSize, 0, &lightMapped);
+    vkMapMemory(vkDevice, paramsMemory, 0, sizeof(ClusterParams), 0, &paramsMapped);
+    writeParams(0);
+
+    // clusters: written by the binning pass
+    //> counts start at zero so fragments drawn before the first binning see no lights
+    if (!VulkanUtility::CreateBuffer(vkPhysicalDevice, vkDevice, vkAllocator, clusterCountSize,
+                                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostVisible,
+                                     clusterCountBuffer, clusterCountMemory) ||
+        !VulkanUtility::CreateBuffer(vkPhysicalDevice, vkDevice, vkAllocator, clusterIndexSize,
+                                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                     clusterIndexBuffer, clusterIndexMemory))
+        return false;
+
+    void* clusterCountMapped = nullptr;
+    vkMapMemory(vkDevice, clusterCountMemory, 0, clusterCountSize, 0, &clusterCountMapped);
+    std::memset(clusterCountMapped, 0, clusterCountSize);
+    vkUnmapMemory(vkDevice, clusterCountMemory);
+
+    // stats: read back by the cpu
+    if (!VulkanUtility::CreateBuffer(vkPhysicalDevice, vkDevice, vkAllocator, sizeof(GpuStats),
+                                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, hostVisible,
+                                     statsBuffer, statsMemory))
+        return false;
+    vkMapMemory(vkDevice, statsMemory, 0, sizeof(GpuStats), 0, &statsMapped);
+    std::memset(statsMapped, 0, sizeof(GpuStats));
+
+    return true;
+}
+
+bool ClusteredLighting::createPipeline()
+{
+    // create set layout
+    //> stats are only written by the binning pass
+    const VkShaderStageFlags stages = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    VkDescriptorSetLayoutBinding bindings[5] = {};
+    bindings[0] = {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, stages, nullptr};
+    bindings[1] = {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stages, nullptr};
+    bindings[2] = {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stages, nullptr};
+    bindings[3] = {3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stages, nullptr};
+    bindings[4] = {4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.bindingCount = 5;
+    setLayoutInfo.pBindings = bindings;
+
+    if (vkCreateDescriptorSetLayout(vkDevice, &setLayoutInfo, vkAllocator, &vkDescriptorSetLayout) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create light cluster set layout!");
+        return false;
+    }
+
+    // create pipeline layout
+    VkPipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &vkDescriptorSetLayout;
+
+    if (vkCreatePipelineLayout(vkDevice, &layoutInfo, vkAllocator, &vkPipelineLayout) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create light binning pipeline layout!");
+        return false;
+    }
+
+    // create pipeline
+    VkShaderModule shaderModule = VK_NULL_HANDLE;
+    bool isCreated =
+            VulkanUtility::CreateShaderModule(vkDevice, vkAllocator, "cluster_binning.comp.spv", shaderModule) &&
+            VulkanUtility::CreateComputePipeline(vkDevice, vkAllocator, shaderModule, vkPipelineLayout, nullptr, vkPipeline);
+
+    // cleanup shader
+    vkDestroyShaderModule(vkDevice, shaderModule, vkAllocator);
+
+    return isCreated;
+}
+
+bool ClusteredLighting::createDescriptorSet()
+{
+    // create descriptor pool
+    VkDescriptorPoolSize poolSizes[2] = {};
+    poolSizes[0] = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1};
+    poolSizes[1] = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4};
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = 2;
+    poolInfo.pPoolSizes = poolSizes;
+
+    if (vkCreateDescriptorPool(vkDevice, &poolInfo, vkAllocator, &vkDescriptorPool) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create light cluster descriptor pool!");
+        return false;
+    }
+
+    // allocate set
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = vkDescriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &vkDescriptorSetLayout;
+
+    if (vkAllocateDescriptorSets(vkDevice, &allocInfo, &vkDescriptorSet) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to allocate light cluster descriptor set!");
+        return false;
+    }
+
+    // write set
+    VkDescriptorBufferInfo bufferInfos[5] = {};
+    bufferInfos[0] = {paramsBuffer, 0, VK_WHOLE_SIZE};
+    bufferInfos[1] = {lightBuffer, 0, VK_WHOLE_SIZE};
+    bufferInfos[2] = {clusterCountBuffer, 0, VK_WHOLE_SIZE};
+    bufferInfos[3] = {clusterIndexBuffer, 0, VK_WHOLE_SIZE};
+    bufferInfos[4] = {statsBuffer, 0, VK_WHOLE_SIZE};
+
+    VkWriteDescriptorSet writes[5] = {};
+    for (uint32_t binding = 0; binding < 5; ++binding)
+    {
+        writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[binding].dstSet = vkDescriptorSet;
+        writes[binding].dstBinding = binding;
+        writes[binding].descriptorCount = 1;
+        writes[binding].descriptorType = binding == 0 ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[binding].pBufferInfo = &bufferInfos[binding];
+    }
+    vkUpdateDescriptorSets(vkDevice, 5, writes, 0, nullptr);
+
+    return true;
+}
@@ -0,0 +1,133 @@
+#ifndef ARCTIC_CLUSTERED_LIGHTING_H
+#define ARCTIC_CLUSTERED_LIGHTING_H
+
+#include <vector>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan_core.h>
+
+// clustered forward lighting
+//> the view frustum is split into a froxel grid (uniform tiles in screen space, exponential slices in depth),
+//> a compute pass bins the lights into the clusters and fragments only evaluate the lights of their cluster
+//> the descriptor set is shared by the binning pass and the fragment shader (set 0)
+class ClusteredLighting
+{
+public:
+    static constexpr uint32_t GRID_SIZE_X = 16;
+    static constexpr uint32_t GRID_SIZE_Y = 9;
+    static constexpr uint32_t GRID_SIZE_Z = 24;
+    static constexpr uint32_t CLUSTER_COUNT = GRID_SIZE_X * GRID_SIZE_Y * GRID_SIZE_Z;
+    static constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 128; // further lights are dropped and counted as overflow
+
+    // matches 'Light' in cluster_binning.comp
+    struct Light
+    {
+        glm::vec4 positionRadius; // xyz: world position, w: radius
+        glm::vec4 colorIntensity; // rgb: color, a: intensity
+    };
+
+    struct Stats
+    {
+        uint32_t lightCount;
+        uint32_t clusterCount;
+        uint32_t activeClusterCount; // clusters with at least one light
+        uint32_t lightIndexCount; // sum of lights over all clusters
+        uint32_t maxClusterLightCount; // including dropped lights
+        uint32_t overflowCount; // dropped lights over all clusters
+    };
+
+    bool Initialize(VkPhysicalDevice physicalDevice,
+                    VkDevice device,
+                    const VkAllocationCallbacks* allocator,
+                    VkExtent2D screenExtent,
+                    uint32_t maxLightCount,
+                    bool isReverseZ);
+    void Cleanup();
+
+    void SetLights(const std::vector<Light>& lights);
+    void SetCamera(const glm::mat4& view, float fieldOfView, float nearPlane, float farPlane);
+    // extent the fragments are rendered at, follows dynamic resolution
+    void SetScreenExtent(VkExtent2D screenExtent) {
+        extent = screenExtent;
+    }
+
+    // bins the lights, must be recorded outside of a render pass
+    void RecordBinning(VkCommandBuffer commandBuffer);
+
+    VkDescriptorSetLayout GetDescriptorSetLayout() const {
+        return vkDescriptorSetLayout;
+    }
+    VkDescriptorSet GetDescriptorSet() const {
+        return vkDescriptorSet;
+    }
+
+    // stats of the last completed binning
+    Stats GetStats() const;
+    void PrintStats() const;
+
+private:
+    // matches 'ClusterParams' in cluster_binning.comp
+    struct ClusterParams
+    {
+        glm::mat4 view;
+        glm::mat4 inverseProjection;
+        glm::uvec4 gridSize; // xyz: cluster count per axis, w: light count
+        glm::vec4 screen; // xy: size in pixels, z: near plane, w: far plane
+    };
+
+    // matches 'Stats' in cluster_binning.comp
+    struct GpuStats
+    {
+        uint32_t activeClusterCount;
+        uint32_t lightIndexCount;
+        uint32_t maxClusterLightCount;
+        uint32_t overflowCount;
+    };
+
+    VkPhysicalDevice vkPhysicalDevice = VK_NULL_HANDLE;
+    VkDevice vkDevice = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* vkAllocator = nullptr;
+
+    // camera
+    VkExtent2D extent{};
+    glm::mat4 view{1.0f};
+    glm::mat4 projection{1.0f};
+    float nearPlane = 0.1f;
+    float farPlane = 100.0f;
+    bool isReverseZ = false; // fragments rebuild their view position from depth with 'projection'
+
+    // lights
+    uint32_t maxLightCount = 0;
+    uint32_t lightCount = 0;
+    VkBuffer lightBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory lightMemory = VK_NULL_HANDLE;
+    void* lightMapped = nullptr;
+
+    // clusters
+    VkBuffer paramsBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory paramsMemory = VK_NULL_HANDLE;
+    void* paramsMapped = nullptr;
+
+    VkBuffer clusterCountBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory clusterCountMemory = VK_NULL_HANDLE;
+    VkBuffer clusterIndexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory clusterIndexMemory = VK_NULL_HANDLE;
+
+    VkBuffer statsBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory statsMemory = VK_NULL_HANDLE;
+    void* statsMapped = nullptr;
+    uint32_t statsLightCount = 0; // light count of the binning the stats belong to
+
+    // pipeline
+    VkDescriptorSetLayout vkDescriptorSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout vkPipelineLayout = VK_NULL_HANDLE;
+    VkPipeline vkPipeline = VK_NULL_HANDLE;
+    VkDescriptorPool vkDescriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet vkDescriptorSet = VK_NULL_HANDLE;
+
+    bool createBuffers();
+    bool createPipeline();
+    void writeParams(uint32_t paramsLightCount);
+    bool createDescriptorSet();
+};
+
+#endif //ARCTIC_CLUSTERED_LIGHTING_H
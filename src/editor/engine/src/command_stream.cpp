@@ -0,0 +1,165 @@
+#include "command_stream.h"
+#include "utilities/logger.h"
+#include <fstream>
+
+namespace
+{
+    struct CaptureHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t width;
+        uint32_t height;
+        uint32_t format;
+        uint32_t resourceCount;
+        uint32_t frameCount;
+    };
+
+    struct ResourceHeader
+    {
+        uint32_t type;
+        uint32_t id;
+        uint64_t size;
+    };
+
+    template<typename T>
+    bool readValue(std::ifstream& file, T& value)
+    {
+        file.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return file.good();
+    }
+
+    template<typename T>
+    void writeValue(std::ofstream& file, const T& value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+}
+
+bool CommandCapture::Save(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        ARCTIC_LOG_ERROR(Capture, "failed to open {} for writing!", path);
+        return false;
+    }
+
+    // header
+    CaptureHeader header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.width = extent.width;
+    header.height = extent.height;
+    header.format = static_cast<uint32_t>(format);
+    header.resourceCount = static_cast<uint32_t>(resources.size());
+    header.frameCount = static_cast<uint32_t>(frames.size());
+    writeValue(file, header);
+
+    // resources
+    for (const auto& resource : resources)
+    {
+        ResourceHeader resourceHeader{};
+        resourceHeader.type = static_cast<uint32_t>(resource.type);
+        resourceHeader.id = resource.id;
+        resourceHeader.size = resource.data.size();
+        writeValue(file, resourceHeader);
+        file.write(resource.data.data(), static_cast<std::streamsize>(resource.data.size()));
+    }
+
+    // frames
+    for (const auto& frame : frames)
+    {
+        uint64_t size = frame.size();
+        writeValue(file, size);
+        file.write(reinterpret_cast<const char*>(frame.data()), static_cast<std::streamsize>(size));
+    }
+
+    return file.good();
+}
+
+bool CommandCapture::Load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        ARCTIC_LOG_ERROR(Capture, "failed to open {}!", path);
+        return false;
+    }
+
+    // counts & sizes are checked against the bytes left, a corrupt file must not allocate beyond its size
+    const auto fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+    auto remaining = [&]()
+    {
+        auto position = file.tellg();
+        return position < 0 ? 0 : fileSize - static_cast<uint64_t>(position);
+    };
+
+    // header
+    CaptureHeader header{};
+    if (!readValue(file, header) || header.magic != MAGIC)
+    {
+        ARCTIC_LOG_ERROR(Capture, "{} is not a capture file!", path);
+        return false;
+    }
+    if (header.version != VERSION)
+    {
+        ARCTIC_LOG_ERROR(Capture, "unsupported version {}!", header.version);
+        return false;
+    }
+
+    extent = {header.width, header.height};
+    format = static_cast<VkFormat>(header.format);
+
+    // resources
+    if (header.resourceCount > remaining() / sizeof(ResourceHeader))
+    {
+        ARCTIC_LOG_ERROR(Capture, "{} is truncated!", path);
+        return false;
+    }
+    resources.resize(header.resourceCount);
+    for (auto& resource : resources)
+    {
+        ResourceHeader resourceHeader{};
+        if (!readValue(file, resourceHeader) || resourceHeader.size > remaining() ||
+            resourceHeader.type != static_cast<uint32_t>(ResourceType::Shader))
+        {
+            ARCTIC_LOG_ERROR(Capture, "{} has an invalid resource!", path);
+            return false;
+        }
+
+        resource.type = static_cast<ResourceType>(resourceHeader.type);
+        resource.id = resourceHeader.id;
+        resource.data.resize(resourceHeader.size);
+        file.read(resource.data.data(), static_cast<std::streamsize>(resourceHeader.size));
+    }
+
+    // frames
+    //> the commands in a frame are checked while reading it ('CommandStream::Reader')
+    if (header.frameCount > remaining() / sizeof(uint64_t))
+    {
+        ARCTIC_LOG_ERROR(Capture, "{} is truncated!", path);
+        return false;
+    }
+    frames.resize(header.frameCount);
+    for (auto& frame : frames)
+    {
+        uint64_t size = 0;
+        if (!readValue(file, size) || size > remaining())
+        {
+            ARCTIC_LOG_ERROR(Capture, "{} is truncated!", path);
+            return false;
+        }
+
+        frame.resize(size);
+        file.read(reinterpret_cast<char*>(frame.data()), static_cast<std::streamsize>(size));
+    }
+
+    if (!file.good())
+    {
+        ARCTIC_LOG_ERROR(Capture, "{} is truncated!", path);
+        return false;
+    }
+    return true;
+}
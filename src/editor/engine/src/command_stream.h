@@ -0,0 +1,262 @@
+#ifndef ARCTIC_COMMAND_STREAM_H
+#define ARCTIC_COMMAND_STREAM_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+// engine level commands
+//> recorded every frame and translated to vulkan commands afterwards,
+//> so a frame can be captured and replayed without the systems that produced it
+enum class CommandType : uint8_t
+{
+    BeginRenderPass,
+    EndRenderPass,
+    BindPipeline,
+    SetViewport,
+    SetScissor,
+    Draw,
+    MultiDraw,
+    SetViewConstants,
+    SetDrawConstants,
+};
+
+struct CommandBeginRenderPass
+{
+    float clearColor[4];
+};
+
+struct CommandBindPipeline
+{
+    uint32_t permutationKey;
+};
+
+struct CommandSetViewport
+{
+    float x, y, width, height, minDepth, maxDepth;
+};
+
+struct CommandSetScissor
+{
+    int32_t x, y;
+    uint32_t width, height;
+};
+
+struct CommandDraw
+{
+    uint32_t vertexCount;
+    uint32_t instanceCount;
+    uint32_t firstVertex;
+    uint32_t firstInstance;
+};
+
+// followed by 'drawCount' tightly packed 'CommandDraw'
+//> layout matches 'VkDrawIndirectCommand', so the draws can be copied to an indirect buffer as is
+struct CommandMultiDraw
+{
+    uint32_t drawCount;
+};
+
+// followed by 'size' bytes of view constants (see 'ViewConstants')
+//> copied into the frame data ring & bound with a dynamic offset for the following draws
+struct CommandSetViewConstants
+{
+    uint32_t size;
+};
+
+// followed by 'drawCount' tightly packed draw constants of 'stride' bytes (see 'DrawConstants')
+//> copied into the frame data ring, the following draws read theirs at their instance index
+struct CommandSetDrawConstants
+{
+    uint32_t drawCount;
+    uint32_t stride;
+};
+
+// compact binary stream of engine commands
+//> each command is stored as a one byte type followed by its tightly packed payload
+class CommandStream
+{
+public:
+    void Reset() {
+        data.clear();
+    }
+
+    void BeginRenderPass(const CommandBeginRenderPass& command) { write(CommandType::BeginRenderPass, command); }
+    void EndRenderPass() { data.push_back(static_cast<uint8_t>(CommandType::EndRenderPass)); }
+    void BindPipeline(const CommandBindPipeline& command) { write(CommandType::BindPipeline, command); }
+    void SetViewport(const CommandSetViewport& command) { write(CommandType::SetViewport, command); }
+    void SetScissor(const CommandSetScissor& command) { write(CommandType::SetScissor, command); }
+    void Draw(const CommandDraw& command) { write(CommandType::Draw, command); }
+    void MultiDraw(const CommandDraw* draws, uint32_t drawCount)
+    {
+        write(CommandType::MultiDraw, CommandMultiDraw{drawCount});
+        size_t offset = data.size();
+        data.resize(offset + drawCount * sizeof(CommandDraw));
+        std::memcpy(data.data() + offset, draws, drawCount * sizeof(CommandDraw));
+    }
+    void SetViewConstants(const void* constants, uint32_t size)
+    {
+        write(CommandType::SetViewConstants, CommandSetViewConstants{size});
+        size_t offset = data.size();
+        data.resize(offset + size);
+        std::memcpy(data.data() + offset, constants, size);
+    }
+    void SetDrawConstants(const void* constants, uint32_t drawCount, uint32_t stride)
+    {
+        write(CommandType::SetDrawConstants, CommandSetDrawConstants{drawCount, stride});
+        size_t offset = data.size();
+        data.resize(offset + drawCount * stride);
+        std::memcpy(data.data() + offset, constants, drawCount * stride);
+    }
+
+    const std::vector<uint8_t>& GetData() const {
+        return data;
+    }
+    void SetData(std::vector<uint8_t> streamData) {
+        data = std::move(streamData);
+    }
+
+    // sequential reader over a stream
+    //> 'Next' checks that the whole command, including its trailing data, lies within the stream,
+    //> so a truncated or corrupt stream (e.g. from a capture file) ends the read instead of overrunning it
+    class Reader
+    {
+    public:
+        explicit Reader(const std::vector<uint8_t>& data) : data(data) {}
+
+        bool Next(CommandType& type)
+        {
+            if (isFailed || offset >= data.size())
+                return false;
+            type = static_cast<CommandType>(data[offset]);
+            if (!fitsCommand(type, offset + 1))
+            {
+                isFailed = true;
+                return false;
+            }
+            ++offset;
+            return true;
+        }
+
+        // false when the read stopped at a command that does not fit the stream or has an unknown type
+        bool IsComplete() const {
+            return !isFailed;
+        }
+
+        template<typename T>
+        T Read()
+        {
+            T command{};
+            if (isFailed || sizeof(T) > data.size() - offset)
+            {
+                isFailed = true;
+                return command;
+            }
+            std::memcpy(&command, data.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return command;
+        }
+
+        // points into the stream, valid while the stream is unchanged, null on overrun
+        const uint8_t* Skip(size_t size)
+        {
+            if (isFailed || size > data.size() - offset)
+            {
+                isFailed = true;
+                return nullptr;
+            }
+            const uint8_t* bytes = data.data() + offset;
+            offset += size;
+            return bytes;
+        }
+
+    private:
+        const std::vector<uint8_t>& data;
+        size_t offset = 0;
+        bool isFailed = false;
+
+        // payload & trailing data of the command at 'payload' fit the stream
+        bool fitsCommand(CommandType type, size_t payload) const
+        {
+            const size_t available = data.size() - payload;
+            switch (type)
+            {
+                case CommandType::BeginRenderPass: return sizeof(CommandBeginRenderPass) <= available;
+                case CommandType::EndRenderPass: return true;
+                case CommandType::BindPipeline: return sizeof(CommandBindPipeline) <= available;
+                case CommandType::SetViewport: return sizeof(CommandSetViewport) <= available;
+                case CommandType::SetScissor: return sizeof(CommandSetScissor) <= available;
+                case CommandType::Draw: return sizeof(CommandDraw) <= available;
+                case CommandType::MultiDraw:
+                {
+                    CommandMultiDraw command{};
+                    if (sizeof(command) > available)
+                        return false;
+                    std::memcpy(&command, data.data() + payload, sizeof(command));
+                    return static_cast<uint64_t>(command.drawCount) * sizeof(CommandDraw) <= available - sizeof(command);
+                }
+                case CommandType::SetViewConstants:
+                {
+                    CommandSetViewConstants command{};
+                    if (sizeof(command) > available)
+                        return false;
+                    std::memcpy(&command, data.data() + payload, sizeof(command));
+                    return command.size <= available - sizeof(command);
+                }
+                case CommandType::SetDrawConstants:
+                {
+                    CommandSetDrawConstants command{};
+                    if (sizeof(command) > available)
+                        return false;
+                    std::memcpy(&command, data.data() + payload, sizeof(command));
+                    return static_cast<uint64_t>(command.drawCount) * command.stride <= available - sizeof(command);
+                }
+            }
+            return false;
+        }
+    };
+
+private:
+    std::vector<uint8_t> data;
+
+    template<typename T>
+    void write(CommandType type, const T& command)
+    {
+        size_t offset = data.size();
+        data.resize(offset + 1 + sizeof(T));
+        data[offset] = static_cast<uint8_t>(type);
+        std::memcpy(data.data() + offset + 1, &command, sizeof(T));
+    }
+};
+
+// captured frames and the resources they reference
+//> stored as a single binary file: header, resources, frames
+struct CommandCapture
+{
+    static constexpr uint32_t MAGIC = 0x50414341; // "ACAP"
+    static constexpr uint32_t VERSION = 2; // 2: view & draw constants
+
+    enum class ResourceType : uint32_t
+    {
+        Shader, // id: VkShaderStageFlagBits, data: spir-v
+    };
+
+    struct Resource
+    {
+        ResourceType type;
+        uint32_t id;
+        std::vector<char> data;
+    };
+
+    VkExtent2D extent{};
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    std::vector<Resource> resources;
+    std::vector<std::vector<uint8_t>> frames;
+
+    bool Save(const std::string& path) const;
+    bool Load(const std::string& path);
+};
+
+#endif //ARCTIC_COMMAND_STREAM_H
@@ -0,0 +1,135 @@
+#include "deletion_queue.h"
+#include "utilities/logger.h"
+#include <format>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    template<typename T>
+    T fromHandle(uint64_t handle) {
+        return reinterpret_cast<T>(handle);
+    }
+}
+
+void DeletionQueue::Initialize(VkDevice device, const VkAllocationCallbacks* allocator)
+{
+    vkDevice = device;
+    vkAllocator = allocator;
+}
+
+void DeletionQueue::Cleanup()
+{
+    std::lock_guard lock(entriesMutex);
+    for (const auto& entry : entries)
+        destroy(entry);
+    destroyedCount += entries.size();
+    entries.clear();
+}
+
+void DeletionQueue::Collect(uint64_t completedFrame)
+{
+    // take the completed entries, destroyed outside the lock so pushes from other threads don't wait on the driver
+    std::vector<Entry> completed;
+    {
+        std::lock_guard lock(entriesMutex);
+        while (!entries.empty() && entries.front().frame <= completedFrame)
+        {
+            completed.push_back(entries.front());
+            entries.pop_front();
+        }
+        destroyedCount += completed.size();
+    }
+
+    for (const auto& entry : completed)
+        destroy(entry);
+}
+
+void DeletionQueue::push(VkObjectType type, uint64_t handle, uint64_t parent, uint64_t frame)
+{
+    if (handle == 0)
+        return;
+
+    std::lock_guard lock(entriesMutex);
+    entries.push_back({frame, type, handle, parent});
+    ++queuedCount;
+}
+
+void DeletionQueue::destroy(const Entry& entry)
+{
+    switch (entry.type)
+    {
+        case VK_OBJECT_TYPE_BUFFER:
+            vkDestroyBuffer(vkDevice, fromHandle<VkBuffer>(entry.handle), vkAllocator);
+            break;
+        case VK_OBJECT_TYPE_IMAGE:
+            vkDestroyImage(vkDevice, fromHandle<VkImage>(entry.handle), vkAllocator);
+            break;
+        case VK_OBJECT_TYPE_IMAGE_VIEW:
+            vkDestroyImageView(vkDevice, fromHandle<VkImageView>(entry.handle), vkAllocator);
+            break;
+        case VK_OBJECT_TYPE_DEVICE_MEMORY:
+            vkFreeMemory(vkDevice, fromHandle<VkDeviceMemory>(entry.handle), vkAllocator);
+            break;
+        case VK_OBJECT_TYPE_SAMPLER:
+            vkDestroySampler(vkDevice, fromHandle<VkSampler>(entry.handle), vkAllocator);
+            break;
+        case VK_OBJECT_TYPE_PIPELINE:
+            vkDestroyPipeline(vkDevice, fromHandle<VkPipeline>(entry.handle), vkAllocator);
+            break;
+        case VK_OBJECT_TYPE_PIPELINE_LAYOUT:
+            vkDestroyPipelineLayout(vkDevice, fromHandle<VkPipelineLayout>(entry.handle), vkAllocator);
+            break;
+        case VK_OBJECT_TYPE_SHADER_MODULE:
+            vkDestroyShaderModule(vkDevice, fromHandle<VkShaderModule>(entry.handle), vkAllocator);
+            break;
+        case VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT:
+            vkDestroyDescriptorSetLayout(vkDevice, fromHandle<VkDescriptorSetLayout>(entry.handle), vkAllocator);
+            break;
+        case VK_OBJECT_TYPE_DESCRIPTOR_POOL:
+            vkDestroyDescriptorPool(vkDevice, fromHandle<VkDescriptorPool>(entry.handle), vkAllocator);
+            break;
+        case VK_OBJECT_TYPE_DESCRIPTOR_SET:
+        {
+            VkDescriptorSet set = fromHandle<VkDescriptorSet>(entry.handle);
+            vkFreeDescriptorSets(vkDevice, fromHandle<VkDescriptorPool>(entry.parent), 1, &set);
+            break;
+        }
+        case VK_OBJECT_TYPE_FRAMEBUFFER:
+            vkDestroyFramebuffer(vkDevice, fromHandle<VkFramebuffer>(entry.handle), vkAllocator);
+            break;
+        case VK_OBJECT_TYPE_RENDER_PASS:
+            vkDestroyRenderPass(vkDevice, fromHandle<VkRenderPass>(entry.handle), vkAllocator);
+            break;
+        case VK_OBJECT_TYPE_QUERY_POOL:
+            vkDestroyQueryPool(vkDevice, fromHandle<VkQueryPool>(entry.handle), vkAllocator);
+            break;
+        default:
+            ARCTIC_LOG_ERROR(Vulkan, "unsupported object type {}!", static_cast<uint32_t>(entry.type));
+            break;
+    }
+}
+
+DeletionQueue::Stats DeletionQueue::GetStats() const
+{
+    std::lock_guard lock(entriesMutex);
+
+    Stats stats{};
+    stats.queuedCount = queuedCount;
+    stats.destroyedCount = destroyedCount;
+    stats.pendingCount = static_cast<uint32_t>(entries.size());
+    stats.oldestPendingFrame = entries.empty() ? 0 : entries.front().frame;
+    return stats;
+}
+
+void DeletionQueue::PrintStats() const
+{
+    Stats stats = GetStats();
+    std::cout << "info: deletion queue:" << std::endl;
+    std::cout << std::format("\tqueued {}, destroyed {}, pending {} (oldest frame {}, current frame {})",
+                             stats.queuedCount,
+                             stats.destroyedCount,
+                             stats.pendingCount,
+                             stats.oldestPendingFrame,
+                             currentFrame) << std::endl;
+}
@@ -0,0 +1,134 @@
+#ifndef ARCTIC_DELETION_QUEUE_H
+#define ARCTIC_DELETION_QUEUE_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vulkan/vulkan_core.h>
+
+// frame-deferred destruction of vulkan objects
+//> objects are tagged with the frame they were last used in & destroyed once the gpu completed that frame,
+//> so resources can be released at runtime (streaming, hot reload, resize) without draining the device
+//> the tag is a plain counter, the loader uses its frame count but a timeline semaphore value works the same
+class DeletionQueue
+{
+public:
+    struct Stats
+    {
+        uint64_t queuedCount;
+        uint64_t destroyedCount;
+        uint32_t pendingCount;
+        uint64_t oldestPendingFrame; // 0 without pending objects
+    };
+
+    void Initialize(VkDevice device, const VkAllocationCallbacks* allocator);
+    // destroys everything pending, the device must be idle
+    void Cleanup();
+
+    // frame being recorded, objects pushed without a frame are tagged with it
+    void SetFrame(uint64_t frame) {
+        currentFrame = frame;
+    }
+    uint64_t GetFrame() const {
+        return currentFrame;
+    }
+
+    // destroys the objects last used in 'completedFrame' or earlier
+    void Collect(uint64_t completedFrame);
+
+    // thread safe
+    //> 'lastUseFrame' overrides the current frame, e.g. for an object only used by an older frame
+    void Push(VkBuffer buffer) {
+        push(VK_OBJECT_TYPE_BUFFER, toHandle(buffer), 0, currentFrame);
+    }
+    void Push(VkBuffer buffer, uint64_t lastUseFrame) {
+        push(VK_OBJECT_TYPE_BUFFER, toHandle(buffer), 0, lastUseFrame);
+    }
+    void Push(VkImage image) {
+        push(VK_OBJECT_TYPE_IMAGE, toHandle(image), 0, currentFrame);
+    }
+    void Push(VkImage image, uint64_t lastUseFrame) {
+        push(VK_OBJECT_TYPE_IMAGE, toHandle(image), 0, lastUseFrame);
+    }
+    void Push(VkImageView view) {
+        push(VK_OBJECT_TYPE_IMAGE_VIEW, toHandle(view), 0, currentFrame);
+    }
+    void Push(VkImageView view, uint64_t lastUseFrame) {
+        push(VK_OBJECT_TYPE_IMAGE_VIEW, toHandle(view), 0, lastUseFrame);
+    }
+    void Push(VkDeviceMemory memory) {
+        push(VK_OBJECT_TYPE_DEVICE_MEMORY, toHandle(memory), 0, currentFrame);
+    }
+    void Push(VkDeviceMemory memory, uint64_t lastUseFrame) {
+        push(VK_OBJECT_TYPE_DEVICE_MEMORY, toHandle(memory), 0, lastUseFrame);
+    }
+    void Push(VkSampler sampler) {
+        push(VK_OBJECT_TYPE_SAMPLER, toHandle(sampler), 0, currentFrame);
+    }
+    void Push(VkPipeline pipeline) {
+        push(VK_OBJECT_TYPE_PIPELINE, toHandle(pipeline), 0, currentFrame);
+    }
+    void Push(VkPipeline pipeline, uint64_t lastUseFrame) {
+        push(VK_OBJECT_TYPE_PIPELINE, toHandle(pipeline), 0, lastUseFrame);
+    }
+    void Push(VkPipelineLayout layout) {
+        push(VK_OBJECT_TYPE_PIPELINE_LAYOUT, toHandle(layout), 0, currentFrame);
+    }
+    void Push(VkShaderModule module) {
+        push(VK_OBJECT_TYPE_SHADER_MODULE, toHandle(module), 0, currentFrame);
+    }
+    void Push(VkDescriptorSetLayout layout) {
+        push(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, toHandle(layout), 0, currentFrame);
+    }
+    void Push(VkDescriptorPool pool) {
+        push(VK_OBJECT_TYPE_DESCRIPTOR_POOL, toHandle(pool), 0, currentFrame);
+    }
+    // the pool must be created with 'VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT' & outlive the set
+    void Push(VkDescriptorSet set, VkDescriptorPool pool) {
+        push(VK_OBJECT_TYPE_DESCRIPTOR_SET, toHandle(set), toHandle(pool), currentFrame);
+    }
+    void Push(VkFramebuffer framebuffer) {
+        push(VK_OBJECT_TYPE_FRAMEBUFFER, toHandle(framebuffer), 0, currentFrame);
+    }
+    void Push(VkRenderPass renderPass) {
+        push(VK_OBJECT_TYPE_RENDER_PASS, toHandle(renderPass), 0, currentFrame);
+    }
+    void Push(VkQueryPool queryPool) {
+        push(VK_OBJECT_TYPE_QUERY_POOL, toHandle(queryPool), 0, currentFrame);
+    }
+
+    Stats GetStats() const;
+    void PrintStats() const;
+
+private:
+    struct Entry
+    {
+        uint64_t frame;
+        VkObjectType type;
+        uint64_t handle;
+        uint64_t parent; // pool of descriptor sets
+    };
+
+    VkDevice vkDevice = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* vkAllocator = nullptr;
+    uint64_t currentFrame = 0;
+
+    //> pushed in frame order, entries with an older explicit frame wait behind newer ones (later, never early)
+    mutable std::mutex entriesMutex;
+    std::deque<Entry> entries;
+
+    // stats
+    uint64_t queuedCount = 0;
+    uint64_t destroyedCount = 0;
+
+    //> non-dispatchable handles are pointers on 64-bit & 'uint64_t' otherwise
+    template<typename T>
+    static uint64_t toHandle(T handle) {
+        return reinterpret_cast<uint64_t>(handle);
+    }
+
+    void push(VkObjectType type, uint64_t handle, uint64_t parent, uint64_t frame);
+    void destroy(const Entry& entry);
+};
+
+#endif //ARCTIC_DELETION_QUEUE_H
@@ -0,0 +1,602 @@
+#include "dynamic_resolution.h"
+#include "vulkan_utility.h"
+#include "utilities/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <iostream>
+
+namespace
+{
+    float quantizeScale(float scale)
+    {
+        return std::floor(scale / DynamicResolution::SCALE_STEP + 1e-3f) * DynamicResolution::SCALE_STEP;
+    }
+}
+
+bool DynamicResolution::Initialize(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        const VkAllocationCallbacks* allocator,
+        VkExtent2D output,
+        VkFormat format,
+        VkFormat depthFormat,
+        VkImageView depthView,
+        const std::vector<VkImageView>& outputViews,
+        float targetTime)
+{
+    vkPhysicalDevice = physicalDevice;
+    vkDevice = device;
+    vkAllocator = allocator;
+    outputExtent = output;
+    targetGpuTime = targetTime;
+
+    targetExtent.width = std::max(static_cast<uint32_t>(std::lround(static_cast<float>(output.width) * MAX_SCALE)), 1u);
+    targetExtent.height = std::max(static_cast<uint32_t>(std::lround(static_cast<float>(output.height) * MAX_SCALE)), 1u);
+    scale = MAX_SCALE;
+    updateRenderExtent();
+
+    return createTiming() &&
+           createSceneTarget(format, depthFormat, depthView) &&
+           createUpscalePass(format, outputViews) &&
+           createUpscalePipeline() &&
+           createDescriptorSet();
+}
+
+void DynamicResolution::Cleanup()
+{
+    // upscale
+    vkDestroyPipeline(vkDevice, vkPipeline, vkAllocator);
+    vkDestroyPipelineLayout(vkDevice, vkPipelineLayout, vkAllocator);
+    vkDestroyDescriptorPool(vkDevice, vkDescriptorPool, vkAllocator);
+    vkDestroyDescriptorSetLayout(vkDevice, vkDescriptorSetLayout, vkAllocator);
+    vkDestroySampler(vkDevice, vkSampler, vkAllocator);
+    for (auto framebuffer : upscaleFramebuffers)
+        vkDestroyFramebuffer(vkDevice, framebuffer, vkAllocator);
+    upscaleFramebuffers.clear();
+    vkDestroyRenderPass(vkDevice, vkUpscaleRenderPass, vkAllocator);
+
+    // scene target
+    vkDestroyFramebuffer(vkDevice, vkSceneFramebuffer, vkAllocator);
+    vkDestroyRenderPass(vkDevice, vkSceneRenderPass, vkAllocator);
+    vkDestroyRenderPass(vkDevice, vkSceneLoadRenderPass, vkAllocator);
+    vkDestroyImageView(vkDevice, sceneView, vkAllocator);
+    vkDestroyImage(vkDevice, sceneImage, vkAllocator);
+    vkFreeMemory(vkDevice, sceneMemory, vkAllocator);
+
+    // timing
+    vkDestroyQueryPool(vkDevice, vkQueryPool, vkAllocator);
+}
+
+void DynamicResolution::BeginFrame(VkCommandBuffer commandBuffer)
+{
+    // read gpu time of the previous frame
+    //> the previous frame is done at this point, results are available without waiting
+    if (isTimingSupported && isTimingPending)
+    {
+        uint64_t timestamps[2] = {};
+        VkResult result = vkGetQueryPoolResults(vkDevice, vkQueryPool, 0, 2, sizeof(timestamps), timestamps, sizeof(uint64_t),
+                                                VK_QUERY_RESULT_64_BIT);
+        if (result == VK_SUCCESS)
+        {
+            double ticks = static_cast<double>(timestamps[1] - timestamps[0]);
+            UpdateScale(static_cast<float>(ticks * timestampPeriod / 1000000.0));
+        }
+        isTimingPending = false;
+    }
+    updateRenderExtent();
+
+    // start timing
+    if (isTimingSupported)
+    {
+        vkCmdResetQueryPool(commandBuffer, vkQueryPool, 0, 2);
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, vkQueryPool, 0);
+    }
+}
+
+void DynamicResolution::RecordUpscale(VkCommandBuffer commandBuffer, uint32_t outputIndex)
+{
+    // begin upscale pass
+    //> every pixel is written, nothing to clear
+    VkRenderPassBeginInfo renderPassBeginInfo{};
+    renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassBeginInfo.renderPass = vkUpscaleRenderPass;
+    renderPassBeginInfo.framebuffer = upscaleFramebuffers[outputIndex];
+    renderPassBeginInfo.renderArea.offset = {0, 0};
+    renderPassBeginInfo.renderArea.extent = outputExtent;
+    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+    // draw fullscreen triangle
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vkPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vkPipelineLayout, 0, 1, &vkDescriptorSet, 0, nullptr);
+
+    VkViewport viewport{0.0f, 0.0f, (float) outputExtent.width, (float) outputExtent.height, 0.0f, 1.0f};
+    VkRect2D scissor{{0, 0}, outputExtent};
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    UpscaleConstants constants{};
+    constants.uvScale[0] = (float) renderExtent.width / (float) targetExtent.width;
+    constants.uvScale[1] = (float) renderExtent.height / (float) targetExtent.height;
+    constants.texelSize[0] = 1.0f / (float) targetExtent.width;
+    constants.texelSize[1] = 1.0f / (float) targetExtent.height;
+    constants.sharpness = sharpness;
+    constants.filter = static_cast<uint32_t>(filter);
+    vkCmdPushConstants(commandBuffer, vkPipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(UpscaleConstants), &constants);
+
+    vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+    vkCmdEndRenderPass(commandBuffer);
+
+    // end timing
+    if (isTimingSupported)
+    {
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, vkQueryPool, 1);
+        isTimingPending = true;
+    }
+}
+
+float DynamicResolution::UpdateScale(float frameGpuTime)
+{
+    if (frameGpuTime <= 0.0f)
+        return scale;
+
+    gpuTime = frameGpuTime;
+    averageGpuTime = averageGpuTime > 0.0f ? averageGpuTime + (frameGpuTime - averageGpuTime) * TIME_SMOOTHING : frameGpuTime;
+
+    // gpu time is assumed to follow the pixel count, so the square of the scale
+    if (frameGpuTime > targetGpuTime)
+    {
+        // over budget: react to the last frame, not the average
+        calmFrameCount = 0;
+        float estimatedScale = scale * std::sqrt(targetGpuTime / frameGpuTime);
+        float newScale = std::max(quantizeScale(estimatedScale), MIN_SCALE);
+        if (newScale < scale)
+        {
+            scale = newScale;
+            ++decreaseCount;
+        }
+    }
+    else if (scale < MAX_SCALE && averageGpuTime < targetGpuTime * INCREASE_THRESHOLD)
+    {
+        // under budget: recover towards the threshold, not the budget
+        if (++calmFrameCount < INCREASE_DELAY)
+            return scale;
+
+        calmFrameCount = 0;
+        float estimatedScale = scale * std::sqrt(targetGpuTime * INCREASE_THRESHOLD / averageGpuTime);
+        float newScale = std::min(quantizeScale(std::min(estimatedScale, scale + INCREASE_STEP)), MAX_SCALE);
+        if (newScale > scale)
+        {
+            scale = newScale;
+            ++increaseCount;
+        }
+    }
+    else
+    {
+        calmFrameCount = 0;
+    }
+    return scale;
+}
+
+void DynamicResolution::updateRenderExtent()
+{
+    //> relative to the target, which is allocated at max scale
+    float relativeScale = scale / MAX_SCALE;
+    renderExtent.width = std::clamp(static_cast<uint32_t>(std::lround(static_cast<float>(targetExtent.width) * relativeScale)), 1u, targetExtent.width);
+    renderExtent.height = std::clamp(static_cast<uint32_t>(std::lround(static_cast<float>(targetExtent.height) * relativeScale)), 1u, targetExtent.height);
+}
+
+DynamicResolution::Stats DynamicResolution::GetStats() const
+{
+    Stats stats{};
+    stats.scale = scale;
+    stats.renderExtent = renderExtent;
+    stats.outputExtent = outputExtent;
+    stats.gpuTime = gpuTime;
+    stats.averageGpuTime = averageGpuTime;
+    stats.targetGpuTime = targetGpuTime;
+    stats.decreaseCount = decreaseCount;
+    stats.increaseCount = increaseCount;
+    return stats;
+}
+
+void DynamicResolution::PrintStats() const
+{
+    Stats stats = GetStats();
+
+    std::cout << "info: vulkan: dynamic resolution:" << std::endl;
+    std::cout << std::format("\tscale {:.3f}, render {}x{}, output {}x{}, filter {}",
+                             stats.scale,
+                             stats.renderExtent.width,
+                             stats.renderExtent.height,
+                             stats.outputExtent.width,
+                             stats.outputExtent.height,
+                             filter == UpscaleFilter::Sharpen ? "sharpen" : "bilinear") << std::endl;
+    std::cout << std::format("\tgpu {:.3f} ms (avg {:.3f} ms, target {:.3f} ms{}), decreases {}, increases {}",
+                             stats.gpuTime,
+                             stats.averageGpuTime,
+                             stats.targetGpuTime,
+                             isTimingSupported ? "" : ", no timestamps",
+                             stats.decreaseCount,
+                             stats.increaseCount) << std::endl;
+}
+
+bool DynamicResolution::createTiming()
+{
+    // check support
+    //> without timestamps on graphics queues the scale stays at max
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(vkPhysicalDevice, &deviceProperties);
+    isTimingSupported = deviceProperties.limits.timestampComputeAndGraphics == VK_TRUE;
+    timestampPeriod = deviceProperties.limits.timestampPeriod;
+    if (!isTimingSupported)
+        return true;
+
+    // create query pool
+    //> two timestamps: start and end of frame
+    VkQueryPoolCreateInfo queryPoolInfo{};
+    queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolInfo.queryCount = 2;
+
+    if (vkCreateQueryPool(vkDevice, &queryPoolInfo, vkAllocator, &vkQueryPool) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create dynamic resolution query pool!");
+        return false;
+    }
+    return true;
+}
+
+bool DynamicResolution::createSceneTarget(VkFormat format, VkFormat depthFormat, VkImageView depthView)
+{
+    // create image
+    if (!VulkanUtility::CreateImage(vkPhysicalDevice, vkDevice, vkAllocator, targetExtent, 1, format,
+                                    VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                                    sceneImage, sceneMemory) ||
+        !VulkanUtility::CreateImageView(vkDevice, vkAllocator, sceneImage, format,
+                                        VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, sceneView))
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create dynamic resolution target!");
+        return false;
+    }
+
+    // create render pass
+    //> same attachments as the swap chain pass, the color ends ready for sampling
+    VkAttachmentDescription attachments[2] = {};
+    VkAttachmentDescription& colorAttachment = attachments[0];
+    colorAttachment.format = format;
+    colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    attachments[1] = VulkanUtility::GetSceneDepthAttachment(depthFormat);
+
+    VkAttachmentReference colorAttachmentRef{0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+    VkAttachmentReference depthAttachmentRef{1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+
+    VkSubpassDescription subpass{};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &colorAttachmentRef;
+    subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+    //> the upscale of the previous frame reads the image, this frame writes it
+    //> the depth of the previous frame is cleared, its writes & the particle collisions reading it have to finish first
+    VkSubpassDependency dependencies[3] = {};
+    dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[0].dstSubpass = 0;
+    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+                                   VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    dependencies[0].srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+    //> the upscale reads what this pass wrote
+    dependencies[1].srcSubpass = 0;
+    dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    //> the particle collisions of the next frame sample the depth
+    dependencies[2].srcSubpass = 0;
+    dependencies[2].dstSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[2].srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependencies[2].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dependencies[2].dstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    dependencies[2].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    VkRenderPassCreateInfo renderPassInfo{};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    renderPassInfo.attachmentCount = 2;
+    renderPassInfo.pAttachments = attachments;
+    renderPassInfo.subpassCount = 1;
+    renderPassInfo.pSubpasses = &subpass;
+    renderPassInfo.dependencyCount = 3;
+    renderPassInfo.pDependencies = dependencies;
+
+    if (vkCreateRenderPass(vkDevice, &renderPassInfo, vkAllocator, &vkSceneRenderPass) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create dynamic resolution scene render pass!");
+        return false;
+    }
+    if (!VulkanUtility::CreateSceneLoadRenderPass(vkDevice, vkAllocator, format, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                                  depthFormat, vkSceneLoadRenderPass))
+        return false;
+
+    // create framebuffer
+    //> the depth view is shared with the swap chain framebuffers, only one of them is drawn per frame
+    VkImageView framebufferViews[2] = {sceneView, depthView};
+
+    VkFramebufferCreateInfo framebufferInfo{};
+    framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    framebufferInfo.renderPass = vkSceneRenderPass;
+    framebufferInfo.attachmentCount = 2;
+    framebufferInfo.pAttachments = framebufferViews;
+    framebufferInfo.width = targetExtent.width;
+    framebufferInfo.height = targetExtent.height;
+    framebufferInfo.layers = 1;
+
+    if (vkCreateFramebuffer(vkDevice, &framebufferInfo, vkAllocator, &vkSceneFramebuffer) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create dynamic resolution scene framebuffer!");
+        return false;
+    }
+    return true;
+}
+
+bool DynamicResolution::createUpscalePass(VkFormat format, const std::vector<VkImageView>& outputViews)
+{
+    // create render pass
+    //> the previous content is fully overwritten
+    VkAttachmentDescription colorAttachment{};
+    colorAttachment.format = format;
+    colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+    VkAttachmentReference colorAttachmentRef{0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+
+    VkSubpassDescription subpass{};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &colorAttachmentRef;
+
+    //> waits for the swap chain image like the regular pass
+    VkSubpassDependency dependency{};
+    dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependency.dstSubpass = 0;
+    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependency.srcAccessMask = 0;
+    dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+    VkRenderPassCreateInfo renderPassInfo{};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    renderPassInfo.attachmentCount = 1;
+    renderPassInfo.pAttachments = &colorAttachment;
+    renderPassInfo.subpassCount = 1;
+    renderPassInfo.pSubpasses = &subpass;
+    renderPassInfo.dependencyCount = 1;
+    renderPassInfo.pDependencies = &dependency;
+
+    if (vkCreateRenderPass(vkDevice, &renderPassInfo, vkAllocator, &vkUpscaleRenderPass) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create upscale render pass!");
+        return false;
+    }
+
+    // create framebuffers
+    //> one per swap chain image
+    upscaleFramebuffers.resize(outputViews.size(), VK_NULL_HANDLE);
+    for (size_t i = 0; i < outputViews.size(); ++i)
+    {
+        VkFramebufferCreateInfo framebufferInfo{};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = vkUpscaleRenderPass;
+        framebufferInfo.attachmentCount = 1;
+        framebufferInfo.pAttachments = &outputViews[i];
+        framebufferInfo.width = outputExtent.width;
+        framebufferInfo.height = outputExtent.height;
+        framebufferInfo.layers = 1;
+
+        if (vkCreateFramebuffer(vkDevice, &framebufferInfo, vkAllocator, &upscaleFramebuffers[i]) != VK_SUCCESS)
+        {
+            ARCTIC_LOG_ERROR(Vulkan, "failed to create upscale framebuffer!");
+            return false;
+        }
+    }
+
+    // create sampler
+    //> bilinear, clamped so the edge of the render area does not wrap
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_LINEAR;
+    samplerInfo.minFilter = VK_FILTER_LINEAR;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.maxLod = 0.0f;
+
+    if (vkCreateSampler(vkDevice, &samplerInfo, vkAllocator, &vkSampler) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create upscale sampler!");
+        return false;
+    }
+    return true;
+}
+
+bool DynamicResolution::createUpscalePipeline()
+{
+    // create set layout
+    VkDescriptorSetLayoutBinding binding{0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr};
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.bindingCount = 1;
+    setLayoutInfo.pBindings = &binding;
+
+    if (vkCreateDescriptorSetLayout(vkDevice, &setLayoutInfo, vkAllocator, &vkDescriptorSetLayout) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create upscale set layout!");
+        return false;
+    }
+
+    // create pipeline layout
+    VkPushConstantRange pushConstantRange{VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(UpscaleConstants)};
+
+    VkPipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &vkDescriptorSetLayout;
+    layoutInfo.pushConstantRangeCount = 1;
+    layoutInfo.pPushConstantRanges = &pushConstantRange;
+
+    if (vkCreatePipelineLayout(vkDevice, &layoutInfo, vkAllocator, &vkPipelineLayout) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create upscale pipeline layout!");
+        return false;
+    }
+
+    // create shader modules
+    VkShaderModule vertexModule = VK_NULL_HANDLE;
+    VkShaderModule fragmentModule = VK_NULL_HANDLE;
+    if (!VulkanUtility::CreateShaderModule(vkDevice, vkAllocator, "upscale.vert.spv", vertexModule) ||
+        !VulkanUtility::CreateShaderModule(vkDevice, vkAllocator, "upscale.frag.spv", fragmentModule))
+    {
+        vkDestroyShaderModule(vkDevice, vertexModule, vkAllocator);
+        return false;
+    }
+
+    VkPipelineShaderStageCreateInfo stages[2] = {};
+    stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = vertexModule;
+    stages[0].pName = "main";
+    stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = fragmentModule;
+    stages[1].pName = "main";
+
+    // fixed function state
+    //> fullscreen triangle generated in the vertex shader, no vertex input, no blending
+    VkDynamicState dynamicStates[2] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = 2;
+    dynamicState.pDynamicStates = dynamicStates;
+
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewportState{};
+    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.cullMode = VK_CULL_MODE_NONE;
+    rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
+    rasterizer.lineWidth = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo multisampling{};
+    multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+    VkPipelineColorBlendStateCreateInfo colorBlending{};
+    colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlending.attachmentCount = 1;
+    colorBlending.pAttachments = &colorBlendAttachment;
+
+    // create pipeline
+    VkGraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount = 2;
+    pipelineInfo.pStages = stages;
+    pipelineInfo.pVertexInputState = &vertexInputInfo;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState = &multisampling;
+    pipelineInfo.pColorBlendState = &colorBlending;
+    pipelineInfo.pDynamicState = &dynamicState;
+    pipelineInfo.layout = vkPipelineLayout;
+    pipelineInfo.renderPass = vkUpscaleRenderPass;
+    pipelineInfo.subpass = 0;
+
+    VkResult result = vkCreateGraphicsPipelines(vkDevice, VK_NULL_HANDLE, 1, &pipelineInfo, vkAllocator, &vkPipeline);
+
+    // cleanup shaders
+    vkDestroyShaderModule(vkDevice, vertexModule, vkAllocator);
+    vkDestroyShaderModule(vkDevice, fragmentModule, vkAllocator);
+
+    if (result != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create upscale pipeline!");
+        return false;
+    }
+    return true;
+}
+
+bool DynamicResolution::createDescriptorSet()
+{
+    // create descriptor pool
+    VkDescriptorPoolSize poolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1};
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+
+    if (vkCreateDescriptorPool(vkDevice, &poolInfo, vkAllocator, &vkDescriptorPool) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create upscale descriptor pool!");
+        return false;
+    }
+
+    // allocate set
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = vkDescriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &vkDescriptorSetLayout;
+
+    if (vkAllocateDescriptorSets(vkDevice, &allocInfo, &vkDescriptorSet) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to allocate upscale descriptor set!");
+        return false;
+    }
+
+    // write set
+    VkDescriptorImageInfo imageInfo{vkSampler, sceneView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = vkDescriptorSet;
+    write.dstBinding = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+    vkUpdateDescriptorSets(vkDevice, 1, &write, 0, nullptr);
+
+    return true;
+}
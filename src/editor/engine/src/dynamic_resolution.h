@@ -0,0 +1,157 @@
+#ifndef ARCTIC_DYNAMIC_RESOLUTION_H
+#define ARCTIC_DYNAMIC_RESOLUTION_H
+
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+// dynamic resolution scaling
+//> the scene renders into the top left corner of an offscreen target allocated at the largest scale,
+//> so changing the resolution is a viewport change and never re-creates resources
+//> an upscale pass then samples that corner onto the swap chain image
+//> the scale is driven by the gpu time of the previous frame (timestamps around the whole frame):
+//> - over budget: drop to the estimated scale at once, so spikes cost resolution instead of frames
+//> - under budget: recover in small steps after a few calm frames, so the scale does not oscillate
+class DynamicResolution
+{
+public:
+    static constexpr float MIN_SCALE = 0.5f;
+    static constexpr float MAX_SCALE = 1.0f;
+    static constexpr float SCALE_STEP = 1.0f / 64.0f; // scales are quantized, small jitter keeps the extent
+    static constexpr float INCREASE_STEP = 0.02f; // max increase per frame
+    static constexpr float INCREASE_THRESHOLD = 0.85f; // of the budget, the gpu time must be below to increase
+    static constexpr uint32_t INCREASE_DELAY = 8; // frames below the threshold before increasing
+    static constexpr float TIME_SMOOTHING = 0.2f; // weight of the newest frame in the averaged gpu time
+
+    enum class UpscaleFilter : uint32_t
+    {
+        Bilinear = 0,
+        Sharpen = 1 // bilinear followed by a contrast adaptive sharpen, recovers some of the lost detail
+    };
+
+    struct Stats
+    {
+        float scale;
+        VkExtent2D renderExtent;
+        VkExtent2D outputExtent;
+        float gpuTime; // ms, last frame
+        float averageGpuTime; // ms
+        float targetGpuTime; // ms
+        uint32_t decreaseCount; // scale drops
+        uint32_t increaseCount; // scale recoveries
+    };
+
+    // renders into 'outputViews' (the swap chain), the scene render pass is compatible with one that
+    //> draws a single 'format' color attachment & the scene depth attachment, so existing pipelines can be used in it
+    //> 'depthView' must cover the output extent
+    bool Initialize(VkPhysicalDevice physicalDevice,
+                    VkDevice device,
+                    const VkAllocationCallbacks* allocator,
+                    VkExtent2D outputExtent,
+                    VkFormat format,
+                    VkFormat depthFormat,
+                    VkImageView depthView,
+                    const std::vector<VkImageView>& outputViews,
+                    float targetGpuTime);
+    void Cleanup();
+
+    void SetTargetGpuTime(float milliseconds) {
+        targetGpuTime = milliseconds;
+    }
+    void SetFilter(UpscaleFilter upscaleFilter, float upscaleSharpness) {
+        filter = upscaleFilter;
+        sharpness = upscaleSharpness;
+    }
+
+    // reads the gpu time of the previous frame & picks the render extent, starts timing this frame
+    //> must be recorded first, after the previous frame completed
+    void BeginFrame(VkCommandBuffer commandBuffer);
+    // upscales the scene to the output image & ends timing, recorded last
+    void RecordUpscale(VkCommandBuffer commandBuffer, uint32_t outputIndex);
+
+    // the scene is drawn with these, render area & viewport limited to the render extent
+    VkRenderPass GetSceneRenderPass() const {
+        return vkSceneRenderPass;
+    }
+    //> continues the scene pass in the same frame, e.g. for the draws of the second occlusion culling phase
+    VkRenderPass GetSceneLoadRenderPass() const {
+        return vkSceneLoadRenderPass;
+    }
+    VkFramebuffer GetSceneFramebuffer() const {
+        return vkSceneFramebuffer;
+    }
+    VkExtent2D GetRenderExtent() const {
+        return renderExtent;
+    }
+
+    // controller step, needs no device
+    //> returns the scale for the next frame
+    float UpdateScale(float frameGpuTime);
+
+    Stats GetStats() const;
+    void PrintStats() const;
+
+private:
+    // matches 'Constants' in upscale.frag
+    struct UpscaleConstants
+    {
+        float uvScale[2]; // render extent / target extent
+        float texelSize[2]; // 1 / target extent
+        float sharpness;
+        uint32_t filter;
+    };
+
+    VkPhysicalDevice vkPhysicalDevice = VK_NULL_HANDLE;
+    VkDevice vkDevice = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* vkAllocator = nullptr;
+
+    // controller
+    float targetGpuTime = 16.0f;
+    float scale = MAX_SCALE;
+    float gpuTime = 0.0f;
+    float averageGpuTime = 0.0f;
+    uint32_t calmFrameCount = 0;
+    uint32_t decreaseCount = 0;
+    uint32_t increaseCount = 0;
+
+    // extents
+    VkExtent2D outputExtent{};
+    VkExtent2D targetExtent{}; // output extent at max scale
+    VkExtent2D renderExtent{};
+
+    // timing
+    //> without timestamp support the scale stays at max
+    bool isTimingSupported = false;
+    bool isTimingPending = false; // timestamps of the previous frame are written
+    double timestampPeriod = 1.0; // nanoseconds per tick
+    VkQueryPool vkQueryPool = VK_NULL_HANDLE;
+
+    // scene target
+    VkImage sceneImage = VK_NULL_HANDLE;
+    VkDeviceMemory sceneMemory = VK_NULL_HANDLE;
+    VkImageView sceneView = VK_NULL_HANDLE;
+    VkRenderPass vkSceneRenderPass = VK_NULL_HANDLE;
+    VkRenderPass vkSceneLoadRenderPass = VK_NULL_HANDLE;
+    VkFramebuffer vkSceneFramebuffer = VK_NULL_HANDLE;
+
+    // upscale
+    UpscaleFilter filter = UpscaleFilter::Sharpen;
+    float sharpness = 0.5f;
+    VkRenderPass vkUpscaleRenderPass = VK_NULL_HANDLE;
+    std::vector<VkFramebuffer> upscaleFramebuffers;
+    VkSampler vkSampler = VK_NULL_HANDLE;
+    VkDescriptorSetLayout vkDescriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool vkDescriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet vkDescriptorSet = VK_NULL_HANDLE;
+    VkPipelineLayout vkPipelineLayout = VK_NULL_HANDLE;
+    VkPipeline vkPipeline = VK_NULL_HANDLE;
+
+    bool createTiming();
+    bool createSceneTarget(VkFormat format, VkFormat depthFormat, VkImageView depthView);
+    bool createUpscalePass(VkFormat format, const std::vector<VkImageView>& outputViews);
+    bool createUpscalePipeline();
+    bool createDescriptorSet();
+    void updateRenderExtent();
+};
+
+#endif //ARCTIC_DYNAMIC_RESOLUTION_H
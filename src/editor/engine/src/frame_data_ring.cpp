@@ -0,0 +1,220 @@
+#include "frame_data_ring.h"
+#include "utilities/logger.h"
+#include <algorithm>
+#include <format>
+#include <iostream>
+
+bool FrameDataRing::Initialize(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        const VkAllocationCallbacks* allocator,
+        GpuResources& resources,
+        DeletionQueue& deletions,
+        VkDeviceSize ringCapacity)
+{
+    vkDevice = device;
+    vkAllocator = allocator;
+    gpuResources = &resources;
+    deletionQueue = &deletions;
+
+    // dynamic offsets must be a multiple of the device's uniform alignment
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    uniformAlignment = static_cast<uint32_t>(std::max<VkDeviceSize>(properties.limits.minUniformBufferOffsetAlignment, 1));
+
+    // create ring
+    //> host visible & coherent, written straight from the command stream
+    capacity = ringCapacity;
+    buffer = gpuResources->CreateBuffer(capacity,
+                                        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (!buffer)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create frame data ring!");
+        return false;
+    }
+    mapped = static_cast<uint8_t*>(gpuResources->Get(buffer)->mapped);
+    stats.capacity = capacity;
+
+    return createDescriptorSet();
+}
+
+void FrameDataRing::Cleanup()
+{
+    if (vkDevice == VK_NULL_HANDLE)
+        return;
+
+    // buffer
+    //> the handle is null when initialization failed part way
+    if (buffer)
+        gpuResources->Destroy(buffer);
+    buffer = {};
+    mapped = nullptr;
+
+    // set
+    if (vkDescriptorPool != VK_NULL_HANDLE)
+        deletionQueue->Push(vkDescriptorPool);
+    vkDestroyDescriptorSetLayout(vkDevice, vkDescriptorSetLayout, vkAllocator);
+    vkDescriptorPool = VK_NULL_HANDLE;
+    vkDescriptorSetLayout = VK_NULL_HANDLE;
+    vkDescriptorSet = VK_NULL_HANDLE;
+
+    head = tail = 0;
+    frameMarks.clear();
+}
+
+void FrameDataRing::BeginFrame(uint64_t frame, uint64_t completedFrame)
+{
+    // close the previous frame
+    if (frame != currentFrame)
+        frameMarks.push_back({currentFrame, head});
+    currentFrame = frame;
+
+    // release completed frames
+    while (!frameMarks.empty() && frameMarks.front().frame <= completedFrame)
+    {
+        tail = frameMarks.front().end;
+        frameMarks.pop_front();
+    }
+
+    // reset stats
+    stats.frameBytes = 0;
+    stats.inFlightBytes = head - tail;
+    stats.allocationCount = 0;
+    stats.overflowCount = 0;
+}
+
+bool FrameDataRing::Allocate(uint32_t size, uint32_t alignment, Allocation& allocation)
+{
+    // align
+    //> an allocation never wraps, the rest of the ring is skipped & it starts over at zero
+    alignment = std::max(alignment, 1u);
+    const VkDeviceSize position = head % capacity;
+    VkDeviceSize offset = (position + alignment - 1) / alignment * alignment;
+    VkDeviceSize padding = offset - position;
+    if (offset + size > capacity)
+    {
+        offset = 0;
+        padding = capacity - position;
+    }
+    const VkDeviceSize required = padding + size;
+
+    // check space
+    //> the tail is the end of the oldest frame in flight
+    if (size > capacity || head - tail + required > capacity)
+    {
+        if (stats.overflowCount++ == 0)
+            ARCTIC_LOG_ERROR(Vulkan, "frame data ring overflow, {} bytes requested with {} of {} in flight!", size, head - tail, capacity);
+        ++stats.totalOverflowCount;
+        return false;
+    }
+
+    head += required;
+    allocation.offset = static_cast<uint32_t>(offset);
+    allocation.data = mapped + allocation.offset;
+
+    // stats
+    stats.frameBytes += required;
+    stats.inFlightBytes = head - tail;
+    stats.highWaterBytes = std::max(stats.highWaterBytes, stats.inFlightBytes);
+    ++stats.allocationCount;
+    return true;
+}
+
+bool FrameDataRing::AllocateView(uint32_t size, Allocation& allocation)
+{
+    //> the full binding range is reserved, the shader may read all of it
+    return size <= VIEW_CONSTANTS_SIZE && Allocate(VIEW_CONSTANTS_SIZE, uniformAlignment, allocation);
+}
+
+bool FrameDataRing::AllocateDraws(uint32_t count, uint32_t stride, Allocation& allocation, uint32_t& firstDraw)
+{
+    //> aligned to the stride, so the offset is a whole index into the storage binding
+    if (count == 0 || stride == 0 || !Allocate(count * stride, stride, allocation))
+        return false;
+    firstDraw = allocation.offset / stride;
+    return true;
+}
+
+void FrameDataRing::PrintStats() const
+{
+    std::cout << "info: vulkan: frame data:" << std::endl;
+    std::cout << std::format("\tframe {} KB in {} allocations, in flight {} KB, high water {} KB of {} KB, overflows {} (total {})",
+                             stats.frameBytes / 1024,
+                             stats.allocationCount,
+                             stats.inFlightBytes / 1024,
+                             stats.highWaterBytes / 1024,
+                             stats.capacity / 1024,
+                             stats.overflowCount,
+                             stats.totalOverflowCount) << std::endl;
+}
+
+bool FrameDataRing::createDescriptorSet()
+{
+    // create set layout
+    const VkShaderStageFlags stages = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    VkDescriptorSetLayoutBinding bindings[2] = {};
+    bindings[0] = {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1, stages, nullptr};
+    bindings[1] = {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stages, nullptr};
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.bindingCount = 2;
+    setLayoutInfo.pBindings = bindings;
+
+    if (vkCreateDescriptorSetLayout(vkDevice, &setLayoutInfo, vkAllocator, &vkDescriptorSetLayout) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create frame data set layout!");
+        return false;
+    }
+
+    // create descriptor pool
+    VkDescriptorPoolSize poolSizes[2] = {};
+    poolSizes[0] = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1};
+    poolSizes[1] = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1};
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = 2;
+    poolInfo.pPoolSizes = poolSizes;
+
+    if (vkCreateDescriptorPool(vkDevice, &poolInfo, vkAllocator, &vkDescriptorPool) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create frame data descriptor pool!");
+        return false;
+    }
+
+    // allocate set
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = vkDescriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &vkDescriptorSetLayout;
+
+    if (vkAllocateDescriptorSets(vkDevice, &allocInfo, &vkDescriptorSet) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to allocate frame data descriptor set!");
+        return false;
+    }
+
+    // write ring
+    //> written once, views only change the dynamic offset
+    VkBuffer ringBuffer = gpuResources->Get(buffer)->buffer;
+    VkDescriptorBufferInfo bufferInfos[2] = {};
+    bufferInfos[0] = {ringBuffer, 0, VIEW_CONSTANTS_SIZE};
+    bufferInfos[1] = {ringBuffer, 0, VK_WHOLE_SIZE};
+
+    VkWriteDescriptorSet writes[2] = {};
+    for (uint32_t binding = 0; binding < 2; ++binding)
+    {
+        writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[binding].dstSet = vkDescriptorSet;
+        writes[binding].dstBinding = binding;
+        writes[binding].descriptorCount = 1;
+        writes[binding].descriptorType = bindings[binding].descriptorType;
+        writes[binding].pBufferInfo = &bufferInfos[binding];
+    }
+    vkUpdateDescriptorSets(vkDevice, 2, writes, 0, nullptr);
+    return true;
+}
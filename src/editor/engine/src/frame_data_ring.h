@@ -0,0 +1,121 @@
+#ifndef ARCTIC_FRAME_DATA_RING_H
+#define ARCTIC_FRAME_DATA_RING_H
+
+#include <cstdint>
+#include <deque>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan_core.h>
+#include "gpu_resources.h"
+
+// matches 'ViewConstants' in first_shader.vert
+struct ViewConstants
+{
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProjection;
+};
+
+// matches 'DrawConstants' in first_shader.vert
+struct DrawConstants
+{
+    glm::mat4 world;
+    glm::vec4 color;
+};
+
+// per-frame constants of views & draws in one persistently mapped ring buffer
+//> the gpu reads them through a single descriptor set, written once on creation:
+//> binding 0: view constants, uniform buffer addressed by a dynamic offset per view
+//> binding 1: draw constants, the whole ring as storage buffer, indexed by a push constant base + the instance index
+//> so thousands of draws per frame need no descriptor writes, only a bind per view & a push per batch
+//> frames are tagged like the deletion queue, their part of the ring is reused once the gpu completed them
+//> main thread only
+class FrameDataRing
+{
+public:
+    static constexpr VkDeviceSize DEFAULT_CAPACITY = 4u << 20; // bytes
+    static constexpr uint32_t VIEW_CONSTANTS_SIZE = 256; // bytes, range of the dynamic uniform binding
+
+    static_assert(sizeof(ViewConstants) <= VIEW_CONSTANTS_SIZE);
+    static_assert(sizeof(DrawConstants) % 16 == 0); // std430 array stride
+
+    struct Allocation
+    {
+        uint32_t offset; // bytes, into the ring
+        void* data; // mapped
+    };
+
+    struct Stats
+    {
+        VkDeviceSize capacity;
+        VkDeviceSize frameBytes; // allocated by the current frame
+        VkDeviceSize inFlightBytes; // current & uncompleted frames, including alignment & wrap padding
+        VkDeviceSize highWaterBytes; // peak of 'inFlightBytes'
+        uint32_t allocationCount; // current frame
+        uint32_t overflowCount; // current frame, allocations that did not fit
+        uint64_t totalOverflowCount;
+    };
+
+    bool Initialize(VkPhysicalDevice physicalDevice,
+                    VkDevice device,
+                    const VkAllocationCallbacks* allocator,
+                    GpuResources& gpuResources,
+                    DeletionQueue& deletionQueue,
+                    VkDeviceSize capacity = DEFAULT_CAPACITY);
+    void Cleanup();
+
+    // tags the following allocations with 'frame' & reuses the space of 'completedFrame' and earlier
+    void BeginFrame(uint64_t frame, uint64_t completedFrame);
+
+    // false on overflow, the ring is full up to the oldest frame in flight
+    //> 'alignment' does not need to be a power of two, any offset that is a multiple of it is returned
+    bool Allocate(uint32_t size, uint32_t alignment, Allocation& allocation);
+    // view constants, bound with 'allocation.offset' as dynamic offset
+    bool AllocateView(uint32_t size, Allocation& allocation);
+    // 'count' draw constants of 'stride' bytes, 'firstDraw' is the index of the first one in the storage binding
+    bool AllocateDraws(uint32_t count, uint32_t stride, Allocation& allocation, uint32_t& firstDraw);
+
+    VkDescriptorSetLayout GetDescriptorSetLayout() const {
+        return vkDescriptorSetLayout;
+    }
+    VkDescriptorSet GetDescriptorSet() const {
+        return vkDescriptorSet;
+    }
+
+    const Stats& GetStats() const {
+        return stats;
+    }
+    void PrintStats() const;
+
+private:
+    // ring position after the last allocation of a frame
+    struct FrameMark
+    {
+        uint64_t frame;
+        uint64_t end;
+    };
+
+    VkDevice vkDevice = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* vkAllocator = nullptr;
+    GpuResources* gpuResources = nullptr;
+    DeletionQueue* deletionQueue = nullptr;
+
+    BufferHandle buffer;
+    uint8_t* mapped = nullptr;
+    VkDeviceSize capacity = 0;
+    uint32_t uniformAlignment = 1; // dynamic uniform offsets
+
+    //> head & tail count bytes since creation, the ring offset is the remainder by the capacity
+    uint64_t head = 0;
+    uint64_t tail = 0;
+    uint64_t currentFrame = 0;
+    std::deque<FrameMark> frameMarks; // uncompleted frames, oldest first
+    Stats stats{};
+
+    VkDescriptorSetLayout vkDescriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool vkDescriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet vkDescriptorSet = VK_NULL_HANDLE;
+
+    bool createDescriptorSet();
+};
+
+#endif //ARCTIC_FRAME_DATA_RING_H
@@ -0,0 +1,153 @@
+#include "gpu_resources.h"
+#include "vulkan_utility.h"
+#include "utilities/logger.h"
+#include <format>
+#include <iostream>
+
+void GpuResources::Initialize(VkPhysicalDevice physicalDevice,
+                              VkDevice device,
+                              const VkAllocationCallbacks* allocator,
+                              DeletionQueue& deletions)
+{
+    vkPhysicalDevice = physicalDevice;
+    vkDevice = device;
+    vkAllocator = allocator;
+    deletionQueue = &deletions;
+}
+
+void GpuResources::Cleanup()
+{
+    if (vkDevice == VK_NULL_HANDLE)
+        return;
+
+    for (const auto& buffer : buffers.GetObjects())
+        queueDeletion(buffer);
+    for (const auto& image : images.GetObjects())
+        queueDeletion(image);
+
+    buffers.Clear();
+    images.Clear();
+    bufferBytes = 0;
+}
+
+#pragma region gpu_resources_create
+
+BufferHandle GpuResources::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties)
+{
+    GpuBuffer buffer{};
+    if (!VulkanUtility::CreateBuffer(vkPhysicalDevice, vkDevice, vkAllocator, size, usage, properties, buffer.buffer, buffer.memory))
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create buffer of {} bytes!", size);
+        return {};
+    }
+
+    // map host visible memory for the lifetime of the buffer
+    if ((properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0 &&
+        vkMapMemory(vkDevice, buffer.memory, 0, size, 0, &buffer.mapped) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to map buffer memory!");
+        vkDestroyBuffer(vkDevice, buffer.buffer, vkAllocator);
+        vkFreeMemory(vkDevice, buffer.memory, vkAllocator);
+        return {};
+    }
+
+    BufferHandle handle = buffers.Add(buffer, {size, usage, properties});
+    if (!handle)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "buffer pool is full!");
+        queueDeletion(buffer);
+        return {};
+    }
+    bufferBytes += size;
+    return handle;
+}
+
+ImageHandle GpuResources::CreateImage(VkExtent2D extent, VkFormat format, VkImageUsageFlags usage, VkImageAspectFlags aspectMask)
+{
+    GpuImage image{};
+    if (!VulkanUtility::CreateImage(vkPhysicalDevice, vkDevice, vkAllocator, extent, 1, format, usage, image.image, image.memory))
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create image of {}x{}!", extent.width, extent.height);
+        return {};
+    }
+    if (!VulkanUtility::CreateImageView(vkDevice, vkAllocator, image.image, format, aspectMask, 0, 1, image.view))
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create image view!");
+        vkDestroyImage(vkDevice, image.image, vkAllocator);
+        vkFreeMemory(vkDevice, image.memory, vkAllocator);
+        return {};
+    }
+
+    ImageHandle handle = images.Add(image, {extent, format, usage});
+    if (!handle)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "image pool is full!");
+        queueDeletion(image);
+    }
+    return handle;
+}
+
+#pragma endregion gpu_resources_create
+
+#pragma region gpu_resources_destroy
+
+void GpuResources::Destroy(BufferHandle handle)
+{
+    GpuBuffer buffer;
+    VkDeviceSize size = buffers.IsValid(handle) ? buffers.GetMetadata(handle)->size : 0;
+    if (!buffers.Remove(handle, buffer))
+    {
+        ++staleHandleCount;
+        return;
+    }
+    bufferBytes -= size;
+    queueDeletion(buffer);
+}
+
+void GpuResources::Destroy(ImageHandle handle)
+{
+    GpuImage image;
+    if (!images.Remove(handle, image))
+    {
+        ++staleHandleCount;
+        return;
+    }
+    queueDeletion(image);
+}
+
+void GpuResources::queueDeletion(const GpuBuffer& buffer)
+{
+    //> freeing the memory unmaps it
+    deletionQueue->Push(buffer.buffer);
+    deletionQueue->Push(buffer.memory);
+}
+
+void GpuResources::queueDeletion(const GpuImage& image)
+{
+    deletionQueue->Push(image.view);
+    deletionQueue->Push(image.image);
+    deletionQueue->Push(image.memory);
+}
+
+#pragma endregion gpu_resources_destroy
+
+GpuResources::Stats GpuResources::GetStats() const
+{
+    Stats stats{};
+    stats.bufferCount = buffers.GetCount();
+    stats.imageCount = images.GetCount();
+    stats.bufferBytes = bufferBytes;
+    stats.staleHandleCount = staleHandleCount;
+    return stats;
+}
+
+void GpuResources::PrintStats() const
+{
+    Stats stats = GetStats();
+    std::cout << "info: vulkan: gpu resources:" << std::endl;
+    std::cout << std::format("\tbuffers {} ({} KB), images {}, stale destroys {}",
+                             stats.bufferCount,
+                             stats.bufferBytes / 1024,
+                             stats.imageCount,
+                             stats.staleHandleCount) << std::endl;
+}
@@ -0,0 +1,106 @@
+#ifndef ARCTIC_GPU_RESOURCES_H
+#define ARCTIC_GPU_RESOURCES_H
+
+#include <cstdint>
+#include <vulkan/vulkan_core.h>
+#include "utilities/handle_pool.h"
+#include "deletion_queue.h"
+
+// hot data, read when recording commands
+struct GpuBuffer
+{
+    VkBuffer buffer;
+    VkDeviceMemory memory;
+    void* mapped; // host visible buffers only
+};
+
+struct GpuImage
+{
+    VkImage image;
+    VkImageView view;
+    VkDeviceMemory memory;
+};
+
+// metadata, kept out of band
+struct GpuBufferInfo
+{
+    VkDeviceSize size;
+    VkBufferUsageFlags usage;
+    VkMemoryPropertyFlags properties;
+};
+
+struct GpuImageInfo
+{
+    VkExtent2D extent;
+    VkFormat format;
+    VkImageUsageFlags usage;
+};
+
+using BufferHandle = Handle<GpuBuffer>;
+using ImageHandle = Handle<GpuImage>;
+
+// owns buffers & images behind 32-bit generational handles
+//> samplers & pipelines stay with the systems that create them, most of those are set up off the main thread
+//> destruction goes through the deletion queue, so a handle can be destroyed while a frame still uses it
+//> main thread only
+class GpuResources
+{
+public:
+    struct Stats
+    {
+        uint32_t bufferCount;
+        uint32_t imageCount;
+        uint64_t bufferBytes;
+        uint32_t staleHandleCount; // destroy calls with stale handles
+    };
+
+    void Initialize(VkPhysicalDevice physicalDevice,
+                    VkDevice device,
+                    const VkAllocationCallbacks* allocator,
+                    DeletionQueue& deletionQueue);
+    // queues everything left for deletion
+    void Cleanup();
+
+    // host visible buffers are mapped persistently
+    BufferHandle CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
+    ImageHandle CreateImage(VkExtent2D extent, VkFormat format, VkImageUsageFlags usage, VkImageAspectFlags aspectMask);
+
+    void Destroy(BufferHandle handle);
+    void Destroy(ImageHandle handle);
+
+    // null for stale handles in debug builds
+    const GpuBuffer* Get(BufferHandle handle) const {
+        return buffers.Get(handle);
+    }
+    const GpuImage* Get(ImageHandle handle) const {
+        return images.Get(handle);
+    }
+
+    const GpuBufferInfo* GetInfo(BufferHandle handle) const {
+        return buffers.GetMetadata(handle);
+    }
+    const GpuImageInfo* GetInfo(ImageHandle handle) const {
+        return images.GetMetadata(handle);
+    }
+
+    Stats GetStats() const;
+    void PrintStats() const;
+
+private:
+    VkPhysicalDevice vkPhysicalDevice = VK_NULL_HANDLE;
+    VkDevice vkDevice = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* vkAllocator = nullptr;
+    DeletionQueue* deletionQueue = nullptr;
+
+    HandlePool<GpuBuffer, GpuBufferInfo> buffers;
+    HandlePool<GpuImage, GpuImageInfo> images;
+
+    // stats
+    uint64_t bufferBytes = 0;
+    uint32_t staleHandleCount = 0;
+
+    void queueDeletion(const GpuBuffer& buffer);
+    void queueDeletion(const GpuImage& image);
+};
+
+#endif //ARCTIC_GPU_RESOURCES_H
@@ -0,0 +1,106 @@
+#include "mesh.h"
+#include "utilities/logger.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    struct MeshHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t lodCount;
+        float boundingSphere[4];
+    };
+}
+
+void MeshData::ComputeBoundingSphere()
+{
+    // center of the bounds, radius to the furthest vertex
+    if (vertices.empty())
+    {
+        boundingSphere = glm::vec4(0.0f);
+        return;
+    }
+
+    glm::vec3 min = vertices[0].position;
+    glm::vec3 max = vertices[0].position;
+    for (const auto& vertex : vertices)
+    {
+        min = glm::min(min, vertex.position);
+        max = glm::max(max, vertex.position);
+    }
+
+    glm::vec3 center = (min + max) * 0.5f;
+    float radius = 0.0f;
+    for (const auto& vertex : vertices)
+        radius = std::max(radius, glm::length(vertex.position - center));
+    boundingSphere = glm::vec4(center, radius);
+}
+
+bool MeshData::Save(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        ARCTIC_LOG_ERROR(Assets, "failed to open {} for writing!", path);
+        return false;
+    }
+
+    MeshHeader header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.vertexCount = static_cast<uint32_t>(vertices.size());
+    header.indexCount = static_cast<uint32_t>(indices.size());
+    header.lodCount = static_cast<uint32_t>(lods.size());
+    std::memcpy(header.boundingSphere, &boundingSphere, sizeof(header.boundingSphere));
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(lods.data()), static_cast<std::streamsize>(lods.size() * sizeof(MeshLod)));
+    file.write(reinterpret_cast<const char*>(vertices.data()), static_cast<std::streamsize>(vertices.size() * sizeof(MeshVertex)));
+    file.write(reinterpret_cast<const char*>(indices.data()), static_cast<std::streamsize>(indices.size() * sizeof(uint32_t)));
+    return file.good();
+}
+
+bool MeshData::Load(const std::vector<char>& file)
+{
+    MeshHeader header{};
+    if (file.size() < sizeof(header))
+        return false;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != MAGIC || header.version != VERSION || header.lodCount == 0 || header.lodCount > MAX_LOD_COUNT)
+        return false;
+
+    const size_t lodSize = header.lodCount * sizeof(MeshLod);
+    const size_t vertexSize = static_cast<size_t>(header.vertexCount) * sizeof(MeshVertex);
+    const size_t indexSize = static_cast<size_t>(header.indexCount) * sizeof(uint32_t);
+    if (file.size() != sizeof(header) + lodSize + vertexSize + indexSize)
+        return false;
+
+    const char* data = file.data() + sizeof(header);
+    lods.resize(header.lodCount);
+    std::memcpy(lods.data(), data, lodSize);
+    data += lodSize;
+    vertices.resize(header.vertexCount);
+    std::memcpy(vertices.data(), data, vertexSize);
+    data += vertexSize;
+    indices.resize(header.indexCount);
+    std::memcpy(indices.data(), data, indexSize);
+    std::memcpy(&boundingSphere, header.boundingSphere, sizeof(header.boundingSphere));
+
+    // validate ranges
+    for (const auto& lod : lods)
+    {
+        if (static_cast<uint64_t>(lod.firstIndex) + lod.indexCount > header.indexCount)
+            return false;
+    }
+    for (uint32_t index : indices)
+    {
+        if (index >= header.vertexCount)
+            return false;
+    }
+    return true;
+}
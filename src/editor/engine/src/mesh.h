@@ -0,0 +1,43 @@
+#ifndef ARCTIC_MESH_H
+#define ARCTIC_MESH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct MeshVertex
+{
+    glm::vec3 position;
+    glm::vec3 normal;
+};
+
+// index range of one level of detail
+//> all levels share the vertices, coarser levels only reference fewer of them
+struct MeshLod
+{
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    float error; // world space deviation from the full detail mesh
+};
+
+// cooked mesh ('.mesh'), produced by 'ArcticCook'
+//> layout: header, lods, vertices, indices (lod 0 first, every lod a contiguous range)
+struct MeshData
+{
+    static constexpr uint32_t MAGIC = 0x48534D41; // "AMSH"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t MAX_LOD_COUNT = 8;
+
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<MeshLod> lods;
+    glm::vec4 boundingSphere{0.0f}; // xyz: center, w: radius
+
+    void ComputeBoundingSphere();
+
+    bool Save(const std::string& path) const;
+    bool Load(const std::vector<char>& file);
+};
+
+#endif //ARCTIC_MESH_H
@@ -0,0 +1,424 @@
+#include "mesh_cooker.h"
+#include "utilities/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace
+{
+    // symmetric 4x4 error quadric of weighted planes
+    //> evaluates to the weighted mean squared distance of a point to the planes
+    struct Quadric
+    {
+        double a2 = 0.0, b2 = 0.0, c2 = 0.0, d2 = 0.0;
+        double ab = 0.0, ac = 0.0, ad = 0.0;
+        double bc = 0.0, bd = 0.0, cd = 0.0;
+        double weight = 0.0;
+
+        static Quadric FromPlane(const glm::vec3& normal, float distance, float planeWeight)
+        {
+            double a = normal.x, b = normal.y, c = normal.z, d = distance, w = planeWeight;
+            Quadric quadric;
+            quadric.a2 = a * a * w; quadric.b2 = b * b * w; quadric.c2 = c * c * w; quadric.d2 = d * d * w;
+            quadric.ab = a * b * w; quadric.ac = a * c * w; quadric.ad = a * d * w;
+            quadric.bc = b * c * w; quadric.bd = b * d * w; quadric.cd = c * d * w;
+            quadric.weight = w;
+            return quadric;
+        }
+
+        void Add(const Quadric& other)
+        {
+            a2 += other.a2; b2 += other.b2; c2 += other.c2; d2 += other.d2;
+            ab += other.ab; ac += other.ac; ad += other.ad;
+            bc += other.bc; bd += other.bd; cd += other.cd;
+            weight += other.weight;
+        }
+
+        double Evaluate(const glm::vec3& point) const
+        {
+            double x = point.x, y = point.y, z = point.z;
+            double error = a2 * x * x + b2 * y * y + c2 * z * z + d2 +
+                           2.0 * (ab * x * y + ac * x * z + bc * y * z + ad * x + bd * y + cd * z);
+            return weight > 0.0 ? std::max(error, 0.0) / weight : 0.0;
+        }
+    };
+
+    struct Collapse
+    {
+        uint32_t from;
+        uint32_t to;
+        double cost;
+    };
+
+    struct PositionHash
+    {
+        size_t operator()(const glm::vec3& position) const
+        {
+            uint32_t bits[3];
+            std::memcpy(bits, &position, sizeof(bits));
+            return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+        }
+    };
+
+    struct PositionEqual
+    {
+        bool operator()(const glm::vec3& a, const glm::vec3& b) const {
+            return std::memcmp(&a, &b, sizeof(glm::vec3)) == 0;
+        }
+    };
+
+    // obj index: 1-based, negative counts from the end
+    bool resolveObjIndex(const std::string& token, size_t count, uint32_t& index)
+    {
+        if (token.empty())
+            return false;
+        long value = std::stol(token);
+        long resolved = value < 0 ? static_cast<long>(count) + value : value - 1;
+        if (resolved < 0 || resolved >= static_cast<long>(count))
+            return false;
+        index = static_cast<uint32_t>(resolved);
+        return true;
+    }
+}
+
+bool MeshCooker::LoadObj(const std::string& path, MeshData& mesh)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        ARCTIC_LOG_ERROR(Cook, "failed to open {}!", path);
+        return false;
+    }
+
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> normals;
+    std::unordered_map<uint64_t, uint32_t> vertexIds; // (position, normal) -> vertex
+    mesh = {};
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream lineStream(line);
+        std::string kind;
+        if (!(lineStream >> kind))
+            continue;
+
+        if (kind == "v")
+        {
+            glm::vec3 position;
+            lineStream >> position.x >> position.y >> position.z;
+            positions.push_back(position);
+        }
+        else if (kind == "vn")
+        {
+            glm::vec3 normal;
+            lineStream >> normal.x >> normal.y >> normal.z;
+            normals.push_back(normal);
+        }
+        else if (kind == "f")
+        {
+            // corners: "v", "v/t", "v//n" or "v/t/n"
+            std::vector<uint32_t> polygon;
+            std::string corner;
+            while (lineStream >> corner)
+            {
+                std::string positionToken = corner.substr(0, corner.find('/'));
+                std::string normalToken;
+                size_t lastSlash = corner.rfind('/');
+                if (lastSlash != std::string::npos && corner.find('/') != lastSlash)
+                    normalToken = corner.substr(lastSlash + 1);
+
+                uint32_t positionIndex;
+                if (!resolveObjIndex(positionToken, positions.size(), positionIndex))
+                {
+                    ARCTIC_LOG_ERROR(Cook, "invalid face in {}!", path);
+                    return false;
+                }
+                uint32_t normalIndex = UINT32_MAX;
+                if (!normalToken.empty() && !resolveObjIndex(normalToken, normals.size(), normalIndex))
+                {
+                    ARCTIC_LOG_ERROR(Cook, "invalid face in {}!", path);
+                    return false;
+                }
+
+                uint64_t key = (static_cast<uint64_t>(positionIndex) << 32) | normalIndex;
+                auto [it, isInserted] = vertexIds.try_emplace(key, static_cast<uint32_t>(mesh.vertices.size()));
+                if (isInserted)
+                    mesh.vertices.push_back({positions[positionIndex], normalIndex != UINT32_MAX ? normals[normalIndex] : glm::vec3(0.0f)});
+                polygon.push_back(it->second);
+            }
+
+            for (size_t i = 2; i < polygon.size(); ++i)
+            {
+                mesh.indices.push_back(polygon[0]);
+                mesh.indices.push_back(polygon[i - 1]);
+                mesh.indices.push_back(polygon[i]);
+            }
+        }
+    }
+
+    if (mesh.indices.empty())
+    {
+        ARCTIC_LOG_ERROR(Cook, "{} has no faces!", path);
+        return false;
+    }
+
+    // generate missing normals
+    //> area weighted face normals, accumulated per vertex
+    if (normals.empty())
+    {
+        for (size_t i = 0; i < mesh.indices.size(); i += 3)
+        {
+            MeshVertex& a = mesh.vertices[mesh.indices[i + 0]];
+            MeshVertex& b = mesh.vertices[mesh.indices[i + 1]];
+            MeshVertex& c = mesh.vertices[mesh.indices[i + 2]];
+            glm::vec3 faceNormal = glm::cross(b.position - a.position, c.position - a.position);
+            a.normal += faceNormal;
+            b.normal += faceNormal;
+            c.normal += faceNormal;
+        }
+        for (auto& vertex : mesh.vertices)
+        {
+            float length = glm::length(vertex.normal);
+            vertex.normal = length > 0.0f ? vertex.normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+    }
+
+    mesh.lods = {{0, static_cast<uint32_t>(mesh.indices.size()), 0.0f}};
+    mesh.ComputeBoundingSphere();
+    return true;
+}
+
+void MeshCooker::GenerateLods(MeshData& mesh, const LodSettings& settings)
+{
+    if (mesh.indices.empty())
+        return;
+
+    // keep lod 0 only
+    if (!mesh.lods.empty())
+    {
+        const MeshLod& lod0 = mesh.lods[0];
+        mesh.indices = std::vector<uint32_t>(mesh.indices.begin() + lod0.firstIndex,
+                                             mesh.indices.begin() + lod0.firstIndex + lod0.indexCount);
+    }
+    mesh.lods = {{0, static_cast<uint32_t>(mesh.indices.size()), 0.0f}};
+    mesh.ComputeBoundingSphere();
+
+    // simplify each lod from the previous one
+    //> errors add up along the chain, each step gets the budget left
+    const float maxError = settings.maxError * mesh.boundingSphere.w;
+    const uint32_t maxLodCount = std::min(settings.maxLodCount, MeshData::MAX_LOD_COUNT);
+    std::vector<uint32_t> current = mesh.indices;
+    float error = 0.0f;
+    while (mesh.lods.size() < maxLodCount && error < maxError)
+    {
+        auto targetIndexCount = static_cast<uint32_t>(static_cast<float>(current.size()) * settings.reduction) / 3 * 3;
+        if (targetIndexCount < 3)
+            break;
+
+        float stepError = 0.0f;
+        std::vector<uint32_t> simplified = Simplify(mesh.vertices, current, targetIndexCount, maxError - error, stepError);
+        if (simplified.empty() || static_cast<float>(simplified.size()) > static_cast<float>(current.size()) * settings.minReduction)
+            break;
+
+        error += stepError;
+        mesh.lods.push_back({static_cast<uint32_t>(mesh.indices.size()), static_cast<uint32_t>(simplified.size()), error});
+        mesh.indices.insert(mesh.indices.end(), simplified.begin(), simplified.end());
+        current = std::move(simplified);
+    }
+}
+
+std::vector<uint32_t> MeshCooker::Simplify(
+        const std::vector<MeshVertex>& vertices,
+        const std::vector<uint32_t>& indices,
+        uint32_t targetIndexCount,
+        float maxError,
+        float& error)
+{
+    const auto vertexCount = static_cast<uint32_t>(vertices.size());
+    std::vector<uint32_t> result = indices;
+    error = 0.0f;
+
+    // weld positions
+    //> vertices sharing a position with different attributes form a seam
+    std::unordered_map<glm::vec3, uint32_t, PositionHash, PositionEqual> positionIds;
+    std::vector<uint32_t> positionOf(vertexCount);
+    std::vector<uint32_t> positionUseCount;
+    for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+    {
+        auto [it, isInserted] = positionIds.try_emplace(vertices[vertex].position, static_cast<uint32_t>(positionUseCount.size()));
+        if (isInserted)
+            positionUseCount.push_back(0);
+        positionOf[vertex] = it->second;
+        ++positionUseCount[it->second];
+    }
+
+    // lock seams & borders
+    //> border edges (one triangle) are found on welded positions, so seams are not mistaken for borders
+    std::vector<uint8_t> isLocked(vertexCount, 0);
+    std::unordered_map<uint64_t, uint32_t> edgeUseCount;
+    for (size_t i = 0; i < result.size(); i += 3)
+    {
+        for (int edge = 0; edge < 3; ++edge)
+        {
+            uint32_t a = positionOf[result[i + edge]];
+            uint32_t b = positionOf[result[i + (edge + 1) % 3]];
+            ++edgeUseCount[(static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b)];
+        }
+    }
+    std::vector<uint8_t> isBorderPosition(positionUseCount.size(), 0);
+    for (const auto& [edge, count] : edgeUseCount)
+    {
+        if (count == 1)
+        {
+            isBorderPosition[edge >> 32] = 1;
+            isBorderPosition[edge & 0xFFFFFFFFu] = 1;
+        }
+    }
+    for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+        isLocked[vertex] = positionUseCount[positionOf[vertex]] > 1 || isBorderPosition[positionOf[vertex]];
+
+    // quadrics
+    //> planes weighted by triangle area
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0; i < result.size(); i += 3)
+    {
+        const glm::vec3& a = vertices[result[i + 0]].position;
+        const glm::vec3& b = vertices[result[i + 1]].position;
+        const glm::vec3& c = vertices[result[i + 2]].position;
+        glm::vec3 normal = glm::cross(b - a, c - a);
+        float area = glm::length(normal);
+        if (area <= 0.0f)
+            continue;
+        normal /= area;
+
+        Quadric quadric = Quadric::FromPlane(normal, -glm::dot(normal, a), area * 0.5f);
+        quadrics[result[i + 0]].Add(quadric);
+        quadrics[result[i + 1]].Add(quadric);
+        quadrics[result[i + 2]].Add(quadric);
+    }
+
+    // collapse in passes
+    //> each pass collapses the cheapest independent edges, then rewrites the triangles
+    const double maxCost = static_cast<double>(maxError) * maxError;
+    std::vector<uint32_t> triangleOffsets(vertexCount + 1);
+    std::vector<uint32_t> vertexTriangles;
+    std::vector<Collapse> collapses;
+    std::vector<uint8_t> isTouched(vertexCount);
+    std::vector<uint32_t> remap(vertexCount);
+
+    while (result.size() > targetIndexCount)
+    {
+        // adjacency: triangles per vertex
+        std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+        for (uint32_t index : result)
+            ++triangleOffsets[index + 1];
+        for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+            triangleOffsets[vertex + 1] += triangleOffsets[vertex];
+        vertexTriangles.resize(result.size());
+        {
+            std::vector<uint32_t> fill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+            for (size_t i = 0; i < result.size(); ++i)
+                vertexTriangles[fill[result[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        // candidates: both directions of every edge
+        collapses.clear();
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            for (int edge = 0; edge < 3; ++edge)
+            {
+                uint32_t a = result[i + edge];
+                uint32_t b = result[i + (edge + 1) % 3];
+                for (auto [from, to] : {std::pair{a, b}, std::pair{b, a}})
+                {
+                    if (isLocked[from])
+                        continue;
+                    Quadric quadric = quadrics[from];
+                    quadric.Add(quadrics[to]);
+                    collapses.push_back({from, to, quadric.Evaluate(vertices[to].position)});
+                }
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+        // apply
+        //> vertices of triangles around a collapse are touched, their triangles change in this pass
+        const size_t removeTriangleCount = (result.size() - targetIndexCount + 2) / 3;
+        size_t removedTriangleCount = 0;
+        uint32_t appliedCount = 0;
+        std::fill(isTouched.begin(), isTouched.end(), 0);
+        for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+            remap[vertex] = vertex;
+
+        for (const Collapse& collapse : collapses)
+        {
+            if (collapse.cost > maxCost || removedTriangleCount >= removeTriangleCount)
+                break;
+            if (isTouched[collapse.from] || isTouched[collapse.to])
+                continue;
+
+            // reject flips
+            bool isFlipped = false;
+            uint32_t collapsedTriangleCount = 0;
+            const glm::vec3& target = vertices[collapse.to].position;
+            for (uint32_t t = triangleOffsets[collapse.from]; t < triangleOffsets[collapse.from + 1] && !isFlipped; ++t)
+            {
+                const uint32_t* triangle = &result[vertexTriangles[t] * 3];
+                if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+                {
+                    ++collapsedTriangleCount;
+                    continue;
+                }
+
+                glm::vec3 corners[3];
+                glm::vec3 moved[3];
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    corners[corner] = vertices[triangle[corner]].position;
+                    moved[corner] = triangle[corner] == collapse.from ? target : corners[corner];
+                }
+                glm::vec3 normal = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+                glm::vec3 movedNormal = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+                isFlipped = glm::dot(normal, movedNormal) <= 0.0f;
+            }
+            if (isFlipped)
+                continue;
+
+            remap[collapse.from] = collapse.to;
+            quadrics[collapse.to].Add(quadrics[collapse.from]);
+            for (uint32_t t = triangleOffsets[collapse.from]; t < triangleOffsets[collapse.from + 1]; ++t)
+            {
+                const uint32_t* triangle = &result[vertexTriangles[t] * 3];
+                isTouched[triangle[0]] = isTouched[triangle[1]] = isTouched[triangle[2]] = 1;
+            }
+
+            error = std::max(error, static_cast<float>(std::sqrt(collapse.cost)));
+            removedTriangleCount += collapsedTriangleCount;
+            ++appliedCount;
+        }
+
+        if (appliedCount == 0)
+            break;
+
+        // rewrite triangles, drop degenerate ones
+        size_t writeOffset = 0;
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            uint32_t a = remap[result[i + 0]];
+            uint32_t b = remap[result[i + 1]];
+            uint32_t c = remap[result[i + 2]];
+            if (a == b || b == c || c == a)
+                continue;
+            result[writeOffset++] = a;
+            result[writeOffset++] = b;
+            result[writeOffset++] = c;
+        }
+        result.resize(writeOffset);
+    }
+
+    return result;
+}
@@ -0,0 +1,37 @@
+#ifndef ARCTIC_MESH_COOKER_H
+#define ARCTIC_MESH_COOKER_H
+
+#include <string>
+#include <vector>
+#include "mesh.h"
+
+// offline mesh processing, used by 'ArcticCook'
+class MeshCooker
+{
+public:
+    struct LodSettings
+    {
+        uint32_t maxLodCount = MeshData::MAX_LOD_COUNT;
+        float reduction = 0.5f; // target index count relative to the previous lod
+        float minReduction = 0.85f; // the chain ends when a lod keeps more than this of the previous one
+        float maxError = 0.05f; // accumulated error budget, relative to the bounding sphere radius
+    };
+
+    // wavefront obj: positions, normals & polygons (fan triangulated), missing normals are generated
+    static bool LoadObj(const std::string& path, MeshData& mesh);
+
+    // replaces the lod chain with one generated from lod 0
+    static void GenerateLods(MeshData& mesh, const LodSettings& settings);
+
+    // quadric error simplification by half edge collapses
+    //> vertices are never moved or added, so the result indexes the same vertex buffer
+    //> border & attribute seam vertices are locked, collapses that flip a triangle are rejected
+    //> stops at the target index count or when the next collapse exceeds the max error (world space)
+    static std::vector<uint32_t> Simplify(const std::vector<MeshVertex>& vertices,
+                                          const std::vector<uint32_t>& indices,
+                                          uint32_t targetIndexCount,
+                                          float maxError,
+                                          float& error);
+};
+
+#endif //ARCTIC_MESH_COOKER_H
@@ -0,0 +1,115 @@
+#include "mesh_lod_selector.h"
+#include "utilities/job_system.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <format>
+#include <iostream>
+
+namespace
+{
+    // closest distance used for projection, instances around the camera get lod 0
+    const float MIN_DISTANCE = 1e-3f;
+}
+
+void MeshLodSelector::SetCamera(const glm::vec3& position, float fieldOfView, float screenHeight, float farPlaneDistance)
+{
+    cameraPosition = position;
+    projectionScale = screenHeight / (2.0f * std::tan(fieldOfView * 0.5f));
+    farPlane = farPlaneDistance;
+}
+
+void MeshLodSelector::Select(std::vector<Instance>& instances, JobSystem* jobSystem)
+{
+    std::atomic<uint32_t> switchCount = 0;
+    auto selectRange = [&](uint32_t begin, uint32_t end)
+    {
+        uint32_t rangeSwitchCount = 0;
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            uint32_t lod = selectLod(instances[i]);
+            rangeSwitchCount += lod != instances[i].lod;
+            instances[i].lod = lod;
+        }
+        switchCount.fetch_add(rangeSwitchCount, std::memory_order_relaxed);
+    };
+
+    const auto count = static_cast<uint32_t>(instances.size());
+    if (jobSystem != nullptr && count > SELECT_BATCH_SIZE)
+        jobSystem->ParallelFor(count, SELECT_BATCH_SIZE, selectRange);
+    else
+        selectRange(0, count);
+
+    stats = {};
+    stats.instanceCount = count;
+    stats.switchCount = switchCount.load(std::memory_order_relaxed);
+    for (const auto& instance : instances)
+    {
+        if (instance.lodCount == 0)
+            continue;
+        ++stats.lodCounts[instance.lod];
+        stats.triangleCount += instance.lods[instance.lod].indexCount / 3;
+        stats.fullTriangleCount += instance.lods[0].indexCount / 3;
+    }
+}
+
+uint32_t MeshLodSelector::selectLod(const Instance& instance) const
+{
+    if (instance.lodCount == 0)
+        return 0;
+
+    // pixels per world unit of error at the closest point of the sphere
+    glm::vec3 center(instance.sphere.x, instance.sphere.y, instance.sphere.z);
+    float distance = std::max(glm::length(center - cameraPosition) - instance.sphere.w, MIN_DISTANCE);
+    float pixelScale = projectionScale / distance;
+
+    const uint32_t lastLod = std::min(instance.lodCount, MeshData::MAX_LOD_COUNT) - 1;
+    const uint32_t currentLod = std::min(instance.lod, lastLod);
+
+    // refine while the current lod is clearly too coarse
+    uint32_t lod = currentLod;
+    while (lod > 0 && instance.lods[lod].error * pixelScale > maxPixelError * (1.0f + HYSTERESIS))
+        --lod;
+    if (lod != currentLod)
+        return lod;
+
+    // coarsen while the next lod is clearly fine
+    while (lod < lastLod && instance.lods[lod + 1].error * pixelScale <= maxPixelError * (1.0f - HYSTERESIS))
+        ++lod;
+    return lod;
+}
+
+void MeshLodSelector::Submit(const std::vector<Instance>& instances,
+                             RenderQueue& queue,
+                             ShaderPermutationKey pipeline,
+                             uint16_t material,
+                             uint16_t mesh) const
+{
+    for (const auto& instance : instances)
+    {
+        if (instance.lodCount == 0)
+            continue;
+
+        glm::vec3 center(instance.sphere.x, instance.sphere.y, instance.sphere.z);
+        float depth = glm::length(center - cameraPosition) / farPlane;
+        const MeshLod& lod = instance.lods[instance.lod];
+        queue.Submit(RenderQueue::MakeKey(DrawPass::Opaque, pipeline, material, mesh, depth),
+                     {lod.indexCount, lod.firstIndex, instance.instanceIndex});
+    }
+}
+
+void MeshLodSelector::PrintStats() const
+{
+    std::cout << "info: mesh lod:" << std::endl;
+    std::cout << std::format("\tinstances {}, lod switches {}, triangles {} of {} ({:.1f}%)",
+                             stats.instanceCount,
+                             stats.switchCount,
+                             stats.triangleCount,
+                             stats.fullTriangleCount,
+                             stats.fullTriangleCount > 0 ? 100.0 * static_cast<double>(stats.triangleCount) / static_cast<double>(stats.fullTriangleCount) : 0.0) << std::endl;
+    for (uint32_t lod = 0; lod < MeshData::MAX_LOD_COUNT; ++lod)
+    {
+        if (stats.lodCounts[lod] > 0)
+            std::cout << std::format("\tlod {}: {} instances", lod, stats.lodCounts[lod]) << std::endl;
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef ARCTIC_MESH_LOD_SELECTOR_H
+#define ARCTIC_MESH_LOD_SELECTOR_H
+
+#include <cstdint>
+#include <vector>
+#include "mesh.h"
+#include "render_queue.h"
+
+class JobSystem;
+
+// picks a level of detail per instance from its projected screen space error
+//> the error of a lod (world space) is projected at the distance of the instance bounding sphere,
+//> the coarsest lod below the pixel threshold wins
+//> hysteresis: an instance only coarsens below (1 - HYSTERESIS) and refines above (1 + HYSTERESIS) of the threshold,
+//> so instances near a switch distance do not pop every frame
+class MeshLodSelector
+{
+public:
+    static constexpr float DEFAULT_MAX_PIXEL_ERROR = 1.0f;
+    static constexpr float HYSTERESIS = 0.25f;
+    static constexpr uint32_t SELECT_BATCH_SIZE = 1024; // instances per job
+
+    // 'lod' is the output of 'Select' and the state kept for the hysteresis
+    struct Instance
+    {
+        glm::vec4 sphere; // world space, xyz: center, w: radius
+        const MeshLod* lods;
+        uint32_t lodCount;
+        uint32_t instanceIndex;
+        uint32_t lod;
+    };
+
+    struct Stats
+    {
+        uint32_t instanceCount;
+        uint32_t lodCounts[MeshData::MAX_LOD_COUNT]; // instances per lod
+        uint32_t switchCount; // instances that changed lod
+        uint64_t triangleCount; // triangles of the selected lods
+        uint64_t fullTriangleCount; // triangles at lod 0
+    };
+
+    // vertical field of view in radians, screen height in pixels
+    void SetCamera(const glm::vec3& position, float fieldOfView, float screenHeight, float farPlane);
+    void SetMaxPixelError(float pixels) {
+        maxPixelError = pixels;
+    }
+
+    // large instance lists are selected on the job system
+    void Select(std::vector<Instance>& instances, JobSystem* jobSystem);
+
+    // submits the selected lods as index ranges of one mesh
+    //> meant for vertex pulled draws: a shader reading 'indices[gl_VertexIndex]', so 'firstVertex' is the first index
+    void Submit(const std::vector<Instance>& instances,
+                RenderQueue& queue,
+                ShaderPermutationKey pipeline,
+                uint16_t material,
+                uint16_t mesh) const;
+
+    const Stats& GetStats() const {
+        return stats;
+    }
+    void PrintStats() const;
+
+private:
+    glm::vec3 cameraPosition{0.0f};
+    float projectionScale = 1.0f; // pixels per world unit at distance 1
+    float farPlane = 1.0f;
+    float maxPixelError = DEFAULT_MAX_PIXEL_ERROR;
+    Stats stats{};
+
+    uint32_t selectLod(const Instance& instance) const;
+};
+
+#endif //ARCTIC_MESH_LOD_SELECTOR_H
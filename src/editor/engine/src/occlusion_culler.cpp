@@ -0,0 +1,493 @@
+#include "occlusion_culler.h"
+#include "vulkan_utility.h"
+#include "utilities/logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    struct ReduceConstants
+    {
+        glm::vec2 outputSize;
+        glm::vec2 inputSize;
+    };
+
+    struct CullConstants
+    {
+        glm::mat4 viewProjection;
+        glm::vec2 pyramidSize;
+        uint32_t instanceCount;
+        uint32_t phase;
+        glm::vec2 uvScale;
+    };
+
+    uint32_t previousPowerOfTwo(uint32_t value)
+    {
+        uint32_t result = 1;
+        while (result * 2 <= value)
+            result *= 2;
+        return result;
+    }
+}
+
+bool OcclusionCuller::Initialize(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        const VkAllocationCallbacks* allocator,
+        VkImageView depthImageView,
+        VkExtent2D depthImageExtent,
+        uint32_t maxInstances,
+        bool reverseZ)
+{
+    vkPhysicalDevice = physicalDevice;
+    vkDevice = device;
+    vkAllocator = allocator;
+    depthView = depthImageView;
+    depthExtent = depthImageExtent;
+    maxInstanceCount = maxInstances;
+    isReverseZ = reverseZ;
+
+    return createBuffers() &&
+           createPyramid() &&
+           createPipelines() &&
+           createDescriptorSets();
+}
+
+void OcclusionCuller::Cleanup()
+{
+    // pipelines
+    vkDestroyDescriptorPool(vkDevice, descriptorPool, vkAllocator);
+    vkDestroyPipeline(vkDevice, reducePipeline, vkAllocator);
+    vkDestroyPipeline(vkDevice, cullPipeline, vkAllocator);
+    vkDestroyPipelineLayout(vkDevice, reducePipelineLayout, vkAllocator);
+    vkDestroyPipelineLayout(vkDevice, cullPipelineLayout, vkAllocator);
+    vkDestroyDescriptorSetLayout(vkDevice, reduceSetLayout, vkAllocator);
+    vkDestroyDescriptorSetLayout(vkDevice, cullSetLayout, vkAllocator);
+
+    // pyramid
+    vkDestroySampler(vkDevice, pyramidSampler, vkAllocator);
+    for (auto levelView : pyramidLevelViews)
+        vkDestroyImageView(vkDevice, levelView, vkAllocator);
+    pyramidLevelViews.clear();
+    vkDestroyImageView(vkDevice, pyramidView, vkAllocator);
+    vkDestroyImage(vkDevice, pyramidImage, vkAllocator);
+    vkFreeMemory(vkDevice, pyramidMemory, vkAllocator);
+
+    // buffers
+    vkDestroyBuffer(vkDevice, instanceBuffer, vkAllocator);
+    vkFreeMemory(vkDevice, instanceMemory, vkAllocator);
+    vkDestroyBuffer(vkDevice, visibilityBuffer, vkAllocator);
+    vkFreeMemory(vkDevice, visibilityMemory, vkAllocator);
+    for (uint32_t phase = 0; phase < PHASE_COUNT; ++phase)
+    {
+        vkDestroyBuffer(vkDevice, drawBuffers[phase], vkAllocator);
+        vkFreeMemory(vkDevice, drawMemories[phase], vkAllocator);
+    }
+    vkDestroyBuffer(vkDevice, statsBuffer, vkAllocator);
+    vkFreeMemory(vkDevice, statsMemory, vkAllocator);
+}
+
+void OcclusionCuller::SetInstances(const std::vector<Instance>& instances)
+{
+    instanceCount = static_cast<uint32_t>(std::min<size_t>(instances.size(), maxInstanceCount));
+    std::memcpy(instanceMapped, instances.data(), instanceCount * sizeof(Instance));
+}
+
+OcclusionCuller::Stats OcclusionCuller::GetStats() const
+{
+    Stats stats{};
+    std::memcpy(&stats, statsMapped, sizeof(Stats));
+    return stats;
+}
+
+void OcclusionCuller::RecordCull(VkCommandBuffer commandBuffer, const glm::mat4& viewProjection, uint32_t phase)
+{
+    // reset stats on the first phase
+    if (phase == 0)
+    {
+        vkCmdFillBuffer(commandBuffer, statsBuffer, 0, sizeof(Stats), 0);
+
+        VkMemoryBarrier fillBarrier{};
+        fillBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        fillBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        fillBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 1, &fillBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    // dispatch cull
+    //> without a pyramid (first frame) only the frustum test is done
+    CullConstants constants{};
+    constants.viewProjection = viewProjection;
+    constants.pyramidSize = hasPyramid ? glm::vec2(pyramidExtent.width, pyramidExtent.height) : glm::vec2(0.0f);
+    constants.instanceCount = instanceCount;
+    constants.phase = phase;
+    constants.uvScale = glm::vec2(static_cast<float>(pyramidScreenExtent.width) / static_cast<float>(depthExtent.width),
+                                  static_cast<float>(pyramidScreenExtent.height) / static_cast<float>(depthExtent.height));
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipelineLayout, 0, 1, &cullSets[phase], 0, nullptr);
+    vkCmdPushConstants(commandBuffer, cullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullConstants), &constants);
+    vkCmdDispatch(commandBuffer, (instanceCount + 63) / 64, 1, 1);
+
+    // make draw commands visible to indirect draws
+    VkMemoryBarrier drawBarrier{};
+    drawBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    drawBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    drawBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+                         0, 1, &drawBarrier, 0, nullptr, 0, nullptr);
+}
+
+void OcclusionCuller::RecordBuildPyramid(VkCommandBuffer commandBuffer, VkExtent2D screenExtent)
+{
+    // wait for depth writes & pyramid reads of the previous cull
+    //> first use transitions the pyramid to general, the content is undefined until written
+    VkImageMemoryBarrier pyramidBarrier{};
+    pyramidBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    pyramidBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    pyramidBarrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    pyramidBarrier.oldLayout = isPyramidInitialized ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_UNDEFINED;
+    pyramidBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    pyramidBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    pyramidBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    pyramidBarrier.image = pyramidImage;
+    pyramidBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, pyramidLevelCount, 0, 1};
+
+    VkMemoryBarrier depthBarrier{};
+    depthBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    depthBarrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    depthBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0, 1, &depthBarrier, 0, nullptr, 1, &pyramidBarrier);
+    isPyramidInitialized = true;
+
+    // reduce level by level
+    //> level 0 only reads the depth the scene rendered, the rest of the image is left from earlier frames
+    pyramidScreenExtent.width = std::min(screenExtent.width, depthExtent.width);
+    pyramidScreenExtent.height = std::min(screenExtent.height, depthExtent.height);
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, reducePipeline);
+    for (uint32_t level = 0; level < pyramidLevelCount; ++level)
+    {
+        uint32_t width = std::max(pyramidExtent.width >> level, 1u);
+        uint32_t height = std::max(pyramidExtent.height >> level, 1u);
+
+        ReduceConstants constants{};
+        constants.outputSize = glm::vec2(width, height);
+        constants.inputSize = level == 0 ? glm::vec2(pyramidScreenExtent.width, pyramidScreenExtent.height)
+                                         : glm::vec2(std::max(pyramidExtent.width >> (level - 1), 1u),
+                                                     std::max(pyramidExtent.height >> (level - 1), 1u));
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, reducePipelineLayout, 0, 1, &reduceSets[level], 0, nullptr);
+        vkCmdPushConstants(commandBuffer, reducePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ReduceConstants), &constants);
+        vkCmdDispatch(commandBuffer, (width + 7) / 8, (height + 7) / 8, 1);
+
+        // next level reads this level
+        VkImageMemoryBarrier levelBarrier{};
+        levelBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        levelBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        levelBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        levelBarrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+        levelBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        levelBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        levelBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        levelBarrier.image = pyramidImage;
+        levelBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1};
+
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &levelBarrier);
+    }
+
+    hasPyramid = true;
+}
+
+bool OcclusionCuller::createBuffers()
+{
+    const VkMemoryPropertyFlags hostVisible = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    const VkDeviceSize instanceSize = sizeof(Instance) * maxInstanceCount;
+    const VkDeviceSize visibilitySize = sizeof(uint32_t) * maxInstanceCount;
+    const VkDeviceSize drawSize = sizeof(VkDrawIndirectCommand) * maxInstanceCount;
+
+    // instances: written by the cpu every frame
+    if (!VulkanUtility::CreateBuffer(vkPhysicalDevice, vkDevice, vkAllocator, instanceSize,
+                                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostVisible,
+                                     instanceBuffer, instanceMemory))
+        return false;
+    vkMapMemory(vkDevice, instanceMemory, 0, instanceSize, 0, &instanceMapped);
+
+    // visibility: written for every instance by phase 0, read by phase 1
+    if (!VulkanUtility::CreateBuffer(vkPhysicalDevice, vkDevice, vkAllocator, visibilitySize,
+                                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                     visibilityBuffer, visibilityMemory))
+        return false;
+
+    // draws: one buffer per phase
+    for (uint32_t phase = 0; phase < PHASE_COUNT; ++phase)
+    {
+        if (!VulkanUtility::CreateBuffer(vkPhysicalDevice, vkDevice, vkAllocator, drawSize,
+                                         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                         drawBuffers[phase], drawMemories[phase]))
+            return false;
+    }
+
+    // stats: read back by the cpu
+    if (!VulkanUtility::CreateBuffer(vkPhysicalDevice, vkDevice, vkAllocator, sizeof(Stats),
+                                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, hostVisible,
+                                     statsBuffer, statsMemory))
+        return false;
+    vkMapMemory(vkDevice, statsMemory, 0, sizeof(Stats), 0, &statsMapped);
+    std::memset(statsMapped, 0, sizeof(Stats));
+
+    return true;
+}
+
+bool OcclusionCuller::createPyramid()
+{
+    // pyramid size: power of two, so below level 0 every texel covers exactly 2x2 texels of the level above
+    //> a level 0 texel covers 2 to 4 depth texels per axis, the reduction reads every texel it touches
+    pyramidExtent.width = std::max(previousPowerOfTwo(depthExtent.width) / 2, 1u);
+    pyramidExtent.height = std::max(previousPowerOfTwo(depthExtent.height) / 2, 1u);
+    pyramidLevelCount = 1;
+    while ((std::max(pyramidExtent.width, pyramidExtent.height) >> pyramidLevelCount) > 0)
+        ++pyramidLevelCount;
+
+    // create image
+    if (!VulkanUtility::CreateImage(vkPhysicalDevice, vkDevice, vkAllocator,
+                                    pyramidExtent, pyramidLevelCount, VK_FORMAT_R32_SFLOAT,
+                                    VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                                    pyramidImage, pyramidMemory))
+        return false;
+
+    // create views
+    if (!VulkanUtility::CreateImageView(vkDevice, vkAllocator, pyramidImage, VK_FORMAT_R32_SFLOAT,
+                                        VK_IMAGE_ASPECT_COLOR_BIT, 0, pyramidLevelCount, pyramidView))
+        return false;
+
+    pyramidLevelViews.resize(pyramidLevelCount);
+    for (uint32_t level = 0; level < pyramidLevelCount; ++level)
+    {
+        if (!VulkanUtility::CreateImageView(vkDevice, vkAllocator, pyramidImage, VK_FORMAT_R32_SFLOAT,
+                                            VK_IMAGE_ASPECT_COLOR_BIT, level, 1, pyramidLevelViews[level]))
+            return false;
+    }
+
+    // create sampler
+    //> nearest: every sample must return an actual depth of the level
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_NEAREST;
+    samplerInfo.minFilter = VK_FILTER_NEAREST;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.minLod = 0.0f;
+    samplerInfo.maxLod = static_cast<float>(pyramidLevelCount);
+
+    VkResult result = vkCreateSampler(vkDevice, &samplerInfo, vkAllocator, &pyramidSampler);
+    if (result != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create depth pyramid sampler!");
+        return false;
+    }
+    return true;
+}
+
+bool OcclusionCuller::createPipelines()
+{
+    // create set layout: reduce
+    VkDescriptorSetLayoutBinding reduceBindings[2] = {};
+    reduceBindings[0] = {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    reduceBindings[1] = {1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+
+    VkDescriptorSetLayoutCreateInfo reduceSetLayoutInfo{};
+    reduceSetLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    reduceSetLayoutInfo.bindingCount = 2;
+    reduceSetLayoutInfo.pBindings = reduceBindings;
+
+    // create set layout: cull
+    VkDescriptorSetLayoutBinding cullBindings[5] = {};
+    cullBindings[0] = {0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    cullBindings[1] = {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    cullBindings[2] = {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    cullBindings[3] = {3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    cullBindings[4] = {4, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+
+    VkDescriptorSetLayoutCreateInfo cullSetLayoutInfo{};
+    cullSetLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    cullSetLayoutInfo.bindingCount = 5;
+    cullSetLayoutInfo.pBindings = cullBindings;
+
+    if (vkCreateDescriptorSetLayout(vkDevice, &reduceSetLayoutInfo, vkAllocator, &reduceSetLayout) != VK_SUCCESS ||
+        vkCreateDescriptorSetLayout(vkDevice, &cullSetLayoutInfo, vkAllocator, &cullSetLayout) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create occlusion culling set layouts!");
+        return false;
+    }
+
+    // create pipeline layouts
+    VkPushConstantRange reduceRange{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ReduceConstants)};
+    VkPipelineLayoutCreateInfo reduceLayoutInfo{};
+    reduceLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    reduceLayoutInfo.setLayoutCount = 1;
+    reduceLayoutInfo.pSetLayouts = &reduceSetLayout;
+    reduceLayoutInfo.pushConstantRangeCount = 1;
+    reduceLayoutInfo.pPushConstantRanges = &reduceRange;
+
+    VkPushConstantRange cullRange{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullConstants)};
+    VkPipelineLayoutCreateInfo cullLayoutInfo{};
+    cullLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    cullLayoutInfo.setLayoutCount = 1;
+    cullLayoutInfo.pSetLayouts = &cullSetLayout;
+    cullLayoutInfo.pushConstantRangeCount = 1;
+    cullLayoutInfo.pPushConstantRanges = &cullRange;
+
+    if (vkCreatePipelineLayout(vkDevice, &reduceLayoutInfo, vkAllocator, &reducePipelineLayout) != VK_SUCCESS ||
+        vkCreatePipelineLayout(vkDevice, &cullLayoutInfo, vkAllocator, &cullPipelineLayout) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create occlusion culling pipeline layouts!");
+        return false;
+    }
+
+    // create pipelines
+    //> reverse-z flips min/max in both shaders (constant_id 0)
+    VkBool32 reverseZ = isReverseZ ? VK_TRUE : VK_FALSE;
+    VkSpecializationMapEntry mapEntry{0, 0, sizeof(VkBool32)};
+    VkSpecializationInfo specializationInfo{1, &mapEntry, sizeof(VkBool32), &reverseZ};
+
+    VkShaderModule reduceModule = VK_NULL_HANDLE;
+    VkShaderModule cullModule = VK_NULL_HANDLE;
+    bool isCreated =
+            VulkanUtility::CreateShaderModule(vkDevice, vkAllocator, "hiz_reduce.comp.spv", reduceModule) &&
+            VulkanUtility::CreateShaderModule(vkDevice, vkAllocator, "occlusion_cull.comp.spv", cullModule) &&
+            VulkanUtility::CreateComputePipeline(vkDevice, vkAllocator, reduceModule, reducePipelineLayout, &specializationInfo, reducePipeline) &&
+            VulkanUtility::CreateComputePipeline(vkDevice, vkAllocator, cullModule, cullPipelineLayout, &specializationInfo, cullPipeline);
+
+    // cleanup shaders
+    vkDestroyShaderModule(vkDevice, reduceModule, vkAllocator);
+    vkDestroyShaderModule(vkDevice, cullModule, vkAllocator);
+
+    return isCreated;
+}
+
+bool OcclusionCuller::createDescriptorSets()
+{
+    // create descriptor pool
+    VkDescriptorPoolSize poolSizes[3] = {};
+    poolSizes[0] = {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, pyramidLevelCount + PHASE_COUNT};
+    poolSizes[1] = {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, pyramidLevelCount};
+    poolSizes[2] = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4 * PHASE_COUNT};
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = pyramidLevelCount + PHASE_COUNT;
+    poolInfo.poolSizeCount = 3;
+    poolInfo.pPoolSizes = poolSizes;
+
+    if (vkCreateDescriptorPool(vkDevice, &poolInfo, vkAllocator, &descriptorPool) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create occlusion culling descriptor pool!");
+        return false;
+    }
+
+    // allocate sets
+    std::vector<VkDescriptorSetLayout> reduceLayouts(pyramidLevelCount, reduceSetLayout);
+    reduceSets.resize(pyramidLevelCount);
+
+    VkDescriptorSetAllocateInfo reduceAllocInfo{};
+    reduceAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    reduceAllocInfo.descriptorPool = descriptorPool;
+    reduceAllocInfo.descriptorSetCount = pyramidLevelCount;
+    reduceAllocInfo.pSetLayouts = reduceLayouts.data();
+
+    VkDescriptorSetLayout cullLayouts[PHASE_COUNT] = {cullSetLayout, cullSetLayout};
+    VkDescriptorSetAllocateInfo cullAllocInfo{};
+    cullAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    cullAllocInfo.descriptorPool = descriptorPool;
+    cullAllocInfo.descriptorSetCount = PHASE_COUNT;
+    cullAllocInfo.pSetLayouts = cullLayouts;
+
+    if (vkAllocateDescriptorSets(vkDevice, &reduceAllocInfo, reduceSets.data()) != VK_SUCCESS ||
+        vkAllocateDescriptorSets(vkDevice, &cullAllocInfo, cullSets) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to allocate occlusion culling descriptor sets!");
+        return false;
+    }
+
+    // write reduce sets
+    //> level 0 reads the depth buffer, every other level reads the level above
+    for (uint32_t level = 0; level < pyramidLevelCount; ++level)
+    {
+        VkDescriptorImageInfo inputInfo{};
+        inputInfo.sampler = pyramidSampler;
+        inputInfo.imageView = level == 0 ? depthView : pyramidLevelViews[level - 1];
+        inputInfo.imageLayout = level == 0 ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
+
+        VkDescriptorImageInfo outputInfo{};
+        outputInfo.imageView = pyramidLevelViews[level];
+        outputInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+        VkWriteDescriptorSet writes[2] = {};
+        writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[0].dstSet = reduceSets[level];
+        writes[0].dstBinding = 0;
+        writes[0].descriptorCount = 1;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[0].pImageInfo = &inputInfo;
+
+        writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[1].dstSet = reduceSets[level];
+        writes[1].dstBinding = 1;
+        writes[1].descriptorCount = 1;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[1].pImageInfo = &outputInfo;
+
+        vkUpdateDescriptorSets(vkDevice, 2, writes, 0, nullptr);
+    }
+
+    // write cull sets
+    //> phases only differ in the draw buffer they write
+    for (uint32_t phase = 0; phase < PHASE_COUNT; ++phase)
+    {
+        VkDescriptorBufferInfo bufferInfos[4] = {};
+        bufferInfos[0] = {instanceBuffer, 0, VK_WHOLE_SIZE};
+        bufferInfos[1] = {visibilityBuffer, 0, VK_WHOLE_SIZE};
+        bufferInfos[2] = {drawBuffers[phase], 0, VK_WHOLE_SIZE};
+        bufferInfos[3] = {statsBuffer, 0, VK_WHOLE_SIZE};
+
+        VkDescriptorImageInfo pyramidInfo{};
+        pyramidInfo.sampler = pyramidSampler;
+        pyramidInfo.imageView = pyramidView;
+        pyramidInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+        VkWriteDescriptorSet writes[5] = {};
+        for (uint32_t binding = 0; binding < 4; ++binding)
+        {
+            writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[binding].dstSet = cullSets[phase];
+            writes[binding].dstBinding = binding;
+            writes[binding].descriptorCount = 1;
+            writes[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[binding].pBufferInfo = &bufferInfos[binding];
+        }
+        writes[4].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[4].dstSet = cullSets[phase];
+        writes[4].dstBinding = 4;
+        writes[4].descriptorCount = 1;
+        writes[4].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[4].pImageInfo = &pyramidInfo;
+
+        vkUpdateDescriptorSets(vkDevice, 5, writes, 0, nullptr);
+    }
+
+    return true;
+}
@@ -0,0 +1,122 @@
+#ifndef ARCTIC_OCCLUSION_CULLER_H
+#define ARCTIC_OCCLUSION_CULLER_H
+
+#include <vector>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan_core.h>
+
+// two-phase gpu occlusion culling with a hierarchical depth pyramid (hi-z)
+//> per frame:
+//> 1. RecordCull(phase 0): test all instances against the pyramid of the previous frame, draw the visible ones
+//> 2. RecordBuildPyramid: build the pyramid from the depth of phase 0
+//> 3. RecordCull(phase 1): re-test the rejected instances against the new pyramid, draw the newly visible ones
+//> 4. RecordBuildPyramid: build the pyramid from the full frame, used by phase 0 of the next frame
+//> the depth image must be in 'VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL' when the pyramid is built
+//> draws of phase 1 need 'drawIndirectFirstInstance', the draw commands index the instances by their first instance
+class OcclusionCuller
+{
+public:
+    static constexpr uint32_t PHASE_COUNT = 2;
+
+    // matches 'Instance' in occlusion_cull.comp
+    struct Instance
+    {
+        glm::vec4 sphere; // xyz: world center, w: radius
+        uint32_t vertexCount;
+        uint32_t firstVertex;
+        uint32_t padding[2];
+    };
+
+    // matches 'Stats' in occlusion_cull.comp
+    struct Stats
+    {
+        uint32_t visibleCount;
+        uint32_t occludedCount;
+        uint32_t frustumCulledCount;
+        uint32_t testedCount;
+    };
+
+    bool Initialize(VkPhysicalDevice physicalDevice,
+                    VkDevice device,
+                    const VkAllocationCallbacks* allocator,
+                    VkImageView depthView,
+                    VkExtent2D depthExtent,
+                    uint32_t maxInstanceCount,
+                    bool isReverseZ);
+    void Cleanup();
+
+    void SetInstances(const std::vector<Instance>& instances);
+
+    void RecordCull(VkCommandBuffer commandBuffer, const glm::mat4& viewProjection, uint32_t phase);
+    // 'screenExtent': what the scene rendered into, the top left of the depth image (dynamic resolution)
+    void RecordBuildPyramid(VkCommandBuffer commandBuffer, VkExtent2D screenExtent);
+
+    // draw commands: one 'VkDrawIndirectCommand' per instance, culled instances have an instance count of zero
+    VkBuffer GetDrawBuffer(uint32_t phase) const {
+        return drawBuffers[phase];
+    }
+    uint32_t GetInstanceCount() const {
+        return instanceCount;
+    }
+
+    // stats of the last completed frame (both phases)
+    Stats GetStats() const;
+
+private:
+    VkPhysicalDevice vkPhysicalDevice = VK_NULL_HANDLE;
+    VkDevice vkDevice = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* vkAllocator = nullptr;
+    bool isReverseZ = false;
+
+    // instances
+    uint32_t maxInstanceCount = 0;
+    uint32_t instanceCount = 0;
+    VkBuffer instanceBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory instanceMemory = VK_NULL_HANDLE;
+    void* instanceMapped = nullptr;
+
+    VkBuffer visibilityBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory visibilityMemory = VK_NULL_HANDLE;
+
+    VkBuffer drawBuffers[PHASE_COUNT] = {};
+    VkDeviceMemory drawMemories[PHASE_COUNT] = {};
+
+    VkBuffer statsBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory statsMemory = VK_NULL_HANDLE;
+    void* statsMapped = nullptr;
+
+    // depth pyramid
+    //> level 0 is half the (power of two rounded down) depth size, kept in 'VK_IMAGE_LAYOUT_GENERAL'
+    //> its texels reduce their whole footprint in the depth, so the level sizes halve exactly from there
+    VkImageView depthView = VK_NULL_HANDLE;
+    VkExtent2D depthExtent{};
+    VkExtent2D pyramidScreenExtent{}; // scene extent of the depth the pyramid was built from
+    VkExtent2D pyramidExtent{};
+    uint32_t pyramidLevelCount = 0;
+    VkImage pyramidImage = VK_NULL_HANDLE;
+    VkDeviceMemory pyramidMemory = VK_NULL_HANDLE;
+    VkImageView pyramidView = VK_NULL_HANDLE; // all levels
+    std::vector<VkImageView> pyramidLevelViews;
+    VkSampler pyramidSampler = VK_NULL_HANDLE;
+    bool hasPyramid = false;
+    bool isPyramidInitialized = false;
+
+    // pipelines
+    VkDescriptorSetLayout reduceSetLayout = VK_NULL_HANDLE;
+    VkDescriptorSetLayout cullSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout reducePipelineLayout = VK_NULL_HANDLE;
+    VkPipelineLayout cullPipelineLayout = VK_NULL_HANDLE;
+    VkPipeline reducePipeline = VK_NULL_HANDLE;
+    VkPipeline cullPipeline = VK_NULL_HANDLE;
+
+    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> reduceSets; // one per level
+    VkDescriptorSet cullSets[PHASE_COUNT] = {};
+
+    bool createBuffers();
+    bool createPyramid();
+    bool createPipelines();
+    bool createDescriptorSets();
+};
+
+#endif //ARCTIC_OCCLUSION_CULLER_H
@@ -0,0 +1,727 @@
+#include "particle_system.h"
+#include "vulkan_utility.h"
+#include "utilities/logger.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <initializer_list>
+#include <iostream>
+
+bool ParticleSystem::Initialize(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        const VkAllocationCallbacks* allocator,
+        GpuResources& resources,
+        DeletionQueue& deletions,
+        VkRenderPass renderPass,
+        bool reverseZ)
+{
+    vkPhysicalDevice = physicalDevice;
+    vkDevice = device;
+    vkAllocator = allocator;
+    gpuResources = &resources;
+    deletionQueue = &deletions;
+    isReverseZ = reverseZ;
+
+    return createDepthFallback() &&
+           createPipelines(renderPass) &&
+           createDescriptorPool();
+}
+
+void ParticleSystem::Cleanup()
+{
+    // systems
+    for (const auto& system : systems.GetObjects())
+        destroySystem(system);
+    systems.Clear();
+
+    // pipelines
+    //> the pool is queued after the sets, the queue destroys in order
+    if (vkDescriptorPool != VK_NULL_HANDLE)
+        deletionQueue->Push(vkDescriptorPool);
+    for (auto pipeline : computePipelines)
+        vkDestroyPipeline(vkDevice, pipeline, vkAllocator);
+    vkDestroyPipeline(vkDevice, renderPipeline, vkAllocator);
+    vkDestroyPipelineLayout(vkDevice, vkPipelineLayout, vkAllocator);
+    vkDestroyDescriptorSetLayout(vkDevice, vkDescriptorSetLayout, vkAllocator);
+
+    // depth
+    vkDestroySampler(vkDevice, depthSampler, vkAllocator);
+    if (fallbackDepthImage)
+        gpuResources->Destroy(fallbackDepthImage);
+}
+
+#pragma region particle_system_systems
+
+ParticleSystemHandle ParticleSystem::Create(const std::string& name, uint32_t capacity, const ParticleEmitter& emitter)
+{
+    if (capacity == 0 || capacity > MAX_CAPACITY)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "invalid capacity {} of particle system '{}'!", capacity, name);
+        return {};
+    }
+    if (systems.GetCount() >= MAX_SYSTEM_COUNT)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "too many particle systems, '{}' is not created!", name);
+        return {};
+    }
+
+    GpuParticleSystem system{};
+    system.emitter = emitter;
+    system.capacity = capacity;
+
+    // create buffers
+    //> particles, lists & counters never leave the gpu, params & stats are persistently mapped
+    const VkMemoryPropertyFlags deviceLocal = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    const VkMemoryPropertyFlags hostVisible = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    system.particleBuffer = gpuResources->CreateBuffer(sizeof(Particle) * capacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, deviceLocal);
+    system.deadBuffer = gpuResources->CreateBuffer(sizeof(uint32_t) * capacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, deviceLocal);
+    system.aliveBuffer = gpuResources->CreateBuffer(sizeof(uint32_t) * capacity * 2, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, deviceLocal);
+    system.counterBuffer = gpuResources->CreateBuffer(sizeof(GpuCounters),
+                                                      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                                      VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                                                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                                                      VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                                      deviceLocal);
+    system.paramsBuffer = gpuResources->CreateBuffer(sizeof(ParticleParams), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, hostVisible);
+    system.statsBuffer = gpuResources->CreateBuffer(sizeof(GpuStats),
+                                                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                                    hostVisible);
+
+    if (!system.particleBuffer || !system.deadBuffer || !system.aliveBuffer ||
+        !system.counterBuffer || !system.paramsBuffer || !system.statsBuffer ||
+        !createDescriptorSet(system))
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create particle system '{}' with capacity {}!", name, capacity);
+        destroySystem(system);
+        return {};
+    }
+    std::memset(gpuResources->Get(system.statsBuffer)->mapped, 0, sizeof(GpuStats));
+
+    return systems.Add(system, {name});
+}
+
+void ParticleSystem::Destroy(ParticleSystemHandle handle)
+{
+    GpuParticleSystem system;
+    if (systems.Remove(handle, system))
+        destroySystem(system);
+}
+
+void ParticleSystem::SetEmitter(ParticleSystemHandle handle, const ParticleEmitter& emitter)
+{
+    //> handles come through the engine api, stale ones are rejected in every build
+    if (systems.IsValid(handle))
+        systems.Get(handle)->emitter = emitter;
+}
+
+void ParticleSystem::destroySystem(const GpuParticleSystem& system)
+{
+    //> buffers & set are destroyed once the frames using them completed
+    //> handles are null when creation failed part way
+    for (BufferHandle buffer : {system.particleBuffer, system.deadBuffer, system.aliveBuffer,
+                                system.counterBuffer, system.paramsBuffer, system.statsBuffer})
+    {
+        if (buffer)
+            gpuResources->Destroy(buffer);
+    }
+    if (system.descriptorSet != VK_NULL_HANDLE)
+        deletionQueue->Push(system.descriptorSet, vkDescriptorPool);
+}
+
+#pragma endregion particle_system_systems
+
+#pragma region particle_system_camera
+
+void ParticleSystem::SetCamera(const glm::mat4& viewMatrix, float fov, float nearDistance, float farDistance)
+{
+    view = viewMatrix;
+    fieldOfView = fov;
+    nearPlane = nearDistance;
+    farPlane = farDistance;
+
+    //> reverse-z swaps the planes, near maps to one & far to zero
+    float aspect = (float) extent.width / (float) extent.height;
+    projection = isReverseZ ? glm::perspectiveRH_ZO(fieldOfView, aspect, farPlane, nearPlane)
+                            : glm::perspectiveRH_ZO(fieldOfView, aspect, nearPlane, farPlane);
+}
+
+void ParticleSystem::SetScreenExtent(VkExtent2D screenExtent)
+{
+    if (screenExtent.width == extent.width && screenExtent.height == extent.height)
+        return;
+
+    extent = screenExtent;
+    SetCamera(view, fieldOfView, nearPlane, farPlane);
+}
+
+void ParticleSystem::SetDepth(VkImageView imageView, VkImageLayout imageLayout, VkExtent2D imageExtent)
+{
+    depthView = imageView;
+    depthLayout = imageLayout;
+    depthExtent = imageExtent;
+
+    //> single frame in flight, the sets are not in use while the next frame is recorded
+    for (const auto& system : systems.GetObjects())
+        writeDepthDescriptor(system.descriptorSet);
+}
+
+#pragma endregion particle_system_camera
+
+#pragma region particle_system_record
+
+void ParticleSystem::RecordSimulation(VkCommandBuffer commandBuffer)
+{
+    // advance time
+    auto now = std::chrono::steady_clock::now();
+    float deltaTime = lastFrameTime.time_since_epoch().count() == 0 ? 0.0f : std::chrono::duration<float>(now - lastFrameTime).count();
+    deltaTime = std::min(deltaTime, MAX_DELTA_TIME);
+    lastFrameTime = now;
+    totalTime += deltaTime;
+    ++frameSeed;
+
+    // transition fallback depth
+    //> contents stay undefined, collisions are off while it is bound
+    if (!isFallbackDepthInitialized)
+    {
+        VkImageMemoryBarrier imageBarrier{};
+        imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        imageBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.image = gpuResources->Get(fallbackDepthImage)->image;
+        imageBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        imageBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+        isFallbackDepthInitialized = true;
+    }
+
+    if (systems.GetCount() == 0)
+        return;
+
+    // update params
+    //> the previous frame is done at this point, the mapped memory is not in use by the gpu
+    bool hasReset = false;
+    for (auto& system : systems.GetObjects())
+    {
+        float emitCount = system.emitter.emitRate * deltaTime + system.emitAccumulator;
+        auto emitRequest = static_cast<uint32_t>(std::min(emitCount, static_cast<float>(system.capacity)));
+        system.emitAccumulator = emitCount - std::floor(emitCount);
+        writeParams(system, deltaTime, emitRequest);
+        hasReset |= !system.isReset;
+    }
+
+    VkMemoryBarrier computeBarrier{};
+    computeBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    computeBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    computeBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+
+    // wait for the draws of the previous frame that read the lists
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+    // fill dead lists of new systems
+    if (hasReset)
+    {
+        recordPass(commandBuffer, Pass::Reset);
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 1, &computeBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    // prepare: emit count & indirect arguments
+    recordPass(commandBuffer, Pass::Prepare);
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0, 1, &computeBarrier, 0, nullptr, 0, nullptr);
+
+    // emit
+    recordPass(commandBuffer, Pass::Emit);
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0, 1, &computeBarrier, 0, nullptr, 0, nullptr);
+
+    // simulate & compact
+    recordPass(commandBuffer, Pass::Simulate);
+
+    VkMemoryBarrier copyBarrier{};
+    copyBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    copyBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    copyBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 1, &copyBarrier, 0, nullptr, 0, nullptr);
+
+    // copy survivor counts to the draw arguments & stats
+    for (auto& system : systems.GetObjects())
+    {
+        uint32_t next = 1 - system.list;
+        VkBuffer counterBuffer = gpuResources->Get(system.counterBuffer)->buffer;
+        VkBuffer statsBuffer = gpuResources->Get(system.statsBuffer)->buffer;
+
+        VkBufferCopy drawCopy{offsetof(GpuCounters, aliveCounts) + next * sizeof(uint32_t),
+                              offsetof(GpuCounters, draw) + offsetof(VkDrawIndirectCommand, instanceCount),
+                              sizeof(uint32_t)};
+        vkCmdCopyBuffer(commandBuffer, counterBuffer, counterBuffer, 1, &drawCopy);
+
+        VkBufferCopy statsCopies[2] = {};
+        statsCopies[0] = {offsetof(GpuCounters, aliveCounts) + next * sizeof(uint32_t), offsetof(GpuStats, aliveCount), sizeof(uint32_t)};
+        statsCopies[1] = {offsetof(GpuCounters, deadCount), offsetof(GpuStats, deadCount), sizeof(uint32_t)};
+        vkCmdCopyBuffer(commandBuffer, counterBuffer, statsBuffer, 2, statsCopies);
+
+        // the survivors are drawn & simulated next frame
+        system.list = next;
+        system.isReset = true;
+    }
+
+    // make lists visible to the draws & stats to the host
+    VkMemoryBarrier drawBarrier{};
+    drawBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    drawBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    drawBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+                         0, 1, &drawBarrier, 0, nullptr, 0, nullptr);
+}
+
+void ParticleSystem::recordPass(VkCommandBuffer commandBuffer, Pass pass)
+{
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[static_cast<uint32_t>(pass)]);
+    for (const auto& system : systems.GetObjects())
+    {
+        if (pass == Pass::Reset && system.isReset)
+            continue;
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, vkPipelineLayout, 0, 1, &system.descriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, vkPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(uint32_t), &system.list);
+
+        VkBuffer counterBuffer = gpuResources->Get(system.counterBuffer)->buffer;
+        switch (pass)
+        {
+            case Pass::Reset:
+                vkCmdDispatch(commandBuffer, (system.capacity + 63) / 64, 1, 1);
+                break;
+            case Pass::Prepare:
+                vkCmdDispatch(commandBuffer, 1, 1, 1);
+                break;
+            case Pass::Emit:
+                vkCmdDispatchIndirect(commandBuffer, counterBuffer, offsetof(GpuCounters, emitDispatch));
+                break;
+            case Pass::Simulate:
+                vkCmdDispatchIndirect(commandBuffer, counterBuffer, offsetof(GpuCounters, simulateDispatch));
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+uint32_t ParticleSystem::RecordDraw(VkCommandBuffer commandBuffer)
+{
+    if (systems.GetCount() == 0)
+        return 0;
+
+    // one indirect draw per system
+    //> viewport & scissor are dynamic, set by the scene
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, renderPipeline);
+    for (const auto& system : systems.GetObjects())
+    {
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vkPipelineLayout, 0, 1, &system.descriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, vkPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(uint32_t), &system.list);
+        vkCmdDrawIndirect(commandBuffer, gpuResources->Get(system.counterBuffer)->buffer, offsetof(GpuCounters, draw), 1, sizeof(VkDrawIndirectCommand));
+    }
+    return systems.GetCount();
+}
+
+void ParticleSystem::writeParams(GpuParticleSystem& system, float deltaTime, uint32_t emitRequest)
+{
+    const ParticleEmitter& emitter = system.emitter;
+    bool isCollisionEnabled = emitter.enableCollision && depthView != VK_NULL_HANDLE;
+    glm::mat4 viewProjection = projection * view;
+
+    //> with dynamic resolution the scene covers the top left corner of the depth,
+    //> the current render extent stands in for the one the depth was written at
+    float depthScale = static_cast<float>(extent.width) / static_cast<float>(depthExtent.width);
+
+    ParticleParams params{};
+    params.viewProjection = viewProjection;
+    params.inverseViewProjection = glm::inverse(viewProjection);
+    params.cameraRight = glm::vec4(view[0][0], view[1][0], view[2][0], 0.0f);
+    params.cameraUp = glm::vec4(view[0][1], view[1][1], view[2][1], 0.0f);
+    params.emitterPositionRadius = glm::vec4(glm::make_vec3(emitter.position), emitter.radius);
+    params.emitterVelocitySpread = glm::vec4(glm::make_vec3(emitter.velocity), emitter.velocitySpread);
+    params.colorStart = glm::make_vec4(emitter.colorStart);
+    params.colorEnd = glm::make_vec4(emitter.colorEnd);
+    params.gravityDrag = glm::vec4(glm::make_vec3(emitter.gravity), emitter.drag);
+    params.noise = glm::vec4(emitter.noiseStrength, emitter.noiseFrequency, emitter.noiseSpeed, 0.0f);
+    params.lifetimeSize = glm::vec4(emitter.minLifetime, std::max(emitter.maxLifetime, emitter.minLifetime), emitter.startSize, emitter.endSize);
+    params.collision = glm::vec4(isCollisionEnabled ? 1.0f : 0.0f, emitter.restitution, emitter.collisionThickness, depthScale);
+    params.time = glm::vec4(deltaTime, totalTime, 0.0f, 0.0f);
+    params.counts = glm::uvec4(emitRequest, system.capacity, frameSeed * 0x9E3779B9u + system.particleBuffer.GetValue(), 0);
+    std::memcpy(gpuResources->Get(system.paramsBuffer)->mapped, &params, sizeof(ParticleParams));
+}
+
+#pragma endregion particle_system_record
+
+ParticleSystem::Stats ParticleSystem::GetStats(ParticleSystemHandle handle) const
+{
+    Stats stats{};
+    const GpuParticleSystem* system = systems.Get(handle);
+    if (system == nullptr)
+        return stats;
+
+    GpuStats gpuStats{};
+    std::memcpy(&gpuStats, gpuResources->Get(system->statsBuffer)->mapped, sizeof(GpuStats));
+
+    stats.capacity = system->capacity;
+    stats.aliveCount = gpuStats.aliveCount;
+    stats.deadCount = gpuStats.deadCount;
+    stats.emittedCount = gpuStats.emittedCount;
+    stats.starvedCount = gpuStats.starvedCount;
+    stats.killedCount = gpuStats.killedCount;
+    stats.collisionCount = gpuStats.collisionCount;
+    stats.memorySize = static_cast<uint64_t>(system->capacity) * (sizeof(Particle) + 3 * sizeof(uint32_t)) +
+                       sizeof(GpuCounters) + sizeof(ParticleParams) + sizeof(GpuStats);
+    return stats;
+}
+
+void ParticleSystem::PrintStats() const
+{
+    std::cout << "info: vulkan: particles:" << std::endl;
+    std::cout << std::format("\tsystems {}, collisions {}",
+                             systems.GetCount(),
+                             depthView != VK_NULL_HANDLE ? "on" : "off") << std::endl;
+
+    for (uint32_t i = 0; i < systems.GetCount(); ++i)
+    {
+        ParticleSystemHandle handle = systems.GetHandle(i);
+        Stats stats = GetStats(handle);
+        float usage = stats.capacity > 0 ? 100.0f * (float) stats.aliveCount / (float) stats.capacity : 0.0f;
+
+        std::cout << std::format("\t{}: alive {}/{} ({:.1f}%, {} KB), emitted {}, starved {}, killed {}, collisions {}",
+                                 systems.GetMetadata(handle)->name,
+                                 stats.aliveCount,
+                                 stats.capacity,
+                                 usage,
+                                 stats.memorySize / 1024,
+                                 stats.emittedCount,
+                                 stats.starvedCount,
+                                 stats.killedCount,
+                                 stats.collisionCount) << std::endl;
+    }
+}
+
+#pragma region particle_system_create
+
+bool ParticleSystem::createDepthFallback()
+{
+    fallbackDepthImage = gpuResources->CreateImage({1, 1}, VK_FORMAT_R32_SFLOAT, VK_IMAGE_USAGE_SAMPLED_BIT, VK_IMAGE_ASPECT_COLOR_BIT);
+    if (!fallbackDepthImage)
+        return false;
+
+    // create sampler
+    //> nearest, depth values are not interpolated across edges
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_NEAREST;
+    samplerInfo.minFilter = VK_FILTER_NEAREST;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.maxLod = 0.0f;
+
+    if (vkCreateSampler(vkDevice, &samplerInfo, vkAllocator, &depthSampler) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create particle depth sampler!");
+        return false;
+    }
+    return true;
+}
+
+bool ParticleSystem::createPipelines(VkRenderPass renderPass)
+{
+    // create set layout
+    //> shared by all passes & the draw
+    const VkShaderStageFlags stages = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+    VkDescriptorSetLayoutBinding bindings[7] = {};
+    bindings[0] = {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, stages, nullptr};
+    bindings[1] = {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stages, nullptr};
+    bindings[2] = {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    bindings[3] = {3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stages, nullptr};
+    bindings[4] = {4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    bindings[5] = {5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    bindings[6] = {6, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.bindingCount = 7;
+    setLayoutInfo.pBindings = bindings;
+
+    if (vkCreateDescriptorSetLayout(vkDevice, &setLayoutInfo, vkAllocator, &vkDescriptorSetLayout) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create particle set layout!");
+        return false;
+    }
+
+    // create pipeline layout
+    //> push constant: current alive list
+    VkPushConstantRange pushConstantRange{stages, 0, sizeof(uint32_t)};
+
+    VkPipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &vkDescriptorSetLayout;
+    layoutInfo.pushConstantRangeCount = 1;
+    layoutInfo.pPushConstantRanges = &pushConstantRange;
+
+    if (vkCreatePipelineLayout(vkDevice, &layoutInfo, vkAllocator, &vkPipelineLayout) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create particle pipeline layout!");
+        return false;
+    }
+
+    // create compute pipelines
+    //> one module, the pass (constant_id 0) & reverse-z (constant_id 1) are specialized
+    VkShaderModule computeModule = VK_NULL_HANDLE;
+    if (!VulkanUtility::CreateShaderModule(vkDevice, vkAllocator, "particle_simulate.comp.spv", computeModule))
+        return false;
+
+    struct SpecializationData
+    {
+        uint32_t pass;
+        VkBool32 reverseZ;
+    };
+    VkSpecializationMapEntry mapEntries[2] = {
+            {0, offsetof(SpecializationData, pass), sizeof(uint32_t)},
+            {1, offsetof(SpecializationData, reverseZ), sizeof(VkBool32)}};
+
+    bool isCreated = true;
+    for (uint32_t pass = 0; isCreated && pass < static_cast<uint32_t>(Pass::Count); ++pass)
+    {
+        SpecializationData data{pass, isReverseZ ? VK_TRUE : VK_FALSE};
+        VkSpecializationInfo specializationInfo{2, mapEntries, sizeof(SpecializationData), &data};
+        isCreated = VulkanUtility::CreateComputePipeline(vkDevice, vkAllocator, computeModule, vkPipelineLayout,
+                                                         &specializationInfo, computePipelines[pass]);
+    }
+
+    // cleanup shader
+    vkDestroyShaderModule(vkDevice, computeModule, vkAllocator);
+
+    return isCreated && createRenderPipeline(renderPass);
+}
+
+bool ParticleSystem::createRenderPipeline(VkRenderPass renderPass)
+{
+    // create shader modules
+    VkShaderModule vertexModule = VK_NULL_HANDLE;
+    VkShaderModule fragmentModule = VK_NULL_HANDLE;
+    if (!VulkanUtility::CreateShaderModule(vkDevice, vkAllocator, "particle.vert.spv", vertexModule) ||
+        !VulkanUtility::CreateShaderModule(vkDevice, vkAllocator, "particle.frag.spv", fragmentModule))
+    {
+        vkDestroyShaderModule(vkDevice, vertexModule, vkAllocator);
+        return false;
+    }
+
+    VkPipelineShaderStageCreateInfo stages[2] = {};
+    stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = vertexModule;
+    stages[0].pName = "main";
+    stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = fragmentModule;
+    stages[1].pName = "main";
+
+    // fixed function state
+    //> quads are generated in the vertex shader, no vertex input
+    VkDynamicState dynamicStates[2] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = 2;
+    dynamicState.pDynamicStates = dynamicStates;
+
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewportState{};
+    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.cullMode = VK_CULL_MODE_NONE;
+    rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
+    rasterizer.lineWidth = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo multisampling{};
+    multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    // depth: tested, not written
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable = VK_TRUE;
+    depthStencil.depthWriteEnable = VK_FALSE;
+    depthStencil.depthCompareOp = isReverseZ ? VK_COMPARE_OP_GREATER_OR_EQUAL : VK_COMPARE_OP_LESS_OR_EQUAL;
+
+    // additive blending, order independent
+    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    colorBlendAttachment.blendEnable = VK_TRUE;
+    colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+
+    VkPipelineColorBlendStateCreateInfo colorBlending{};
+    colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlending.attachmentCount = 1;
+    colorBlending.pAttachments = &colorBlendAttachment;
+
+    // create pipeline
+    VkGraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount = 2;
+    pipelineInfo.pStages = stages;
+    pipelineInfo.pVertexInputState = &vertexInputInfo;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState = &multisampling;
+    pipelineInfo.pDepthStencilState = &depthStencil;
+    pipelineInfo.pColorBlendState = &colorBlending;
+    pipelineInfo.pDynamicState = &dynamicState;
+    pipelineInfo.layout = vkPipelineLayout;
+    pipelineInfo.renderPass = renderPass;
+    pipelineInfo.subpass = 0;
+
+    VkResult result = vkCreateGraphicsPipelines(vkDevice, VK_NULL_HANDLE, 1, &pipelineInfo, vkAllocator, &renderPipeline);
+
+    // cleanup shaders
+    vkDestroyShaderModule(vkDevice, vertexModule, vkAllocator);
+    vkDestroyShaderModule(vkDevice, fragmentModule, vkAllocator);
+
+    if (result != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create particle render pipeline!");
+        return false;
+    }
+    return true;
+}
+
+bool ParticleSystem::createDescriptorPool()
+{
+    // create descriptor pool
+    //> sets are freed individually when a system is destroyed
+    VkDescriptorPoolSize poolSizes[3] = {};
+    poolSizes[0] = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_SYSTEM_COUNT};
+    poolSizes[1] = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5 * MAX_SYSTEM_COUNT};
+    poolSizes[2] = {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_SYSTEM_COUNT};
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    poolInfo.maxSets = MAX_SYSTEM_COUNT;
+    poolInfo.poolSizeCount = 3;
+    poolInfo.pPoolSizes = poolSizes;
+
+    if (vkCreateDescriptorPool(vkDevice, &poolInfo, vkAllocator, &vkDescriptorPool) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create particle descriptor pool!");
+        return false;
+    }
+    return true;
+}
+
+bool ParticleSystem::createDescriptorSet(GpuParticleSystem& system)
+{
+    // allocate set
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = vkDescriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &vkDescriptorSetLayout;
+
+    //> a set destroyed this frame is only freed once its frame completed, the pool can be exhausted until then
+    if (vkAllocateDescriptorSets(vkDevice, &allocInfo, &system.descriptorSet) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to allocate particle descriptor set!");
+        system.descriptorSet = VK_NULL_HANDLE;
+        return false;
+    }
+
+    // write buffers
+    VkDescriptorBufferInfo bufferInfos[6] = {};
+    bufferInfos[0] = {gpuResources->Get(system.paramsBuffer)->buffer, 0, VK_WHOLE_SIZE};
+    bufferInfos[1] = {gpuResources->Get(system.particleBuffer)->buffer, 0, VK_WHOLE_SIZE};
+    bufferInfos[2] = {gpuResources->Get(system.deadBuffer)->buffer, 0, VK_WHOLE_SIZE};
+    bufferInfos[3] = {gpuResources->Get(system.aliveBuffer)->buffer, 0, VK_WHOLE_SIZE};
+    bufferInfos[4] = {gpuResources->Get(system.counterBuffer)->buffer, 0, VK_WHOLE_SIZE};
+    bufferInfos[5] = {gpuResources->Get(system.statsBuffer)->buffer, 0, VK_WHOLE_SIZE};
+
+    VkWriteDescriptorSet writes[6] = {};
+    for (uint32_t binding = 0; binding < 6; ++binding)
+    {
+        writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[binding].dstSet = system.descriptorSet;
+        writes[binding].dstBinding = binding;
+        writes[binding].descriptorCount = 1;
+        writes[binding].descriptorType = binding == 0 ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[binding].pBufferInfo = &bufferInfos[binding];
+    }
+    vkUpdateDescriptorSets(vkDevice, 6, writes, 0, nullptr);
+
+    writeDepthDescriptor(system.descriptorSet);
+    return true;
+}
+
+void ParticleSystem::writeDepthDescriptor(VkDescriptorSet descriptorSet)
+{
+    VkDescriptorImageInfo imageInfo{};
+    imageInfo.sampler = depthSampler;
+    if (depthView != VK_NULL_HANDLE)
+    {
+        imageInfo.imageView = depthView;
+        imageInfo.imageLayout = depthLayout;
+    }
+    else
+    {
+        imageInfo.imageView = gpuResources->Get(fallbackDepthImage)->view;
+        imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = descriptorSet;
+    write.dstBinding = 6;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+    vkUpdateDescriptorSets(vkDevice, 1, &write, 0, nullptr);
+}
+
+#pragma endregion particle_system_create
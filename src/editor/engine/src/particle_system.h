@@ -0,0 +1,204 @@
+#ifndef ARCTIC_PARTICLE_SYSTEM_H
+#define ARCTIC_PARTICLE_SYSTEM_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan_core.h>
+#include "engine/particle_emitter.h"
+#include "utilities/handle_pool.h"
+#include "gpu_resources.h"
+
+struct GpuParticleSystem;
+using ParticleSystemHandle = Handle<GpuParticleSystem>;
+
+// per system gpu state
+//> all buffers are owned by 'GpuResources', the descriptor set by the particle system's pool
+struct GpuParticleSystem
+{
+    ParticleEmitter emitter;
+    uint32_t capacity;
+    float emitAccumulator; // fraction of a particle carried to the next frame
+    uint32_t list; // current alive list
+    bool isReset; // dead list filled
+
+    BufferHandle particleBuffer;
+    BufferHandle deadBuffer;
+    BufferHandle aliveBuffer; // two lists of 'capacity'
+    BufferHandle counterBuffer; // counts & indirect arguments
+    BufferHandle paramsBuffer; // host visible
+    BufferHandle statsBuffer; // host visible
+    VkDescriptorSet descriptorSet;
+};
+
+struct GpuParticleSystemInfo
+{
+    std::string name;
+};
+
+// gpu particle systems: emission, simulation & compaction in compute, drawn with gpu written indirect draws
+//> per frame & system the cpu only uploads the emitter params, the particle count never reaches the cpu
+//> dead particles are recycled through a dead list, survivors are compacted into a ping-pong alive list,
+//> its count becomes the instance count of the indirect draw
+//> passes of all systems are batched, so the barriers do not scale with the system count
+//> collisions read the depth buffer of the previous frame through 'SetDepth', without one they are off
+class ParticleSystem
+{
+public:
+    static constexpr uint32_t MAX_SYSTEM_COUNT = 64;
+    static constexpr uint32_t MAX_CAPACITY = 1u << 24; // particles per system
+    static constexpr float MAX_DELTA_TIME = 0.1f; // seconds, longer frames slow the simulation down
+
+    // matches 'Particle' in particle_simulate.comp
+    struct Particle
+    {
+        glm::vec4 positionAge; // xyz: world position, w: age in seconds
+        glm::vec4 velocityLifetime; // xyz: world velocity, w: lifetime in seconds
+    };
+
+    struct Stats
+    {
+        uint32_t capacity; // budget
+        uint32_t aliveCount;
+        uint32_t deadCount;
+        uint32_t emittedCount; // last frame
+        uint32_t starvedCount; // emit requests dropped last frame, the budget was exhausted
+        uint32_t killedCount;
+        uint32_t collisionCount;
+        uint64_t memorySize; // bytes
+    };
+
+    bool Initialize(VkPhysicalDevice physicalDevice,
+                    VkDevice device,
+                    const VkAllocationCallbacks* allocator,
+                    GpuResources& gpuResources,
+                    DeletionQueue& deletionQueue,
+                    VkRenderPass renderPass,
+                    bool isReverseZ);
+    void Cleanup();
+
+    // returns the null handle when the capacity is invalid or creation failed
+    ParticleSystemHandle Create(const std::string& name, uint32_t capacity, const ParticleEmitter& emitter);
+    // particles in flight finish drawing, destruction is deferred
+    void Destroy(ParticleSystemHandle handle);
+    void SetEmitter(ParticleSystemHandle handle, const ParticleEmitter& emitter);
+
+    void SetCamera(const glm::mat4& view, float fieldOfView, float nearPlane, float farPlane);
+    void SetScreenExtent(VkExtent2D screenExtent);
+    // depth of the scene, sampled by the simulate pass of the next frame
+    //> null disables collisions, the scene covers the top left screen extent of it
+    void SetDepth(VkImageView depthView, VkImageLayout depthLayout, VkExtent2D depthExtent);
+
+    // emits & simulates all systems, must be recorded outside of a render pass
+    void RecordSimulation(VkCommandBuffer commandBuffer);
+    // draws all systems in the active render pass, returns the draw call count
+    uint32_t RecordDraw(VkCommandBuffer commandBuffer);
+
+    // stats of the last completed frame
+    Stats GetStats(ParticleSystemHandle handle) const;
+    void PrintStats() const;
+
+private:
+    // matches 'ParticleParams' in particle_simulate.comp & particle.vert
+    struct ParticleParams
+    {
+        glm::mat4 viewProjection;
+        glm::mat4 inverseViewProjection;
+        glm::vec4 cameraRight;
+        glm::vec4 cameraUp;
+        glm::vec4 emitterPositionRadius;
+        glm::vec4 emitterVelocitySpread;
+        glm::vec4 colorStart;
+        glm::vec4 colorEnd;
+        glm::vec4 gravityDrag;
+        glm::vec4 noise;
+        glm::vec4 lifetimeSize;
+        glm::vec4 collision;
+        glm::vec4 time;
+        glm::uvec4 counts;
+    };
+
+    // matches 'Counters' in particle_simulate.comp (std430)
+    struct GpuCounters
+    {
+        uint32_t aliveCounts[2];
+        uint32_t deadCount;
+        uint32_t emitCount;
+        VkDispatchIndirectCommand emitDispatch;
+        uint32_t padding0;
+        VkDispatchIndirectCommand simulateDispatch;
+        uint32_t padding1;
+        VkDrawIndirectCommand draw;
+    };
+
+    // matches 'Stats' in particle_simulate.comp
+    struct GpuStats
+    {
+        uint32_t emittedCount;
+        uint32_t starvedCount;
+        uint32_t killedCount;
+        uint32_t collisionCount;
+        uint32_t aliveCount;
+        uint32_t deadCount;
+    };
+
+    enum class Pass : uint32_t
+    {
+        Reset,
+        Prepare,
+        Emit,
+        Simulate,
+        Count
+    };
+
+    VkPhysicalDevice vkPhysicalDevice = VK_NULL_HANDLE;
+    VkDevice vkDevice = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* vkAllocator = nullptr;
+    GpuResources* gpuResources = nullptr;
+    DeletionQueue* deletionQueue = nullptr;
+    bool isReverseZ = false;
+
+    HandlePool<GpuParticleSystem, GpuParticleSystemInfo> systems;
+
+    // camera
+    VkExtent2D extent{1, 1};
+    glm::mat4 view{1.0f};
+    glm::mat4 projection{1.0f};
+    float fieldOfView = glm::radians(60.0f);
+    float nearPlane = 0.1f;
+    float farPlane = 100.0f;
+
+    // time
+    std::chrono::steady_clock::time_point lastFrameTime{};
+    float totalTime = 0.0f;
+    uint32_t frameSeed = 0;
+
+    // depth
+    //> a 1x1 image stands in while no depth is set, the binding has to stay valid
+    VkImageView depthView = VK_NULL_HANDLE;
+    VkImageLayout depthLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    VkExtent2D depthExtent{1, 1};
+    ImageHandle fallbackDepthImage;
+    bool isFallbackDepthInitialized = false;
+    VkSampler depthSampler = VK_NULL_HANDLE;
+
+    // pipelines
+    VkDescriptorSetLayout vkDescriptorSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout vkPipelineLayout = VK_NULL_HANDLE;
+    VkPipeline computePipelines[static_cast<uint32_t>(Pass::Count)] = {};
+    VkPipeline renderPipeline = VK_NULL_HANDLE;
+    VkDescriptorPool vkDescriptorPool = VK_NULL_HANDLE;
+
+    bool createDepthFallback();
+    bool createPipelines(VkRenderPass renderPass);
+    bool createRenderPipeline(VkRenderPass renderPass);
+    bool createDescriptorPool();
+    bool createDescriptorSet(GpuParticleSystem& system);
+    void writeDepthDescriptor(VkDescriptorSet descriptorSet);
+    void writeParams(GpuParticleSystem& system, float deltaTime, uint32_t emitRequest);
+    void destroySystem(const GpuParticleSystem& system);
+    void recordPass(VkCommandBuffer commandBuffer, Pass pass);
+};
+
+#endif //ARCTIC_PARTICLE_SYSTEM_H
@@ -0,0 +1,152 @@
+#include "pipeline_statistics.h"
+#include "utilities/logger.h"
+#include <cstring>
+#include <format>
+#include <iostream>
+
+namespace
+{
+    const VkQueryPipelineStatisticFlags STATISTIC_FLAGS =
+            VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+
+    const uint32_t COUNTER_COUNT = sizeof(PipelineStatistics::Counters) / sizeof(uint64_t);
+}
+
+bool PipelineStatistics::Initialize(VkDevice device, const VkAllocationCallbacks* allocator, bool isSupported)
+{
+    vkDevice = device;
+    vkAllocator = allocator;
+    if (!isSupported)
+        return true;
+
+    // create info: query pool
+    //> one query per pass
+    VkQueryPoolCreateInfo queryPoolInfo{};
+    queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+    queryPoolInfo.queryCount = PASS_COUNT;
+    queryPoolInfo.pipelineStatistics = STATISTIC_FLAGS;
+
+    if (vkCreateQueryPool(vkDevice, &queryPoolInfo, vkAllocator, &vkQueryPool) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create pipeline statistics query pool!");
+        return false;
+    }
+    return true;
+}
+
+void PipelineStatistics::Cleanup()
+{
+    if (vkQueryPool != VK_NULL_HANDLE)
+        vkDestroyQueryPool(vkDevice, vkQueryPool, vkAllocator);
+    vkQueryPool = VK_NULL_HANDLE;
+}
+
+void PipelineStatistics::Reset(VkCommandBuffer commandBuffer)
+{
+    if (vkQueryPool == VK_NULL_HANDLE)
+        return;
+
+    vkCmdResetQueryPool(commandBuffer, vkQueryPool, 0, PASS_COUNT);
+    activePass = NO_PASS;
+    recordedPassMask = 0;
+    hasResults = true;
+}
+
+void PipelineStatistics::Begin(VkCommandBuffer commandBuffer, Pass pass)
+{
+    const auto passIndex = static_cast<uint32_t>(pass);
+    if (vkQueryPool == VK_NULL_HANDLE || passIndex == activePass || (recordedPassMask & (1u << passIndex)) != 0)
+        return;
+
+    End(commandBuffer);
+    vkCmdBeginQuery(commandBuffer, vkQueryPool, passIndex, 0);
+    activePass = passIndex;
+    recordedPassMask |= 1u << passIndex;
+}
+
+void PipelineStatistics::End(VkCommandBuffer commandBuffer)
+{
+    if (activePass == NO_PASS)
+        return;
+
+    vkCmdEndQuery(commandBuffer, vkQueryPool, activePass);
+    activePass = NO_PASS;
+}
+
+void PipelineStatistics::Read()
+{
+    if (vkQueryPool == VK_NULL_HANDLE || !hasResults)
+        return;
+
+    // read all passes
+    //> each result is followed by its availability, passes that did not run this frame are unavailable & count zero
+    uint64_t results[PASS_COUNT][COUNTER_COUNT + 1] = {};
+    vkGetQueryPoolResults(vkDevice, vkQueryPool, 0, PASS_COUNT, sizeof(results), results, sizeof(results[0]),
+                          VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+    for (uint32_t pass = 0; pass < PASS_COUNT; ++pass)
+    {
+        counters[pass] = {};
+        if (results[pass][COUNTER_COUNT] != 0)
+            std::memcpy(&counters[pass], results[pass], sizeof(Counters));
+    }
+}
+
+const char* PipelineStatistics::GetPassName(Pass pass)
+{
+    switch (pass)
+    {
+        case Pass::Compute: return "compute";
+        case Pass::DepthPrepass: return "depth_prepass";
+        case Pass::Shading: return "shading";
+        case Pass::Particles: return "particles";
+        case Pass::Upscale: return "upscale";
+        default: return "unknown";
+    }
+}
+
+void PipelineStatistics::PrintStats() const
+{
+    std::cout << "info: vulkan: pipeline statistics:" << std::endl;
+    if (vkQueryPool == VK_NULL_HANDLE)
+    {
+        std::cout << "\tnot supported" << std::endl;
+        return;
+    }
+
+    for (uint32_t pass = 0; pass < PASS_COUNT; ++pass)
+    {
+        const Counters& passCounters = counters[pass];
+        std::cout << std::format("\t{}: vertices {}, clipping in {} out {}, fragments {}, compute {}",
+                                 GetPassName(static_cast<Pass>(pass)),
+                                 passCounters.vertexInvocations,
+                                 passCounters.clippingInvocations,
+                                 passCounters.clippingPrimitives,
+                                 passCounters.fragmentInvocations,
+                                 passCounters.computeInvocations) << std::endl;
+    }
+}
+
+std::string PipelineStatistics::ToJson() const
+{
+    std::string json = "{";
+    for (uint32_t pass = 0; pass < PASS_COUNT; ++pass)
+    {
+        const Counters& passCounters = counters[pass];
+        json += std::format(R"({}"{}":{{"vertex_invocations":{},"clipping_invocations":{},"clipping_primitives":{},"fragment_invocations":{},"compute_invocations":{}}})",
+                            pass == 0 ? "" : ",",
+                            GetPassName(static_cast<Pass>(pass)),
+                            passCounters.vertexInvocations,
+                            passCounters.clippingInvocations,
+                            passCounters.clippingPrimitives,
+                            passCounters.fragmentInvocations,
+                            passCounters.computeInvocations);
+    }
+    json += "}";
+    return json;
+}
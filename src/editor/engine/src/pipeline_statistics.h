@@ -0,0 +1,83 @@
+#ifndef ARCTIC_PIPELINE_STATISTICS_H
+#define ARCTIC_PIPELINE_STATISTICS_H
+
+#include <cstdint>
+#include <string>
+#include <vulkan/vulkan_core.h>
+
+// gpu counters per pass from pipeline statistics queries
+//> one query per pass & frame, passes must not overlap, only one query of a type can be active at once
+//> a pass that begins again in the same frame keeps counting into the active query
+//> results are read after the fence of their frame, so they describe the previous frame
+//> without 'pipelineStatisticsQuery' nothing is recorded & the counters stay zero
+//> how to read them:
+//> - vertex bound: many vertex invocations per clipped primitive or fragment
+//> - fill bound: fragment invocations far above the pixel count
+//> - cpu bound: low counters while the frame time stays high
+class PipelineStatistics
+{
+public:
+    enum class Pass : uint32_t
+    {
+        Compute, // light binning, skinning & particle simulation
+        DepthPrepass,
+        Shading,
+        Particles,
+        Upscale,
+
+        Count
+    };
+
+    // in the order the query writes them
+    struct Counters
+    {
+        uint64_t vertexInvocations;
+        uint64_t clippingInvocations; // primitives entering the clipper
+        uint64_t clippingPrimitives; // primitives leaving it
+        uint64_t fragmentInvocations;
+        uint64_t computeInvocations;
+    };
+
+    static constexpr uint32_t PASS_COUNT = static_cast<uint32_t>(Pass::Count);
+
+    // 'isSupported': the 'pipelineStatisticsQuery' feature is enabled
+    bool Initialize(VkDevice device, const VkAllocationCallbacks* allocator, bool isSupported);
+    void Cleanup();
+
+    // must be recorded outside of a render pass, before the first pass of the frame
+    void Reset(VkCommandBuffer commandBuffer);
+    // ends the active pass, passes that were already recorded this frame are not counted again
+    //> a pass begun in a render pass must end in it
+    void Begin(VkCommandBuffer commandBuffer, Pass pass);
+    void End(VkCommandBuffer commandBuffer);
+
+    // reads the frame that was reset last, its fence must have signaled
+    void Read();
+
+    bool IsSupported() const {
+        return vkQueryPool != VK_NULL_HANDLE;
+    }
+    const Counters& GetCounters(Pass pass) const {
+        return counters[static_cast<uint32_t>(pass)];
+    }
+    static const char* GetPassName(Pass pass);
+
+    void PrintStats() const;
+    // one json object, the counters of each pass by name
+    std::string ToJson() const;
+
+private:
+    static constexpr uint32_t NO_PASS = UINT32_MAX;
+
+    VkDevice vkDevice = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* vkAllocator = nullptr;
+    VkQueryPool vkQueryPool = VK_NULL_HANDLE;
+
+    uint32_t activePass = NO_PASS;
+    uint32_t recordedPassMask = 0; // passes begun since the reset
+    bool hasResults = false; // a frame was reset & recorded
+
+    Counters counters[PASS_COUNT] = {};
+};
+
+#endif //ARCTIC_PIPELINE_STATISTICS_H
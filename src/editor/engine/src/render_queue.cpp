@@ -0,0 +1,125 @@
+#include "render_queue.h"
+#include <algorithm>
+
+uint64_t RenderQueue::MakeKey(DrawPass pass, ShaderPermutationKey pipeline, uint16_t material, uint16_t mesh, float depth)
+{
+    // quantize depth
+    //> transparent draws are blended back to front, so their depth is inverted
+    auto depthBits = static_cast<uint32_t>(std::clamp(depth, 0.0f, 1.0f) * static_cast<float>(DEPTH_MAX));
+    depthBits = std::min(depthBits, DEPTH_MAX);
+    if (pass == DrawPass::Transparent)
+        depthBits = DEPTH_MAX - depthBits;
+
+    return (static_cast<uint64_t>(pass) << (PIPELINE_BITS + MATERIAL_BITS + MESH_BITS + DEPTH_BITS)) |
+           (static_cast<uint64_t>(pipeline & ((1u << PIPELINE_BITS) - 1)) << (MATERIAL_BITS + MESH_BITS + DEPTH_BITS)) |
+           (static_cast<uint64_t>(material) << (MESH_BITS + DEPTH_BITS)) |
+           (static_cast<uint64_t>(mesh & MESH_MAX) << DEPTH_BITS) |
+           static_cast<uint64_t>(depthBits);
+}
+
+void RenderQueue::Reset()
+{
+    keys.clear();
+    itemIndices.clear();
+    items.clear();
+    stats = {};
+}
+
+void RenderQueue::Submit(uint64_t key, const DrawItem& item)
+{
+    // split into prepass & equal shading
+    //> the prepass copy keeps material, mesh & depth, so both passes sort front to back the same way
+    const ShaderPermutationKey pipeline = GetPipeline(key);
+    if (isDepthPrepassEnabled && GetPass(key) == DrawPass::Opaque &&
+        ShaderPermutation::GetDepthMode(pipeline) == DepthMode::TestWrite)
+    {
+        const uint64_t lowBits = key & ((1ull << (MATERIAL_BITS + MESH_BITS + DEPTH_BITS)) - 1);
+        const uint64_t prepassPipeline = ShaderPermutation::WithDepthMode(pipeline, DepthMode::Prepass);
+        const uint64_t equalPipeline = ShaderPermutation::WithDepthMode(pipeline, DepthMode::Equal);
+
+        keys.push_back((static_cast<uint64_t>(DrawPass::DepthPrepass) << (PIPELINE_BITS + MATERIAL_BITS + MESH_BITS + DEPTH_BITS)) |
+                       (prepassPipeline << (MATERIAL_BITS + MESH_BITS + DEPTH_BITS)) | lowBits);
+        itemIndices.push_back(static_cast<uint32_t>(items.size()));
+        ++stats.prepassCount;
+
+        key = (static_cast<uint64_t>(DrawPass::Opaque) << (PIPELINE_BITS + MATERIAL_BITS + MESH_BITS + DEPTH_BITS)) |
+              (equalPipeline << (MATERIAL_BITS + MESH_BITS + DEPTH_BITS)) | lowBits;
+    }
+
+    keys.push_back(key);
+    itemIndices.push_back(static_cast<uint32_t>(items.size()));
+    items.push_back(item);
+    ++stats.submittedCount;
+}
+
+void RenderQueue::Sort(JobSystem* jobSystem)
+{
+    sorter.Sort(keys.data(), itemIndices.data(), static_cast<uint32_t>(keys.size()), jobSystem);
+}
+
+void RenderQueue::Record(CommandStream& stream)
+{
+    runDraws.clear();
+
+    uint64_t stateKey = 0;
+    bool hasState = false;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        const uint64_t key = keys[i];
+        const DrawItem& item = items[itemIndices[i]];
+
+        // state change
+        //> everything above the depth bits is state
+        if (!hasState || (key >> DEPTH_BITS) != (stateKey >> DEPTH_BITS))
+        {
+            flushRun(stream);
+
+            if (!hasState || GetPipeline(key) != GetPipeline(stateKey))
+            {
+                stream.BindPipeline({GetPipeline(key)});
+                ++stats.pipelineChangeCount;
+            }
+            if (!hasState || GetMaterial(key) != GetMaterial(stateKey))
+                ++stats.materialChangeCount;
+            if (!hasState || GetMesh(key) != GetMesh(stateKey))
+                ++stats.meshChangeCount;
+
+            stateKey = key;
+            hasState = true;
+        }
+
+        // merge into the previous draw when this is its next instance
+        if (!runDraws.empty())
+        {
+            CommandDraw& previous = runDraws.back();
+            if (previous.vertexCount == item.vertexCount &&
+                previous.firstVertex == item.firstVertex &&
+                previous.firstInstance + previous.instanceCount == item.instanceIndex)
+            {
+                ++previous.instanceCount;
+                ++stats.instancedMergeCount;
+                continue;
+            }
+        }
+        runDraws.push_back({item.vertexCount, 1, item.firstVertex, item.instanceIndex});
+    }
+    flushRun(stream);
+}
+
+void RenderQueue::flushRun(CommandStream& stream)
+{
+    if (runDraws.empty())
+        return;
+
+    if (runDraws.size() == 1)
+    {
+        stream.Draw(runDraws.front());
+    }
+    else
+    {
+        stream.MultiDraw(runDraws.data(), static_cast<uint32_t>(runDraws.size()));
+        ++stats.multiDrawCount;
+    }
+    stats.drawCount += static_cast<uint32_t>(runDraws.size());
+    runDraws.clear();
+}
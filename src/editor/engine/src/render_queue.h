@@ -0,0 +1,113 @@
+#ifndef ARCTIC_RENDER_QUEUE_H
+#define ARCTIC_RENDER_QUEUE_H
+
+#include <cstdint>
+#include <vector>
+#include "command_stream.h"
+#include "shader_permutation.h"
+#include "utilities/radix_sort.h"
+
+class JobSystem;
+
+// passes in submission order, the pass is the most significant part of the sort key
+enum class DrawPass : uint8_t
+{
+    DepthPrepass = 0, // front to back, filled from the opaque draws (see 'SetDepthPrepass')
+    Opaque = 1, // front to back
+    Transparent = 2, // back to front
+
+    Count
+};
+
+// collects the draws of a frame and records them sorted by state
+//> every draw submits a 64-bit key: pass (4) | pipeline (16) | material (16) | mesh (12) | depth (16), most significant first
+//> sorting groups draws sharing a pipeline, material & mesh, so each state change is recorded once,
+//> and adjacent draws of the same state are merged into instanced draws or a single multi-draw
+//> draws of different meshes are never merged, their index ranges address different buffers
+class RenderQueue
+{
+public:
+    static constexpr uint32_t PASS_BITS = 4;
+    static constexpr uint32_t PIPELINE_BITS = 16;
+    static constexpr uint32_t MATERIAL_BITS = 16;
+    static constexpr uint32_t MESH_BITS = 12;
+    static constexpr uint32_t MESH_MAX = (1u << MESH_BITS) - 1;
+    static constexpr uint32_t DEPTH_BITS = 16;
+    static constexpr uint32_t DEPTH_MAX = (1u << DEPTH_BITS) - 1;
+    static_assert(PASS_BITS + PIPELINE_BITS + MATERIAL_BITS + MESH_BITS + DEPTH_BITS == 64);
+
+    // the pipeline field holds the permutation key, so every feature & the depth mode need a bit in it
+    static_assert(static_cast<uint32_t>(ShaderFeature::Count) <= PIPELINE_BITS);
+    static_assert(ShaderPermutation::DEPTH_MODE_SHIFT + ShaderPermutation::DEPTH_MODE_BITS <= PIPELINE_BITS);
+    static_assert(static_cast<uint32_t>(DrawPass::Count) <= (1u << PASS_BITS));
+
+    // instances are drawn with 'firstInstance' = 'instanceIndex'
+    //> shaders read the draw constants of the frame at their instance index
+    struct DrawItem
+    {
+        uint32_t vertexCount;
+        uint32_t firstVertex;
+        uint32_t instanceIndex;
+    };
+
+    struct Stats
+    {
+        uint32_t submittedCount;
+        uint32_t prepassCount; // opaque draws repeated in the depth prepass
+        uint32_t drawCount; // draws left after merging, including the draws inside multi-draws
+        uint32_t instancedMergeCount; // submitted draws folded into the instance range of the previous draw
+        uint32_t multiDrawCount; // multi-draw commands
+        uint32_t pipelineChangeCount;
+        uint32_t materialChangeCount;
+        uint32_t meshChangeCount;
+    };
+
+    // depth is the view depth normalized to [0, 1], mesh is below 'MESH_MAX'
+    static uint64_t MakeKey(DrawPass pass, ShaderPermutationKey pipeline, uint16_t material, uint16_t mesh, float depth);
+    static DrawPass GetPass(uint64_t key) {
+        return static_cast<DrawPass>(key >> (PIPELINE_BITS + MATERIAL_BITS + MESH_BITS + DEPTH_BITS));
+    }
+    static ShaderPermutationKey GetPipeline(uint64_t key) {
+        return static_cast<ShaderPermutationKey>(key >> (MATERIAL_BITS + MESH_BITS + DEPTH_BITS)) & ((1u << PIPELINE_BITS) - 1);
+    }
+    static uint16_t GetMaterial(uint64_t key) {
+        return static_cast<uint16_t>(key >> (MESH_BITS + DEPTH_BITS));
+    }
+    static uint16_t GetMesh(uint64_t key) {
+        return static_cast<uint16_t>(key >> DEPTH_BITS) & MESH_MAX;
+    }
+
+    // opaque draws with 'DepthMode::TestWrite' are also queued depth only in the prepass,
+    //> then shaded with 'DepthMode::Equal', so each pixel runs the fragment stage of one draw only
+    void SetDepthPrepass(bool isEnabled) {
+        isDepthPrepassEnabled = isEnabled;
+    }
+
+    void Reset();
+    void Submit(uint64_t key, const DrawItem& item);
+
+    // sorts the submitted draws, large queues are sorted on the job system
+    void Sort(JobSystem* jobSystem);
+
+    // records the sorted draws, must be called inside a render pass
+    //> the pipeline is bound on change only, material & mesh changes split draws that could be merged
+    void Record(CommandStream& stream);
+
+    const Stats& GetStats() const {
+        return stats;
+    }
+
+private:
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> itemIndices; // sorted along with the keys
+    std::vector<DrawItem> items;
+    RadixSorter sorter;
+    bool isDepthPrepassEnabled = false;
+
+    std::vector<CommandDraw> runDraws; // merged draws of the current state
+    Stats stats{};
+
+    void flushRun(CommandStream& stream);
+};
+
+#endif //ARCTIC_RENDER_QUEUE_H
@@ -0,0 +1,352 @@
+#include "scene.h"
+#include "utilities/logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+    uint64_t alignSection(uint64_t offset)
+    {
+        return (offset + Scene::SECTION_ALIGNMENT - 1) & ~(Scene::SECTION_ALIGNMENT - 1);
+    }
+
+    size_t getComponentSize(SceneComponentType type)
+    {
+        switch (type)
+        {
+            case SceneComponentType::Mesh: return sizeof(SceneMeshComponent);
+            case SceneComponentType::Light: return sizeof(SceneLightComponent);
+            case SceneComponentType::Collider: return sizeof(SceneColliderComponent);
+            default: return 0;
+        }
+    }
+}
+
+bool Scene::Load(const std::string& path)
+{
+    Unload();
+
+    // map
+    auto mapStart = std::chrono::steady_clock::now();
+    if (!file.Open(path))
+    {
+        ARCTIC_LOG_ERROR(Assets, "failed to map {}!", path);
+        return false;
+    }
+    auto mapEnd = std::chrono::steady_clock::now();
+
+    // check schema
+    char* data = file.GetData();
+    const size_t size = file.GetSize();
+    auto* mappedHeader = reinterpret_cast<SceneHeader*>(data);
+    if (size < sizeof(SceneHeader) || mappedHeader->magic != MAGIC)
+    {
+        ARCTIC_LOG_ERROR(Assets, "{} is not a scene!", path);
+        Unload();
+        return false;
+    }
+    if (mappedHeader->version != VERSION ||
+        mappedHeader->entitySize != sizeof(SceneEntity) ||
+        mappedHeader->transformSize != sizeof(SceneTransform) ||
+        mappedHeader->componentSize != sizeof(SceneComponent) ||
+        mappedHeader->assetSize != sizeof(SceneAsset))
+    {
+        ARCTIC_LOG_ERROR(Assets, "{} has scene schema version {}, expected {}, convert it again from its text form!",
+                         path, mappedHeader->version, VERSION);
+        Unload();
+        return false;
+    }
+    if (mappedHeader->fileSize != size ||
+        mappedHeader->fixupOffset % sizeof(uint64_t) != 0 ||
+        mappedHeader->fixupOffset < sizeof(SceneHeader) ||
+        mappedHeader->fixupOffset > size ||
+        mappedHeader->fixupCount > (size - mappedHeader->fixupOffset) / sizeof(uint64_t))
+    {
+        ARCTIC_LOG_ERROR(Assets, "{} is truncated!", path);
+        Unload();
+        return false;
+    }
+
+    // apply fixups
+    //> pointers lie before the fixup table, each is checked before it is patched, a corrupt file
+    //> must not write outside of the mapping, the targets are checked afterwards by 'validate'
+    //> the bounds are compared without adding to the untrusted values, which could wrap around
+    const auto base = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(data));
+    const char* fixups = data + mappedHeader->fixupOffset;
+    for (uint32_t i = 0; i < mappedHeader->fixupCount; ++i)
+    {
+        uint64_t slot;
+        std::memcpy(&slot, fixups + i * sizeof(uint64_t), sizeof(uint64_t));
+        if (slot % sizeof(uint64_t) != 0 || slot > mappedHeader->fixupOffset - sizeof(uint64_t))
+        {
+            ARCTIC_LOG_ERROR(Assets, "{} has an invalid fixup!", path);
+            Unload();
+            return false;
+        }
+
+        auto* pointer = reinterpret_cast<uint64_t*>(data + slot);
+        *pointer += base;
+    }
+
+    header = mappedHeader;
+    if (!validate())
+    {
+        ARCTIC_LOG_ERROR(Assets, "{} is corrupt!", path);
+        Unload();
+        return false;
+    }
+    auto fixupEnd = std::chrono::steady_clock::now();
+
+    stats.fileSize = size;
+    stats.fixupCount = header->fixupCount;
+    stats.mapTime = std::chrono::duration<float, std::milli>(mapEnd - mapStart).count();
+    stats.fixupTime = std::chrono::duration<float, std::milli>(fixupEnd - mapEnd).count();
+    return true;
+}
+
+void Scene::Unload()
+{
+    file.Close();
+    header = nullptr;
+    stats = {};
+}
+
+bool Scene::validate() const
+{
+    // pointer & length inside of the mapping
+    const char* begin = file.GetData();
+    const char* end = begin + file.GetSize();
+    auto isInside = [begin, end](const void* pointer, size_t length, size_t alignment) {
+        auto* bytes = static_cast<const char*>(pointer);
+        return bytes >= begin && bytes <= end && static_cast<size_t>(end - bytes) >= length &&
+               reinterpret_cast<uintptr_t>(bytes) % alignment == 0;
+    };
+
+    // sections
+    //> the file ends with a terminator, so a name inside of the file ends inside of it as well
+    if (end[-1] != '\0' ||
+        !isInside(header->entities.Get(), header->entityCount * sizeof(SceneEntity), alignof(SceneEntity)) ||
+        !isInside(header->transforms.Get(), header->entityCount * sizeof(SceneTransform), alignof(SceneTransform)) ||
+        !isInside(header->components.Get(), header->componentCount * sizeof(SceneComponent), alignof(SceneComponent)) ||
+        !isInside(header->assets.Get(), header->assetCount * sizeof(SceneAsset), alignof(SceneAsset)))
+        return false;
+
+    // entities
+    //> parents come first, so the hierarchy has no cycles
+    for (uint32_t i = 0; i < header->entityCount; ++i)
+    {
+        const SceneEntity& entity = GetEntity(i);
+        if (!isInside(entity.name.Get(), 1, 1) ||
+            (entity.parent != NO_PARENT && entity.parent >= i) ||
+            static_cast<uint64_t>(entity.firstComponent) + entity.componentCount > header->componentCount)
+            return false;
+    }
+
+    // components
+    for (uint32_t i = 0; i < header->componentCount; ++i)
+    {
+        const SceneComponent& component = header->components.Get()[i];
+        const size_t componentSize = getComponentSize(component.type);
+        if (componentSize == 0 || component.entity >= header->entityCount ||
+            !isInside(component.data.Get(), componentSize, alignof(float)))
+            return false;
+
+        if (component.type == SceneComponentType::Mesh)
+        {
+            auto* mesh = static_cast<const SceneMeshComponent*>(component.data.Get());
+            if (mesh->mesh >= header->assetCount || mesh->material >= header->assetCount)
+                return false;
+        }
+    }
+
+    // assets
+    for (uint32_t i = 0; i < header->assetCount; ++i)
+    {
+        const SceneAsset& asset = GetAsset(i);
+        if (asset.type >= SceneAssetType::Count || !isInside(asset.path.Get(), 1, 1))
+            return false;
+    }
+    return true;
+}
+
+void Scene::PrintStats() const
+{
+    std::cout << "info: scene:" << std::endl;
+    if (!IsLoaded())
+    {
+        std::cout << "\tnot loaded" << std::endl;
+        return;
+    }
+
+    std::cout << std::format("\tentities {}, components {}, assets {}",
+                             header->entityCount,
+                             header->componentCount,
+                             header->assetCount) << std::endl;
+    std::cout << std::format("\tfile {} bytes, fixups {}, map {:.3f} ms, fixup {:.3f} ms",
+                             stats.fileSize,
+                             stats.fixupCount,
+                             stats.mapTime,
+                             stats.fixupTime) << std::endl;
+}
+
+uint32_t SceneDescription::AddAsset(SceneAssetType type, const std::string& path)
+{
+    for (size_t i = 0; i < assets.size(); ++i)
+    {
+        if (assets[i].type == type && assets[i].path == path)
+            return static_cast<uint32_t>(i);
+    }
+    assets.push_back({type, path});
+    return static_cast<uint32_t>(assets.size() - 1);
+}
+
+bool SceneDescription::Save(const std::string& path) const
+{
+    // collect components
+    //> grouped by entity, each data record aligned to 8 bytes
+    struct ComponentRecord
+    {
+        SceneComponentType type;
+        uint32_t entity;
+        const void* data;
+    };
+    std::vector<ComponentRecord> componentRecords;
+    std::vector<uint32_t> firstComponents;
+    for (size_t i = 0; i < entities.size(); ++i)
+    {
+        const Entity& entity = entities[i];
+        const auto entityIndex = static_cast<uint32_t>(i);
+        if (entity.parent != Scene::NO_PARENT && entity.parent >= entityIndex)
+        {
+            ARCTIC_LOG_ERROR(Cook, "parent of {} must be stored before it!", entity.name);
+            return false;
+        }
+
+        firstComponents.push_back(static_cast<uint32_t>(componentRecords.size()));
+        if (entity.mesh)
+            componentRecords.push_back({SceneComponentType::Mesh, entityIndex, &*entity.mesh});
+        if (entity.light)
+            componentRecords.push_back({SceneComponentType::Light, entityIndex, &*entity.light});
+        if (entity.collider)
+            componentRecords.push_back({SceneComponentType::Collider, entityIndex, &*entity.collider});
+    }
+
+    // lay out sections
+    const uint64_t entityOffset = alignSection(sizeof(SceneHeader));
+    const uint64_t transformOffset = alignSection(entityOffset + entities.size() * sizeof(SceneEntity));
+    const uint64_t componentOffset = alignSection(transformOffset + entities.size() * sizeof(SceneTransform));
+    const uint64_t componentDataOffset = alignSection(componentOffset + componentRecords.size() * sizeof(SceneComponent));
+
+    std::vector<uint64_t> componentDataOffsets;
+    uint64_t componentDataEnd = componentDataOffset;
+    for (const auto& record : componentRecords)
+    {
+        componentDataOffsets.push_back(componentDataEnd);
+        componentDataEnd = (componentDataEnd + getComponentSize(record.type) + 7) & ~7ull;
+    }
+
+    const uint64_t assetOffset = alignSection(componentDataEnd);
+    const uint64_t fixupOffset = alignSection(assetOffset + assets.size() * sizeof(SceneAsset));
+    const uint64_t fixupCount = 4 + entities.size() + componentRecords.size() + assets.size();
+    const uint64_t stringOffset = alignSection(fixupOffset + fixupCount * sizeof(uint64_t));
+
+    std::vector<uint64_t> stringOffsets;
+    uint64_t stringEnd = stringOffset;
+    for (const auto& entity : entities)
+    {
+        stringOffsets.push_back(stringEnd);
+        stringEnd += entity.name.size() + 1;
+    }
+    for (const auto& asset : assets)
+    {
+        stringOffsets.push_back(stringEnd);
+        stringEnd += asset.path.size() + 1;
+    }
+    const uint64_t fileSize = stringEnd + 1; // terminator, also when there are no strings
+
+    // write image
+    //> pointers hold their target offset, their own offset goes to the fixup table
+    std::vector<char> image(fileSize, 0);
+    std::vector<uint64_t> fixups;
+    auto writePointer = [&image, &fixups](uint64_t slotOffset, uint64_t targetOffset) {
+        std::memcpy(image.data() + slotOffset, &targetOffset, sizeof(uint64_t));
+        fixups.push_back(slotOffset);
+    };
+
+    SceneHeader header{};
+    header.magic = Scene::MAGIC;
+    header.version = Scene::VERSION;
+    header.fileSize = fileSize;
+    header.entitySize = sizeof(SceneEntity);
+    header.transformSize = sizeof(SceneTransform);
+    header.componentSize = sizeof(SceneComponent);
+    header.assetSize = sizeof(SceneAsset);
+    header.fixupOffset = fixupOffset;
+    header.entityCount = static_cast<uint32_t>(entities.size());
+    header.componentCount = static_cast<uint32_t>(componentRecords.size());
+    header.assetCount = static_cast<uint32_t>(assets.size());
+    header.fixupCount = static_cast<uint32_t>(fixupCount);
+    std::memcpy(image.data(), &header, sizeof(header));
+    writePointer(offsetof(SceneHeader, entities), entityOffset);
+    writePointer(offsetof(SceneHeader, transforms), transformOffset);
+    writePointer(offsetof(SceneHeader, components), componentOffset);
+    writePointer(offsetof(SceneHeader, assets), assetOffset);
+
+    for (size_t i = 0; i < entities.size(); ++i)
+    {
+        SceneEntity entity{};
+        entity.parent = entities[i].parent;
+        entity.firstComponent = firstComponents[i];
+        entity.componentCount = (i + 1 < entities.size() ? firstComponents[i + 1] : header.componentCount) - firstComponents[i];
+
+        const uint64_t entityRecordOffset = entityOffset + i * sizeof(SceneEntity);
+        std::memcpy(image.data() + entityRecordOffset, &entity, sizeof(entity));
+        writePointer(entityRecordOffset + offsetof(SceneEntity, name), stringOffsets[i]);
+        std::memcpy(image.data() + transformOffset + i * sizeof(SceneTransform), &entities[i].transform, sizeof(SceneTransform));
+        std::memcpy(image.data() + stringOffsets[i], entities[i].name.c_str(), entities[i].name.size());
+    }
+
+    for (size_t i = 0; i < componentRecords.size(); ++i)
+    {
+        const ComponentRecord& record = componentRecords[i];
+        SceneComponent component{};
+        component.type = record.type;
+        component.entity = record.entity;
+
+        const uint64_t componentRecordOffset = componentOffset + i * sizeof(SceneComponent);
+        std::memcpy(image.data() + componentRecordOffset, &component, sizeof(component));
+        writePointer(componentRecordOffset + offsetof(SceneComponent, data), componentDataOffsets[i]);
+        std::memcpy(image.data() + componentDataOffsets[i], record.data, getComponentSize(record.type));
+    }
+
+    for (size_t i = 0; i < assets.size(); ++i)
+    {
+        SceneAsset asset{};
+        asset.type = assets[i].type;
+
+        const uint64_t assetRecordOffset = assetOffset + i * sizeof(SceneAsset);
+        const uint64_t pathOffset = stringOffsets[entities.size() + i];
+        std::memcpy(image.data() + assetRecordOffset, &asset, sizeof(asset));
+        writePointer(assetRecordOffset + offsetof(SceneAsset, path), pathOffset);
+        std::memcpy(image.data() + pathOffset, assets[i].path.c_str(), assets[i].path.size());
+    }
+
+    //> ascending, so the fixups walk the mapping front to back
+    std::sort(fixups.begin(), fixups.end());
+    std::memcpy(image.data() + fixupOffset, fixups.data(), fixups.size() * sizeof(uint64_t));
+
+    // write file
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        ARCTIC_LOG_ERROR(Cook, "failed to open {} for writing!", path);
+        return false;
+    }
+    file.write(image.data(), static_cast<std::streamsize>(image.size()));
+    return file.good();
+}
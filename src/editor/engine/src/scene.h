@@ -0,0 +1,228 @@
+#ifndef ARCTIC_SCENE_H
+#define ARCTIC_SCENE_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "utilities/file_utility.h"
+
+// relocatable binary scene ('.scene'), converted from text ('.scn') by 'ArcticCook'
+//> every section is stored exactly as it is used in memory, loading maps the file & patches its pointers,
+//> nothing is parsed or copied, so the load time is the time to page the file in
+//> layout: header, entities, transforms, components, component data, assets, fixups, strings
+//> each section starts 16 byte aligned, the strings come last & the file ends with a terminator,
+//> so every name ends inside of the file
+
+// pointer stored as offset from the start of the file
+//> the fixup table lists the file offset of every pointer, 'Scene::Load' adds the address of the mapping to it
+static_assert(sizeof(void*) == sizeof(uint64_t), "the scene format stores 64-bit pointers");
+
+template<typename T>
+struct ScenePointer
+{
+    uint64_t value;
+
+    T* Get() const {
+        return reinterpret_cast<T*>(static_cast<uintptr_t>(value));
+    }
+};
+
+// local to the parent, rotation as quaternion (xyzw)
+struct SceneTransform
+{
+    float position[3];
+    float rotation[4];
+    float scale[3];
+};
+
+// parents are stored before their children, so transforms resolve in one pass in order
+struct SceneEntity
+{
+    ScenePointer<const char> name;
+    uint32_t parent; // entity index or 'Scene::NO_PARENT'
+    uint32_t firstComponent;
+    uint32_t componentCount;
+    uint32_t padding;
+};
+
+enum class SceneComponentType : uint32_t
+{
+    Mesh,
+    Light,
+    Collider,
+
+    Count
+};
+
+struct SceneComponent
+{
+    SceneComponentType type;
+    uint32_t entity;
+    ScenePointer<const void> data; // one of the component structs below, by type
+};
+
+struct SceneMeshComponent
+{
+    static constexpr SceneComponentType TYPE = SceneComponentType::Mesh;
+
+    uint32_t mesh; // asset index
+    uint32_t material; // asset index
+};
+
+struct SceneLightComponent
+{
+    static constexpr SceneComponentType TYPE = SceneComponentType::Light;
+
+    float color[3];
+    float intensity;
+    float radius;
+};
+
+// box around the entity position, e.g. for the broadphase
+struct SceneColliderComponent
+{
+    static constexpr SceneComponentType TYPE = SceneComponentType::Collider;
+
+    float halfExtents[3];
+};
+
+enum class SceneAssetType : uint32_t
+{
+    Mesh,
+    Material,
+
+    Count
+};
+
+// referenced by path relative to the assets directory, loading the asset is up to the user
+struct SceneAsset
+{
+    SceneAssetType type;
+    uint32_t padding;
+    ScenePointer<const char> path;
+};
+
+// schema: the version is raised with every layout change, the record sizes catch a layout that changed without it
+//> files of another schema are rejected, they are converted again from their text form
+struct SceneHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t fileSize;
+    uint32_t entitySize;
+    uint32_t transformSize;
+    uint32_t componentSize;
+    uint32_t assetSize;
+
+    ScenePointer<SceneEntity> entities;
+    ScenePointer<SceneTransform> transforms; // one per entity
+    ScenePointer<SceneComponent> components;
+    ScenePointer<SceneAsset> assets;
+    uint64_t fixupOffset; // not a pointer, read before the fixups are applied
+    uint32_t entityCount;
+    uint32_t componentCount;
+    uint32_t assetCount;
+    uint32_t fixupCount;
+};
+
+// scene mapped from a '.scene' file, read only once loaded
+class Scene
+{
+public:
+    static constexpr uint32_t MAGIC = 0x4E435341; // "ASCN"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t NO_PARENT = UINT32_MAX;
+    static constexpr uint64_t SECTION_ALIGNMENT = 16;
+
+    struct LoadStats
+    {
+        uint64_t fileSize;
+        uint32_t fixupCount;
+        float mapTime; // ms
+        float fixupTime; // ms, fixups & validation
+    };
+
+    // maps the file & applies the fixups, a loaded scene is unloaded first
+    //> the mapping is copy on write, only pages holding pointers are copied
+    bool Load(const std::string& path);
+    void Unload();
+
+    bool IsLoaded() const {
+        return header != nullptr;
+    }
+    uint32_t GetEntityCount() const {
+        return header->entityCount;
+    }
+    const SceneEntity& GetEntity(uint32_t index) const {
+        return header->entities.Get()[index];
+    }
+    const SceneTransform& GetTransform(uint32_t index) const {
+        return header->transforms.Get()[index];
+    }
+    const SceneComponent* GetComponents(uint32_t index) const {
+        return header->components.Get() + GetEntity(index).firstComponent;
+    }
+    uint32_t GetAssetCount() const {
+        return header->assetCount;
+    }
+    const SceneAsset& GetAsset(uint32_t index) const {
+        return header->assets.Get()[index];
+    }
+
+    // first component of the type, null when the entity has none
+    template<typename T>
+    const T* GetComponent(uint32_t index) const
+    {
+        const SceneEntity& entity = GetEntity(index);
+        const SceneComponent* components = GetComponents(index);
+        for (uint32_t i = 0; i < entity.componentCount; ++i)
+        {
+            if (components[i].type == T::TYPE)
+                return static_cast<const T*>(components[i].data.Get());
+        }
+        return nullptr;
+    }
+
+    const LoadStats& GetLoadStats() const {
+        return stats;
+    }
+    void PrintStats() const;
+
+private:
+    MappedFile file;
+    const SceneHeader* header = nullptr;
+    LoadStats stats{};
+
+    bool validate() const;
+};
+
+// editable scene, written to the relocatable format by 'Save'
+struct SceneDescription
+{
+    struct Entity
+    {
+        std::string name;
+        uint32_t parent = Scene::NO_PARENT; // index of an earlier entity
+        SceneTransform transform{{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}};
+        std::optional<SceneMeshComponent> mesh;
+        std::optional<SceneLightComponent> light;
+        std::optional<SceneColliderComponent> collider;
+    };
+
+    struct Asset
+    {
+        SceneAssetType type;
+        std::string path;
+    };
+
+    std::vector<Entity> entities;
+    std::vector<Asset> assets;
+
+    // index of the asset, added when not referenced yet
+    uint32_t AddAsset(SceneAssetType type, const std::string& path);
+
+    bool Save(const std::string& path) const;
+};
+
+#endif //ARCTIC_SCENE_H
@@ -0,0 +1,127 @@
+#include "scene_cooker.h"
+#include "utilities/logger.h"
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+bool SceneCooker::LoadText(const std::string& path, SceneDescription& scene)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        ARCTIC_LOG_ERROR(Cook, "failed to open {}!", path);
+        return false;
+    }
+
+    std::unordered_map<std::string, uint32_t> entityIds; // name -> entity
+    bool hasVersion = false;
+    scene = {};
+
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        std::istringstream lineStream(line);
+        std::string kind;
+        if (!(lineStream >> kind) || kind.starts_with('#'))
+            continue;
+
+        // version
+        //> required before anything else
+        if (!hasVersion)
+        {
+            uint32_t version = 0;
+            if (kind != "version" || !(lineStream >> version) || version != TEXT_VERSION)
+            {
+                ARCTIC_LOG_ERROR(Cook, "{}:{}: expected 'version {}'!", path, lineNumber, TEXT_VERSION);
+                return false;
+            }
+            hasVersion = true;
+            continue;
+        }
+
+        // entity
+        if (kind == "entity")
+        {
+            std::string name;
+            if (!(lineStream >> name) || entityIds.contains(name))
+            {
+                ARCTIC_LOG_ERROR(Cook, "{}:{}: entity without unique name!", path, lineNumber);
+                return false;
+            }
+            entityIds[name] = static_cast<uint32_t>(scene.entities.size());
+            scene.entities.emplace_back().name = name;
+            continue;
+        }
+        if (scene.entities.empty())
+        {
+            ARCTIC_LOG_ERROR(Cook, "{}:{}: '{}' outside of an entity!", path, lineNumber, kind);
+            return false;
+        }
+
+        // properties of the last entity
+        SceneDescription::Entity& entity = scene.entities.back();
+        SceneTransform& transform = entity.transform;
+        bool isRead = true;
+        if (kind == "parent")
+        {
+            std::string name;
+            isRead = static_cast<bool>(lineStream >> name) && entityIds.contains(name) && name != entity.name;
+            if (isRead)
+                entity.parent = entityIds[name];
+        }
+        else if (kind == "position")
+        {
+            isRead = static_cast<bool>(lineStream >> transform.position[0] >> transform.position[1] >> transform.position[2]);
+        }
+        else if (kind == "rotation")
+        {
+            isRead = static_cast<bool>(lineStream >> transform.rotation[0] >> transform.rotation[1] >> transform.rotation[2] >> transform.rotation[3]);
+        }
+        else if (kind == "scale")
+        {
+            isRead = static_cast<bool>(lineStream >> transform.scale[0] >> transform.scale[1] >> transform.scale[2]);
+        }
+        else if (kind == "mesh")
+        {
+            std::string meshPath, materialPath;
+            isRead = static_cast<bool>(lineStream >> meshPath >> materialPath);
+            if (isRead)
+                entity.mesh = SceneMeshComponent{scene.AddAsset(SceneAssetType::Mesh, meshPath),
+                                                 scene.AddAsset(SceneAssetType::Material, materialPath)};
+        }
+        else if (kind == "light")
+        {
+            SceneLightComponent light{};
+            isRead = static_cast<bool>(lineStream >> light.color[0] >> light.color[1] >> light.color[2] >> light.intensity >> light.radius);
+            if (isRead)
+                entity.light = light;
+        }
+        else if (kind == "collider")
+        {
+            SceneColliderComponent collider{};
+            isRead = static_cast<bool>(lineStream >> collider.halfExtents[0] >> collider.halfExtents[1] >> collider.halfExtents[2]);
+            if (isRead)
+                entity.collider = collider;
+        }
+        else
+        {
+            ARCTIC_LOG_ERROR(Cook, "{}:{}: unknown statement '{}'!", path, lineNumber, kind);
+            return false;
+        }
+
+        if (!isRead)
+        {
+            ARCTIC_LOG_ERROR(Cook, "{}:{}: invalid '{}'!", path, lineNumber, kind);
+            return false;
+        }
+    }
+
+    if (!hasVersion)
+    {
+        ARCTIC_LOG_ERROR(Cook, "{}: expected 'version {}'!", path, TEXT_VERSION);
+        return false;
+    }
+    return true;
+}
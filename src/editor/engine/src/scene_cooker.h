@@ -0,0 +1,27 @@
+#ifndef ARCTIC_SCENE_COOKER_H
+#define ARCTIC_SCENE_COOKER_H
+
+#include <string>
+#include "scene.h"
+
+// offline scene processing, used by 'ArcticCook'
+class SceneCooker
+{
+public:
+    static constexpr uint32_t TEXT_VERSION = 1;
+
+    // text scene ('.scn'), one statement per line, '#' starts a comment:
+    //> "version 1"                            first statement, files of another version are rejected
+    //> "entity <name>"                        starts an entity, names are unique
+    //> "parent <name>"                        an entity declared before
+    //> "position <x> <y> <z>"
+    //> "rotation <x> <y> <z> <w>"             quaternion
+    //> "scale <x> <y> <z>"
+    //> "mesh <mesh path> <material path>"     paths relative to the assets directory
+    //> "light <r> <g> <b> <intensity> <radius>"
+    //> "collider <x> <y> <z>"                 half extents
+    //> the statements after 'entity' describe that entity
+    static bool LoadText(const std::string& path, SceneDescription& scene);
+};
+
+#endif //ARCTIC_SCENE_COOKER_H
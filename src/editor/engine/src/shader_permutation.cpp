@@ -0,0 +1,82 @@
+#include "shader_permutation.h"
+#include "utilities/logger.h"
+
+ShaderPermutation::ShaderPermutation(ShaderPermutationKey key)
+    : key(key)
+{
+}
+
+void ShaderPermutation::SetFeature(ShaderFeature feature, bool isEnabled)
+{
+    if (isEnabled)
+        key |= ToBit(feature);
+    else
+        key &= ~ToBit(feature);
+}
+
+bool ShaderPermutation::IsFeatureEnabled(ShaderFeature feature) const
+{
+    return (key & ToBit(feature)) != 0;
+}
+
+const VkSpecializationInfo* ShaderPermutation::GetSpecializationInfo()
+{
+    // create map entry per feature
+    //> constant ids that are not declared in a shader module are ignored by the driver,
+    //> so every stage can share the same specialization info
+    const uint32_t featureCount = static_cast<uint32_t>(ShaderFeature::Count);
+    for (uint32_t i = 0; i < featureCount; ++i)
+    {
+        values[i] = (key & (1u << i)) != 0 ? VK_TRUE : VK_FALSE;
+
+        mapEntries[i].constantID = i;
+        mapEntries[i].offset = static_cast<uint32_t>(i * sizeof(VkBool32));
+        mapEntries[i].size = sizeof(VkBool32);
+    }
+
+    // create info: specialization
+    specializationInfo.mapEntryCount = featureCount;
+    specializationInfo.pMapEntries = mapEntries.data();
+    specializationInfo.dataSize = featureCount * sizeof(VkBool32);
+    specializationInfo.pData = values.data();
+
+    return &specializationInfo;
+}
+
+void ShaderPermutationCache::Initialize(VkDevice device, const VkAllocationCallbacks* allocator, CreatePipelineFunc createPipelineFunc)
+{
+    vkDevice = device;
+    vkAllocator = allocator;
+    createPipeline = std::move(createPipelineFunc);
+}
+
+void ShaderPermutationCache::Cleanup()
+{
+    //> failed permutations are cached as null, destroying null is a no-op
+    for (auto& [key, pipeline] : pipelines)
+        vkDestroyPipeline(vkDevice, pipeline, vkAllocator);
+
+    pipelines.clear();
+}
+
+VkPipeline ShaderPermutationCache::GetPipeline(ShaderPermutationKey key)
+{
+    // return cached pipeline
+    //> null when the permutation failed before, it is not compiled again
+    auto it = pipelines.find(key);
+    if (it != pipelines.end())
+        return it->second;
+
+    // compile new permutation
+    ShaderPermutation permutation(key);
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    if (!createPipeline || !createPipeline(permutation, pipeline))
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create pipeline permutation {}!", key);
+        pipelines.emplace(key, VK_NULL_HANDLE);
+        return VK_NULL_HANDLE;
+    }
+
+    pipelines.emplace(key, pipeline);
+    return pipeline;
+}
@@ -0,0 +1,109 @@
+#ifndef ARCTIC_SHADER_PERMUTATION_H
+#define ARCTIC_SHADER_PERMUTATION_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vulkan/vulkan_core.h>
+
+// feature toggles declared by shaders as specialization constants
+//> the value of each entry is used as 'constant_id' in glsl:
+//> "layout(constant_id = 0) const bool FEATURE_VERTEX_COLOR = true;"
+enum class ShaderFeature : uint32_t
+{
+    VertexColor = 0,
+    Grayscale = 1,
+    ClusteredLighting = 2, // requires the light cluster set (see ClusteredLighting)
+    OverdrawView = 3, // debug view, blends a constant per shaded fragment (see 'VulkanLoader::SetOverdrawView')
+
+    Count
+};
+
+// compact key describing which features are enabled (one bit per feature)
+//> the depth mode is stored above the feature bits
+using ShaderPermutationKey = uint32_t;
+
+// depth state of a pipeline
+//> not a specialization constant, it selects fixed function state & which stages are compiled
+enum class DepthMode : uint32_t
+{
+    TestWrite = 0, // tested & written
+    Prepass = 1, // depth only: written, no fragment stage & no color writes
+    Equal = 2, // shades what the prepass left visible, tested equal & not written
+
+    Count
+};
+
+class ShaderPermutation
+{
+public:
+    static const uint32_t MAX_FEATURES = 32;
+    static constexpr uint32_t DEPTH_MODE_SHIFT = 14;
+    static constexpr uint32_t DEPTH_MODE_BITS = 2;
+
+    // features & depth mode share the 16 bit pipeline field of the render queue key
+    static_assert(static_cast<uint32_t>(ShaderFeature::Count) <= DEPTH_MODE_SHIFT);
+    static_assert(static_cast<uint32_t>(DepthMode::Count) <= (1u << DEPTH_MODE_BITS));
+
+    explicit ShaderPermutation(ShaderPermutationKey key = 0);
+
+    void SetFeature(ShaderFeature feature, bool isEnabled);
+    bool IsFeatureEnabled(ShaderFeature feature) const;
+
+    DepthMode GetDepthMode() const {
+        return GetDepthMode(key);
+    }
+
+    ShaderPermutationKey GetKey() const {
+        return key;
+    }
+
+    // builds the specialization info from the key
+    //> the returned pointer stays valid as long as this permutation is alive and not modified
+    const VkSpecializationInfo* GetSpecializationInfo();
+
+    static ShaderPermutationKey ToBit(ShaderFeature feature) {
+        return static_cast<ShaderPermutationKey>(1u) << static_cast<uint32_t>(feature);
+    }
+    static DepthMode GetDepthMode(ShaderPermutationKey key) {
+        return static_cast<DepthMode>((key >> DEPTH_MODE_SHIFT) & ((1u << DEPTH_MODE_BITS) - 1));
+    }
+    static ShaderPermutationKey WithDepthMode(ShaderPermutationKey key, DepthMode mode) {
+        const ShaderPermutationKey mask = ((1u << DEPTH_MODE_BITS) - 1) << DEPTH_MODE_SHIFT;
+        return (key & ~mask) | (static_cast<ShaderPermutationKey>(mode) << DEPTH_MODE_SHIFT);
+    }
+
+private:
+    ShaderPermutationKey key;
+
+    std::array<VkSpecializationMapEntry, MAX_FEATURES> mapEntries{};
+    std::array<VkBool32, MAX_FEATURES> values{};
+    VkSpecializationInfo specializationInfo{};
+};
+
+// caches one pipeline per permutation key
+//> pipelines are only compiled the first time a key is requested, a failed compile is cached as null & not retried
+class ShaderPermutationCache
+{
+public:
+    using CreatePipelineFunc = std::function<bool(ShaderPermutation& permutation, VkPipeline& pipeline)>;
+
+    void Initialize(VkDevice device, const VkAllocationCallbacks* allocator, CreatePipelineFunc createPipelineFunc);
+    void Cleanup();
+
+    VkPipeline GetPipeline(ShaderPermutationKey key);
+
+    // failed permutations included
+    size_t GetPipelineCount() const {
+        return pipelines.size();
+    }
+
+private:
+    VkDevice vkDevice = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* vkAllocator = nullptr;
+    CreatePipelineFunc createPipeline;
+    std::unordered_map<ShaderPermutationKey, VkPipeline> pipelines;
+};
+
+#endif //ARCTIC_SHADER_PERMUTATION_H
@@ -0,0 +1,682 @@
+#include "shader_reflection.h"
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <iostream>
+#include "utilities/logger.h"
+
+namespace
+{
+    const uint32_t SPIRV_MAGIC = 0x07230203;
+    const uint32_t HEADER_WORD_COUNT = 5;
+    const uint32_t UNDEFINED = UINT32_MAX;
+    const uint32_t MAX_TYPE_DEPTH = 32; // nested types, deeper (or self-referential) types are rejected
+
+    // opcodes
+    const uint32_t OP_ENTRY_POINT = 15;
+    const uint32_t OP_TYPE_INT = 21;
+    const uint32_t OP_TYPE_FLOAT = 22;
+    const uint32_t OP_TYPE_VECTOR = 23;
+    const uint32_t OP_TYPE_MATRIX = 24;
+    const uint32_t OP_TYPE_IMAGE = 25;
+    const uint32_t OP_TYPE_SAMPLER = 26;
+    const uint32_t OP_TYPE_SAMPLED_IMAGE = 27;
+    const uint32_t OP_TYPE_ARRAY = 28;
+    const uint32_t OP_TYPE_RUNTIME_ARRAY = 29;
+    const uint32_t OP_TYPE_STRUCT = 30;
+    const uint32_t OP_TYPE_POINTER = 32;
+    const uint32_t OP_CONSTANT = 43;
+    const uint32_t OP_SPEC_CONSTANT = 50;
+    const uint32_t OP_VARIABLE = 59;
+    const uint32_t OP_DECORATE = 71;
+    const uint32_t OP_MEMBER_DECORATE = 72;
+    const uint32_t OP_TYPE_ACCELERATION_STRUCTURE = 5341;
+
+    // decorations
+    const uint32_t DECORATION_BUFFER_BLOCK = 3;
+    const uint32_t DECORATION_ARRAY_STRIDE = 6;
+    const uint32_t DECORATION_MATRIX_STRIDE = 7;
+    const uint32_t DECORATION_BUILT_IN = 11;
+    const uint32_t DECORATION_LOCATION = 30;
+    const uint32_t DECORATION_BINDING = 33;
+    const uint32_t DECORATION_DESCRIPTOR_SET = 34;
+    const uint32_t DECORATION_OFFSET = 35;
+
+    // storage classes
+    const uint32_t STORAGE_UNIFORM_CONSTANT = 0;
+    const uint32_t STORAGE_INPUT = 1;
+    const uint32_t STORAGE_UNIFORM = 2;
+    const uint32_t STORAGE_PUSH_CONSTANT = 9;
+    const uint32_t STORAGE_STORAGE_BUFFER = 12;
+
+    // image dimensions & usage
+    const uint32_t DIM_BUFFER = 5;
+    const uint32_t DIM_SUBPASS_DATA = 6;
+    const uint32_t IMAGE_STORAGE = 2;
+
+    // ids of interest: the defining instruction & decorations
+    struct SpirvId
+    {
+        uint32_t instruction = 0; // word offset, zero when not defined by a type, constant or variable
+        uint32_t set = UNDEFINED;
+        uint32_t binding = UNDEFINED;
+        uint32_t location = UNDEFINED;
+        uint32_t arrayStride = 0;
+        bool isBuiltIn = false;
+        bool isBufferBlock = false;
+    };
+
+    struct SpirvMember
+    {
+        uint32_t offset = 0;
+        uint32_t matrixStride = 0;
+        bool isBuiltIn = false;
+    };
+
+    struct SpirvModule
+    {
+        std::vector<uint32_t> words;
+        std::vector<SpirvId> ids;
+        std::unordered_map<uint64_t, SpirvMember> members; // struct id << 32 | member
+        uint32_t executionModel = UNDEFINED;
+
+        uint32_t getOpcode(uint32_t id) const {
+            return id < ids.size() && ids[id].instruction != 0 ? words[ids[id].instruction] & 0xFFFF : 0;
+        }
+        // operand after the opcode word, zero past the end of the instruction
+        uint32_t getOperand(uint32_t id, uint32_t index) const {
+            return index < getOperandCount(id) ? words[ids[id].instruction + 1 + index] : 0;
+        }
+        uint32_t getOperandCount(uint32_t id) const {
+            return getOpcode(id) != 0 ? (words[ids[id].instruction] >> 16) - 1 : 0;
+        }
+        const SpirvMember* findMember(uint32_t id, uint32_t member) const {
+            auto it = members.find((static_cast<uint64_t>(id) << 32) | member);
+            return it != members.end() ? &it->second : nullptr;
+        }
+    };
+
+    // result id position per opcode, zero for instructions that are not tracked
+    uint32_t getResultOperand(uint32_t opcode)
+    {
+        switch (opcode)
+        {
+            case OP_TYPE_INT:
+            case OP_TYPE_FLOAT:
+            case OP_TYPE_VECTOR:
+            case OP_TYPE_MATRIX:
+            case OP_TYPE_IMAGE:
+            case OP_TYPE_SAMPLER:
+            case OP_TYPE_SAMPLED_IMAGE:
+            case OP_TYPE_ARRAY:
+            case OP_TYPE_RUNTIME_ARRAY:
+            case OP_TYPE_STRUCT:
+            case OP_TYPE_POINTER:
+            case OP_TYPE_ACCELERATION_STRUCTURE:
+                return 1;
+            case OP_CONSTANT:
+            case OP_SPEC_CONSTANT:
+            case OP_VARIABLE:
+                return 2;
+            default:
+                return 0;
+        }
+    }
+
+    bool readModule(const std::vector<char>& code, SpirvModule& module)
+    {
+        // copy words
+        //> the code is a char buffer without alignment guarantees
+        if (code.size() < HEADER_WORD_COUNT * sizeof(uint32_t) || code.size() % sizeof(uint32_t) != 0)
+            return false;
+        module.words.resize(code.size() / sizeof(uint32_t));
+        std::memcpy(module.words.data(), code.data(), code.size());
+        if (module.words[0] != SPIRV_MAGIC)
+            return false;
+
+        // header word 3 is the id bound
+        //> every id is defined by an instruction, a bound beyond the word count is corrupt
+        const uint32_t idBound = module.words[3];
+        if (idBound > module.words.size())
+            return false;
+        module.ids.resize(idBound);
+
+        // walk instructions
+        const auto wordCount = static_cast<uint32_t>(module.words.size());
+        for (uint32_t offset = HEADER_WORD_COUNT; offset < wordCount;)
+        {
+            const uint32_t* instruction = &module.words[offset];
+            const uint32_t opcode = instruction[0] & 0xFFFF;
+            const uint32_t length = instruction[0] >> 16;
+            if (length == 0 || offset + length > wordCount)
+                return false;
+
+            if (opcode == OP_ENTRY_POINT && module.executionModel == UNDEFINED)
+            {
+                module.executionModel = instruction[1];
+            }
+            else if (opcode == OP_DECORATE && length >= 3 && instruction[1] < idBound)
+            {
+                SpirvId& id = module.ids[instruction[1]];
+                const uint32_t value = length >= 4 ? instruction[3] : 0;
+                switch (instruction[2])
+                {
+                    case DECORATION_BUFFER_BLOCK: id.isBufferBlock = true; break;
+                    case DECORATION_ARRAY_STRIDE: id.arrayStride = value; break;
+                    case DECORATION_BUILT_IN: id.isBuiltIn = true; break;
+                    case DECORATION_LOCATION: id.location = value; break;
+                    case DECORATION_BINDING: id.binding = value; break;
+                    case DECORATION_DESCRIPTOR_SET: id.set = value; break;
+                    default: break;
+                }
+            }
+            else if (opcode == OP_MEMBER_DECORATE && length >= 4)
+            {
+                SpirvMember& member = module.members[(static_cast<uint64_t>(instruction[1]) << 32) | instruction[2]];
+                const uint32_t value = length >= 5 ? instruction[4] : 0;
+                switch (instruction[3])
+                {
+                    case DECORATION_OFFSET: member.offset = value; break;
+                    case DECORATION_MATRIX_STRIDE: member.matrixStride = value; break;
+                    case DECORATION_BUILT_IN: member.isBuiltIn = true; break;
+                    default: break;
+                }
+            }
+            else if (uint32_t resultOperand = getResultOperand(opcode); resultOperand != 0)
+            {
+                if (length <= resultOperand || instruction[resultOperand] >= idBound)
+                    return false;
+                module.ids[instruction[resultOperand]].instruction = offset;
+            }
+
+            offset += length;
+        }
+        return module.executionModel != UNDEFINED;
+    }
+
+    bool getStage(uint32_t executionModel, VkShaderStageFlagBits& stage)
+    {
+        switch (executionModel)
+        {
+            case 0: stage = VK_SHADER_STAGE_VERTEX_BIT; return true;
+            case 1: stage = VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT; return true;
+            case 2: stage = VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT; return true;
+            case 3: stage = VK_SHADER_STAGE_GEOMETRY_BIT; return true;
+            case 4: stage = VK_SHADER_STAGE_FRAGMENT_BIT; return true;
+            case 5: stage = VK_SHADER_STAGE_COMPUTE_BIT; return true;
+            default: return false;
+        }
+    }
+
+    // array lengths are (specialization) constants, the default value is used
+    bool getConstant(const SpirvModule& module, uint32_t id, uint32_t& value)
+    {
+        uint32_t opcode = module.getOpcode(id);
+        if ((opcode != OP_CONSTANT && opcode != OP_SPEC_CONSTANT) || module.getOperandCount(id) < 3)
+            return false;
+        value = module.getOperand(id, 2);
+        return true;
+    }
+
+    // bytes in an explicitly laid out block (push constants), zero for unsupported types
+    uint32_t getTypeSize(const SpirvModule& module, uint32_t type, uint32_t matrixStride, uint32_t depth = 0)
+    {
+        if (depth > MAX_TYPE_DEPTH)
+            return 0;
+
+        switch (module.getOpcode(type))
+        {
+            case OP_TYPE_INT:
+            case OP_TYPE_FLOAT:
+                return module.getOperand(type, 1) / 8;
+            case OP_TYPE_VECTOR:
+                return module.getOperand(type, 2) * getTypeSize(module, module.getOperand(type, 1), 0, depth + 1);
+            case OP_TYPE_MATRIX:
+            {
+                uint32_t columnSize = getTypeSize(module, module.getOperand(type, 1), 0, depth + 1);
+                return module.getOperand(type, 2) * std::max(matrixStride, columnSize);
+            }
+            case OP_TYPE_ARRAY:
+            {
+                uint32_t length = 0;
+                if (!getConstant(module, module.getOperand(type, 2), length))
+                    return 0;
+                uint32_t stride = module.ids[type].arrayStride;
+                return length * (stride != 0 ? stride : getTypeSize(module, module.getOperand(type, 1), matrixStride, depth + 1));
+            }
+            case OP_TYPE_STRUCT:
+            {
+                //> the block ends with the member ending last
+                uint32_t size = 0;
+                for (uint32_t member = 0; member + 1 < module.getOperandCount(type); ++member)
+                {
+                    const SpirvMember* decoration = module.findMember(type, member);
+                    uint32_t offset = decoration ? decoration->offset : 0;
+                    uint32_t stride = decoration ? decoration->matrixStride : 0;
+                    size = std::max(size, offset + getTypeSize(module, module.getOperand(type, 1 + member), stride, depth + 1));
+                }
+                return size;
+            }
+            default:
+                return 0;
+        }
+    }
+
+    bool getDescriptorType(const SpirvModule& module, uint32_t storageClass, uint32_t type, VkDescriptorType& descriptorType)
+    {
+        switch (storageClass)
+        {
+            case STORAGE_UNIFORM:
+                //> glsl before storage buffer classes marks ssbos as buffer blocks
+                if (module.getOpcode(type) != OP_TYPE_STRUCT)
+                    return false;
+                descriptorType = module.ids[type].isBufferBlock ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                return true;
+            case STORAGE_STORAGE_BUFFER:
+                descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                return true;
+            case STORAGE_UNIFORM_CONSTANT:
+                break;
+            default:
+                return false;
+        }
+
+        switch (module.getOpcode(type))
+        {
+            case OP_TYPE_SAMPLER:
+                descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+                return true;
+            case OP_TYPE_SAMPLED_IMAGE:
+                descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                return true;
+            case OP_TYPE_ACCELERATION_STRUCTURE:
+                descriptorType = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+                return true;
+            case OP_TYPE_IMAGE:
+            {
+                uint32_t dimension = module.getOperand(type, 2);
+                bool isStorage = module.getOperand(type, 6) == IMAGE_STORAGE;
+                if (dimension == DIM_BUFFER)
+                    descriptorType = isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                else if (dimension == DIM_SUBPASS_DATA)
+                    descriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+                else
+                    descriptorType = isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    bool getVertexFormat(const SpirvModule& module, uint32_t type, VkFormat& format, uint32_t& size)
+    {
+        // components
+        uint32_t componentType = type;
+        uint32_t componentCount = 1;
+        if (module.getOpcode(type) == OP_TYPE_VECTOR)
+        {
+            componentType = module.getOperand(type, 1);
+            componentCount = module.getOperand(type, 2);
+        }
+
+        uint32_t opcode = module.getOpcode(componentType);
+        if ((opcode != OP_TYPE_FLOAT && opcode != OP_TYPE_INT) || module.getOperand(componentType, 1) != 32 ||
+            componentCount == 0 || componentCount > 4)
+            return false;
+
+        // format
+        const VkFormat floatFormats[4] = {VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT};
+        const VkFormat intFormats[4] = {VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT};
+        const VkFormat uintFormats[4] = {VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT};
+        if (opcode == OP_TYPE_FLOAT)
+            format = floatFormats[componentCount - 1];
+        else
+            format = module.getOperand(componentType, 2) != 0 ? intFormats[componentCount - 1] : uintFormats[componentCount - 1];
+        size = componentCount * sizeof(uint32_t);
+        return true;
+    }
+
+    uint64_t hashValue(uint64_t hash, const void* data, size_t size)
+    {
+        // fnv-1a
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i)
+            hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+        return hash;
+    }
+
+    const uint64_t HASH_SEED = 0xCBF29CE484222325ull;
+
+    bool isBindingEqual(const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b)
+    {
+        return a.binding == b.binding &&
+               a.descriptorType == b.descriptorType &&
+               a.descriptorCount == b.descriptorCount &&
+               a.stageFlags == b.stageFlags &&
+               a.pImmutableSamplers == b.pImmutableSamplers;
+    }
+
+    bool isRangeEqual(const VkPushConstantRange& a, const VkPushConstantRange& b)
+    {
+        return a.stageFlags == b.stageFlags && a.offset == b.offset && a.size == b.size;
+    }
+}
+
+#pragma region shader_reflection_parse
+
+bool ShaderReflection::Parse(const std::vector<char>& code)
+{
+    *this = {};
+
+    SpirvModule module;
+    VkShaderStageFlagBits stage;
+    if (!readModule(code, module) || !getStage(module.executionModel, stage))
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to read spir-v module!");
+        return false;
+    }
+    stages = stage;
+
+    // variables
+    for (uint32_t id = 0; id < module.ids.size(); ++id)
+    {
+        if (module.getOpcode(id) != OP_VARIABLE)
+            continue;
+
+        const SpirvId& variable = module.ids[id];
+        const uint32_t storageClass = module.getOperand(id, 2);
+        const uint32_t pointer = module.getOperand(id, 0);
+        if (module.getOpcode(pointer) != OP_TYPE_POINTER)
+            return false;
+        uint32_t type = module.getOperand(pointer, 2);
+
+        // push constants
+        if (storageClass == STORAGE_PUSH_CONSTANT)
+        {
+            pushConstantSize = std::max(pushConstantSize, getTypeSize(module, type, 0));
+            pushConstantStages = stage;
+            continue;
+        }
+
+        // vertex inputs
+        //> built-ins (e.g. 'gl_VertexIndex') are not fed by vertex buffers
+        if (storageClass == STORAGE_INPUT)
+        {
+            if (stage != VK_SHADER_STAGE_VERTEX_BIT || variable.isBuiltIn || variable.location == UNDEFINED)
+                continue;
+
+            ShaderVertexInput input{variable.location, VK_FORMAT_UNDEFINED, 0};
+            if (!getVertexFormat(module, type, input.format, input.size))
+            {
+                ARCTIC_LOG_ERROR(Vulkan, "unsupported vertex input at location {}!", variable.location);
+                return false;
+            }
+            vertexInputs.push_back(input);
+            continue;
+        }
+
+        // descriptors
+        if (variable.set == UNDEFINED || variable.binding == UNDEFINED)
+            continue;
+
+        ShaderBinding binding{variable.set, variable.binding, VK_DESCRIPTOR_TYPE_MAX_ENUM, 1, stage};
+        for (uint32_t depth = 0; module.getOpcode(type) == OP_TYPE_ARRAY; ++depth)
+        {
+            if (depth == MAX_TYPE_DEPTH)
+                return false;
+
+            uint32_t length = 0;
+            if (!getConstant(module, module.getOperand(type, 2), length))
+                return false;
+            binding.count *= length;
+            type = module.getOperand(type, 1);
+        }
+        if (module.getOpcode(type) == OP_TYPE_RUNTIME_ARRAY || !getDescriptorType(module, storageClass, type, binding.type))
+        {
+            ARCTIC_LOG_ERROR(Vulkan, "unsupported resource at set {} binding {}!", binding.set, binding.binding);
+            return false;
+        }
+        bindings.push_back(binding);
+    }
+
+    // sort
+    std::sort(bindings.begin(), bindings.end(), [](const ShaderBinding& a, const ShaderBinding& b) {
+        return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+    });
+    std::sort(vertexInputs.begin(), vertexInputs.end(), [](const ShaderVertexInput& a, const ShaderVertexInput& b) {
+        return a.location < b.location;
+    });
+    return true;
+}
+
+bool ShaderReflection::Merge(const ShaderReflection& other)
+{
+    // bindings
+    for (const ShaderBinding& binding : other.bindings)
+    {
+        auto it = std::lower_bound(bindings.begin(), bindings.end(), binding, [](const ShaderBinding& a, const ShaderBinding& b) {
+            return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+        });
+        if (it == bindings.end() || it->set != binding.set || it->binding != binding.binding)
+        {
+            bindings.insert(it, binding);
+            continue;
+        }
+
+        if (it->type != binding.type || it->count != binding.count)
+        {
+            ARCTIC_LOG_ERROR(Vulkan, "stages declare set {} binding {} differently!", binding.set, binding.binding);
+            return false;
+        }
+        it->stages |= binding.stages;
+    }
+
+    // vertex inputs
+    //> only the vertex stage declares them
+    vertexInputs.insert(vertexInputs.end(), other.vertexInputs.begin(), other.vertexInputs.end());
+    std::sort(vertexInputs.begin(), vertexInputs.end(), [](const ShaderVertexInput& a, const ShaderVertexInput& b) {
+        return a.location < b.location;
+    });
+
+    // push constants
+    //> one range from zero for all stages using them
+    pushConstantSize = std::max(pushConstantSize, other.pushConstantSize);
+    pushConstantStages |= other.pushConstantStages;
+
+    stages |= other.stages;
+    return true;
+}
+
+std::vector<VkDescriptorSetLayoutBinding> ShaderReflection::GetSetBindings(uint32_t set) const
+{
+    std::vector<VkDescriptorSetLayoutBinding> setBindings;
+    for (const ShaderBinding& binding : bindings)
+    {
+        if (binding.set == set)
+            setBindings.push_back({binding.binding, binding.type, binding.count, binding.stages, nullptr});
+    }
+    return setBindings;
+}
+
+uint32_t ShaderReflection::GetVertexStride() const
+{
+    uint32_t stride = 0;
+    for (const ShaderVertexInput& input : vertexInputs)
+        stride += input.size;
+    return stride;
+}
+
+std::vector<VkVertexInputAttributeDescription> ShaderReflection::GetVertexAttributes(uint32_t binding) const
+{
+    std::vector<VkVertexInputAttributeDescription> attributes;
+    uint32_t offset = 0;
+    for (const ShaderVertexInput& input : vertexInputs)
+    {
+        attributes.push_back({input.location, binding, input.format, offset});
+        offset += input.size;
+    }
+    return attributes;
+}
+
+#pragma endregion shader_reflection_parse
+
+#pragma region shader_reflection_cache
+
+void PipelineLayoutCache::Initialize(VkDevice device, const VkAllocationCallbacks* allocator)
+{
+    vkDevice = device;
+    vkAllocator = allocator;
+}
+
+void PipelineLayoutCache::Cleanup()
+{
+    // pipeline layouts before the set layouts they reference
+    for (auto& [hash, entries] : pipelineLayouts)
+    {
+        for (auto& entry : entries)
+            vkDestroyPipelineLayout(vkDevice, entry.layout, vkAllocator);
+    }
+    for (auto& [hash, entries] : setLayouts)
+    {
+        for (auto& entry : entries)
+            vkDestroyDescriptorSetLayout(vkDevice, entry.layout, vkAllocator);
+    }
+    pipelineLayouts.clear();
+    setLayouts.clear();
+    stats = {};
+}
+
+VkDescriptorSetLayout PipelineLayoutCache::GetSetLayout(std::vector<VkDescriptorSetLayoutBinding> bindings)
+{
+    ++stats.requestCount;
+
+    // hash
+    //> bindings are sorted, the same set declared in another order hashes the same
+    std::sort(bindings.begin(), bindings.end(), [](const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b) {
+        return a.binding < b.binding;
+    });
+    uint64_t hash = HASH_SEED;
+    for (const auto& binding : bindings)
+    {
+        hash = hashValue(hash, &binding.binding, sizeof(binding.binding));
+        hash = hashValue(hash, &binding.descriptorType, sizeof(binding.descriptorType));
+        hash = hashValue(hash, &binding.descriptorCount, sizeof(binding.descriptorCount));
+        hash = hashValue(hash, &binding.stageFlags, sizeof(binding.stageFlags));
+        hash = hashValue(hash, &binding.pImmutableSamplers, sizeof(binding.pImmutableSamplers));
+    }
+
+    // return cached layout
+    auto& entries = setLayouts[hash];
+    for (const auto& entry : entries)
+    {
+        if (std::equal(entry.bindings.begin(), entry.bindings.end(), bindings.begin(), bindings.end(), isBindingEqual))
+        {
+            ++stats.hitCount;
+            return entry.layout;
+        }
+    }
+
+    // create layout
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    if (vkCreateDescriptorSetLayout(vkDevice, &layoutInfo, vkAllocator, &layout) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create descriptor set layout!");
+        return VK_NULL_HANDLE;
+    }
+
+    entries.push_back({std::move(bindings), layout});
+    ++stats.setLayoutCount;
+    return layout;
+}
+
+VkPipelineLayout PipelineLayoutCache::GetPipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayouts,
+                                                        const std::vector<VkPushConstantRange>& pushConstantRanges)
+{
+    ++stats.requestCount;
+
+    // hash
+    uint64_t hash = HASH_SEED;
+    for (VkDescriptorSetLayout setLayout : setLayouts)
+        hash = hashValue(hash, &setLayout, sizeof(setLayout));
+    for (const auto& range : pushConstantRanges)
+    {
+        hash = hashValue(hash, &range.stageFlags, sizeof(range.stageFlags));
+        hash = hashValue(hash, &range.offset, sizeof(range.offset));
+        hash = hashValue(hash, &range.size, sizeof(range.size));
+    }
+
+    // return cached layout
+    auto& entries = pipelineLayouts[hash];
+    for (const auto& entry : entries)
+    {
+        if (entry.setLayouts == setLayouts &&
+            std::equal(entry.pushConstantRanges.begin(), entry.pushConstantRanges.end(), pushConstantRanges.begin(), pushConstantRanges.end(), isRangeEqual))
+        {
+            ++stats.hitCount;
+            return entry.layout;
+        }
+    }
+
+    // create layout
+    VkPipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+    layoutInfo.pSetLayouts = setLayouts.data();
+    layoutInfo.pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size());
+    layoutInfo.pPushConstantRanges = pushConstantRanges.data();
+
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    if (vkCreatePipelineLayout(vkDevice, &layoutInfo, vkAllocator, &layout) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create pipeline layout!");
+        return VK_NULL_HANDLE;
+    }
+
+    entries.push_back({setLayouts, pushConstantRanges, layout});
+    ++stats.pipelineLayoutCount;
+    return layout;
+}
+
+VkPipelineLayout PipelineLayoutCache::GetPipelineLayout(const ShaderReflection& reflection,
+                                                        const std::unordered_map<uint32_t, VkDescriptorSetLayout>& providedSetLayouts)
+{
+    // set layouts
+    //> sets the stages skip get an empty layout
+    uint32_t setCount = reflection.GetSetCount();
+    for (const auto& [set, layout] : providedSetLayouts)
+        setCount = std::max(setCount, set + 1);
+
+    std::vector<VkDescriptorSetLayout> layouts(setCount, VK_NULL_HANDLE);
+    for (uint32_t set = 0; set < setCount; ++set)
+    {
+        auto it = providedSetLayouts.find(set);
+        layouts[set] = it != providedSetLayouts.end() ? it->second : GetSetLayout(reflection.GetSetBindings(set));
+        if (layouts[set] == VK_NULL_HANDLE)
+            return VK_NULL_HANDLE;
+    }
+
+    // push constants
+    std::vector<VkPushConstantRange> ranges;
+    if (reflection.pushConstantSize > 0)
+        ranges.push_back({reflection.pushConstantStages, 0, reflection.pushConstantSize});
+
+    return GetPipelineLayout(layouts, ranges);
+}
+
+void PipelineLayoutCache::PrintStats() const
+{
+    std::cout << "info: vulkan: layouts:" << std::endl;
+    std::cout << std::format("\tset layouts {}, pipeline layouts {}, requests {} ({} hits)",
+                             stats.setLayoutCount,
+                             stats.pipelineLayoutCount,
+                             stats.requestCount,
+                             stats.hitCount) << std::endl;
+}
+
+#pragma endregion shader_reflection_cache
@@ -0,0 +1,111 @@
+#ifndef ARCTIC_SHADER_REFLECTION_H
+#define ARCTIC_SHADER_REFLECTION_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+// resource binding declared by a shader
+struct ShaderBinding
+{
+    uint32_t set;
+    uint32_t binding;
+    VkDescriptorType type;
+    uint32_t count; // array size
+    VkShaderStageFlags stages;
+};
+
+// vertex shader input, scalars & vectors of 32-bit components
+struct ShaderVertexInput
+{
+    uint32_t location;
+    VkFormat format;
+    uint32_t size; // bytes
+};
+
+// interface of one or more shader stages, read from spir-v
+//> descriptor sets & bindings, push constants and the inputs of the vertex stage
+//> matrices, 64-bit & runtime sized descriptor arrays are not supported as vertex input & bindings
+struct ShaderReflection
+{
+    VkShaderStageFlags stages = 0;
+    std::vector<ShaderBinding> bindings; // sorted by set & binding
+    std::vector<ShaderVertexInput> vertexInputs; // sorted by location
+    uint32_t pushConstantSize = 0; // bytes, the range starts at zero
+    VkShaderStageFlags pushConstantStages = 0;
+
+    // reads the module, false when it is malformed or declares unsupported resources
+    bool Parse(const std::vector<char>& code);
+
+    // adds the interface of another stage, bindings used by both get both stages
+    //> false when both declare the same binding differently
+    bool Merge(const ShaderReflection& other);
+
+    uint32_t GetSetCount() const {
+        return bindings.empty() ? 0 : bindings.back().set + 1;
+    }
+    std::vector<VkDescriptorSetLayoutBinding> GetSetBindings(uint32_t set) const;
+
+    // one interleaved per-vertex binding, attributes packed in location order
+    uint32_t GetVertexStride() const;
+    std::vector<VkVertexInputAttributeDescription> GetVertexAttributes(uint32_t binding) const;
+};
+
+// deduplicates descriptor set & pipeline layouts by their content
+//> layouts are hashed, equal descriptions share one vulkan object so pipelines built from the same
+//> interface stay layout compatible and bound sets survive pipeline switches
+//> layouts live until 'Cleanup'
+class PipelineLayoutCache
+{
+public:
+    struct Stats
+    {
+        uint32_t setLayoutCount;
+        uint32_t pipelineLayoutCount;
+        uint32_t requestCount;
+        uint32_t hitCount; // requests served by an existing layout
+    };
+
+    void Initialize(VkDevice device, const VkAllocationCallbacks* allocator);
+    void Cleanup();
+
+    // bindings in any order
+    VkDescriptorSetLayout GetSetLayout(std::vector<VkDescriptorSetLayoutBinding> bindings);
+    VkPipelineLayout GetPipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayouts,
+                                       const std::vector<VkPushConstantRange>& pushConstantRanges);
+
+    // one set layout per set of the reflection, 'providedSetLayouts' replace the reflected layout of their set
+    //> a provided layout is used as is, it must declare every binding the stages use
+    VkPipelineLayout GetPipelineLayout(const ShaderReflection& reflection,
+                                       const std::unordered_map<uint32_t, VkDescriptorSetLayout>& providedSetLayouts = {});
+
+    const Stats& GetStats() const {
+        return stats;
+    }
+    void PrintStats() const;
+
+private:
+    struct SetLayoutEntry
+    {
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+        VkDescriptorSetLayout layout;
+    };
+
+    struct PipelineLayoutEntry
+    {
+        std::vector<VkDescriptorSetLayout> setLayouts;
+        std::vector<VkPushConstantRange> pushConstantRanges;
+        VkPipelineLayout layout;
+    };
+
+    VkDevice vkDevice = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* vkAllocator = nullptr;
+
+    //> entries with the same hash are compared by content
+    std::unordered_map<uint64_t, std::vector<SetLayoutEntry>> setLayouts;
+    std::unordered_map<uint64_t, std::vector<PipelineLayoutEntry>> pipelineLayouts;
+    Stats stats{};
+};
+
+#endif //ARCTIC_SHADER_REFLECTION_H
@@ -0,0 +1,133 @@
+#include "simulation_loop.h"
+#include <algorithm>
+#include <format>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+void SimulationLoop::Initialize(double rate, TickFunc tickFunc)
+{
+    tickRate = rate > 0.0 ? rate : DEFAULT_TICK_RATE;
+    tickPeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / tickRate));
+    tick = std::move(tickFunc);
+    isStarted = false;
+    isStopRequested = false;
+    ResetStats();
+}
+
+uint32_t SimulationLoop::Advance()
+{
+    return advance(0);
+}
+
+void SimulationLoop::Run(uint64_t tickLimit)
+{
+    // sleep until the next tick is due
+    //> no busy waiting, many server instances share a machine
+    while (!isStopRequested.load(std::memory_order_relaxed) && (tickLimit == 0 || tickCount < tickLimit))
+    {
+        if (isStarted)
+            std::this_thread::sleep_until(nextTickTime);
+        advance(tickLimit);
+    }
+}
+
+uint32_t SimulationLoop::advance(uint64_t tickLimit)
+{
+    // the first call starts the clock
+    Clock::time_point now = Clock::now();
+    if (!isStarted)
+    {
+        nextTickTime = now;
+        isStarted = true;
+    }
+
+    // drop ticks a stall left behind, the simulation slows down instead of falling further behind
+    if (now - nextTickTime > tickPeriod * MAX_CATCH_UP_TICKS)
+    {
+        auto behindCount = static_cast<uint64_t>((now - nextTickTime) / tickPeriod) - MAX_CATCH_UP_TICKS + 1;
+        droppedTickCount += behindCount;
+        nextTickTime += tickPeriod * behindCount;
+    }
+
+    uint32_t runCount = 0;
+    //> a catch-up stops at the tick limit as well
+    while (nextTickTime <= now && (tickLimit == 0 || tickCount < tickLimit))
+    {
+        runTick(nextTickTime);
+        nextTickTime += tickPeriod;
+        ++runCount;
+    }
+    return runCount;
+}
+
+void SimulationLoop::runTick(Clock::time_point scheduledTime)
+{
+    Clock::time_point start = Clock::now();
+    if (tick)
+        tick(std::chrono::duration<double>(tickPeriod).count());
+    Clock::time_point end = Clock::now();
+
+    double tickTime = std::chrono::duration<double, std::milli>(end - start).count();
+    double lateness = std::chrono::duration<double, std::milli>(start - scheduledTime).count();
+
+    minTickTime = tickCount == 0 ? tickTime : std::min(minTickTime, tickTime);
+    maxTickTime = std::max(maxTickTime, tickTime);
+    totalTickTime += tickTime;
+    totalLateness += std::max(lateness, 0.0);
+    if (end - start > tickPeriod)
+        ++overrunCount;
+    tickTimes[tickCount % TICK_TIME_HISTORY] = static_cast<float>(tickTime);
+    ++tickCount;
+}
+
+SimulationLoop::Stats SimulationLoop::GetStats() const
+{
+    Stats stats{};
+    stats.tickRate = tickRate;
+    stats.tickCount = tickCount;
+    stats.droppedTickCount = droppedTickCount;
+    stats.overrunCount = overrunCount;
+    stats.minTickTime = minTickTime;
+    stats.maxTickTime = maxTickTime;
+    if (tickCount == 0)
+        return stats;
+
+    stats.averageTickTime = totalTickTime / static_cast<double>(tickCount);
+    stats.averageLateness = totalLateness / static_cast<double>(tickCount);
+
+    // percentile of the recent ticks
+    std::vector<float> recentTimes(tickTimes.begin(), tickTimes.begin() + std::min<uint64_t>(tickCount, TICK_TIME_HISTORY));
+    size_t p99Index = (recentTimes.size() * 99) / 100;
+    std::nth_element(recentTimes.begin(), recentTimes.begin() + p99Index, recentTimes.end());
+    stats.p99TickTime = recentTimes[p99Index];
+    return stats;
+}
+
+void SimulationLoop::PrintStats() const
+{
+    Stats stats = GetStats();
+    std::cout << "info: simulation:" << std::endl;
+    std::cout << std::format("\tticks {} at {:.1f} hz, dropped {}, overruns {}",
+                             stats.tickCount,
+                             stats.tickRate,
+                             stats.droppedTickCount,
+                             stats.overrunCount) << std::endl;
+    std::cout << std::format("\ttick time: avg {:.3f} ms, min {:.3f} ms, max {:.3f} ms, p99 {:.3f} ms, lateness avg {:.3f} ms",
+                             stats.averageTickTime,
+                             stats.minTickTime,
+                             stats.maxTickTime,
+                             stats.p99TickTime,
+                             stats.averageLateness) << std::endl;
+}
+
+void SimulationLoop::ResetStats()
+{
+    tickCount = 0;
+    droppedTickCount = 0;
+    overrunCount = 0;
+    totalTickTime = 0.0;
+    minTickTime = 0.0;
+    maxTickTime = 0.0;
+    totalLateness = 0.0;
+}
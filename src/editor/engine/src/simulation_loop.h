@@ -0,0 +1,81 @@
+#ifndef ARCTIC_SIMULATION_LOOP_H
+#define ARCTIC_SIMULATION_LOOP_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+// fixed rate simulation tick
+//> the simulation always advances by the same delta time, independent of the frame rate (client) or load (server)
+//> the client calls 'Advance' once per frame, the server blocks in 'Run' and sleeps between ticks
+class SimulationLoop
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using TickFunc = std::function<void(double deltaTime)>;
+
+    static constexpr double DEFAULT_TICK_RATE = 60.0; // hz
+    static constexpr uint32_t MAX_CATCH_UP_TICKS = 5; // per advance, older due ticks are dropped so a stall can not snowball
+    static constexpr uint32_t TICK_TIME_HISTORY = 1024; // recent ticks kept for percentiles
+
+    struct Stats
+    {
+        double tickRate; // hz
+        uint64_t tickCount;
+        uint64_t droppedTickCount; // skipped to catch up after a stall
+        uint64_t overrunCount; // ticks that took longer than the tick period
+        double averageTickTime; // ms
+        double minTickTime; // ms
+        double maxTickTime; // ms
+        double p99TickTime; // ms, of the recent ticks
+        double averageLateness; // ms, start of a tick after its scheduled time
+    };
+
+    void Initialize(double tickRate, TickFunc tickFunc);
+    void SetTickFunc(TickFunc tickFunc) {
+        tick = std::move(tickFunc);
+    }
+
+    // runs the ticks that are due, returns how many ran
+    uint32_t Advance();
+
+    // ticks at the fixed rate until 'RequestStop' or 'tickLimit' ticks (zero: no limit)
+    void Run(uint64_t tickLimit = 0);
+    // thread & signal safe
+    void RequestStop() {
+        isStopRequested.store(true, std::memory_order_relaxed);
+    }
+    bool IsStopRequested() const {
+        return isStopRequested.load(std::memory_order_relaxed);
+    }
+
+    Stats GetStats() const;
+    void PrintStats() const;
+    void ResetStats();
+
+private:
+    double tickRate = DEFAULT_TICK_RATE;
+    Clock::duration tickPeriod{};
+    TickFunc tick;
+    Clock::time_point nextTickTime{};
+    bool isStarted = false;
+    std::atomic<bool> isStopRequested = false;
+
+    // stats
+    uint64_t tickCount = 0;
+    uint64_t droppedTickCount = 0;
+    uint64_t overrunCount = 0;
+    double totalTickTime = 0.0;
+    double minTickTime = 0.0;
+    double maxTickTime = 0.0;
+    double totalLateness = 0.0;
+    std::array<float, TICK_TIME_HISTORY> tickTimes{};
+
+    uint32_t advance(uint64_t tickLimit); // zero: no limit
+    void runTick(Clock::time_point scheduledTime);
+};
+
+#endif //ARCTIC_SIMULATION_LOOP_H
@@ -0,0 +1,254 @@
+#include "startup_graph.h"
+#include "utilities/job_system.h"
+#include "utilities/logger.h"
+#include <algorithm>
+#include <format>
+#include <iostream>
+
+namespace
+{
+    double toMilliseconds(StartupGraph::Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    const char* getThreadName(StartupGraph::PhaseThread thread)
+    {
+        switch (thread)
+        {
+            case StartupGraph::PhaseThread::Main: return "main";
+            case StartupGraph::PhaseThread::Worker: return "worker";
+            case StartupGraph::PhaseThread::IO: return "io";
+        }
+        return "unknown";
+    }
+
+    const char* getStateName(StartupGraph::PhaseState state)
+    {
+        switch (state)
+        {
+            case StartupGraph::PhaseState::Pending: return "pending";
+            case StartupGraph::PhaseState::Succeeded: return "";
+            case StartupGraph::PhaseState::Failed: return "failed";
+            case StartupGraph::PhaseState::Skipped: return "skipped";
+        }
+        return "unknown";
+    }
+}
+
+StartupGraph::PhaseId StartupGraph::Add(const std::string& name, PhaseThread thread, std::initializer_list<PhaseId> dependencies, PhaseFunc func)
+{
+    PhaseId id = static_cast<PhaseId>(phases.size());
+
+    Phase phase{};
+    phase.name = name;
+    phase.thread = thread;
+    phase.func = std::move(func);
+    phase.state = PhaseState::Pending;
+    for (PhaseId dependency : dependencies)
+    {
+        //> also rules out cycles
+        if (dependency >= id)
+        {
+            ARCTIC_LOG_ERROR(General, "startup phase {} depends on a phase added after it!", name);
+            continue;
+        }
+        phase.dependencies.push_back(dependency);
+        phases[dependency].dependents.push_back(id);
+    }
+    phase.remainingCount = static_cast<uint32_t>(phase.dependencies.size());
+    phases.push_back(std::move(phase));
+    return id;
+}
+
+bool StartupGraph::Run(JobSystem& jobs)
+{
+    jobSystem = &jobs;
+    runStartTime = Clock::now();
+    finishedCount = 0;
+
+    // start phases without dependencies
+    for (PhaseId id = 0; id < phases.size(); ++id)
+    {
+        if (phases[id].dependencies.empty())
+            dispatch(id);
+    }
+
+    // run main thread phases until everything finished
+    {
+        std::unique_lock lock(mutex);
+        while (finishedCount < phases.size())
+        {
+            condition.wait(lock, [this]() { return !mainQueue.empty() || finishedCount == phases.size(); });
+            if (mainQueue.empty())
+                continue;
+
+            PhaseId id = mainQueue.front();
+            mainQueue.pop_front();
+            lock.unlock();
+            runPhase(id);
+            lock.lock();
+        }
+    }
+    runEndTime = Clock::now();
+
+    return std::none_of(phases.begin(), phases.end(), [](const Phase& phase) {
+        return phase.state != PhaseState::Succeeded;
+    });
+}
+
+void StartupGraph::dispatch(PhaseId id)
+{
+    switch (phases[id].thread)
+    {
+        case PhaseThread::Main:
+        {
+            std::lock_guard lock(mutex);
+            mainQueue.push_back(id);
+            condition.notify_all();
+            break;
+        }
+        case PhaseThread::Worker:
+            jobSystem->Schedule([this, id]() { runPhase(id); }, JobQueue::Worker);
+            break;
+        case PhaseThread::IO:
+            jobSystem->Schedule([this, id]() { runPhase(id); }, JobQueue::IO);
+            break;
+    }
+}
+
+void StartupGraph::runPhase(PhaseId id)
+{
+    Phase& phase = phases[id];
+    phase.startTime = Clock::now();
+    bool isSucceeded = phase.func();
+    phase.endTime = Clock::now();
+
+    if (!isSucceeded)
+        ARCTIC_LOG_ERROR(General, "startup phase {} failed!", phase.name);
+    finish(id, isSucceeded ? PhaseState::Succeeded : PhaseState::Failed);
+}
+
+void StartupGraph::finish(PhaseId id, PhaseState state)
+{
+    // publish & release dependents
+    //> notified under the lock, 'Run' can return (and the graph go away) as soon as the lock is released
+    std::vector<PhaseId> readyPhases;
+    {
+        std::lock_guard lock(mutex);
+        phases[id].state = state;
+        for (PhaseId dependent : phases[id].dependents)
+        {
+            if (state != PhaseState::Succeeded)
+                phases[dependent].isDependencyFailed = true;
+            if (--phases[dependent].remainingCount == 0)
+                readyPhases.push_back(dependent);
+        }
+        ++finishedCount;
+        condition.notify_all();
+    }
+
+    // start dependents
+    //> their counts reached zero, no other thread touches them anymore
+    for (PhaseId dependent : readyPhases)
+    {
+        Phase& phase = phases[dependent];
+        if (phase.isDependencyFailed)
+        {
+            phase.startTime = phase.endTime = Clock::now();
+            finish(dependent, PhaseState::Skipped);
+        }
+        else
+        {
+            dispatch(dependent);
+        }
+    }
+}
+
+std::vector<bool> StartupGraph::findCriticalPath() const
+{
+    // walk back from the phase that finished last, always to the dependency that finished last
+    std::vector<bool> isCritical(phases.size(), false);
+    if (phases.empty())
+        return isCritical;
+
+    auto finishedLater = [this](PhaseId a, PhaseId b) {
+        return phases[a].endTime < phases[b].endTime;
+    };
+
+    std::vector<PhaseId> ids(phases.size());
+    for (PhaseId id = 0; id < phases.size(); ++id)
+        ids[id] = id;
+    PhaseId current = *std::max_element(ids.begin(), ids.end(), finishedLater);
+    while (true)
+    {
+        isCritical[current] = true;
+        const auto& dependencies = phases[current].dependencies;
+        if (dependencies.empty())
+            break;
+        current = *std::max_element(dependencies.begin(), dependencies.end(), finishedLater);
+    }
+    return isCritical;
+}
+
+std::vector<StartupGraph::PhaseTiming> StartupGraph::GetTimings() const
+{
+    std::vector<bool> isCritical = findCriticalPath();
+
+    std::vector<PhaseTiming> timings;
+    timings.reserve(phases.size());
+    for (PhaseId id = 0; id < phases.size(); ++id)
+    {
+        const Phase& phase = phases[id];
+        timings.push_back({phase.name,
+                           phase.thread,
+                           phase.state,
+                           toMilliseconds(phase.startTime - runStartTime),
+                           toMilliseconds(phase.endTime - phase.startTime),
+                           isCritical[id]});
+    }
+    return timings;
+}
+
+double StartupGraph::GetTotalTime() const
+{
+    return toMilliseconds(runEndTime - runStartTime);
+}
+
+void StartupGraph::PrintReport() const
+{
+    std::vector<PhaseTiming> timings = GetTimings();
+    std::sort(timings.begin(), timings.end(), [](const PhaseTiming& a, const PhaseTiming& b) {
+        return a.startTime < b.startTime;
+    });
+
+    // parallelism: summed phase time over wall time
+    double phaseTime = 0.0;
+    double mainThreadTime = 0.0;
+    for (const auto& timing : timings)
+    {
+        phaseTime += timing.duration;
+        if (timing.thread == PhaseThread::Main)
+            mainThreadTime += timing.duration;
+    }
+    double totalTime = GetTotalTime();
+
+    std::cout << "info: startup:" << std::endl;
+    std::cout << std::format("\ttotal {:.2f} ms, {} phases, {:.2f} ms of work ({:.2f}x parallel), main thread {:.2f} ms",
+                             totalTime,
+                             timings.size(),
+                             phaseTime,
+                             totalTime > 0.0 ? phaseTime / totalTime : 0.0,
+                             mainThreadTime) << std::endl;
+    std::cout << std::format("\t{:>9} {:>9}  {:<6}  {}", "start ms", "took ms", "thread", "phase (* critical path)") << std::endl;
+    for (const auto& timing : timings)
+    {
+        std::cout << std::format("\t{:>9.2f} {:>9.2f}  {:<6}  {}{} {}",
+                                 timing.startTime,
+                                 timing.duration,
+                                 getThreadName(timing.thread),
+                                 timing.isCritical ? "* " : "  ",
+                                 timing.name,
+                                 getStateName(timing.state)) << std::endl;
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef ARCTIC_STARTUP_GRAPH_H
+#define ARCTIC_STARTUP_GRAPH_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+// startup as a dependency graph of timed phases
+//> a phase starts as soon as all of its dependencies finished, independent phases overlap
+//> (e.g. file reads & pipeline compilation next to window & device creation)
+//> phases that touch glfw or upload through the main thread's asset manager are pinned to the main thread,
+//> which runs them in between waiting for the rest
+//> a failed phase skips everything that depends on it, unrelated phases still run
+class StartupGraph
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using PhaseId = uint32_t;
+    using PhaseFunc = std::function<bool()>; // returns false on failure
+
+    enum class PhaseThread : uint8_t
+    {
+        Main,
+        Worker,
+        IO
+    };
+
+    enum class PhaseState : uint8_t
+    {
+        Pending,
+        Succeeded,
+        Failed,
+        Skipped // a dependency failed
+    };
+
+    struct PhaseTiming
+    {
+        std::string name;
+        PhaseThread thread;
+        PhaseState state;
+        double startTime; // ms since 'Run'
+        double duration; // ms
+        bool isCritical; // on the longest dependency chain, shortening it shortens startup
+    };
+
+    // dependencies must be added before their dependents
+    PhaseId Add(const std::string& name, PhaseThread thread, std::initializer_list<PhaseId> dependencies, PhaseFunc func);
+
+    // blocks until every phase finished or was skipped, returns false if any failed
+    bool Run(JobSystem& jobSystem);
+
+    // valid after 'Run'
+    std::vector<PhaseTiming> GetTimings() const;
+    double GetTotalTime() const; // ms
+    void PrintReport() const;
+
+private:
+    struct Phase
+    {
+        std::string name;
+        PhaseThread thread;
+        PhaseFunc func;
+        std::vector<PhaseId> dependencies;
+        std::vector<PhaseId> dependents;
+        uint32_t remainingCount; // unfinished dependencies
+        bool isDependencyFailed;
+        PhaseState state;
+        Clock::time_point startTime;
+        Clock::time_point endTime;
+    };
+
+    std::vector<Phase> phases;
+    Clock::time_point runStartTime{};
+    Clock::time_point runEndTime{};
+
+    // scheduling
+    //> guarded by the mutex: dependency counts, states & the main thread queue
+    JobSystem* jobSystem = nullptr;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<PhaseId> mainQueue;
+    uint32_t finishedCount = 0;
+
+    void dispatch(PhaseId id);
+    void runPhase(PhaseId id);
+    void finish(PhaseId id, PhaseState state);
+    std::vector<bool> findCriticalPath() const;
+};
+
+#endif //ARCTIC_STARTUP_GRAPH_H
@@ -0,0 +1,328 @@
+#include "vulkan_host_allocator.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+VulkanHostAllocator::VulkanHostAllocator()
+{
+    // setup pools
+    for (uint32_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+        pools[i].blockSize = MIN_BLOCK_SIZE << i;
+
+    // create info: allocation callbacks
+    callbacks.pUserData = this;
+    callbacks.pfnAllocation = vulkanAllocation;
+    callbacks.pfnReallocation = vulkanReallocation;
+    callbacks.pfnFree = vulkanFree;
+    callbacks.pfnInternalAllocation = vulkanInternalAllocation;
+    callbacks.pfnInternalFree = vulkanInternalFree;
+}
+
+VulkanHostAllocator::~VulkanHostAllocator()
+{
+    // release chunks
+    //> blocks still in use at this point are leaked by the driver, they are reported by 'PrintStats'
+    for (auto& pool : pools)
+    {
+        for (void* chunk : pool.chunks)
+            ::operator delete(chunk, std::align_val_t(HEADER_SIZE));
+        pool.chunks.clear();
+    }
+}
+
+void* VulkanHostAllocator::Allocate(size_t size, size_t alignment, VkSystemAllocationScope scope)
+{
+    if (size == 0)
+        return nullptr;
+
+    alignment = std::max(alignment, HEADER_SIZE);
+
+    // pooled allocation
+    //> blocks are 'HEADER_SIZE' aligned, so user data is as well
+    uint8_t* base = nullptr;
+    uint16_t sizeClass = LARGE_SIZE_CLASS;
+    uint32_t offset = HEADER_SIZE;
+    if (alignment == HEADER_SIZE)
+        sizeClass = findSizeClass(size + HEADER_SIZE);
+
+    if (sizeClass != LARGE_SIZE_CLASS)
+    {
+        base = static_cast<uint8_t*>(allocatePooled(sizeClass));
+    }
+    // large or over-aligned allocation
+    //> header is placed right in front of the aligned user data
+    else
+    {
+        offset = static_cast<uint32_t>(alignment);
+        base = static_cast<uint8_t*>(::operator new(size + alignment, std::align_val_t(alignment), std::nothrow));
+        largeAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (base == nullptr)
+        return nullptr;
+
+    // write header
+    uint8_t* memory = base + offset;
+    auto* header = reinterpret_cast<AllocationHeader*>(memory - HEADER_SIZE);
+    header->size = size;
+    header->sizeClass = sizeClass;
+    header->scope = static_cast<uint16_t>(scope);
+    header->offset = offset;
+
+    trackAllocation(scope, size);
+    return memory;
+}
+
+void* VulkanHostAllocator::Reallocate(void* original, size_t size, size_t alignment, VkSystemAllocationScope scope)
+{
+    // behaves as allocate or free on edge cases (see vulkan spec: PFN_vkReallocationFunction)
+    if (original == nullptr)
+        return Allocate(size, alignment, scope);
+
+    if (size == 0)
+    {
+        Free(original);
+        return nullptr;
+    }
+
+    auto* header = reinterpret_cast<AllocationHeader*>(static_cast<uint8_t*>(original) - HEADER_SIZE);
+    size_t originalSize = header->size;
+
+    // re-use block when it still fits
+    if (header->sizeClass != LARGE_SIZE_CLASS &&
+        alignment <= HEADER_SIZE &&
+        size + HEADER_SIZE <= pools[header->sizeClass].blockSize)
+    {
+        trackFree(header->scope, originalSize);
+        trackAllocation(scope, size);
+        header->size = size;
+        header->scope = static_cast<uint16_t>(scope);
+        counters[scope].reallocationCount.fetch_add(1, std::memory_order_relaxed);
+        return original;
+    }
+
+    // move to new allocation
+    void* memory = Allocate(size, alignment, scope);
+    if (memory == nullptr)
+        return nullptr; // original must stay valid
+
+    std::memcpy(memory, original, std::min(originalSize, size));
+    Free(original);
+
+    counters[scope].reallocationCount.fetch_add(1, std::memory_order_relaxed);
+    return memory;
+}
+
+void VulkanHostAllocator::Free(void* memory)
+{
+    if (memory == nullptr)
+        return;
+
+    // read header
+    auto* header = reinterpret_cast<AllocationHeader*>(static_cast<uint8_t*>(memory) - HEADER_SIZE);
+    uint16_t sizeClass = header->sizeClass;
+    uint8_t* base = static_cast<uint8_t*>(memory) - header->offset;
+    trackFree(header->scope, header->size);
+
+    // release memory
+    if (sizeClass != LARGE_SIZE_CLASS)
+        freePooled(base, sizeClass);
+    else
+        ::operator delete(base, std::align_val_t(header->offset));
+}
+
+uint16_t VulkanHostAllocator::findSizeClass(size_t blockSize)
+{
+    uint32_t classSize = MIN_BLOCK_SIZE;
+    for (uint16_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+    {
+        if (blockSize <= classSize)
+            return i;
+        classSize <<= 1;
+    }
+    return LARGE_SIZE_CLASS;
+}
+
+void* VulkanHostAllocator::allocatePooled(uint16_t sizeClass)
+{
+    SizeClassPool& pool = pools[sizeClass];
+    std::lock_guard lock(pool.mutex);
+
+    // add new chunk when free list is empty
+    //> chunk is carved into blocks that are linked through their first bytes
+    if (pool.freeList == nullptr)
+    {
+        auto* chunk = static_cast<uint8_t*>(::operator new(CHUNK_SIZE, std::align_val_t(HEADER_SIZE), std::nothrow));
+        if (chunk == nullptr)
+            return nullptr;
+
+        pool.chunks.push_back(chunk);
+
+        const uint32_t blockCount = CHUNK_SIZE / pool.blockSize;
+        for (uint32_t i = 0; i < blockCount; ++i)
+        {
+            void* block = chunk + i * pool.blockSize;
+            *static_cast<void**>(block) = pool.freeList;
+            pool.freeList = block;
+        }
+    }
+
+    // pop block
+    void* block = pool.freeList;
+    pool.freeList = *static_cast<void**>(block);
+    ++pool.usedBlockCount;
+    return block;
+}
+
+void VulkanHostAllocator::freePooled(void* block, uint16_t sizeClass)
+{
+    SizeClassPool& pool = pools[sizeClass];
+    std::lock_guard lock(pool.mutex);
+
+    // push block
+    *static_cast<void**>(block) = pool.freeList;
+    pool.freeList = block;
+    --pool.usedBlockCount;
+}
+
+void VulkanHostAllocator::trackAllocation(uint32_t scope, uint64_t size)
+{
+    ScopeCounters& scopeCounters = counters[scope];
+    scopeCounters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+    scopeCounters.liveCount.fetch_add(1, std::memory_order_relaxed);
+    uint64_t liveBytes = scopeCounters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+    // update peak
+    uint64_t peakBytes = scopeCounters.peakBytes.load(std::memory_order_relaxed);
+    while (liveBytes > peakBytes &&
+           !scopeCounters.peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed));
+}
+
+void VulkanHostAllocator::trackFree(uint32_t scope, uint64_t size)
+{
+    ScopeCounters& scopeCounters = counters[scope];
+    scopeCounters.freeCount.fetch_add(1, std::memory_order_relaxed);
+    scopeCounters.liveCount.fetch_sub(1, std::memory_order_relaxed);
+    scopeCounters.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+VulkanHostAllocator::Stats VulkanHostAllocator::GetStats() const
+{
+    Stats stats{};
+
+    // scopes
+    for (uint32_t i = 0; i < SCOPE_COUNT; ++i)
+    {
+        const ScopeCounters& scopeCounters = counters[i];
+        ScopeStats& scopeStats = stats.scopes[i];
+        scopeStats.allocationCount = scopeCounters.allocationCount.load(std::memory_order_relaxed);
+        scopeStats.freeCount = scopeCounters.freeCount.load(std::memory_order_relaxed);
+        scopeStats.reallocationCount = scopeCounters.reallocationCount.load(std::memory_order_relaxed);
+        scopeStats.liveCount = scopeCounters.liveCount.load(std::memory_order_relaxed);
+        scopeStats.liveBytes = scopeCounters.liveBytes.load(std::memory_order_relaxed);
+        scopeStats.peakBytes = scopeCounters.peakBytes.load(std::memory_order_relaxed);
+        scopeStats.internalBytes = scopeCounters.internalBytes.load(std::memory_order_relaxed);
+    }
+
+    // pools
+    //> the chunk list grows under the pool lock while the driver allocates
+    for (uint32_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+    {
+        std::lock_guard lock(pools[i].mutex);
+        stats.pools[i].blockSize = pools[i].blockSize;
+        stats.pools[i].chunkCount = pools[i].chunks.size();
+        stats.pools[i].usedBlockCount = pools[i].usedBlockCount;
+    }
+
+    stats.largeAllocationCount = largeAllocationCount.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void VulkanHostAllocator::PrintStats() const
+{
+    Stats stats = GetStats();
+
+    std::cout << "info: vulkan: host allocations:" << std::endl;
+    for (uint32_t i = 0; i < SCOPE_COUNT; ++i)
+    {
+        const ScopeStats& scopeStats = stats.scopes[i];
+        std::cout << "\t" << GetScopeName(i)
+                  << ": live " << scopeStats.liveCount << " (" << scopeStats.liveBytes << " bytes)"
+                  << ", peak " << scopeStats.peakBytes << " bytes"
+                  << ", allocs " << scopeStats.allocationCount
+                  << ", frees " << scopeStats.freeCount
+                  << ", reallocs " << scopeStats.reallocationCount
+                  << ", internal " << scopeStats.internalBytes << " bytes" << std::endl;
+    }
+
+    std::cout << "info: vulkan: host allocation pools:" << std::endl;
+    for (const auto& poolStats : stats.pools)
+    {
+        std::cout << "\t" << poolStats.blockSize << " bytes"
+                  << ": chunks " << poolStats.chunkCount
+                  << ", used blocks " << poolStats.usedBlockCount << std::endl;
+    }
+    std::cout << "\tlarge allocations: " << stats.largeAllocationCount << std::endl;
+}
+
+const char* VulkanHostAllocator::GetScopeName(uint32_t scope)
+{
+    switch (scope)
+    {
+        case VK_SYSTEM_ALLOCATION_SCOPE_COMMAND: return "command";
+        case VK_SYSTEM_ALLOCATION_SCOPE_OBJECT: return "object";
+        case VK_SYSTEM_ALLOCATION_SCOPE_CACHE: return "cache";
+        case VK_SYSTEM_ALLOCATION_SCOPE_DEVICE: return "device";
+        case VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE: return "instance";
+        default: return "unknown";
+    }
+}
+
+#pragma region vulkan_callbacks
+
+VKAPI_ATTR void* VKAPI_CALL VulkanHostAllocator::vulkanAllocation(
+        void* pUserData,
+        size_t size,
+        size_t alignment,
+        VkSystemAllocationScope allocationScope)
+{
+    return static_cast<VulkanHostAllocator*>(pUserData)->Allocate(size, alignment, allocationScope);
+}
+
+VKAPI_ATTR void* VKAPI_CALL VulkanHostAllocator::vulkanReallocation(
+        void* pUserData,
+        void* pOriginal,
+        size_t size,
+        size_t alignment,
+        VkSystemAllocationScope allocationScope)
+{
+    return static_cast<VulkanHostAllocator*>(pUserData)->Reallocate(pOriginal, size, alignment, allocationScope);
+}
+
+VKAPI_ATTR void VKAPI_CALL VulkanHostAllocator::vulkanFree(void* pUserData, void* pMemory)
+{
+    static_cast<VulkanHostAllocator*>(pUserData)->Free(pMemory);
+}
+
+VKAPI_ATTR void VKAPI_CALL VulkanHostAllocator::vulkanInternalAllocation(
+        void* pUserData,
+        size_t size,
+        VkInternalAllocationType allocationType,
+        VkSystemAllocationScope allocationScope)
+{
+    auto* allocator = static_cast<VulkanHostAllocator*>(pUserData);
+    allocator->counters[allocationScope].internalBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+VKAPI_ATTR void VKAPI_CALL VulkanHostAllocator::vulkanInternalFree(
+        void* pUserData,
+        size_t size,
+        VkInternalAllocationType allocationType,
+        VkSystemAllocationScope allocationScope)
+{
+    auto* allocator = static_cast<VulkanHostAllocator*>(pUserData);
+    allocator->counters[allocationScope].internalBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+#pragma endregion vulkan_callbacks
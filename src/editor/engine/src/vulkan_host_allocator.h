@@ -0,0 +1,118 @@
+#ifndef ARCTIC_VULKAN_HOST_ALLOCATOR_H
+#define ARCTIC_VULKAN_HOST_ALLOCATOR_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+// engine provided host allocator for the vulkan driver
+//> small allocations are served from size-class pools, larger or over-aligned allocations go to the system heap
+//> every allocation is tracked per 'VkSystemAllocationScope'
+class VulkanHostAllocator
+{
+public:
+    static constexpr uint32_t SCOPE_COUNT = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1;
+    static constexpr uint32_t SIZE_CLASS_COUNT = 8; // 32, 64, ..., 4096 bytes
+    static constexpr uint32_t MIN_BLOCK_SIZE = 32;
+    static constexpr uint32_t CHUNK_SIZE = 64 * 1024;
+
+    struct ScopeStats
+    {
+        uint64_t allocationCount = 0; // total allocations (churn)
+        uint64_t freeCount = 0;
+        uint64_t reallocationCount = 0;
+        uint64_t liveCount = 0;
+        uint64_t liveBytes = 0;
+        uint64_t peakBytes = 0;
+        uint64_t internalBytes = 0; // driver internal allocations (notifications only)
+    };
+
+    struct PoolStats
+    {
+        uint32_t blockSize = 0;
+        uint64_t chunkCount = 0;
+        uint64_t usedBlockCount = 0;
+    };
+
+    struct Stats
+    {
+        std::array<ScopeStats, SCOPE_COUNT> scopes;
+        std::array<PoolStats, SIZE_CLASS_COUNT> pools;
+        uint64_t largeAllocationCount = 0;
+    };
+
+    VulkanHostAllocator();
+    ~VulkanHostAllocator();
+
+    VulkanHostAllocator(const VulkanHostAllocator&) = delete;
+    VulkanHostAllocator& operator=(const VulkanHostAllocator&) = delete;
+
+    const VkAllocationCallbacks* GetCallbacks() const {
+        return &callbacks;
+    }
+
+    void* Allocate(size_t size, size_t alignment, VkSystemAllocationScope scope);
+    void* Reallocate(void* original, size_t size, size_t alignment, VkSystemAllocationScope scope);
+    void Free(void* memory);
+
+    Stats GetStats() const;
+    void PrintStats() const;
+
+    static const char* GetScopeName(uint32_t scope);
+
+private:
+    // header stored in front of every allocation
+    struct AllocationHeader
+    {
+        uint64_t size;
+        uint16_t sizeClass; // LARGE_SIZE_CLASS when not pooled
+        uint16_t scope;
+        uint32_t offset; // distance from the start of the system allocation
+    };
+    static constexpr uint16_t LARGE_SIZE_CLASS = 0xFFFF;
+    static constexpr size_t HEADER_SIZE = 16;
+    static_assert(sizeof(AllocationHeader) <= HEADER_SIZE);
+
+    struct SizeClassPool
+    {
+        mutable std::mutex mutex;
+        void* freeList = nullptr;
+        std::vector<void*> chunks;
+        uint32_t blockSize = 0;
+        uint64_t usedBlockCount = 0;
+    };
+
+    struct ScopeCounters
+    {
+        std::atomic<uint64_t> allocationCount = 0;
+        std::atomic<uint64_t> freeCount = 0;
+        std::atomic<uint64_t> reallocationCount = 0;
+        std::atomic<uint64_t> liveCount = 0;
+        std::atomic<uint64_t> liveBytes = 0;
+        std::atomic<uint64_t> peakBytes = 0;
+        std::atomic<uint64_t> internalBytes = 0;
+    };
+
+    VkAllocationCallbacks callbacks{};
+    std::array<SizeClassPool, SIZE_CLASS_COUNT> pools;
+    std::array<ScopeCounters, SCOPE_COUNT> counters;
+    std::atomic<uint64_t> largeAllocationCount = 0;
+
+    static uint16_t findSizeClass(size_t blockSize);
+    void* allocatePooled(uint16_t sizeClass);
+    void freePooled(void* block, uint16_t sizeClass);
+    void trackAllocation(uint32_t scope, uint64_t size);
+    void trackFree(uint32_t scope, uint64_t size);
+
+    // vulkan callbacks
+    static VKAPI_ATTR void* VKAPI_CALL vulkanAllocation(void* pUserData, size_t size, size_t alignment, VkSystemAllocationScope allocationScope);
+    static VKAPI_ATTR void* VKAPI_CALL vulkanReallocation(void* pUserData, void* pOriginal, size_t size, size_t alignment, VkSystemAllocationScope allocationScope);
+    static VKAPI_ATTR void VKAPI_CALL vulkanFree(void* pUserData, void* pMemory);
+    static VKAPI_ATTR void VKAPI_CALL vulkanInternalAllocation(void* pUserData, size_t size, VkInternalAllocationType allocationType, VkSystemAllocationScope allocationScope);
+    static VKAPI_ATTR void VKAPI_CALL vulkanInternalFree(void* pUserData, size_t size, VkInternalAllocationType allocationType, VkSystemAllocationScope allocationScope);
+};
+
+#endif //ARCTIC_VULKAN_HOST_ALLOCATOR_H
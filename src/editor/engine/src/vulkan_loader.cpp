@@ -1,6 +1,8 @@
 #include "vulkan_loader.h"
 #include "utilities/file_utility.h"
 #include "utilities/application.h"
+#include "vulkan_utility.h"
+#include "utilities/logger.h"
 
 #ifdef WIN32
 #define VK_USE_PLATFORM_WIN32_KHR
@@ -10,10 +12,38 @@
 
 #include <GLFW/glfw3.h>
 #include <GLFW/glfw3native.h>
+#include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <iostream>
 #include <format>
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+    const char* depthFormatName(VkFormat format)
+    {
+        switch (format)
+        {
+            case VK_FORMAT_D32_SFLOAT: return "d32";
+            case VK_FORMAT_D32_SFLOAT_S8_UINT: return "d32s8";
+            case VK_FORMAT_D24_UNORM_S8_UINT: return "d24s8";
+            case VK_FORMAT_D16_UNORM: return "d16";
+            default: return "none";
+        }
+    }
+
+    // culling instance of a draw
+    //> the bounding sphere is moved into the world, its radius grows with the largest axis scale
+    OcclusionCuller::Instance makeCullInstance(const glm::mat4& world, const glm::vec4& bounds, uint32_t vertexCount, uint32_t firstVertex)
+    {
+        float scale = std::max({glm::length(glm::vec3(world[0])), glm::length(glm::vec3(world[1])), glm::length(glm::vec3(world[2]))});
+        glm::vec3 center = glm::vec3(world * glm::vec4(glm::vec3(bounds), 1.0f));
+        return {glm::vec4(center, bounds.w * scale), vertexCount, firstVertex, {0, 0}};
+    }
+}
 
 void VulkanLoader::vulkanCreateInstance()
 {
@@ -24,7 +54,7 @@ void VulkanLoader::vulkanCreateInstance()
     appInfo.applicationVersion = VK_MAKE_VERSION(1,0,0);
     appInfo.pEngineName = "No Engine";
     appInfo.engineVersion = VK_MAKE_VERSION(1,0,0);
-    appInfo.apiVersion = VK_API_VERSION_1_0;
+    appInfo.apiVersion = VK_API_VERSION_1_1; // required for vkGetPhysicalDeviceMemoryProperties2
 
     // create vk instance create info
     VkInstanceCreateInfo createInfo{};
@@ -51,10 +81,10 @@ void VulkanLoader::vulkanCreateInstance()
     createInfo.ppEnabledExtensionNames = extensions.data();
 
     // create vk instance
-    VkResult result = vkCreateInstance(&createInfo, nullptr, &vkInstance);
+    VkResult result = vkCreateInstance(&createInfo, vkAllocator, &vkInstance);
     if( result != VK_SUCCESS)
     {
-        std::cout << "error: vulkan: failed to create instance!";
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create instance!");
         return;
     }
 }
@@ -65,8 +95,9 @@ std::vector<const char*> VulkanLoader::vulkanGetRequiredExtensions()
     std::vector<const char*> extensions;
 
     // get glfw extensions
+    //> headless has no surface to present to
     uint32_t glfwExtensionCount = 0;
-    const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+    const char** glfwExtensions = isHeadless ? nullptr : glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
     for(int i=0; i<glfwExtensionCount; ++i)
     {
         const char* extension = glfwExtensions[i];
@@ -101,7 +132,7 @@ void VulkanLoader::vulkanLoadPhysicalDevice()
 
     if(deviceCount == 0)
     {
-        std::cout << "error: vulkan: did not find physical device!";
+        ARCTIC_LOG_ERROR(Vulkan, "did not find physical device!");
         return;
     }
 
@@ -134,7 +165,7 @@ void VulkanLoader::vulkanLoadPhysicalDevice()
     // final check if device is valid
     if(vkPhysicalDevice == VK_NULL_HANDLE)
     {
-        std::cout << "error: vulkan: did not find suitable physical device!";
+        ARCTIC_LOG_ERROR(Vulkan, "did not find suitable physical device!");
         return;
     }
 }
@@ -163,8 +194,22 @@ void VulkanLoader::vulkanCreateLogicalDevice()
     }
 
     // create device features
-    // >> currently empty
+    //> multi-draw indirect lets the render queue submit a merged run in one call, optional
+    //> indirect first instance lets those draws keep their instance offset (their constants index), optional
+    //> precise occlusion queries count the fragments for the overdraw stats, optional
+    //> pipeline statistics queries count the shader invocations per pass, optional
+    VkPhysicalDeviceFeatures supportedFeatures;
+    vkGetPhysicalDeviceFeatures(vkPhysicalDevice, &supportedFeatures);
+    isMultiDrawIndirectSupported = supportedFeatures.multiDrawIndirect == VK_TRUE;
+    isDrawIndirectFirstInstanceSupported = supportedFeatures.drawIndirectFirstInstance == VK_TRUE;
+    isOverdrawQuerySupported = supportedFeatures.occlusionQueryPrecise == VK_TRUE;
+    isPipelineStatisticsSupported = supportedFeatures.pipelineStatisticsQuery == VK_TRUE;
+
     VkPhysicalDeviceFeatures deviceFeatures{};
+    deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+    deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+    deviceFeatures.occlusionQueryPrecise = supportedFeatures.occlusionQueryPrecise;
+    deviceFeatures.pipelineStatisticsQuery = supportedFeatures.pipelineStatisticsQuery;
 
     // create device info
     VkDeviceCreateInfo createInfo{};
@@ -172,14 +217,24 @@ void VulkanLoader::vulkanCreateLogicalDevice()
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
     createInfo.pEnabledFeatures = &deviceFeatures;
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(requiredDeviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = requiredDeviceExtensions.data();
+
+    // add extensions
+    //> headless never presents, the swap chain extension is left out
+    std::vector<const char*> deviceExtensions;
+    if (!isHeadless)
+        deviceExtensions = requiredDeviceExtensions;
+    isMemoryBudgetSupported = findDeviceExtension(vkPhysicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    if (isMemoryBudgetSupported)
+        deviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
+    createInfo.ppEnabledExtensionNames = deviceExtensions.data();
 
     // create device
-    VkResult result = vkCreateDevice(vkPhysicalDevice, &createInfo, nullptr, &vkDevice);
+    VkResult result = vkCreateDevice(vkPhysicalDevice, &createInfo, vkAllocator, &vkDevice);
     if(result != VK_SUCCESS)
     {
-        std::cout << "error: vulkan: failed to create logical device!";
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create logical device!");
         return;
     }
 
@@ -188,6 +243,18 @@ void VulkanLoader::vulkanCreateLogicalDevice()
 
     // get present queue
     vkGetDeviceQueue(vkDevice, indices.presentFamily.value(), 0, &vkPresentQueue);
+
+    // setup deferred deletions
+    deletionQueue.Initialize(vkDevice, vkAllocator);
+    gpuResources.Initialize(vkPhysicalDevice, vkDevice, vkAllocator, deletionQueue);
+
+    // setup assets
+    //> uploads go through the graphics queue from the main thread
+    if (!assetManager.InitializeDevice(vkPhysicalDevice, vkDevice, vkAllocator, vkGraphicsQueue, indices.graphicsFamily.value(), deletionQueue))
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to setup asset manager!");
+        return;
+    }
 }
 
 bool VulkanLoader::isVkDeviceSuitable(
@@ -213,6 +280,10 @@ bool VulkanLoader::isVkDeviceSuitable(
     if(!foundDeviceExtensions)
         return false;
 
+    // headless does not need a swap chain
+    if(isHeadless)
+        return true;
+
     // check if swap chain is valid
     // >> see device & surface
     SwapChainDeviceSupport swapChainSupport = querySwapChainSupport(device);
@@ -242,8 +313,12 @@ VulkanLoader::QueueFamilyIndices VulkanLoader::findQueueFamilies(const VkPhysica
             queueFamilyIndices.graphicsFamily = familyIndex;
 
         // set present family
+        //> headless never presents, the graphics queue stands in
         VkBool32 isPresentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(device, familyIndex, vkSurface, &isPresentSupport);
+        if(isHeadless)
+            isPresentSupport = (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+        else
+            vkGetPhysicalDeviceSurfaceSupportKHR(device, familyIndex, vkSurface, &isPresentSupport);
         if(isPresentSupport)
             queueFamilyIndices.presentFamily = familyIndex;
 
@@ -254,6 +329,10 @@ VulkanLoader::QueueFamilyIndices VulkanLoader::findQueueFamilies(const VkPhysica
 
 bool VulkanLoader::findRequiredDeviceExtensions(const VkPhysicalDevice & device)
 {
+    // headless requires none
+    if(isHeadless)
+        return true;
+
     // get available device extensions
     uint32_t extensionCount;
     vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
@@ -272,8 +351,69 @@ bool VulkanLoader::findRequiredDeviceExtensions(const VkPhysicalDevice & device)
     return requiredExtensions.empty();
 }
 
+bool VulkanLoader::findDeviceExtension(const VkPhysicalDevice & device, const char* extensionName)
+{
+    // get available device extensions
+    uint32_t extensionCount;
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+
+    std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
+
+    // try find extension
+    for(const auto & extension : availableExtensions)
+    {
+        if(strcmp(extension.extensionName, extensionName) == 0)
+            return true;
+    }
+    return false;
+}
+
 #pragma endregion vulkan_devices
 
+#pragma region vulkan_memory
+
+void VulkanLoader::PrintAllocationStats()
+{
+    // host allocations
+    if (enableHostAllocator)
+        hostAllocator.PrintStats();
+
+    // gpu resources & deferred deletions
+    gpuResources.PrintStats();
+    deletionQueue.PrintStats();
+
+    // device heaps
+    //> budget is an estimate of how much memory the process can allocate without paging
+    if (!isMemoryBudgetSupported || vkPhysicalDevice == VK_NULL_HANDLE)
+        return;
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+    budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    VkPhysicalDeviceMemoryProperties2 memoryProperties{};
+    memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    memoryProperties.pNext = &budgetProperties;
+
+    vkGetPhysicalDeviceMemoryProperties2(vkPhysicalDevice, &memoryProperties);
+
+    std::cout << "info: vulkan: memory heaps:" << std::endl;
+    for (uint32_t i = 0; i < memoryProperties.memoryProperties.memoryHeapCount; ++i)
+    {
+        const VkMemoryHeap& heap = memoryProperties.memoryProperties.memoryHeaps[i];
+        bool isDeviceLocal = (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+
+        std::cout << std::format("\theap {} ({}): usage {} MB, budget {} MB, size {} MB",
+                                 i,
+                                 isDeviceLocal ? "device" : "host",
+                                 budgetProperties.heapUsage[i] / (1024 * 1024),
+                                 budgetProperties.heapBudget[i] / (1024 * 1024),
+                                 heap.size / (1024 * 1024)) << std::endl;
+    }
+}
+
+#pragma endregion vulkan_memory
+
 #pragma region vulkan_presentation
 
 void VulkanLoader::vulkanCreateSwapChain()
@@ -332,10 +472,10 @@ void VulkanLoader::vulkanCreateSwapChain()
     createInfo.oldSwapchain = VK_NULL_HANDLE;
 
     // create swap chain
-    VkResult result = vkCreateSwapchainKHR(vkDevice, &createInfo, nullptr, &vkSwapChain);
+    VkResult result = vkCreateSwapchainKHR(vkDevice, &createInfo, vkAllocator, &vkSwapChain);
     if (result != VK_SUCCESS)
     {
-        std::cout << "error: vulkan: failed to create swap chain!";
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create swap chain!");
         return;
     }
 
@@ -377,10 +517,10 @@ void VulkanLoader::vulkanCreateImageViews()
         createInfo.subresourceRange.layerCount = 1;
 
         // create view
-        VkResult result = vkCreateImageView(vkDevice, &createInfo, nullptr, &swapChainImageViews[i]);
+        VkResult result = vkCreateImageView(vkDevice, &createInfo, vkAllocator, &swapChainImageViews[i]);
         if (result != VK_SUCCESS)
         {
-            std::cout << "error: vulkan: failed to create swap chain image view from image!";
+            ARCTIC_LOG_ERROR(Vulkan, "failed to create swap chain image view from image!");
             return;
         }
     }
@@ -480,7 +620,7 @@ void VulkanLoader::vulkanCreateRenderPass()
     // for the operation that they're going to be involved in next
     // for example: textures and framebuffers in Vulkan are represented by 'VkImage' objects
     colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    colorAttachment.finalLayout = isHeadless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
     // create color attachment reference
     // every subpass references one or more attachment rederences
@@ -489,6 +629,11 @@ void VulkanLoader::vulkanCreateRenderPass()
     colorAttachmentRef.attachment = 0;
     colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
+    // create depth attachment
+    //> shared with the dynamic resolution scene pass, the scene pipelines work in both
+    VkAttachmentDescription attachments[2] = {colorAttachment, VulkanUtility::GetSceneDepthAttachment(depthFormat)};
+    VkAttachmentReference depthAttachmentRef{1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+
     // create sub pass
     //> the index of the attachment in this array is directly referenced from the fragment shader with
     //> "layout(location = 0) out vec4 outColor" directive
@@ -496,12 +641,13 @@ void VulkanLoader::vulkanCreateRenderPass()
     subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
     subpass.colorAttachmentCount = 1;
     subpass.pColorAttachments = &colorAttachmentRef;
+    subpass.pDepthStencilAttachment = &depthAttachmentRef;
 
     // create info: render pass
     VkRenderPassCreateInfo renderPassInfo{};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    renderPassInfo.attachmentCount = 1;
-    renderPassInfo.pAttachments = &colorAttachment;
+    renderPassInfo.attachmentCount = 2;
+    renderPassInfo.pAttachments = attachments;
     renderPassInfo.subpassCount = 1;
     renderPassInfo.pSubpasses = &subpass;
 
@@ -510,56 +656,170 @@ void VulkanLoader::vulkanCreateRenderPass()
     dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
     dependency.dstSubpass = 0;
 
-    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dependency.srcAccessMask = 0;
+    //> the depth of the previous frame is cleared, its writes & the particle collisions reading it have to finish first
+    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+                              VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    dependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
-    dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
-    renderPassInfo.dependencyCount = 1;
-    renderPassInfo.pDependencies = &dependency;
+    //> the particle collisions of the next frame sample the depth
+    VkSubpassDependency depthDependency{};
+    depthDependency.srcSubpass = 0;
+    depthDependency.dstSubpass = VK_SUBPASS_EXTERNAL;
+    depthDependency.srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    depthDependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    depthDependency.dstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    depthDependency.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    VkSubpassDependency dependencies[2] = {dependency, depthDependency};
+    renderPassInfo.dependencyCount = 2;
+    renderPassInfo.pDependencies = dependencies;
 
     // create render pass
-    VkResult resultPipeline = vkCreateRenderPass(vkDevice, &renderPassInfo, nullptr, &vkRenderPass);
+    VkResult resultPipeline = vkCreateRenderPass(vkDevice, &renderPassInfo, vkAllocator, &vkRenderPass);
     if (resultPipeline != VK_SUCCESS)
     {
-        std::cout <<"error: vulkan: failed to create render pass!";
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create render pass!");
         return;
     }
+
+    // create load render pass
+    //> optional, occlusion culling stays off without it
+    VulkanUtility::CreateSceneLoadRenderPass(vkDevice, vkAllocator, swapChainData.imageFormat, colorAttachment.finalLayout,
+                                             depthFormat, vkLoadRenderPass);
 }
 
 void VulkanLoader::vulkanCreatePipeline()
 {
-    // read vertex shader
-    std::vector<char> fileVert;
-    std::string pathVert = std::format("{}/shaders/{}", Application::AssetsPath, "vert.spv");
-    FileUtility::ReadBinaryFile(pathVert, fileVert);
-    VkShaderModule shaderModuleVert;
-    vulkanCreateShaderModule(fileVert, shaderModuleVert);
-
-    // read frag shader
-    std::vector<char> fileFrag;
-    std::string pathFrag= std::format("{}/shaders/{}",Application::AssetsPath, "frag.spv");
-    FileUtility::ReadBinaryFile(pathFrag, fileFrag);
-    VkShaderModule shaderModuleFrag;
-    vulkanCreateShaderModule(fileFrag, shaderModuleFrag);
-
-    // create pipeline: vertex
-    VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
-    vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-    vertShaderStageInfo.module = shaderModuleVert;
-    vertShaderStageInfo.pName = "main";
-
-    // create pipeline: frag
-    VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
-    fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    fragShaderStageInfo.module = shaderModuleFrag;
-    fragShaderStageInfo.pName = "main";
-
-    // combine pipelines
-    VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
+    // read shaders
+    //> feature toggles are declared as specialization constants, one module per stage is enough for all permutations
+    //> stages can already be provided by a capture
+    if (shaderStages.empty() && !vulkanLoadMaterialShaders(DEFAULT_MATERIAL_PATH))
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to load shader stages!");
+        return;
+    }
+
+    // setup clustered lighting
+    //> its set is bound for every permutation, unused bindings are removed with the dead branches
+    if (!clusteredLighting.Initialize(vkPhysicalDevice, vkDevice, vkAllocator, swapChainData.extent, MAX_LIGHT_COUNT, enableReverseZ))
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to setup clustered lighting!");
+        return;
+    }
+
+    // merge stage interfaces
+    shaderInterface = {};
+    for (const auto& shaderStage : shaderStages)
+    {
+        if (!shaderInterface.Merge(shaderStage.reflection))
+        {
+            ARCTIC_LOG_ERROR(Vulkan, "failed to merge shader stage interfaces!");
+            return;
+        }
+    }
+
+    // create pipeline layout
+    //> sets, push constants & vertex input come from the reflected stages
+    //> set 0: light clusters, set 1: frame data, both sets are allocated by their owners so their layouts are used
+    //> in place of the reflected ones (reflection can not tell a dynamic uniform buffer from a plain one)
+    pipelineLayouts.Initialize(vkDevice, vkAllocator);
+    vkPipelineLayout = pipelineLayouts.GetPipelineLayout(shaderInterface, {
+            {0, clusteredLighting.GetDescriptorSetLayout()},
+            {FRAME_DATA_SET, frameData.GetDescriptorSetLayout()}
+    });
+    if (vkPipelineLayout == VK_NULL_HANDLE)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create pipeline layout!");
+        return;
+    }
+
+    // create pipeline cache
+    //> lets the driver re-use compiled state between permutations that share stages
+    VkPipelineCacheCreateInfo pipelineCacheInfo{};
+    pipelineCacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+    VkResult resultPipelineCache = vkCreatePipelineCache(vkDevice, &pipelineCacheInfo, vkAllocator, &vkPipelineCache);
+    if (resultPipelineCache != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create pipeline cache!");
+        return;
+    }
+
+    // setup permutations
+    pipelinePermutations.Initialize(vkDevice, vkAllocator, [this](ShaderPermutation& permutation, VkPipeline& pipeline) {
+        return vulkanCreatePipelinePermutation(permutation, pipeline);
+    });
+
+    // compile default permutation upfront
+    //> with the prepass, opaque draws use its depth only & equal variants
+    if (enableDepthPrepass)
+    {
+        pipelinePermutations.GetPipeline(ShaderPermutation::WithDepthMode(shaderPermutationKey, DepthMode::Prepass));
+        pipelinePermutations.GetPipeline(ShaderPermutation::WithDepthMode(shaderPermutationKey, DepthMode::Equal));
+    }
+    else
+    {
+        pipelinePermutations.GetPipeline(shaderPermutationKey);
+    }
+}
+
+bool VulkanLoader::vulkanLoadMaterialShaders(const std::string& materialPath)
+{
+    // load material
+    //> shaders of the material load in parallel, this blocks until all of them are uploaded
+    AssetHandle<MaterialAsset> material = assetManager.Load<MaterialAsset>(materialPath);
+    if (!material || !assetManager.Wait(*material.Get()))
+        return false;
+
+    // take stages
+    //> the asset owns the module
+    for (const auto& shader : material->shaders)
+        shaderStages.push_back({shader->stage, shader->module, shader->code, shader->reflection, shader});
+
+    return true;
+}
+
+bool VulkanLoader::vulkanCreateShaderStage(std::vector<char> code, VkShaderStageFlagBits stage)
+{
+    // reflect
+    ShaderReflection reflection;
+    if (!reflection.Parse(code) || reflection.stages != static_cast<VkShaderStageFlags>(stage))
+        return false;
+
+    // create shader module
+    VkShaderModule shaderModule;
+    if (!vulkanCreateShaderModule(code, shaderModule))
+        return false;
+
+    shaderStages.push_back({stage, shaderModule, std::move(code), std::move(reflection)});
+    return true;
+}
+
+bool VulkanLoader::vulkanCreatePipelinePermutation(ShaderPermutation& permutation, VkPipeline& pipeline)
+{
+    // create pipeline: shader stages
+    //> every stage is specialized with the same constants, dead branches are removed when the pipeline is compiled
+    //> the depth prepass runs without fragment stage, materials that discard would need it back
+    const VkSpecializationInfo* specializationInfo = permutation.GetSpecializationInfo();
+    const DepthMode depthMode = permutation.GetDepthMode();
+
+    std::vector<VkPipelineShaderStageCreateInfo> shaderStageInfos;
+    for (const auto& shaderStage : shaderStages)
+    {
+        if (depthMode == DepthMode::Prepass && shaderStage.stage == VK_SHADER_STAGE_FRAGMENT_BIT)
+            continue;
+
+        VkPipelineShaderStageCreateInfo shaderStageInfo{};
+        shaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        shaderStageInfo.stage = shaderStage.stage;
+        shaderStageInfo.module = shaderStage.module;
+        shaderStageInfo.pName = "main";
+        shaderStageInfo.pSpecializationInfo = specializationInfo;
+        shaderStageInfos.push_back(shaderStageInfo);
+    }
 
     // create info: dynamic states
     //> while most of the pipeline state needs to be baked into the pipeline state,
@@ -579,14 +839,16 @@ void VulkanLoader::vulkanCreatePipeline()
     //> describes the format of the vertex data that will be passed to the vertex shader
     //> bindings: spacing between data and whether the data is per-vertex or per-instance
     //> attribute descriptions: type of the attributes passed to the vertex shader, which binding to load them from and at which offset
-    // todo: because we're hard coding the vertex data directly in the vertex shader,
-    //       we'll fill in this structure to specify that there is no vertex data to load for now
+    //> reflected from the vertex stage: one interleaved per-vertex binding, no binding when the stage has no inputs
+    std::vector<VkVertexInputAttributeDescription> vertexAttributes = shaderInterface.GetVertexAttributes(0);
+    VkVertexInputBindingDescription vertexBinding{0, shaderInterface.GetVertexStride(), VK_VERTEX_INPUT_RATE_VERTEX};
+
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInputInfo.vertexBindingDescriptionCount = 0;
-    vertexInputInfo.pVertexBindingDescriptions = nullptr; // optional
-    vertexInputInfo.vertexAttributeDescriptionCount = 0;
-    vertexInputInfo.pVertexAttributeDescriptions = nullptr; // optional
+    vertexInputInfo.vertexBindingDescriptionCount = vertexAttributes.empty() ? 0 : 1;
+    vertexInputInfo.pVertexBindingDescriptions = vertexAttributes.empty() ? nullptr : &vertexBinding;
+    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexAttributes.size());
+    vertexInputInfo.pVertexAttributeDescriptions = vertexAttributes.data();
 
     // create info: input assembly
     //> what kind of geometry/topology will be drawn from the vertices
@@ -648,8 +910,19 @@ void VulkanLoader::vulkanCreatePipeline()
     multisampling.alphaToOneEnable = VK_FALSE; // optional
 
     // create info: depth and stencil testing
-    // todo
-    //> for now pass a nullptr to be disabled
+    //> reverse-z keeps the nearer fragment with 'greater', or equal so geometry on the far plane is still drawn
+    //> equal: the prepass already wrote the nearest depth, only the fragments matching it are shaded
+    //> the vertex stage declares 'gl_Position' invariant, so both passes produce the same depth
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable = VK_TRUE;
+    depthStencil.depthWriteEnable = depthMode == DepthMode::Equal ? VK_FALSE : VK_TRUE;
+    if (depthMode == DepthMode::Equal)
+        depthStencil.depthCompareOp = VK_COMPARE_OP_EQUAL;
+    else
+        depthStencil.depthCompareOp = enableReverseZ ? VK_COMPARE_OP_GREATER_OR_EQUAL : VK_COMPARE_OP_LESS_OR_EQUAL;
+    depthStencil.depthBoundsTestEnable = VK_FALSE;
+    depthStencil.stencilTestEnable = VK_FALSE;
 
     // create color blend attachment state
     //> contains the configuration per attached framebuffer
@@ -663,6 +936,8 @@ void VulkanLoader::vulkanCreatePipeline()
 
     VkPipelineColorBlendAttachmentState colorBlendAttachment{};
     colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    if (depthMode == DepthMode::Prepass)
+        colorBlendAttachment.colorWriteMask = 0;
     colorBlendAttachment.blendEnable = VK_TRUE;
     colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
     colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
@@ -671,6 +946,13 @@ void VulkanLoader::vulkanCreatePipeline()
     colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
     colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
 
+    //> overdraw view: additive, the color target counts the shaded fragments per pixel
+    if (permutation.IsFeatureEnabled(ShaderFeature::OverdrawView))
+    {
+        colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+        colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    }
+
     // create info: color blend states
     //> contains the global color blending settings
     //> references the array of structures for all framebuffers and allows you to set blend constants that you can use as blend factors in the calculations
@@ -685,33 +967,18 @@ void VulkanLoader::vulkanCreatePipeline()
     colorBlending.blendConstants[2] = 0.0f; // optional
     colorBlending.blendConstants[3] = 0.0f; // optional
 
-    // create info: pipeline layout
-    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutInfo.setLayoutCount = 0; // optional
-    pipelineLayoutInfo.pSetLayouts = nullptr; // optional
-    pipelineLayoutInfo.pushConstantRangeCount = 0; // optional
-    pipelineLayoutInfo.pPushConstantRanges = nullptr; // optional
-
-    VkResult resultPipelineLayout = vkCreatePipelineLayout(vkDevice, &pipelineLayoutInfo, nullptr, &vkPipelineLayout);
-    if (resultPipelineLayout != VK_SUCCESS)
-    {
-        std::cout <<"error: vulkan: failed to create pipeline layout!";
-        return;
-    }
-
     // create info: graphics pipeline
     VkGraphicsPipelineCreateInfo pipelineInfo{};
     pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pipelineInfo.stageCount = 2;
-    pipelineInfo.pStages = shaderStages;
+    pipelineInfo.stageCount = static_cast<uint32_t>(shaderStageInfos.size());
+    pipelineInfo.pStages = shaderStageInfos.data();
 
     pipelineInfo.pVertexInputState = &vertexInputInfo;
     pipelineInfo.pInputAssemblyState = &inputAssembly;
     pipelineInfo.pViewportState = &viewportState;
     pipelineInfo.pRasterizationState = &rasterizer;
     pipelineInfo.pMultisampleState = &multisampling;
-    pipelineInfo.pDepthStencilState = nullptr; // optional
+    pipelineInfo.pDepthStencilState = &depthStencil;
     pipelineInfo.pColorBlendState = &colorBlending;
     pipelineInfo.pDynamicState = &dynamicState;
 
@@ -724,16 +991,13 @@ void VulkanLoader::vulkanCreatePipeline()
     pipelineInfo.basePipelineIndex = -1; // optional
 
     // info: it is designed to take multiple VkGraphicsPipelineCreateInfo objects and create multiple VkPipeline objects in a single call
-    VkResult resultPipeline = vkCreateGraphicsPipelines(vkDevice, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &vkPipeline);
+    VkResult resultPipeline = vkCreateGraphicsPipelines(vkDevice, vkPipelineCache, 1, &pipelineInfo, vkAllocator, &pipeline);
     if (resultPipeline != VK_SUCCESS)
     {
-        std::cout << "error: vulkan: failed to create pipeline!";
-        return;
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create pipeline!");
+        return false;
     }
-
-    // cleanup shaders
-    vkDestroyShaderModule(vkDevice, shaderModuleVert, nullptr);
-    vkDestroyShaderModule(vkDevice, shaderModuleFrag, nullptr);
+    return true;
 }
 
 bool VulkanLoader::vulkanCreateShaderModule(const std::vector<char>& code, VkShaderModule& shaderModule)
@@ -745,10 +1009,10 @@ bool VulkanLoader::vulkanCreateShaderModule(const std::vector<char>& code, VkSha
     createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
 
     // create shader
-    VkResult result = vkCreateShaderModule(vkDevice, &createInfo, nullptr, &shaderModule);
+    VkResult result = vkCreateShaderModule(vkDevice, &createInfo, vkAllocator, &shaderModule);
     if (result != VK_SUCCESS)
     {
-        std::cout <<"error: vulkan: failed to create shader module!";
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create shader module!");
         return false;
     }
     return true;
@@ -762,9 +1026,11 @@ void VulkanLoader::vulkanCreateFramebuffers()
     // loop over ALL swap chain image views
     for (size_t i = 0; i < swapChainImageViews.size(); i++)
     {
+        //> every framebuffer shares the depth image, single frame in flight
         VkImageView attachments[] =
                 {
-                        swapChainImageViews[i]
+                        swapChainImageViews[i],
+                        depthView
                 };
 
         // create info: frame buffer
@@ -773,17 +1039,17 @@ void VulkanLoader::vulkanCreateFramebuffers()
         VkFramebufferCreateInfo framebufferInfo{};
         framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
         framebufferInfo.renderPass = vkRenderPass;
-        framebufferInfo.attachmentCount = 1;
+        framebufferInfo.attachmentCount = 2;
         framebufferInfo.pAttachments = attachments;
         framebufferInfo.width = swapChainData.extent.width;
         framebufferInfo.height = swapChainData.extent.height;
         framebufferInfo.layers = 1;
 
         // create frame buffer
-        VkResult resultFrameBuffer = vkCreateFramebuffer(vkDevice, &framebufferInfo, nullptr, &swapChainFramebuffers[i]);
+        VkResult resultFrameBuffer = vkCreateFramebuffer(vkDevice, &framebufferInfo, vkAllocator, &swapChainFramebuffers[i]);
         if (resultFrameBuffer != VK_SUCCESS)
         {
-            std::cout <<"error: vulkan: failed to create framebuffer!";
+            ARCTIC_LOG_ERROR(Vulkan, "failed to create framebuffer!");
             return;
         }
     }
@@ -800,10 +1066,10 @@ void VulkanLoader::vulkanCreateCommandPool()
     poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
 
     // create command pool
-    VkResult result = vkCreateCommandPool(vkDevice, &poolInfo, nullptr, &vkCommandPool);
+    VkResult result = vkCreateCommandPool(vkDevice, &poolInfo, vkAllocator, &vkCommandPool);
     if (result != VK_SUCCESS)
     {
-        std::cout << "error: vulkan: failed to create command pool!";
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create command pool!");
         return;
     }
 }
@@ -821,7 +1087,7 @@ void VulkanLoader::vulkanCreateCommandBuffer()
     VkResult result = vkAllocateCommandBuffers(vkDevice, &allocInfo, &vkCommandBuffer);
     if (result != VK_SUCCESS)
     {
-        std::cout << "error: vulkan: failed to create command buffer!";
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create command buffer!");
         return;
     }
 }
@@ -837,59 +1103,637 @@ void VulkanLoader::vulkanRecordCommandBuffer(VkCommandBuffer commandBuffer, uint
     VkResult resultBeginCommandBuffer = vkBeginCommandBuffer(commandBuffer, &beginInfo);
     if (resultBeginCommandBuffer != VK_SUCCESS)
     {
-        std::cout << "error: vulkan: failed to begin command buffer!";
+        ARCTIC_LOG_ERROR(Vulkan, "failed to begin command buffer!");
         return;
     }
 
-    // command buffer: begin render pass
-    VkRenderPassBeginInfo renderPassBeginInfo{};
-    renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    renderPassBeginInfo.renderPass = vkRenderPass;
-    renderPassBeginInfo.framebuffer = swapChainFramebuffers[imageIndex];
+    // pick render extent
+    //> dynamic resolution scales it from the gpu time of the previous frame
+    renderExtent = swapChainData.extent;
+    if (isDynamicResolutionActive)
+    {
+        dynamicResolution.BeginFrame(commandBuffer);
+        renderExtent = dynamicResolution.GetRenderExtent();
+        clusteredLighting.SetScreenExtent(renderExtent);
+    }
 
-    renderPassBeginInfo.renderArea.offset = VkOffset2D {0, 0};
-    renderPassBeginInfo.renderArea.extent = swapChainData.extent;
+    // dump stats of the previous frame
+    //> its gpu time was read just now, its queries after the fence
+    if (isDumpingStats)
+        vulkanDumpFrameStats();
 
-    VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
-    renderPassBeginInfo.clearValueCount = 1;
-    renderPassBeginInfo.pClearValues = &clearColor;
+    // build engine commands
+    auto recordStart = std::chrono::steady_clock::now();
+    frameCommands.Reset();
+    vulkanBuildFrameCommands(frameCommands);
 
-    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    if (isCapturing)
+        vulkanCaptureFrame(frameCommands);
 
-    // command buffer: bind to pipeline
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vkPipeline);
+    // command buffer: pipeline statistics
+    //> the compute passes share one query, it ends before the render pass begins
+    pipelineStatistics.Reset(commandBuffer);
+    pipelineStatistics.Begin(commandBuffer, PipelineStatistics::Pass::Compute);
 
-    // command buffer: set viewport
-    VkViewport viewport{};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = (float) swapChainData.extent.width;
-    viewport.height = (float) swapChainData.extent.height;
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
-    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    // command buffer: bin lights
+    //> compute pass, recorded before the render pass begins
+    if ((shaderPermutationKey & ShaderPermutation::ToBit(ShaderFeature::ClusteredLighting)) != 0)
+        clusteredLighting.RecordBinning(commandBuffer);
 
-    // command buffer: set scissor
-    VkRect2D scissor{};
-    scissor.offset = {0, 0};
-    scissor.extent = swapChainData.extent;
-    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+    // command buffer: simulate particles
+    //> compute passes, recorded before the render pass begins
+    if (isParticleSystemActive)
+    {
+        //> collide with the depth from the second frame on, the first one has not written it yet
+        if (frameCount == 1)
+            particleSystem.SetDepth(depthView, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, swapChainData.extent);
+        particleSystem.SetScreenExtent(renderExtent);
+        particleSystem.RecordSimulation(commandBuffer);
+    }
 
-    // command buffer: draw
-    vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+    // command buffer: cull against the previous frame
+    //> the instances match the draw constants of the frame, the culled draws are read from the culler's buffers
+    if (isOcclusionCullerActive)
+    {
+        occlusionCuller.SetInstances(cullInstances);
+        occlusionCuller.RecordCull(commandBuffer, viewConstants.viewProjection, 0);
+    }
+    pipelineStatistics.End(commandBuffer);
+
+    // command buffer: translate engine commands
+    //> with dynamic resolution the scene goes to the offscreen target, then is upscaled to the swap chain image
+    VkRenderPass sceneRenderPass = isDynamicResolutionActive ? dynamicResolution.GetSceneRenderPass() : vkRenderPass;
+    VkRenderPass sceneLoadRenderPass = isDynamicResolutionActive ? dynamicResolution.GetSceneLoadRenderPass() : vkLoadRenderPass;
+    VkFramebuffer sceneFramebuffer = isDynamicResolutionActive ? dynamicResolution.GetSceneFramebuffer() : swapChainFramebuffers[imageIndex];
+    vulkanExecuteCommandStream(commandBuffer, frameCommands.GetData(), sceneRenderPass, sceneFramebuffer, renderExtent);
+
+    // command buffer: cull against this frame
+    //> the pyramid of the first pass re-tests what phase 0 rejected, those draws continue the scene pass,
+    //> the pyramid of the full frame is used by the next one
+    if (isOcclusionCullerActive)
+    {
+        occlusionCuller.RecordBuildPyramid(commandBuffer, renderExtent);
+        occlusionCuller.RecordCull(commandBuffer, viewConstants.viewProjection, 1);
+        vulkanExecuteCommandStream(commandBuffer, frameCommands.GetData(), sceneLoadRenderPass, sceneFramebuffer, renderExtent, 1);
+        occlusionCuller.RecordBuildPyramid(commandBuffer, renderExtent);
+    }
+
+    // command buffer: upscale
+    if (isDynamicResolutionActive)
+    {
+        pipelineStatistics.Begin(commandBuffer, PipelineStatistics::Pass::Upscale);
+        dynamicResolution.RecordUpscale(commandBuffer, imageIndex);
+        pipelineStatistics.End(commandBuffer);
+    }
 
-    // command buffer: end render pass
-    vkCmdEndRenderPass(commandBuffer);
+    //> cpu time from building the engine commands to the end of the recording, 'frameStats' is reset by the executor
+    frameStats.recordTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - recordStart).count();
 
     // command buffer: end
     VkResult resultEndCommandBuffer = vkEndCommandBuffer(commandBuffer);
     if (resultEndCommandBuffer != VK_SUCCESS)
     {
-        std::cout << "error: vulkan: failed to end command buffer!";
+        ARCTIC_LOG_ERROR(Vulkan, "failed to end command buffer!");
         return;
     }
 }
 
+void VulkanLoader::vulkanBuildFrameCommands(CommandStream& stream)
+{
+    // queue draws
+    //> the instance index of a draw is the index of its constants & of its culling instance
+    drawConstants.clear();
+    drawConstants.push_back({glm::mat4(1.0f), glm::vec4(1.0f)});
+
+    cullInstances.clear();
+    if (isOcclusionCullerActive)
+    {
+        for (const DrawConstants& constants : drawConstants)
+            cullInstances.push_back(makeCullInstance(constants.world, TRIANGLE_BOUNDS, 3, 0));
+    }
+
+    renderQueue.SetDepthPrepass(enableDepthPrepass);
+    renderQueue.Reset();
+    ShaderPermutationKey pipelineKey = shaderPermutationKey;
+    if (isOverdrawViewEnabled)
+        pipelineKey |= ShaderPermutation::ToBit(ShaderFeature::OverdrawView);
+    renderQueue.Submit(RenderQueue::MakeKey(DrawPass::Opaque, pipelineKey, 0, 0, 0.0f), {3, 0, 0});
+    renderQueue.Sort(&jobSystem);
+
+    // begin render pass
+    //> clear to black
+    stream.BeginRenderPass({{0.0f, 0.0f, 0.0f, 1.0f}});
+
+    // set view & draw constants
+    stream.SetViewConstants(&viewConstants, sizeof(ViewConstants));
+    stream.SetDrawConstants(drawConstants.data(), static_cast<uint32_t>(drawConstants.size()), sizeof(DrawConstants));
+
+    // set viewport & scissor
+    //> dynamic state of every pipeline, so it survives the pipeline binds of the queue
+    stream.SetViewport({0.0f, 0.0f, (float) renderExtent.width, (float) renderExtent.height, 0.0f, 1.0f});
+    stream.SetScissor({0, 0, renderExtent.width, renderExtent.height});
+
+    // draw
+    //> binds pipelines on change
+    renderQueue.Record(stream);
+
+    // end render pass
+    stream.EndRenderPass();
+}
+
+void VulkanLoader::setViewConstants(const glm::mat4& view, float fieldOfView, float nearPlane, float farPlane)
+{
+    //> vulkan clip space: depth from zero to one, same projection as the light clusters
+    //> reverse-z swaps the planes, near maps to one & far to zero
+    float aspect = (float) swapChainData.extent.width / (float) std::max(swapChainData.extent.height, 1u);
+    viewConstants.view = view;
+    viewConstants.projection = enableReverseZ ? glm::perspectiveRH_ZO(fieldOfView, aspect, farPlane, nearPlane)
+                                              : glm::perspectiveRH_ZO(fieldOfView, aspect, nearPlane, farPlane);
+    viewConstants.viewProjection = viewConstants.projection * view;
+}
+
+void VulkanLoader::vulkanExecuteCommandStream(
+        VkCommandBuffer commandBuffer,
+        const std::vector<uint8_t>& streamData,
+        VkRenderPass renderPass,
+        VkFramebuffer framebuffer,
+        VkExtent2D extent,
+        uint32_t cullPhase)
+{
+    // culling phase
+    //> phase 1 runs the stream again in a pass that loads the first, only the culled draws are recorded again,
+    //> the counters & queries continue from phase 0, particles are drawn by the last pass
+    const bool isFirstPass = cullPhase == 0;
+    const bool isLastPass = !isOcclusionCullerActive || cullPhase == OcclusionCuller::PHASE_COUNT - 1;
+    const VkQueryPool overdrawQueryPool = isFirstPass ? vkOverdrawQueryPool : VK_NULL_HANDLE;
+    if (isFirstPass)
+        frameStats = {};
+    const GpuBuffer* indirect = gpuResources.Get(indirectBuffer);
+    uint32_t indirectDrawOffset = 0;
+
+    // descriptor sets
+    //> every permutation shares the pipeline layout, so the sets & push constants stay bound across pipeline binds
+    //> other layouts (particles) disturb them, they are bound again with the next pipeline
+    bool areSetsBound = false;
+    VkDescriptorSet frameDataSet = frameData.GetDescriptorSet();
+    bool hasViewConstants = false;
+    uint32_t viewOffset = 0;
+    bool hasDrawConstants = false;
+    uint32_t firstDraw = 0;
+    const bool isFirstDrawPushed = shaderInterface.pushConstantSize >= sizeof(uint32_t);
+
+    // pipeline
+    //> a permutation that failed to compile is not bound, the draws up to the next pipeline are skipped
+    bool isPipelineBound = false;
+
+    // draw counters
+    //> counted from the recorded draws, merged instances included
+    auto countDraw = [this, isFirstPass](const CommandDraw& draw) {
+        if (!isFirstPass)
+            return;
+        ++frameStats.drawCount;
+        frameStats.instanceCount += draw.instanceCount;
+        frameStats.triangleCount += static_cast<uint64_t>(draw.vertexCount / 3) * draw.instanceCount;
+    };
+
+    // culled draws
+    //> the culler writes one draw per instance at its instance index, culled instances draw zero instances
+    //> draws past its instances are not culled, only phase 0 records them
+    auto isCulled = [this](const CommandDraw& draw) {
+        return isOcclusionCullerActive &&
+               static_cast<uint64_t>(draw.firstInstance) + draw.instanceCount <= occlusionCuller.GetInstanceCount();
+    };
+    auto drawCulled = [this, commandBuffer, cullPhase](const CommandDraw& draw) {
+        VkBuffer buffer = occlusionCuller.GetDrawBuffer(cullPhase);
+        VkDeviceSize offset = static_cast<VkDeviceSize>(draw.firstInstance) * sizeof(VkDrawIndirectCommand);
+        //> without 'multiDrawIndirect' an indirect call can only hold a single draw
+        if (isMultiDrawIndirectSupported)
+        {
+            vkCmdDrawIndirect(commandBuffer, buffer, offset, draw.instanceCount, sizeof(VkDrawIndirectCommand));
+            ++frameStats.drawCallCount;
+        }
+        else
+        {
+            for (uint32_t i = 0; i < draw.instanceCount; ++i)
+                vkCmdDrawIndirect(commandBuffer, buffer, offset + i * sizeof(VkDrawIndirectCommand), 1, sizeof(VkDrawIndirectCommand));
+            frameStats.drawCallCount += draw.instanceCount;
+        }
+        frameStats.indirectDrawCount += draw.instanceCount;
+    };
+
+    // overdraw queries
+    //> 0: depth prepass, 1: shading, each begins with the first pipeline of its pass
+    //> the queue sorts the prepass first, so each query is recorded once
+    const uint32_t NO_QUERY = UINT32_MAX;
+    uint32_t activeQuery = NO_QUERY;
+    bool isQueryRecorded[2] = {};
+    if (overdrawQueryPool != VK_NULL_HANDLE)
+    {
+        vkCmdResetQueryPool(commandBuffer, overdrawQueryPool, 0, 2);
+        queriedPixelCount = static_cast<uint64_t>(extent.width) * extent.height;
+    }
+
+    CommandStream::Reader reader(streamData);
+    CommandType type;
+    while (reader.Next(type))
+    {
+        switch (type)
+        {
+            case CommandType::BeginRenderPass:
+            {
+                auto command = reader.Read<CommandBeginRenderPass>();
+
+                VkRenderPassBeginInfo renderPassBeginInfo{};
+                renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+                renderPassBeginInfo.renderPass = renderPass;
+                renderPassBeginInfo.framebuffer = framebuffer;
+
+                renderPassBeginInfo.renderArea.offset = VkOffset2D {0, 0};
+                renderPassBeginInfo.renderArea.extent = extent;
+
+                //> depth clears to the far plane, zero with reverse-z
+                VkClearValue clearValues[2] = {};
+                clearValues[0].color = {{command.clearColor[0], command.clearColor[1], command.clearColor[2], command.clearColor[3]}};
+                clearValues[1].depthStencil = {enableReverseZ ? 0.0f : 1.0f, 0};
+                renderPassBeginInfo.clearValueCount = 2;
+                renderPassBeginInfo.pClearValues = clearValues;
+
+                vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+                break;
+            }
+            case CommandType::EndRenderPass:
+            {
+                // end overdraw query
+                //> particles are blended on top, they are not part of the scene overdraw
+                if (activeQuery != NO_QUERY)
+                {
+                    vkCmdEndQuery(commandBuffer, overdrawQueryPool, activeQuery);
+                    activeQuery = NO_QUERY;
+                }
+                pipelineStatistics.End(commandBuffer);
+
+                // draw particles on top of the scene
+                //> binds its own pipeline layout, the sets have to be bound again afterwards
+                if (isParticleSystemActive && isLastPass)
+                {
+                    pipelineStatistics.Begin(commandBuffer, PipelineStatistics::Pass::Particles);
+                    frameStats.drawCallCount += particleSystem.RecordDraw(commandBuffer);
+                    pipelineStatistics.End(commandBuffer);
+                    areSetsBound = false;
+                }
+
+                vkCmdEndRenderPass(commandBuffer);
+                break;
+            }
+            case CommandType::BindPipeline:
+            {
+                //> selected permutation is compiled on first use
+                auto command = reader.Read<CommandBindPipeline>();
+                VkPipeline pipeline = pipelinePermutations.GetPipeline(command.permutationKey);
+                isPipelineBound = pipeline != VK_NULL_HANDLE;
+                if (!isPipelineBound)
+                    break;
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+                ++frameStats.pipelineBindCount;
+
+                // switch queries with the pass
+                const bool isPrepass = ShaderPermutation::GetDepthMode(command.permutationKey) == DepthMode::Prepass;
+                pipelineStatistics.Begin(commandBuffer, isPrepass ? PipelineStatistics::Pass::DepthPrepass
+                                                                  : PipelineStatistics::Pass::Shading);
+                if (overdrawQueryPool != VK_NULL_HANDLE)
+                {
+                    uint32_t query = isPrepass ? 0 : 1;
+                    if (query != activeQuery && !isQueryRecorded[query])
+                    {
+                        if (activeQuery != NO_QUERY)
+                            vkCmdEndQuery(commandBuffer, overdrawQueryPool, activeQuery);
+                        vkCmdBeginQuery(commandBuffer, overdrawQueryPool, query, VK_QUERY_CONTROL_PRECISE_BIT);
+                        activeQuery = query;
+                        isQueryRecorded[query] = true;
+                    }
+                }
+
+                if (!areSetsBound)
+                {
+                    VkDescriptorSet sets[2] = {clusteredLighting.GetDescriptorSet(), frameDataSet};
+                    uint32_t setCount = hasViewConstants ? 2 : 1;
+                    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vkPipelineLayout, 0, setCount, sets,
+                                            hasViewConstants ? 1 : 0, &viewOffset);
+                    ++frameStats.descriptorSetBindCount;
+                    if (hasDrawConstants && isFirstDrawPushed)
+                        vkCmdPushConstants(commandBuffer, vkPipelineLayout, shaderInterface.pushConstantStages, 0, sizeof(uint32_t), &firstDraw);
+                    areSetsBound = true;
+                }
+                break;
+            }
+            case CommandType::SetViewConstants:
+            {
+                auto command = reader.Read<CommandSetViewConstants>();
+                const uint8_t* constants = reader.Skip(command.size);
+
+                // copy into the ring & bind at its offset
+                //> the set is never written, only bound with another dynamic offset
+                //> before the first pipeline it is bound together with the lighting set
+                FrameDataRing::Allocation allocation{};
+                hasViewConstants = frameData.AllocateView(command.size, allocation);
+                if (!hasViewConstants)
+                    break;
+                std::memcpy(allocation.data, constants, command.size);
+                viewOffset = allocation.offset;
+
+                if (areSetsBound)
+                {
+                    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vkPipelineLayout, FRAME_DATA_SET, 1, &frameDataSet, 1, &viewOffset);
+                    ++frameStats.descriptorSetBindCount;
+                }
+                break;
+            }
+            case CommandType::SetDrawConstants:
+            {
+                auto command = reader.Read<CommandSetDrawConstants>();
+                const size_t size = static_cast<size_t>(command.drawCount) * command.stride;
+                const uint8_t* constants = reader.Skip(size);
+
+                // copy into the ring & push the index of the first draw
+                FrameDataRing::Allocation allocation{};
+                hasDrawConstants = frameData.AllocateDraws(command.drawCount, command.stride, allocation, firstDraw);
+                if (!hasDrawConstants)
+                    break;
+                std::memcpy(allocation.data, constants, size);
+
+                if (areSetsBound && isFirstDrawPushed)
+                    vkCmdPushConstants(commandBuffer, vkPipelineLayout, shaderInterface.pushConstantStages, 0, sizeof(uint32_t), &firstDraw);
+                break;
+            }
+            case CommandType::SetViewport:
+            {
+                auto command = reader.Read<CommandSetViewport>();
+
+                VkViewport viewport{};
+                viewport.x = command.x;
+                viewport.y = command.y;
+                viewport.width = command.width;
+                viewport.height = command.height;
+                viewport.minDepth = command.minDepth;
+                viewport.maxDepth = command.maxDepth;
+                vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+                break;
+            }
+            case CommandType::SetScissor:
+            {
+                auto command = reader.Read<CommandSetScissor>();
+
+                VkRect2D scissor{};
+                scissor.offset = {command.x, command.y};
+                scissor.extent = {command.width, command.height};
+                vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+                break;
+            }
+            case CommandType::Draw:
+            {
+                auto command = reader.Read<CommandDraw>();
+                if (!isPipelineBound || !hasViewConstants || !hasDrawConstants)
+                {
+                    if (isFirstPass)
+                        ++frameStats.skippedDrawCount;
+                    break;
+                }
+                countDraw(command);
+                if (isCulled(command))
+                {
+                    drawCulled(command);
+                    break;
+                }
+                if (!isFirstPass)
+                    break;
+                vkCmdDraw(commandBuffer, command.vertexCount, command.instanceCount, command.firstVertex, command.firstInstance);
+                ++frameStats.drawCallCount;
+                break;
+            }
+            case CommandType::MultiDraw:
+            {
+                auto command = reader.Read<CommandMultiDraw>();
+                const auto* draws = reinterpret_cast<const CommandDraw*>(reader.Skip(command.drawCount * sizeof(CommandDraw)));
+                if (!isPipelineBound || !hasViewConstants || !hasDrawConstants)
+                {
+                    if (isFirstPass)
+                        frameStats.skippedDrawCount += command.drawCount;
+                    break;
+                }
+                for (uint32_t i = 0; i < command.drawCount; ++i)
+                {
+                    CommandDraw draw;
+                    std::memcpy(&draw, draws + i, sizeof(CommandDraw));
+                    countDraw(draw);
+                }
+
+                // culled
+                //> each draw from the culler's buffer, the ones past its instances directly in phase 0
+                if (isOcclusionCullerActive)
+                {
+                    for (uint32_t i = 0; i < command.drawCount; ++i)
+                    {
+                        CommandDraw draw;
+                        std::memcpy(&draw, draws + i, sizeof(CommandDraw));
+                        if (isCulled(draw))
+                        {
+                            drawCulled(draw);
+                        }
+                        else if (isFirstPass)
+                        {
+                            vkCmdDraw(commandBuffer, draw.vertexCount, draw.instanceCount, draw.firstVertex, draw.firstInstance);
+                            ++frameStats.drawCallCount;
+                        }
+                    }
+                    break;
+                }
+
+                // indirect
+                //> draws are laid out as 'VkDrawIndirectCommand', copied as is
+                if (isMultiDrawIndirectSupported && isDrawIndirectFirstInstanceSupported &&
+                    indirect && indirectDrawOffset + command.drawCount <= MAX_INDIRECT_DRAW_COUNT)
+                {
+                    auto* indirectDraws = static_cast<VkDrawIndirectCommand*>(indirect->mapped) + indirectDrawOffset;
+                    std::memcpy(indirectDraws, draws, command.drawCount * sizeof(CommandDraw));
+                    vkCmdDrawIndirect(commandBuffer, indirect->buffer, indirectDrawOffset * sizeof(VkDrawIndirectCommand),
+                                      command.drawCount, sizeof(VkDrawIndirectCommand));
+                    indirectDrawOffset += command.drawCount;
+                    ++frameStats.drawCallCount;
+                    frameStats.indirectDrawCount += command.drawCount;
+                    break;
+                }
+
+                // direct
+                //> without 'multiDrawIndirect' an indirect call can only hold a single draw,
+                //> without 'drawIndirectFirstInstance' its first instance has to be zero
+                for (uint32_t i = 0; i < command.drawCount; ++i)
+                {
+                    CommandDraw draw;
+                    std::memcpy(&draw, draws + i, sizeof(CommandDraw));
+                    vkCmdDraw(commandBuffer, draw.vertexCount, draw.instanceCount, draw.firstVertex, draw.firstInstance);
+                }
+                frameStats.drawCallCount += command.drawCount;
+                break;
+            }
+            default:
+            {
+                ARCTIC_LOG_ERROR(Vulkan, "unknown command in command stream!");
+                return;
+            }
+        }
+    }
+
+    if (!reader.IsComplete())
+        ARCTIC_LOG_ERROR(Vulkan, "invalid command in command stream!");
+}
+
+bool VulkanLoader::vulkanCreateIndirectBuffer()
+{
+    // create buffer
+    //> host visible, the frame is waited on before it is recorded again
+    const VkDeviceSize size = sizeof(VkDrawIndirectCommand) * MAX_INDIRECT_DRAW_COUNT;
+    indirectBuffer = gpuResources.CreateBuffer(size,
+                                               VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (!indirectBuffer)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create indirect draw buffer!");
+        return false;
+    }
+    return true;
+}
+
+bool VulkanLoader::vulkanCreateDepthTarget()
+{
+    // pick format
+    depthFormat = VulkanUtility::FindDepthFormat(vkPhysicalDevice);
+    if (depthFormat == VK_FORMAT_UNDEFINED)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to find a depth format!");
+        return false;
+    }
+
+    // create image
+    //> written & tested inside the scene pass, kept afterwards for the particle collisions of the next frame
+    depthImage = gpuResources.CreateImage(swapChainData.extent, depthFormat,
+                                          VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                                          VK_IMAGE_ASPECT_DEPTH_BIT);
+    if (!depthImage)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create depth target!");
+        return false;
+    }
+    depthView = gpuResources.Get(depthImage)->view;
+    return true;
+}
+
+bool VulkanLoader::vulkanCreateOverdrawQueryPool()
+{
+    //> imprecise occlusion queries may only tell visible from hidden, the overdraw is not measured then
+    if (!isOverdrawQuerySupported)
+        return true;
+
+    // create info: query pool
+    //> two queries: depth prepass and shading
+    VkQueryPoolCreateInfo queryPoolInfo{};
+    queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolInfo.queryType = VK_QUERY_TYPE_OCCLUSION;
+    queryPoolInfo.queryCount = 2;
+
+    if (vkCreateQueryPool(vkDevice, &queryPoolInfo, vkAllocator, &vkOverdrawQueryPool) != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create overdraw query pool!");
+        return false;
+    }
+    return true;
+}
+
+void VulkanLoader::vulkanReadOverdrawQueries()
+{
+    //> nothing recorded yet
+    if (vkOverdrawQueryPool == VK_NULL_HANDLE || queriedPixelCount == 0)
+        return;
+
+    // read the previous frame
+    //> its fence signaled, a query without draws in its pass stays unavailable & counts zero
+    uint64_t results[2][2] = {}; // value, availability
+    vkGetQueryPoolResults(vkDevice, vkOverdrawQueryPool, 0, 2, sizeof(results), results, sizeof(results[0]),
+                          VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+    overdrawStats.prepassSampleCount = results[0][1] != 0 ? results[0][0] : 0;
+    overdrawStats.shadedSampleCount = results[1][1] != 0 ? results[1][0] : 0;
+    overdrawStats.overdraw = static_cast<float>(overdrawStats.shadedSampleCount) / static_cast<float>(queriedPixelCount);
+}
+
+bool VulkanLoader::vulkanCreateFrameData()
+{
+    // setup frame data ring
+    if (!frameData.Initialize(vkPhysicalDevice, vkDevice, vkAllocator, gpuResources, deletionQueue))
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to setup frame data ring!");
+        frameData.Cleanup();
+        return false;
+    }
+    return true;
+}
+
+void VulkanLoader::vulkanCreateDynamicResolution()
+{
+    if (!enableDynamicResolution)
+        return;
+
+    // setup dynamic resolution
+    //> falls back to rendering straight into the swap chain images
+    isDynamicResolutionActive = dynamicResolution.Initialize(vkPhysicalDevice, vkDevice, vkAllocator,
+                                                             swapChainData.extent, swapChainData.imageFormat,
+                                                             depthFormat, depthView,
+                                                             swapChainImageViews, TARGET_GPU_TIME);
+    if (!isDynamicResolutionActive)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to setup dynamic resolution!");
+        dynamicResolution.Cleanup();
+    }
+}
+
+void VulkanLoader::vulkanCreateParticleSystem()
+{
+    if (!enableParticles)
+        return;
+
+    // setup particles
+    //> drawn in the scene pass, its render pass is compatible with the dynamic resolution target
+    isParticleSystemActive = particleSystem.Initialize(vkPhysicalDevice, vkDevice, vkAllocator, gpuResources, deletionQueue,
+                                                       vkRenderPass, enableReverseZ);
+    if (!isParticleSystemActive)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to setup particles!");
+        particleSystem.Cleanup();
+    }
+}
+
+void VulkanLoader::vulkanCreateOcclusionCuller()
+{
+    if (!enableOcclusionCulling)
+        return;
+
+    //> culled draws index their constants by their first instance, phase 1 needs the load pass
+    if (!isDrawIndirectFirstInstanceSupported || vkLoadRenderPass == VK_NULL_HANDLE)
+    {
+        ARCTIC_LOG_WARNING(Vulkan, "occlusion culling needs drawIndirectFirstInstance & the load render pass, drawing without it");
+        return;
+    }
+
+    // setup occlusion culling
+    //> the pyramid covers the whole depth image, dynamic resolution renders into its top left
+    isOcclusionCullerActive = occlusionCuller.Initialize(vkPhysicalDevice, vkDevice, vkAllocator, depthView, swapChainData.extent,
+                                                         MAX_CULLED_INSTANCE_COUNT, enableReverseZ);
+    if (!isOcclusionCullerActive)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to setup occlusion culling!");
+        occlusionCuller.Cleanup();
+    }
+}
+
 void VulkanLoader::vulkanCreateSyncObjects()
 {
     VkSemaphoreCreateInfo semaphoreInfo{};
@@ -899,11 +1743,11 @@ void VulkanLoader::vulkanCreateSyncObjects()
     fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
     fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT; // is signaled on start
 
-    if (vkCreateSemaphore(vkDevice, &semaphoreInfo, nullptr, &imageAvailableSemaphore) != VK_SUCCESS ||
-        vkCreateSemaphore(vkDevice, &semaphoreInfo, nullptr, &renderFinishedSemaphore) != VK_SUCCESS ||
-        vkCreateFence(vkDevice, &fenceInfo, nullptr, &isDoneRenderingFence) != VK_SUCCESS)
+    if (vkCreateSemaphore(vkDevice, &semaphoreInfo, vkAllocator, &imageAvailableSemaphore) != VK_SUCCESS ||
+        vkCreateSemaphore(vkDevice, &semaphoreInfo, vkAllocator, &renderFinishedSemaphore) != VK_SUCCESS ||
+        vkCreateFence(vkDevice, &fenceInfo, vkAllocator, &isDoneRenderingFence) != VK_SUCCESS)
     {
-        std::cout << "error: vulkan: failed to create sync objects!";
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create sync objects!");
         return;
     }
 }
@@ -923,10 +1767,10 @@ void VulkanLoader::vulkanLoadDebugMessenger()
     vulkanPopulateDebugMessengerCreateInfo(debugCreateInfo);
 
     // create debug messenger
-    auto result = vulkanCreateDebugUtilsMessengerEXT(vkInstance, &debugCreateInfo, nullptr, &debugMessenger);
+    auto result = vulkanCreateDebugUtilsMessengerEXT(vkInstance, &debugCreateInfo, vkAllocator, &debugMessenger);
     if( result != VK_SUCCESS)
     {
-        std::cout << "error: vulkan: failed to create debug messenger!";
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create debug messenger!");
         return;
     }
 }
@@ -934,7 +1778,7 @@ void VulkanLoader::vulkanLoadDebugMessenger()
 void VulkanLoader::vulkanDestroyDebugMessenger()
 {
     if (enableValidationLayers)
-        vulkanDestroyDebugUtilsMessengerEXT(vkInstance, debugMessenger, nullptr);
+        vulkanDestroyDebugUtilsMessengerEXT(vkInstance, debugMessenger, vkAllocator);
 }
 
 bool VulkanLoader::vulkanFoundValidationLayers()
@@ -1010,7 +1854,20 @@ VKAPI_ATTR VkBool32 VKAPI_CALL VulkanLoader::debugCallback(
         const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
         void* pUserData)
 {
-    std::cerr << "validation layer: " << pCallbackData->pMessage << std::endl;
+    // deferred to the log thread, validation can report many messages per draw
+    LogSeverity severity = LogSeverity::Debug;
+    if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
+        severity = LogSeverity::Error;
+    else if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT)
+        severity = LogSeverity::Warning;
+    else if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT)
+        severity = LogSeverity::Info;
+
+    //> rate limited per message id, a flood of one message does not hide the others
+    static std::array<LogSite, 64> logSites;
+    LogSite& logSite = logSites[static_cast<uint32_t>(pCallbackData->messageIdNumber) % logSites.size()];
+    if (static_cast<int>(severity) >= ARCTIC_LOG_MIN_SEVERITY && Logger::IsEnabled(severity, LogCategory::Validation))
+        Logger::Write(logSite, severity, LogCategory::Validation, "{}", pCallbackData->pMessage);
     return VK_FALSE;
 }
 
@@ -1027,7 +1884,7 @@ void VulkanLoader::vulkanLoadSurface()
     VkResult resultWindows = vkCreateWin32SurfaceKHR(vkInstance, &createInfo, nullptr, &vkSurface);
     if(resultWindows != VK_SUCCESS)
     {
-        std::cout << "error: vulkan: failed to create window 32 surface!";
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create window 32 surface!");
         return;
     }
 
@@ -1035,44 +1892,396 @@ void VulkanLoader::vulkanLoadSurface()
     VkResult resultGlfw = glfwCreateWindowSurface(vkInstance, window, nullptr, &vkSurface);
     if(resultGlfw != VK_SUCCESS)
     {
-        std::cout << "error: vulkan: failed to create glfw window surface!";
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create glfw window surface!");
         return;
     }
 }
 
-void VulkanLoader::Load()
+#pragma region vulkan_capture
+
+void VulkanLoader::BeginCapture(const std::string& path, uint32_t frameCount)
 {
-    // init glfw
-    glfwInit();
+    if (isCapturing || frameCount == 0)
+        return;
+
+    // reset capture
+    activeCapture = {};
+    activeCapture.extent = swapChainData.extent;
+    activeCapture.format = swapChainData.imageFormat;
+
+    // store referenced resources
+    for (const auto& shaderStage : shaderStages)
+        activeCapture.resources.push_back({CommandCapture::ResourceType::Shader, static_cast<uint32_t>(shaderStage.stage), shaderStage.code});
+
+    capturePath = path;
+    captureFrameCount = frameCount;
+    isCapturing = true;
+}
+
+void VulkanLoader::vulkanCaptureFrame(const CommandStream& stream)
+{
+    activeCapture.frames.push_back(stream.GetData());
+    if (activeCapture.frames.size() < captureFrameCount)
+        return;
+
+    // finish capture
+    isCapturing = false;
+    if (!activeCapture.Save(capturePath))
+    {
+        ARCTIC_LOG_ERROR(Capture, "failed to save {}!", capturePath);
+        return;
+    }
+    std::cout << "info: capture: saved " << activeCapture.frames.size() << " frames to " << capturePath << std::endl;
+    activeCapture = {};
+}
+
+void VulkanLoader::BeginStatsDump(const std::string& path, uint32_t frameCount)
+{
+    if (isDumpingStats || frameCount == 0)
+        return;
 
-    // set hints
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-    glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+    statsDumpFile.open(path, std::ios::trunc);
+    if (!statsDumpFile)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to open {}!", path);
+        return;
+    }
+    statsDumpFrameCount = frameCount;
+    isDumpingStats = true;
+}
+
+void VulkanLoader::vulkanDumpFrameStats()
+{
+    //> nothing was recorded before the first frame
+    if (frameCount == 0)
+        return;
+
+    // write frame
+    //> gpu time is null without dynamic resolution, which owns the frame timestamps
+    std::string gpuTime = isDynamicResolutionActive ? std::format("{:.3f}", dynamicResolution.GetStats().gpuTime) : "null";
+    statsDumpFile << std::format(R"({{"frame":{},"cpu_record_ms":{:.3f},"gpu_ms":{},"draws":{},"instances":{},"triangles":{},)"
+                                 R"("draw_calls":{},"pipeline_binds":{},"descriptor_set_binds":{},"skipped_draws":{},"overdraw":{:.3f},"passes":{}}})",
+                                 frameCount - 1,
+                                 frameStats.recordTime,
+                                 gpuTime,
+                                 frameStats.drawCount,
+                                 frameStats.instanceCount,
+                                 frameStats.triangleCount,
+                                 frameStats.drawCallCount,
+                                 frameStats.pipelineBindCount,
+                                 frameStats.descriptorSetBindCount,
+                                 frameStats.skippedDrawCount,
+                                 overdrawStats.overdraw,
+                                 pipelineStatistics.ToJson()) << '\n';
+    if (--statsDumpFrameCount > 0)
+        return;
+
+    // finish dump
+    isDumpingStats = false;
+    statsDumpFile.close();
+    std::cout << "info: vulkan: stats dump finished" << std::endl;
+}
+
+bool VulkanLoader::vulkanCreateOffscreenTarget(VkExtent2D extent, VkFormat format)
+{
+    // create image
+    VkImage offscreenImage;
+    bool isCreated = VulkanUtility::CreateImage(vkPhysicalDevice, vkDevice, vkAllocator,
+                                                extent, 1, format,
+                                                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                                offscreenImage, offscreenImageMemory);
+    if (!isCreated)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create offscreen target!");
+        return false;
+    }
+
+    // use as only swap chain image
+    swapChainData = {};
+    swapChainData.imageFormat = format;
+    swapChainData.extent = extent;
+    swapChainImages = {offscreenImage};
+    return true;
+}
+
+bool VulkanLoader::vulkanCreateTimestampQueryPool()
+{
+    // create info: query pool
+    //> two timestamps: start and end of frame
+    VkQueryPoolCreateInfo queryPoolInfo{};
+    queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolInfo.queryCount = 2;
+
+    VkResult result = vkCreateQueryPool(vkDevice, &queryPoolInfo, vkAllocator, &vkTimestampQueryPool);
+    if (result != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create timestamp query pool!");
+        return false;
+    }
+    return true;
+}
 
-    // create window
-    window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Vulkan", nullptr, nullptr);
+bool VulkanLoader::LoadHeadless(const CommandCapture& capture)
+{
+    isHeadless = true;
+    assetManager.Initialize(jobSystem);
 
     // check validation layers
     if(enableValidationLayers && !vulkanFoundValidationLayers())
     {
-        std::cout << "error: vulkan: validation layers requested, but not available!";
-        return;
+        ARCTIC_LOG_ERROR(Vulkan, "validation layers requested, but not available!");
+        return false;
     }
 
-    // create instance
+    // create instance & device
+    //> no window, surface or swap chain
     vulkanCreateInstance();
     vulkanLoadDebugMessenger();
-    vulkanLoadSurface();
     vulkanLoadPhysicalDevice();
+    if (vkPhysicalDevice == VK_NULL_HANDLE)
+        return false;
     vulkanCreateLogicalDevice();
-    vulkanCreateSwapChain();
+
+    // create target
+    if (!vulkanCreateOffscreenTarget(capture.extent, capture.format))
+        return false;
     vulkanCreateImageViews();
+    if (!vulkanCreateDepthTarget())
+        return false;
     vulkanCreateRenderPass();
+
+    // create shaders from capture
+    for (const auto& resource : capture.resources)
+    {
+        if (resource.type != CommandCapture::ResourceType::Shader)
+            continue;
+        if (!vulkanCreateShaderStage(resource.data, static_cast<VkShaderStageFlagBits>(resource.id)))
+            return false;
+    }
+
+    if (!vulkanCreateFrameData())
+        return false;
     vulkanCreatePipeline();
     vulkanCreateFramebuffers();
     vulkanCreateCommandPool();
     vulkanCreateCommandBuffer();
     vulkanCreateSyncObjects();
+    return vulkanCreateIndirectBuffer() &&
+           vulkanCreateTimestampQueryPool() &&
+           vulkanCreateOverdrawQueryPool() &&
+           pipelineStatistics.Initialize(vkDevice, vkAllocator, isPipelineStatisticsSupported);
+}
+
+void VulkanLoader::Replay(const CommandCapture& capture, uint32_t iterations)
+{
+    if (!isHeadless || capture.frames.empty())
+        return;
+
+    // get timestamp period (nanoseconds per tick)
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(vkPhysicalDevice, &deviceProperties);
+    double timestampPeriod = deviceProperties.limits.timestampPeriod;
+
+    struct Timing
+    {
+        double total = 0.0;
+        double min = std::numeric_limits<double>::max();
+        double max = 0.0;
+
+        void Add(double value)
+        {
+            total += value;
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+    };
+    Timing cpuTiming;
+    Timing gpuTiming;
+
+    // replay all frames
+    //> every frame is waited on, so timings are not affected by frames in flight
+    uint64_t replayFrame = 0;
+    for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+    {
+        for (const auto& frame : capture.frames)
+        {
+            vkWaitForFences(vkDevice, 1, &isDoneRenderingFence, VK_TRUE, UINT64_MAX);
+            vkResetFences(vkDevice, 1, &isDoneRenderingFence);
+
+            // reuse the frame data of the waited frame
+            ++replayFrame;
+            frameData.BeginFrame(replayFrame, replayFrame - 1);
+
+            auto cpuStart = std::chrono::steady_clock::now();
+
+            // record command buffer
+            vkResetCommandBuffer(vkCommandBuffer, 0);
+
+            VkCommandBufferBeginInfo beginInfo{};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(vkCommandBuffer, &beginInfo);
+
+            vkCmdResetQueryPool(vkCommandBuffer, vkTimestampQueryPool, 0, 2);
+            pipelineStatistics.Reset(vkCommandBuffer);
+            vkCmdWriteTimestamp(vkCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, vkTimestampQueryPool, 0);
+            vulkanExecuteCommandStream(vkCommandBuffer, frame, vkRenderPass, swapChainFramebuffers[0], swapChainData.extent);
+            vkCmdWriteTimestamp(vkCommandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, vkTimestampQueryPool, 1);
+
+            vkEndCommandBuffer(vkCommandBuffer);
+
+            // submit
+            VkSubmitInfo submitInfo{};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &vkCommandBuffer;
+
+            VkResult resultQueueSubmit = vkQueueSubmit(vkGraphicsQueue, 1, &submitInfo, isDoneRenderingFence);
+            if (resultQueueSubmit != VK_SUCCESS)
+            {
+                ARCTIC_LOG_ERROR(Vulkan, "failed to submit replay frame!");
+                return;
+            }
+
+            auto cpuEnd = std::chrono::steady_clock::now();
+            cpuTiming.Add(std::chrono::duration<double, std::milli>(cpuEnd - cpuStart).count());
+
+            // read gpu time
+            vkWaitForFences(vkDevice, 1, &isDoneRenderingFence, VK_TRUE, UINT64_MAX);
+
+            uint64_t timestamps[2] = {};
+            vkGetQueryPoolResults(vkDevice, vkTimestampQueryPool, 0, 2, sizeof(timestamps), timestamps, sizeof(uint64_t),
+                                  VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+            gpuTiming.Add(static_cast<double>(timestamps[1] - timestamps[0]) * timestampPeriod / 1000000.0);
+        }
+    }
+
+    // report
+    double frameCount = static_cast<double>(capture.frames.size()) * iterations;
+    std::cout << std::format("info: replay: {} frames x {} iterations", capture.frames.size(), iterations) << std::endl;
+    std::cout << std::format("\tcpu: avg {:.3f} ms, min {:.3f} ms, max {:.3f} ms",
+                             cpuTiming.total / frameCount, cpuTiming.min, cpuTiming.max) << std::endl;
+    std::cout << std::format("\tgpu: avg {:.3f} ms, min {:.3f} ms, max {:.3f} ms",
+                             gpuTiming.total / frameCount, gpuTiming.min, gpuTiming.max) << std::endl;
+}
+
+#pragma endregion vulkan_capture
+
+void VulkanLoader::Load()
+{
+    loadStartTime = StartupGraph::Clock::now();
+
+    // start loading the material & its shaders
+    //> reads & decodes run on the job threads while the phases below create the window & device
+    assetManager.Initialize(jobSystem);
+    AssetHandle<MaterialAsset> material = assetManager.Load<MaterialAsset>(DEFAULT_MATERIAL_PATH);
+
+    // build startup graph
+    //> glfw & asset uploads are main thread only, everything else runs on the workers once its inputs exist
+    //> phases check the objects they create, so a failure skips its dependents instead of using null handles
+    using Thread = StartupGraph::PhaseThread;
+    StartupGraph graph;
+
+    auto glfw = graph.Add("glfw", Thread::Main, {}, []() {
+        return glfwInit() == GLFW_TRUE;
+    });
+    auto windowPhase = graph.Add("window", Thread::Main, {glfw}, [this]() {
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+        window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Vulkan", nullptr, nullptr);
+        return window != nullptr;
+    });
+    //> only needs glfw for the required extensions, runs while the window opens
+    auto instance = graph.Add("instance", Thread::Worker, {glfw}, [this]() {
+        if (enableValidationLayers && !vulkanFoundValidationLayers())
+        {
+            ARCTIC_LOG_ERROR(Vulkan, "validation layers requested, but not available!");
+            return false;
+        }
+        vulkanCreateInstance();
+        vulkanLoadDebugMessenger();
+        return vkInstance != VK_NULL_HANDLE;
+    });
+    auto surface = graph.Add("surface", Thread::Main, {windowPhase, instance}, [this]() {
+        vulkanLoadSurface();
+        return vkSurface != VK_NULL_HANDLE;
+    });
+    auto device = graph.Add("device", Thread::Worker, {surface}, [this]() {
+        vulkanLoadPhysicalDevice();
+        if (vkPhysicalDevice == VK_NULL_HANDLE)
+            return false;
+        vulkanCreateLogicalDevice();
+        return vkDevice != VK_NULL_HANDLE;
+    });
+
+    // presentation
+    //> the swap chain extent comes from glfw
+    auto swapChain = graph.Add("swap chain", Thread::Main, {device}, [this]() {
+        vulkanCreateSwapChain();
+        vulkanCreateImageViews();
+        return vkSwapChain != VK_NULL_HANDLE && !swapChainImageViews.empty();
+    });
+    //> first of the chained 'GpuResources' users, resolves the depth view for the framebuffers & dynamic resolution
+    auto depth = graph.Add("depth target", Thread::Worker, {swapChain}, [this]() {
+        return vulkanCreateDepthTarget();
+    });
+    auto renderPass = graph.Add("render pass", Thread::Worker, {swapChain, depth}, [this]() {
+        vulkanCreateRenderPass();
+        return vkRenderPass != VK_NULL_HANDLE;
+    });
+    graph.Add("framebuffers", Thread::Worker, {renderPass}, [this]() {
+        vulkanCreateFramebuffers();
+        return std::find(swapChainFramebuffers.begin(), swapChainFramebuffers.end(), VK_NULL_HANDLE) == swapChainFramebuffers.end();
+    });
+
+    // pipelines
+    //> the shader modules are created by the asset uploads, the pipelines compile on the workers next to each other
+    auto shaders = graph.Add("shaders", Thread::Main, {device}, [this]() {
+        return vulkanLoadMaterialShaders(DEFAULT_MATERIAL_PATH);
+    });
+    //> the frame data layout is part of the pipeline layout
+    auto frameDataPhase = graph.Add("frame data", Thread::Worker, {depth}, [this]() {
+        return vulkanCreateFrameData();
+    });
+    graph.Add("pipeline", Thread::Worker, {shaders, renderPass, frameDataPhase}, [this]() {
+        vulkanCreatePipeline();
+        return vkPipelineCache != VK_NULL_HANDLE;
+    });
+    auto resolution = graph.Add("dynamic resolution", Thread::Worker, {swapChain, depth}, [this]() {
+        vulkanCreateDynamicResolution(); // optional, falls back on failure
+        return true;
+    });
+    //> its second pass continues the scene passes, both have to exist
+    graph.Add("occlusion culling", Thread::Worker, {renderPass, resolution}, [this]() {
+        vulkanCreateOcclusionCuller(); // optional, falls back on failure
+        return true;
+    });
+
+    // frame resources
+    graph.Add("commands", Thread::Worker, {device}, [this]() {
+        vulkanCreateCommandPool();
+        vulkanCreateCommandBuffer();
+        vulkanCreateSyncObjects();
+        vulkanCreateOverdrawQueryPool(); // optional, stats stay zero on failure
+        pipelineStatistics.Initialize(vkDevice, vkAllocator, isPipelineStatisticsSupported); // optional, as above
+        return vkCommandBuffer != VK_NULL_HANDLE && isDoneRenderingFence != VK_NULL_HANDLE;
+    });
+    auto indirect = graph.Add("indirect buffer", Thread::Worker, {frameDataPhase}, [this]() {
+        return vulkanCreateIndirectBuffer();
+    });
+    //> chained after the depth target, the frame data & the indirect buffer, 'GpuResources' is not thread safe
+    graph.Add("particles", Thread::Worker, {renderPass, indirect}, [this]() {
+        vulkanCreateParticleSystem(); // optional, falls back on failure
+        return true;
+    });
+
+    // run
+    bool isLoaded = graph.Run(jobSystem);
+    if (enableStartupReport)
+        graph.PrintReport();
+    if (!isLoaded)
+        ARCTIC_LOG_ERROR(Vulkan, "failed to load!");
 }
 
 void VulkanLoader::Draw()
@@ -1084,6 +2293,15 @@ void VulkanLoader::Draw()
     // reset fence state to zero
     vkResetFences(vkDevice, 1, &isDoneRenderingFence);
 
+    // destroy objects of the previous frame
+    //> single frame in flight, so every earlier frame completed with the fence
+    if (frameCount > 0)
+        deletionQueue.Collect(frameCount - 1);
+    deletionQueue.SetFrame(frameCount);
+    frameData.BeginFrame(frameCount, frameCount - 1);
+    vulkanReadOverdrawQueries();
+    pipelineStatistics.Read();
+
     // acquire next image from swap chain
     uint32_t availableImageIndex;
     vkAcquireNextImageKHR(vkDevice, vkSwapChain, UINT64_MAX, imageAvailableSemaphore, VK_NULL_HANDLE, &availableImageIndex);
@@ -1116,7 +2334,7 @@ void VulkanLoader::Draw()
     VkResult resultQueueSubmit = vkQueueSubmit(vkGraphicsQueue, 1, &submitInfo, isDoneRenderingFence);
     if(resultQueueSubmit != VK_SUCCESS)
     {
-        std::cout << "error: vulkan: failed to submit command buffer to graphics queue!";
+        ARCTIC_LOG_ERROR(Vulkan, "failed to submit command buffer to graphics queue!");
         return;
     }
 
@@ -1135,46 +2353,214 @@ void VulkanLoader::Draw()
 
     // queue present khr
     vkQueuePresentKHR(vkPresentQueue, &presentInfo);
-}
 
-void VulkanLoader::Cleanup()
-{
-    // syncing
-    vkDestroySemaphore(vkDevice, imageAvailableSemaphore, nullptr);
-    vkDestroySemaphore(vkDevice, renderFinishedSemaphore, nullptr);
-    vkDestroyFence(vkDevice, isDoneRenderingFence, nullptr);
+    // report time to first frame
+    if (enableStartupReport && frameCount == 0)
+    {
+        double firstFrameTime = std::chrono::duration<double, std::milli>(StartupGraph::Clock::now() - loadStartTime).count();
+        std::cout << std::format("info: startup: first frame presented {:.2f} ms after load started", firstFrameTime) << std::endl;
+    }
+
+    // finish asset uploads & release unused assets
+    assetManager.Update();
+
+    // dump allocation stats
+    ++frameCount;
+    if (enableAllocationStatsDump && frameCount % ALLOCATION_STATS_DUMP_INTERVAL == 0)
+        PrintAllocationStats();
+
+    // dump lighting stats
+    //> stats belong to the previous frame, the current one is still in flight
+    if (enableLightingStatsDump && frameCount % LIGHTING_STATS_DUMP_INTERVAL == 0)
+        PrintLightingStats();
 
-    // command pool
-    vkDestroyCommandPool(vkDevice, vkCommandPool, nullptr);
+    // dump frame stats
+    if (enableFrameStatsDump && frameCount % FRAME_STATS_DUMP_INTERVAL == 0)
+        PrintFrameStats();
+
+    // dump resolution stats
+    if (enableResolutionStatsDump && frameCount % RESOLUTION_STATS_DUMP_INTERVAL == 0)
+        PrintResolutionStats();
+
+    // dump particle stats
+    if (enableParticleStatsDump && frameCount % PARTICLE_STATS_DUMP_INTERVAL == 0)
+        PrintParticleStats();
+}
 
-    for (auto framebuffer : swapChainFramebuffers)
+void VulkanLoader::PrintFrameStats() const
+{
+    const RenderQueue::Stats& queueStats = renderQueue.GetStats();
+
+    std::cout << "info: vulkan: frame:" << std::endl;
+    std::cout << std::format("\tqueue: submitted {}, draws {}, instanced merges {}, multi-draws {}, pipeline changes {}, material changes {}, mesh changes {}",
+                             queueStats.submittedCount,
+                             queueStats.drawCount,
+                             queueStats.instancedMergeCount,
+                             queueStats.multiDrawCount,
+                             queueStats.pipelineChangeCount,
+                             queueStats.materialChangeCount,
+                             queueStats.meshChangeCount) << std::endl;
+    std::cout << std::format("\tcommands: pipeline binds {}, descriptor set binds {}, draw calls {}, indirect draws {} (multi-draw indirect {}), skipped draws {}",
+                             frameStats.pipelineBindCount,
+                             frameStats.descriptorSetBindCount,
+                             frameStats.drawCallCount,
+                             frameStats.indirectDrawCount,
+                             isMultiDrawIndirectSupported && isDrawIndirectFirstInstanceSupported ? "on" : "off",
+                             frameStats.skippedDrawCount) << std::endl;
+    std::cout << std::format("\tdraws {}, instances {}, triangles {}, cpu record {:.3f} ms",
+                             frameStats.drawCount,
+                             frameStats.instanceCount,
+                             frameStats.triangleCount,
+                             frameStats.recordTime) << std::endl;
+
+    std::cout << std::format("\tdepth: format {}, reverse-z {}, prepass {} ({} draws), samples: prepass {}, shaded {} ({:.2f} per pixel{})",
+                             depthFormatName(depthFormat),
+                             enableReverseZ ? "on" : "off",
+                             enableDepthPrepass ? "on" : "off",
+                             queueStats.prepassCount,
+                             overdrawStats.prepassSampleCount,
+                             overdrawStats.shadedSampleCount,
+                             overdrawStats.overdraw,
+                             vkOverdrawQueryPool != VK_NULL_HANDLE ? "" : ", not measured") << std::endl;
+
+    // culling counters of the previous frame, both phases
+    if (isOcclusionCullerActive)
     {
-        vkDestroyFramebuffer(vkDevice, framebuffer, nullptr);
+        OcclusionCuller::Stats cullStats = occlusionCuller.GetStats();
+        std::cout << std::format("\tocclusion culling: tested {}, visible {}, occluded {}, outside the frustum {}",
+                                 cullStats.testedCount,
+                                 cullStats.visibleCount,
+                                 cullStats.occludedCount,
+                                 cullStats.frustumCulledCount) << std::endl;
     }
 
-    // pipeline
-    vkDestroyPipeline(vkDevice, vkPipeline, nullptr);
-    vkDestroyPipelineLayout(vkDevice, vkPipelineLayout, nullptr);
-    vkDestroyRenderPass(vkDevice, vkRenderPass, nullptr);
+    // layouts shared by the pipelines
+    pipelineLayouts.PrintStats();
 
-    // images & swapchain
-    for(auto & imageView : swapChainImageViews)
+    // per-frame constants
+    frameData.PrintStats();
+
+    // shader invocations of the previous frame
+    pipelineStatistics.PrintStats();
+}
+
+void VulkanLoader::Cleanup()
+{
+    // device objects
+    //> also after a failed load, objects that were not created are null
+    if (vkDevice != VK_NULL_HANDLE)
     {
-        vkDestroyImageView(vkDevice, imageView, nullptr);
-    }
-    vkDestroySwapchainKHR(vkDevice, vkSwapChain, nullptr);
+        // wait for the frame in flight
+        vkDeviceWaitIdle(vkDevice);
+
+        // queries
+        if (vkTimestampQueryPool != VK_NULL_HANDLE)
+            vkDestroyQueryPool(vkDevice, vkTimestampQueryPool, vkAllocator);
+        if (vkOverdrawQueryPool != VK_NULL_HANDLE)
+            vkDestroyQueryPool(vkDevice, vkOverdrawQueryPool, vkAllocator);
+        pipelineStatistics.Cleanup();
+
+        // syncing
+        vkDestroySemaphore(vkDevice, imageAvailableSemaphore, vkAllocator);
+        vkDestroySemaphore(vkDevice, renderFinishedSemaphore, vkAllocator);
+        vkDestroyFence(vkDevice, isDoneRenderingFence, vkAllocator);
 
-    // devices
-    vkDestroyDevice(vkDevice, nullptr);
+        // command pool
+        vkDestroyCommandPool(vkDevice, vkCommandPool, vkAllocator);
+
+        // dynamic resolution
+        if (isDynamicResolutionActive)
+            dynamicResolution.Cleanup();
+
+        for (auto framebuffer : swapChainFramebuffers)
+        {
+            vkDestroyFramebuffer(vkDevice, framebuffer, vkAllocator);
+        }
+
+        // lighting
+        clusteredLighting.Cleanup();
+
+        // particles
+        //> before the gpu resources, its buffers are queued for deletion
+        if (isParticleSystemActive)
+            particleSystem.Cleanup();
+
+        // occlusion culling
+        if (isOcclusionCullerActive)
+            occlusionCuller.Cleanup();
+
+        // pipeline
+        pipelinePermutations.Cleanup();
+        vkDestroyPipelineCache(vkDevice, vkPipelineCache, vkAllocator);
+        pipelineLayouts.Cleanup();
+
+        // shaders
+        for (auto& shaderStage : shaderStages)
+        {
+            if (!shaderStage.asset)
+                vkDestroyShaderModule(vkDevice, shaderStage.module, vkAllocator);
+        }
+        shaderStages.clear();
+
+        // frame data
+        //> before the gpu resources, its buffer & pool are released through them
+        frameData.Cleanup();
+
+        // depth
+        if (depthImage)
+            gpuResources.Destroy(depthImage);
+        depthView = VK_NULL_HANDLE;
+
+        // assets
+        assetManager.Cleanup();
+
+        // gpu resources
+        gpuResources.Cleanup();
+
+        // deferred deletions
+        //> after the assets & gpu resources, their objects are queued on release
+        deletionQueue.Cleanup();
+
+        // render pass
+        vkDestroyRenderPass(vkDevice, vkRenderPass, vkAllocator);
+        vkDestroyRenderPass(vkDevice, vkLoadRenderPass, vkAllocator);
+
+        // images & swapchain
+        for(auto & imageView : swapChainImageViews)
+        {
+            vkDestroyImageView(vkDevice, imageView, vkAllocator);
+        }
+        if (isHeadless)
+        {
+            if (!swapChainImages.empty())
+                vkDestroyImage(vkDevice, swapChainImages[0], vkAllocator);
+            vkFreeMemory(vkDevice, offscreenImageMemory, vkAllocator);
+        }
+        else
+        {
+            vkDestroySwapchainKHR(vkDevice, vkSwapChain, vkAllocator);
+        }
+
+        // device
+        vkDestroyDevice(vkDevice, vkAllocator);
+    }
 
     // debug
     vulkanDestroyDebugMessenger();
 
     // instance
-    vkDestroySurfaceKHR(vkInstance, vkSurface, nullptr);
-    vkDestroyInstance(vkInstance, nullptr);
+    if (!isHeadless)
+        vkDestroySurfaceKHR(vkInstance, vkSurface, nullptr);
+    vkDestroyInstance(vkInstance, vkAllocator);
 
     // glfw
-    glfwDestroyWindow(window);
-    glfwTerminate();
+    if (!isHeadless)
+    {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+    }
+
+    // report allocations still alive after shutdown (driver leaks)
+    if (enableAllocationStatsDump)
+        hostAllocator.PrintStats();
 }
@@ -7,53 +7,315 @@
 
 #include <vector>
 #include <optional>
+#include <fstream>
 #include <set>
+#include <string>
 #include <vulkan/vulkan_core.h>
+#include "shader_permutation.h"
+#include "shader_reflection.h"
+#include "vulkan_host_allocator.h"
+#include "command_stream.h"
+#include "clustered_lighting.h"
+#include "asset_manager.h"
+#include "render_queue.h"
+#include "dynamic_resolution.h"
+#include "deletion_queue.h"
+#include "gpu_resources.h"
+#include "particle_system.h"
+#include "occlusion_culler.h"
+#include "frame_data_ring.h"
+#include "pipeline_statistics.h"
+#include "startup_graph.h"
 
 class GLFWwindow;
 
 class VulkanLoader
 {
 public:
+    explicit VulkanLoader(JobSystem& jobSystem) : jobSystem(jobSystem) {}
+
     void Load();
     void Draw();
     void Cleanup();
 
+    // capture & replay
+    //> a capture stores the engine command stream of N frames with the resources it references,
+    //> replay re-submits it to an offscreen target without window or swap chain
+    void BeginCapture(const std::string& path, uint32_t frameCount);
+    bool LoadHeadless(const CommandCapture& capture);
+    void Replay(const CommandCapture& capture, uint32_t iterations);
+
     GLFWwindow* GetWindow() {
         return window;
     }
 
+    // select the shader permutation used for drawing
+    //> the pipeline is compiled on first use and cached afterwards
+    void SetShaderPermutation(ShaderPermutationKey key) {
+        shaderPermutationKey = key;
+    }
+
+    // host allocation & device heap stats
+    const VulkanHostAllocator& GetHostAllocator() const {
+        return hostAllocator;
+    }
+    void PrintAllocationStats();
+
+    // clustered lighting
+    //> only used by permutations with 'ShaderFeature::ClusteredLighting'
+    void SetLights(const std::vector<ClusteredLighting::Light>& lights) {
+        clusteredLighting.SetLights(lights);
+    }
+    void SetCamera(const glm::mat4& view, float fieldOfView, float nearPlane, float farPlane) {
+        setViewConstants(view, fieldOfView, nearPlane, farPlane);
+        clusteredLighting.SetCamera(view, fieldOfView, nearPlane, farPlane);
+        if (isParticleSystemActive)
+            particleSystem.SetCamera(view, fieldOfView, nearPlane, farPlane);
+    }
+    void PrintLightingStats() const {
+        clusteredLighting.PrintStats();
+    }
+
+    // draw submission & binding counts of the last recorded frame
+    void PrintFrameStats() const;
+
+    // write the stats of the next frames to a file, one json object per line
+    //> each line describes one completed frame: cpu recording, draw counters, gpu time & pipeline statistics
+    void BeginStatsDump(const std::string& path, uint32_t frameCount);
+
+    // overdraw view
+    //> replaces the shading with a constant blended additively, brighter pixels were shaded more often
+    void SetOverdrawView(bool isEnabled) {
+        isOverdrawViewEnabled = isEnabled;
+    }
+
+    // dynamic resolution
+    void SetTargetGpuTime(float milliseconds) {
+        dynamicResolution.SetTargetGpuTime(milliseconds);
+    }
+    void PrintResolutionStats() const {
+        if (isDynamicResolutionActive)
+            dynamicResolution.PrintStats();
+    }
+
+    // gpu particles
+    //> returns the null handle when particles are not available
+    ParticleSystemHandle CreateParticleSystem(const std::string& name, uint32_t capacity, const ParticleEmitter& emitter) {
+        return isParticleSystemActive ? particleSystem.Create(name, capacity, emitter) : ParticleSystemHandle{};
+    }
+    void DestroyParticleSystem(ParticleSystemHandle handle) {
+        if (isParticleSystemActive)
+            particleSystem.Destroy(handle);
+    }
+    void SetParticleEmitter(ParticleSystemHandle handle, const ParticleEmitter& emitter) {
+        if (isParticleSystemActive)
+            particleSystem.SetEmitter(handle, emitter);
+    }
+    void PrintParticleStats() const {
+        if (isParticleSystemActive)
+            particleSystem.PrintStats();
+    }
+
 private:
     // glfw
     const uint32_t WINDOW_WIDTH = 1280;
     const uint32_t WINDOW_HEIGHT = 720;
     GLFWwindow* window = nullptr;
 
+    // host allocations
+    //> driver host memory is routed through the engine allocator, disable to compare against the driver default
+    const bool enableHostAllocator = true;
+    const bool enableAllocationStatsDump = false;
+    const uint64_t ALLOCATION_STATS_DUMP_INTERVAL = 1000; // frames
+    VulkanHostAllocator hostAllocator;
+    const VkAllocationCallbacks* vkAllocator = enableHostAllocator ? hostAllocator.GetCallbacks() : nullptr;
+    bool isMemoryBudgetSupported = false;
+    uint64_t frameCount = 0;
+
     // vulkan
     VkInstance vkInstance = nullptr;
 
     VkPhysicalDevice vkPhysicalDevice = VK_NULL_HANDLE;
     VkDevice vkDevice = VK_NULL_HANDLE;
 
-    VkSurfaceKHR vkSurface;
-    VkSwapchainKHR vkSwapChain;
+    VkSurfaceKHR vkSurface = VK_NULL_HANDLE;
+    VkSwapchainKHR vkSwapChain = VK_NULL_HANDLE;
     std::vector<VkImage> swapChainImages;
     std::vector<VkImageView> swapChainImageViews;
 
-    VkRenderPass vkRenderPass;
-    VkPipelineLayout vkPipelineLayout;
-    VkPipeline vkPipeline;
+    VkRenderPass vkRenderPass = VK_NULL_HANDLE;
+    VkRenderPass vkLoadRenderPass = VK_NULL_HANDLE; // continues 'vkRenderPass' in the same frame (occlusion culling)
+    VkPipelineLayout vkPipelineLayout = VK_NULL_HANDLE; // owned by 'pipelineLayouts'
+    VkPipelineCache vkPipelineCache = VK_NULL_HANDLE;
+
+    // layouts
+    //> derived from the reflected shader stages, equal layouts are shared
+    PipelineLayoutCache pipelineLayouts;
+    ShaderReflection shaderInterface; // all stages merged
+
+    // deferred deletions
+    //> objects are tagged with 'frameCount' & destroyed once that frame's fence signaled
+    DeletionQueue deletionQueue;
+
+    // gpu resources behind generational handles
+    GpuResources gpuResources;
+
+    // jobs & assets
+    JobSystem& jobSystem;
+    AssetManager assetManager;
+
+    // shaders
+    //> modules are kept alive so new permutations can be compiled at runtime
+    const char* DEFAULT_MATERIAL_PATH = "materials/first_material.mat";
+    struct ShaderStage
+    {
+        VkShaderStageFlagBits stage;
+        VkShaderModule module;
+        std::vector<char> code; // kept for captures
+        ShaderReflection reflection;
+        AssetHandle<ShaderAsset> asset; // owns the module, empty for stages created from a capture
+    };
+    std::vector<ShaderStage> shaderStages;
+
+    // shader permutations
+    ShaderPermutationCache pipelinePermutations;
+    ShaderPermutationKey shaderPermutationKey = ShaderPermutation::ToBit(ShaderFeature::VertexColor);
+
+    // clustered lighting
+    const uint32_t MAX_LIGHT_COUNT = 1024;
+    const bool enableLightingStatsDump = false;
+    const uint64_t LIGHTING_STATS_DUMP_INTERVAL = 1000; // frames
+    ClusteredLighting clusteredLighting;
 
     VkQueue vkGraphicsQueue;
     VkQueue vkPresentQueue;
 
     std::vector<VkFramebuffer> swapChainFramebuffers;
-    VkCommandPool vkCommandPool;
-    VkCommandBuffer vkCommandBuffer;
+    VkCommandPool vkCommandPool = VK_NULL_HANDLE;
+    VkCommandBuffer vkCommandBuffer = VK_NULL_HANDLE;
+
+    // command stream
+    CommandStream frameCommands;
+
+    // render queue
+    //> multi-draws are copied to the indirect buffer, one indirect call each when 'multiDrawIndirect' is supported
+    const uint32_t MAX_INDIRECT_DRAW_COUNT = 16384; // per frame, further draws are recorded directly
+    const bool enableFrameStatsDump = false;
+    const uint64_t FRAME_STATS_DUMP_INTERVAL = 1000; // frames
+    RenderQueue renderQueue;
+    bool isMultiDrawIndirectSupported = false;
+    bool isDrawIndirectFirstInstanceSupported = false; // draws index their constants by instance, the indirect path needs it
+    BufferHandle indirectBuffer; // persistently mapped
+
+    // depth
+    //> reverse-z: near maps to one & far to zero, so the float precision is spread evenly over the distance
+    //> the depth prepass lays down the opaque depth with vertex only pipelines, the shading pass then tests equal,
+    //> so overlapping opaque draws shade each pixel once (see 'RenderQueue::SetDepthPrepass')
+    //> one image, single frame in flight, shared by the swap chain & dynamic resolution framebuffers
+    const bool enableReverseZ = true;
+    const bool enableDepthPrepass = true;
+    VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+    ImageHandle depthImage;
+    VkImageView depthView = VK_NULL_HANDLE; // of 'depthImage', resolved once so startup phases off the 'GpuResources' chain can use it
+
+    // overdraw
+    //> precise occlusion queries count the samples that pass the depth test in the prepass & the shading pass,
+    //> with early depth tests those are the fragments that ran the fragment stage
+    bool isOverdrawQuerySupported = false;
+    VkQueryPool vkOverdrawQueryPool = VK_NULL_HANDLE;
+    uint64_t queriedPixelCount = 0; // render extent of the frame the queries were recorded in
+    struct OverdrawStats
+    {
+        uint64_t prepassSampleCount;
+        uint64_t shadedSampleCount;
+        float overdraw; // shaded samples per pixel
+    };
+    OverdrawStats overdrawStats{};
+    bool isOverdrawViewEnabled = false;
+
+    // pipeline statistics
+    //> vertex, clipping, fragment & compute invocations per pass, optional ('pipelineStatisticsQuery')
+    bool isPipelineStatisticsSupported = false;
+    PipelineStatistics pipelineStatistics;
+
+    // per-frame constants
+    //> written into the command stream & copied into the ring when it is executed, so captures replay them
+    //> set 1 of the pipeline layout, draws read their constants at their instance index
+    const uint32_t FRAME_DATA_SET = 1;
+    FrameDataRing frameData;
+    ViewConstants viewConstants{glm::mat4(1.0f), glm::mat4(1.0f), glm::mat4(1.0f)};
+    std::vector<DrawConstants> drawConstants; // of the frame being built
+    const glm::vec4 TRIANGLE_BOUNDS{0.0f, 0.0f, 0.0f, 0.70710678f}; // sphere around the triangle of first_shader.vert
+
+    // counts of the recorded vulkan commands
+    struct FrameStats
+    {
+        uint32_t pipelineBindCount;
+        uint32_t descriptorSetBindCount;
+        uint32_t drawCallCount; // direct & indirect calls
+        uint32_t indirectDrawCount; // draws executed by indirect calls
+        uint32_t skippedDrawCount; // without pipeline, view or draw constants, e.g. when the ring overflowed
+        uint32_t drawCount; // draws executed, direct & indirect
+        uint32_t instanceCount;
+        uint64_t triangleCount;
+        float recordTime; // ms, cpu time to build & record the frame
+    };
+    FrameStats frameStats{};
+
+    // dynamic resolution
+    //> the scene renders offscreen at a scale picked from the gpu time, then is upscaled to the swap chain image
+    const bool enableDynamicResolution = true;
+    const float TARGET_GPU_TIME = 1000.0f / 60.0f; // ms
+    const bool enableResolutionStatsDump = false;
+    const uint64_t RESOLUTION_STATS_DUMP_INTERVAL = 1000; // frames
+    DynamicResolution dynamicResolution;
+    bool isDynamicResolutionActive = false;
+    VkExtent2D renderExtent{}; // scene extent of the frame being recorded
+
+    // gpu particles
+    //> simulated before the scene render pass, drawn at its end, not part of captures
+    const bool enableParticles = true;
+    const bool enableParticleStatsDump = false;
+    const uint64_t PARTICLE_STATS_DUMP_INTERVAL = 1000; // frames
+    ParticleSystem particleSystem;
+    bool isParticleSystemActive = false;
+
+    // occlusion culling
+    //> phase 0 culls the scene draws against the depth pyramid of the previous frame before the scene pass,
+    //> phase 1 re-tests the rejected ones against the pyramid of phase 0 & draws them in a second pass that loads the first
+    //> culled draws are read from the draw buffers of the culler at their instance index, which needs 'drawIndirectFirstInstance'
+    const bool enableOcclusionCulling = true;
+    const uint32_t MAX_CULLED_INSTANCE_COUNT = 16384; // per frame, further draws are not culled
+    OcclusionCuller occlusionCuller;
+    bool isOcclusionCullerActive = false;
+    std::vector<OcclusionCuller::Instance> cullInstances; // of the frame being built, one per draw constants
+
+    // startup
+    //> 'Load' runs as a graph of phases, the report lists when each ran & for how long
+    const bool enableStartupReport = true;
+    StartupGraph::Clock::time_point loadStartTime{};
+
+    // capture
+    bool isCapturing = false;
+    std::string capturePath;
+    uint32_t captureFrameCount = 0;
+    CommandCapture activeCapture;
+
+    // stats dump
+    //> written when the next frame is recorded, the previous one is complete then
+    bool isDumpingStats = false;
+    uint32_t statsDumpFrameCount = 0;
+    std::ofstream statsDumpFile;
+
+    // headless
+    //> the offscreen image takes the place of the swap chain images
+    bool isHeadless = false;
+    VkDeviceMemory offscreenImageMemory = VK_NULL_HANDLE;
+    VkQueryPool vkTimestampQueryPool = VK_NULL_HANDLE;
 
-    VkSemaphore imageAvailableSemaphore;
-    VkSemaphore renderFinishedSemaphore;
-    VkFence isDoneRenderingFence;
+    VkSemaphore imageAvailableSemaphore = VK_NULL_HANDLE;
+    VkSemaphore renderFinishedSemaphore = VK_NULL_HANDLE;
+    VkFence isDoneRenderingFence = VK_NULL_HANDLE;
 
     const std::vector<const char*> requiredDeviceExtensions = {
             VK_KHR_SWAPCHAIN_EXTENSION_NAME
@@ -93,12 +355,35 @@ private:
     void vulkanCreateSwapChain();
     void vulkanCreateImageViews();
     void vulkanCreateRenderPass();
+    bool vulkanCreateDepthTarget();
+    bool vulkanCreateOverdrawQueryPool();
+    void vulkanDumpFrameStats();
+    void vulkanReadOverdrawQueries();
     void vulkanCreatePipeline();
+    bool vulkanCreatePipelinePermutation(ShaderPermutation& permutation, VkPipeline& pipeline);
+    bool vulkanLoadMaterialShaders(const std::string& materialPath);
     void vulkanCreateFramebuffers();
     void vulkanCreateCommandPool();
     void vulkanCreateCommandBuffer();
     void vulkanCreateSyncObjects();
+    bool vulkanCreateIndirectBuffer();
+    bool vulkanCreateFrameData();
+    void vulkanCreateDynamicResolution();
+    void vulkanCreateParticleSystem();
+    void vulkanCreateOcclusionCuller();
     void vulkanRecordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+    void vulkanBuildFrameCommands(CommandStream& stream);
+    void setViewConstants(const glm::mat4& view, float fieldOfView, float nearPlane, float farPlane);
+    void vulkanExecuteCommandStream(VkCommandBuffer commandBuffer,
+                                    const std::vector<uint8_t>& streamData,
+                                    VkRenderPass renderPass,
+                                    VkFramebuffer framebuffer,
+                                    VkExtent2D extent,
+                                    uint32_t cullPhase = 0);
+    void vulkanCaptureFrame(const CommandStream& stream);
+    bool vulkanCreateOffscreenTarget(VkExtent2D extent, VkFormat format);
+    bool vulkanCreateTimestampQueryPool();
+    bool vulkanCreateShaderStage(std::vector<char> code, VkShaderStageFlagBits stage);
     bool vulkanCreateShaderModule(const std::vector<char>& code, VkShaderModule& shaderModule);
 
     // devices
@@ -109,6 +394,7 @@ private:
                             QueueFamilyIndices queueFamilyIndices);
     QueueFamilyIndices findQueueFamilies(const VkPhysicalDevice& device);
     bool findRequiredDeviceExtensions(const VkPhysicalDevice& device);
+    bool findDeviceExtension(const VkPhysicalDevice& device, const char* extensionName);
 
     // swap chain
     SwapChainDeviceSupport querySwapChainSupport(const VkPhysicalDevice& device);
@@ -0,0 +1,349 @@
+#include "vulkan_utility.h"
+#include "utilities/file_utility.h"
+#include "utilities/application.h"
+#include "utilities/logger.h"
+#include <vector>
+
+bool VulkanUtility::FindMemoryType(
+        VkPhysicalDevice physicalDevice,
+        uint32_t typeFilter,
+        VkMemoryPropertyFlags properties,
+        uint32_t& memoryTypeIndex)
+{
+    // get memory properties
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+    // find first type that is allowed and has all requested properties
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i)
+    {
+        bool isAllowed = (typeFilter & (1u << i)) != 0;
+        bool hasProperties = (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties;
+        if (isAllowed && hasProperties)
+        {
+            memoryTypeIndex = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool VulkanUtility::CreateBuffer(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        const VkAllocationCallbacks* allocator,
+        VkDeviceSize size,
+        VkBufferUsageFlags usage,
+        VkMemoryPropertyFlags properties,
+        VkBuffer& buffer,
+        VkDeviceMemory& memory)
+{
+    // create info: buffer
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VkResult resultBuffer = vkCreateBuffer(device, &bufferInfo, allocator, &buffer);
+    if (resultBuffer != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create buffer!");
+        return false;
+    }
+
+    // find memory
+    VkMemoryRequirements memoryRequirements;
+    vkGetBufferMemoryRequirements(device, buffer, &memoryRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memoryRequirements.size;
+    if (!FindMemoryType(physicalDevice, memoryRequirements.memoryTypeBits, properties, allocInfo.memoryTypeIndex))
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to find suitable memory type for buffer!");
+        vkDestroyBuffer(device, buffer, allocator);
+        return false;
+    }
+
+    // allocate & bind memory
+    VkResult resultMemory = vkAllocateMemory(device, &allocInfo, allocator, &memory);
+    if (resultMemory != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to allocate buffer memory!");
+        vkDestroyBuffer(device, buffer, allocator);
+        return false;
+    }
+
+    vkBindBufferMemory(device, buffer, memory, 0);
+    return true;
+}
+
+bool VulkanUtility::CreateImage(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        const VkAllocationCallbacks* allocator,
+        VkExtent2D extent,
+        uint32_t mipLevels,
+        VkFormat format,
+        VkImageUsageFlags usage,
+        VkImage& image,
+        VkDeviceMemory& memory)
+{
+    // create info: image
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent.width = extent.width;
+    imageInfo.extent.height = extent.height;
+    imageInfo.extent.depth = 1;
+    imageInfo.mipLevels = mipLevels;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = format;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage = usage;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VkResult resultImage = vkCreateImage(device, &imageInfo, allocator, &image);
+    if (resultImage != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create image!");
+        return false;
+    }
+
+    // find memory
+    VkMemoryRequirements memoryRequirements;
+    vkGetImageMemoryRequirements(device, image, &memoryRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memoryRequirements.size;
+    if (!FindMemoryType(physicalDevice, memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, allocInfo.memoryTypeIndex))
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to find suitable memory type for image!");
+        vkDestroyImage(device, image, allocator);
+        return false;
+    }
+
+    // allocate & bind memory
+    VkResult resultMemory = vkAllocateMemory(device, &allocInfo, allocator, &memory);
+    if (resultMemory != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to allocate image memory!");
+        vkDestroyImage(device, image, allocator);
+        return false;
+    }
+
+    vkBindImageMemory(device, image, memory, 0);
+    return true;
+}
+
+bool VulkanUtility::CreateImageView(
+        VkDevice device,
+        const VkAllocationCallbacks* allocator,
+        VkImage image,
+        VkFormat format,
+        VkImageAspectFlags aspectMask,
+        uint32_t baseMipLevel,
+        uint32_t mipLevels,
+        VkImageView& imageView)
+{
+    // create info: image view
+    VkImageViewCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    createInfo.image = image;
+    createInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    createInfo.format = format;
+
+    createInfo.subresourceRange.aspectMask = aspectMask;
+    createInfo.subresourceRange.baseMipLevel = baseMipLevel;
+    createInfo.subresourceRange.levelCount = mipLevels;
+    createInfo.subresourceRange.baseArrayLayer = 0;
+    createInfo.subresourceRange.layerCount = 1;
+
+    VkResult result = vkCreateImageView(device, &createInfo, allocator, &imageView);
+    if (result != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create image view!");
+        return false;
+    }
+    return true;
+}
+
+VkFormat VulkanUtility::FindDepthFormat(VkPhysicalDevice physicalDevice)
+{
+    //> reverse-z only gains precision with a float format, 16-bit unorm is always supported
+    const VkFormat candidates[] = {
+            VK_FORMAT_D32_SFLOAT,
+            VK_FORMAT_D32_SFLOAT_S8_UINT,
+            VK_FORMAT_D24_UNORM_S8_UINT,
+            VK_FORMAT_D16_UNORM
+    };
+
+    for (VkFormat format : candidates)
+    {
+        VkFormatProperties properties;
+        vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &properties);
+        if ((properties.optimalTilingFeatures & VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT) != 0)
+            return format;
+    }
+    return VK_FORMAT_UNDEFINED;
+}
+
+VkAttachmentDescription VulkanUtility::GetSceneDepthAttachment(VkFormat format)
+{
+    VkAttachmentDescription depthAttachment{};
+    depthAttachment.format = format;
+    depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE; // sampled by the particle collisions of the next frame
+    depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+    return depthAttachment;
+}
+
+bool VulkanUtility::CreateSceneLoadRenderPass(
+        VkDevice device,
+        const VkAllocationCallbacks* allocator,
+        VkFormat colorFormat,
+        VkImageLayout colorLayout,
+        VkFormat depthFormat,
+        VkRenderPass& renderPass)
+{
+    // create attachments
+    //> load what the first pass left, the layouts stay as it ended them
+    VkAttachmentDescription attachments[2] = {};
+    VkAttachmentDescription& colorAttachment = attachments[0];
+    colorAttachment.format = colorFormat;
+    colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    colorAttachment.initialLayout = colorLayout;
+    colorAttachment.finalLayout = colorLayout;
+
+    attachments[1] = GetSceneDepthAttachment(depthFormat);
+    attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    attachments[1].initialLayout = attachments[1].finalLayout;
+
+    VkAttachmentReference colorAttachmentRef{0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+    VkAttachmentReference depthAttachmentRef{1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+
+    VkSubpassDescription subpass{};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &colorAttachmentRef;
+    subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+    //> the first pass wrote color & depth, the compute work in between read the depth
+    VkSubpassDependency dependencies[3] = {};
+    dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[0].dstSubpass = 0;
+    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+                                   VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    dependencies[0].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                   VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+    //> an upscale may read the color
+    dependencies[1].srcSubpass = 0;
+    dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    //> compute passes sample the depth
+    dependencies[2].srcSubpass = 0;
+    dependencies[2].dstSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[2].srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependencies[2].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dependencies[2].dstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    dependencies[2].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    // create render pass
+    VkRenderPassCreateInfo renderPassInfo{};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    renderPassInfo.attachmentCount = 2;
+    renderPassInfo.pAttachments = attachments;
+    renderPassInfo.subpassCount = 1;
+    renderPassInfo.pSubpasses = &subpass;
+    renderPassInfo.dependencyCount = 3;
+    renderPassInfo.pDependencies = dependencies;
+
+    VkResult result = vkCreateRenderPass(device, &renderPassInfo, allocator, &renderPass);
+    if (result != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create scene load render pass!");
+        return false;
+    }
+    return true;
+}
+
+bool VulkanUtility::CreateShaderModule(
+        VkDevice device,
+        const VkAllocationCallbacks* allocator,
+        const std::string& fileName,
+        VkShaderModule& shaderModule)
+{
+    // read shader
+    std::vector<char> code;
+    std::string path = Application::AssetsPath + "/shaders/" + fileName;
+    if (!FileUtility::ReadBinaryFile(path, code))
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to read shader file {}!", path);
+        return false;
+    }
+
+    // create shader module
+    VkShaderModuleCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    createInfo.codeSize = code.size();
+    createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+
+    VkResult result = vkCreateShaderModule(device, &createInfo, allocator, &shaderModule);
+    if (result != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create shader module!");
+        return false;
+    }
+    return true;
+}
+
+bool VulkanUtility::CreateComputePipeline(
+        VkDevice device,
+        const VkAllocationCallbacks* allocator,
+        VkShaderModule shaderModule,
+        VkPipelineLayout pipelineLayout,
+        const VkSpecializationInfo* specializationInfo,
+        VkPipeline& pipeline)
+{
+    // create info: compute stage
+    VkPipelineShaderStageCreateInfo stageInfo{};
+    stageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    stageInfo.module = shaderModule;
+    stageInfo.pName = "main";
+    stageInfo.pSpecializationInfo = specializationInfo;
+
+    // create info: compute pipeline
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage = stageInfo;
+    pipelineInfo.layout = pipelineLayout;
+
+    VkResult result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, allocator, &pipeline);
+    if (result != VK_SUCCESS)
+    {
+        ARCTIC_LOG_ERROR(Vulkan, "failed to create compute pipeline!");
+        return false;
+    }
+    return true;
+}
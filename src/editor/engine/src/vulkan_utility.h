@@ -0,0 +1,76 @@
+#ifndef ARCTIC_VULKAN_UTILITY_H
+#define ARCTIC_VULKAN_UTILITY_H
+
+#include <string>
+#include <vulkan/vulkan_core.h>
+
+// shared helpers for creating vulkan resources outside of the loader
+class VulkanUtility
+{
+public:
+    static bool FindMemoryType(VkPhysicalDevice physicalDevice,
+                               uint32_t typeFilter,
+                               VkMemoryPropertyFlags properties,
+                               uint32_t& memoryTypeIndex);
+
+    static bool CreateBuffer(VkPhysicalDevice physicalDevice,
+                             VkDevice device,
+                             const VkAllocationCallbacks* allocator,
+                             VkDeviceSize size,
+                             VkBufferUsageFlags usage,
+                             VkMemoryPropertyFlags properties,
+                             VkBuffer& buffer,
+                             VkDeviceMemory& memory);
+
+    static bool CreateImage(VkPhysicalDevice physicalDevice,
+                            VkDevice device,
+                            const VkAllocationCallbacks* allocator,
+                            VkExtent2D extent,
+                            uint32_t mipLevels,
+                            VkFormat format,
+                            VkImageUsageFlags usage,
+                            VkImage& image,
+                            VkDeviceMemory& memory);
+
+    static bool CreateImageView(VkDevice device,
+                                const VkAllocationCallbacks* allocator,
+                                VkImage image,
+                                VkFormat format,
+                                VkImageAspectFlags aspectMask,
+                                uint32_t baseMipLevel,
+                                uint32_t mipLevels,
+                                VkImageView& imageView);
+
+    // first depth format usable as optimal tiled attachment, 32-bit float first
+    //> undefined when the device supports none of the candidates
+    static VkFormat FindDepthFormat(VkPhysicalDevice physicalDevice);
+
+    // depth attachment of the scene passes, cleared on load & kept read only at the end for sampling
+    //> every scene pass uses this one, so the scene pipelines stay compatible with all of them
+    static VkAttachmentDescription GetSceneDepthAttachment(VkFormat format);
+
+    // scene pass that continues a scene pass of the same frame, color & depth are loaded instead of cleared
+    //> compatible with the framebuffers of the scene passes, for draws that wait on compute work after the first pass
+    //> 'colorLayout': the final layout of the first pass, kept by this one
+    static bool CreateSceneLoadRenderPass(VkDevice device,
+                                          const VkAllocationCallbacks* allocator,
+                                          VkFormat colorFormat,
+                                          VkImageLayout colorLayout,
+                                          VkFormat depthFormat,
+                                          VkRenderPass& renderPass);
+
+    // reads '<assets>/shaders/<fileName>'
+    static bool CreateShaderModule(VkDevice device,
+                                   const VkAllocationCallbacks* allocator,
+                                   const std::string& fileName,
+                                   VkShaderModule& shaderModule);
+
+    static bool CreateComputePipeline(VkDevice device,
+                                      const VkAllocationCallbacks* allocator,
+                                      VkShaderModule shaderModule,
+                                      VkPipelineLayout pipelineLayout,
+                                      const VkSpecializationInfo* specializationInfo,
+                                      VkPipeline& pipeline);
+};
+
+#endif //ARCTIC_VULKAN_UTILITY_H
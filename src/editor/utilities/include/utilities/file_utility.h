@@ -5,6 +5,7 @@
 #ifndef ARCTIC_FILE_UTILITY_H
 #define ARCTIC_FILE_UTILITY_H
 
+#include <cstddef>
 #include <iostream>
 #include <vector>
 
@@ -12,6 +13,40 @@ class FileUtility
 {
 public:
     static bool ReadBinaryFile(const std::string &path, std::vector<char>&buffer);
+};
+
+// read only file mapped into memory, copy on write
+//> pages are read on first access, writes go to private copies & never reach the file
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile() {
+        Close();
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const {
+        return data != nullptr;
+    }
+    char* GetData() const {
+        return data;
+    }
+    size_t GetSize() const {
+        return size;
+    }
+
+private:
+    char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
 
 #endif //ARCTIC_FILE_UTILITY_H
-};
\ No newline at end of file
@@ -0,0 +1,209 @@
+#ifndef ARCTIC_HANDLE_POOL_H
+#define ARCTIC_HANDLE_POOL_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "logger.h"
+
+// typed 32-bit generational handle: index (20) | generation (12)
+//> the index addresses a stable slot, so it can be packed into sort keys or gpu instance data on its own,
+//> the generation changes every time the slot is reused, so stale handles are detected
+//> the zero value is the null handle, generations start at one
+template<typename T>
+class Handle
+{
+public:
+    static constexpr uint32_t INDEX_BITS = 20;
+    static constexpr uint32_t GENERATION_BITS = 12;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << GENERATION_BITS) - 1;
+
+    Handle() = default;
+    Handle(uint32_t index, uint32_t generation) : value((generation << INDEX_BITS) | (index & INDEX_MASK)) {}
+
+    static Handle FromValue(uint32_t value)
+    {
+        Handle handle;
+        handle.value = value;
+        return handle;
+    }
+
+    uint32_t GetValue() const {
+        return value;
+    }
+    uint32_t GetIndex() const {
+        return value & INDEX_MASK;
+    }
+    uint32_t GetGeneration() const {
+        return value >> INDEX_BITS;
+    }
+
+    explicit operator bool() const {
+        return value != 0;
+    }
+    bool operator==(const Handle& other) const = default;
+
+private:
+    uint32_t value = 0;
+};
+
+// dense pool addressed by generational handles
+//> objects & their metadata live in two packed arrays, so the hot data of all objects is contiguous
+//> and the metadata (sizes, formats, names) does not share cache lines with it
+//> removal swaps the last object into the gap, slots map the stable handle index to the dense position
+//> stale handles are rejected by 'IsValid' & 'Remove' always, by 'Get' in debug builds only (null handles always)
+template<typename T, typename Metadata>
+class HandlePool
+{
+public:
+    using HandleType = Handle<T>;
+    static constexpr uint32_t MAX_COUNT = 1u << HandleType::INDEX_BITS;
+
+    // returns the null handle when the pool is full
+    HandleType Add(const T& object, const Metadata& metadata)
+    {
+        uint32_t slotIndex;
+        if (!freeSlots.empty())
+        {
+            slotIndex = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else
+        {
+            if (slots.size() >= MAX_COUNT)
+                return {};
+            slotIndex = static_cast<uint32_t>(slots.size());
+            slots.push_back({0, 1});
+        }
+
+        Slot& slot = slots[slotIndex];
+        slot.denseIndex = static_cast<uint32_t>(objects.size());
+        objects.push_back(object);
+        objectMetadata.push_back(metadata);
+        denseToSlot.push_back(slotIndex);
+        return HandleType(slotIndex, slot.generation);
+    }
+
+    // moves the object out, returns false for stale handles
+    bool Remove(HandleType handle, T& object)
+    {
+        if (!IsValid(handle))
+            return false;
+
+        Slot& slot = slots[handle.GetIndex()];
+        uint32_t denseIndex = slot.denseIndex;
+        object = std::move(objects[denseIndex]);
+
+        // fill the gap with the last object
+        uint32_t lastIndex = static_cast<uint32_t>(objects.size() - 1);
+        if (denseIndex != lastIndex)
+        {
+            objects[denseIndex] = std::move(objects[lastIndex]);
+            objectMetadata[denseIndex] = std::move(objectMetadata[lastIndex]);
+            denseToSlot[denseIndex] = denseToSlot[lastIndex];
+            slots[denseToSlot[denseIndex]].denseIndex = denseIndex;
+        }
+        objects.pop_back();
+        objectMetadata.pop_back();
+        denseToSlot.pop_back();
+
+        // invalidate outstanding handles
+        slot.generation = nextGeneration(slot.generation);
+        freeSlots.push_back(handle.GetIndex());
+        return true;
+    }
+
+    bool IsValid(HandleType handle) const
+    {
+        uint32_t index = handle.GetIndex();
+        return handle && index < slots.size() && slots[index].generation == handle.GetGeneration();
+    }
+
+    T* Get(HandleType handle)
+    {
+        uint32_t denseIndex;
+        return findDenseIndex(handle, denseIndex) ? &objects[denseIndex] : nullptr;
+    }
+    const T* Get(HandleType handle) const
+    {
+        uint32_t denseIndex;
+        return findDenseIndex(handle, denseIndex) ? &objects[denseIndex] : nullptr;
+    }
+    const Metadata* GetMetadata(HandleType handle) const
+    {
+        uint32_t denseIndex;
+        return findDenseIndex(handle, denseIndex) ? &objectMetadata[denseIndex] : nullptr;
+    }
+
+    uint32_t GetCount() const {
+        return static_cast<uint32_t>(objects.size());
+    }
+
+    // packed objects, e.g. for bulk destruction
+    //> order changes on removal
+    const std::vector<T>& GetObjects() const {
+        return objects;
+    }
+    // objects can be modified in place, not added or removed
+    std::vector<T>& GetObjects() {
+        return objects;
+    }
+    HandleType GetHandle(uint32_t denseIndex) const
+    {
+        uint32_t slotIndex = denseToSlot[denseIndex];
+        return HandleType(slotIndex, slots[slotIndex].generation);
+    }
+
+    // invalidates every handle
+    void Clear()
+    {
+        for (uint32_t slotIndex : denseToSlot)
+        {
+            slots[slotIndex].generation = nextGeneration(slots[slotIndex].generation);
+            freeSlots.push_back(slotIndex);
+        }
+        objects.clear();
+        objectMetadata.clear();
+        denseToSlot.clear();
+    }
+
+private:
+    struct Slot
+    {
+        uint32_t denseIndex;
+        uint32_t generation;
+    };
+
+    std::vector<T> objects;
+    std::vector<Metadata> objectMetadata;
+    std::vector<uint32_t> denseToSlot;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+
+    // wraps around, zero is skipped so no handle becomes null
+    static uint32_t nextGeneration(uint32_t generation)
+    {
+        generation = (generation + 1) & HandleType::GENERATION_MASK;
+        return generation != 0 ? generation : 1;
+    }
+
+    // release builds only reject null handles, the generation is trusted
+    bool findDenseIndex(HandleType handle, uint32_t& denseIndex) const
+    {
+#ifndef NDEBUG
+        if (!IsValid(handle))
+        {
+            ARCTIC_LOG_ERROR(General, "stale or null handle {:#x}!", handle.GetValue());
+            return false;
+        }
+#else
+        if (!handle)
+            return false;
+#endif
+        denseIndex = slots[handle.GetIndex()].denseIndex;
+        return true;
+    }
+};
+
+#endif //ARCTIC_HANDLE_POOL_H
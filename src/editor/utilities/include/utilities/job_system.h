@@ -0,0 +1,80 @@
+#ifndef ARCTIC_JOB_SYSTEM_H
+#define ARCTIC_JOB_SYSTEM_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// thread pools the engine schedules work on
+//> worker: cpu bound jobs, one thread per core (minus the main thread)
+//> io: blocking file access, a few threads so multiple reads are in flight at once
+enum class JobQueue : uint8_t
+{
+    Worker = 0,
+    IO = 1,
+
+    Count
+};
+
+class JobSystem
+{
+public:
+    using Job = std::function<void()>;
+
+    // zero worker threads: one per hardware thread minus the main thread
+    void Initialize(uint32_t workerThreadCount = 0, uint32_t ioThreadCount = 2);
+    void Shutdown();
+
+    void Schedule(Job job, JobQueue queue = JobQueue::Worker);
+
+    // splits [0, count) into batches and runs them on the workers, blocks until all batches are done
+    //> the calling thread runs batches as well, so nested calls from a worker can not dead lock
+    void ParallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t begin, uint32_t end)>& func);
+
+    // resumes the awaiting coroutine on a thread of the queue
+    //> "co_await jobSystem.SwitchTo(JobQueue::IO);"
+    auto SwitchTo(JobQueue queue)
+    {
+        struct Awaiter
+        {
+            JobSystem* jobSystem;
+            JobQueue queue;
+
+            bool await_ready() const noexcept {
+                return false;
+            }
+            void await_suspend(std::coroutine_handle<> handle) const {
+                jobSystem->Schedule([handle]() { handle.resume(); }, queue);
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this, queue};
+    }
+
+    uint32_t GetThreadCount(JobQueue queue) const {
+        return static_cast<uint32_t>(queues[static_cast<size_t>(queue)].threads.size());
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<Job> jobs;
+        std::vector<std::thread> threads;
+    };
+
+    std::array<Queue, static_cast<size_t>(JobQueue::Count)> queues;
+    std::atomic<bool> isRunning = false;
+
+    void threadLoop(Queue& queue);
+};
+
+#endif //ARCTIC_JOB_SYSTEM_H
@@ -0,0 +1,254 @@
+#ifndef ARCTIC_LOGGER_H
+#define ARCTIC_LOGGER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+// statements below this severity are compiled out (0 debug, 1 info, 2 warning, 3 error)
+#ifndef ARCTIC_LOG_MIN_SEVERITY
+#define ARCTIC_LOG_MIN_SEVERITY 0
+#endif
+
+enum class LogSeverity : uint8_t
+{
+    Debug = 0,
+    Info = 1,
+    Warning = 2,
+    Error = 3,
+
+    Count
+};
+
+enum class LogCategory : uint8_t
+{
+    General,
+    Vulkan,
+    Validation, // vulkan validation layer messages
+    Assets,
+    Capture,
+    Cook,
+
+    Count
+};
+
+// rate limiting state of a log statement, one per call site
+//> a site that suppressed messages is registered with the logger, which reports what no later message did at shutdown
+struct LogSite
+{
+    std::atomic<uint64_t> windowStart = 0; // ns
+    std::atomic<uint32_t> windowCount = 0;
+    std::atomic<uint32_t> suppressedCount = 0; // in the current window, reported with the next message
+    std::atomic<bool> isRegistered = false;
+};
+//> read by the logger's own static destructor, after the sites' static lifetimes would otherwise have ended
+static_assert(std::is_trivially_destructible_v<LogSite>);
+
+// asynchronous logger
+//> a statement copies its format string pointer & raw arguments into a lock-free ring of the calling thread,
+//> a background thread formats & prints them, so logging costs a copy instead of formatting & a syscall
+//> the format string must outlive the logger (string literal), string arguments are copied
+//> full rings drop messages instead of blocking
+class Logger
+{
+public:
+    static constexpr uint32_t RING_SIZE = 64 * 1024; // bytes per thread
+    static constexpr uint32_t MAX_RECORD_SIZE = 4096; // bytes, longer string arguments are truncated & end in "..."
+    static constexpr uint32_t RATE_LIMIT = 16; // messages per call site & window, further ones are suppressed
+    static constexpr uint64_t RATE_LIMIT_WINDOW = 1000000000; // ns
+
+    struct Stats
+    {
+        uint64_t writtenCount;
+        uint64_t droppedCount; // rings were full
+        uint64_t suppressedCount; // rate limited, counted when reported
+        uint32_t threadCount;
+    };
+
+    // run-time filter, on top of 'ARCTIC_LOG_MIN_SEVERITY'
+    static void SetMinSeverity(LogSeverity severity);
+    static void SetMinSeverity(LogCategory category, LogSeverity severity);
+    static bool IsEnabled(LogSeverity severity, LogCategory category) {
+        return static_cast<uint8_t>(severity) >= minSeverities[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+    }
+
+    // use the 'ARCTIC_LOG_*' macros, they filter & provide the call site
+    template<typename... Args>
+    static void Write(LogSite& site, LogSeverity severity, LogCategory category, const char* format, const Args&... args)
+    {
+        // rate limit
+        uint64_t timestamp = now();
+        uint32_t suppressedCount = 0;
+        if (!admit(site, timestamp, suppressedCount))
+        {
+            if (!site.isRegistered.exchange(true, std::memory_order_relaxed))
+                registerSite(site, severity, category, format);
+            return;
+        }
+
+        // encode
+        alignas(8) uint8_t record[MAX_RECORD_SIZE];
+        RecordHeader header{};
+        header.severity = severity;
+        header.category = category;
+        header.suppressedCount = suppressedCount;
+        header.format = format;
+        header.formatter = &formatRecord<Stored<Args>...>;
+
+        //> plain values always fit, strings share the remaining space
+        constexpr size_t stringCount = (size_t{0} + ... + (isString<Args> ? 1 : 0));
+        constexpr size_t fixedSize = (size_t{0} + ... + (isString<Args> ? sizeof(uint32_t) : sizeof(Stored<Args>)));
+        static_assert(sizeof(RecordHeader) + fixedSize <= MAX_RECORD_SIZE, "log arguments exceed the record size");
+        constexpr size_t stringCapacity = (MAX_RECORD_SIZE - sizeof(RecordHeader) - fixedSize) / std::max<size_t>(stringCount, 1);
+
+        uint8_t* cursor = record + sizeof(RecordHeader);
+        (encode(cursor, stringCapacity, args), ...);
+        header.size = static_cast<uint32_t>(cursor - record);
+        std::memcpy(record, &header, sizeof(RecordHeader));
+
+        push(record, header.size);
+    }
+
+    // formats & prints everything logged so far, blocks
+    //> e.g. before exiting after an error
+    static void Flush();
+
+    static Stats GetStats();
+    static void PrintStats();
+
+private:
+    friend class LogBackend;
+
+    using Formatter = void (*)(const uint8_t* arguments, const char* format, std::string& message);
+
+    struct RecordHeader
+    {
+        uint32_t size; // header & arguments
+        LogSeverity severity;
+        LogCategory category;
+        uint32_t suppressedCount;
+        const char* format;
+        Formatter formatter;
+    };
+
+    static inline std::array<std::atomic<uint8_t>, static_cast<size_t>(LogCategory::Count)> minSeverities{};
+    static constexpr std::string_view TRUNCATION_MARKER = "...";
+
+    // strings are stored inline (length & characters) & formatted as views
+    template<typename T>
+    static constexpr bool isString = std::is_convertible_v<const T&, std::string_view>;
+    template<typename T>
+    using Stored = std::conditional_t<isString<T>, std::string_view, std::decay_t<T>>;
+
+    static uint64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static bool admit(LogSite& site, uint64_t timestamp, uint32_t& suppressedCount)
+    {
+        // first message after the window: start a new one & report what the last one suppressed
+        uint64_t windowStart = site.windowStart.load(std::memory_order_relaxed);
+        if (timestamp - windowStart >= RATE_LIMIT_WINDOW &&
+            site.windowStart.compare_exchange_strong(windowStart, timestamp, std::memory_order_relaxed))
+        {
+            site.windowCount.store(0, std::memory_order_relaxed);
+            suppressedCount = site.suppressedCount.exchange(0, std::memory_order_relaxed);
+        }
+
+        if (site.windowCount.fetch_add(1, std::memory_order_relaxed) < RATE_LIMIT)
+            return true;
+        site.suppressedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    template<typename T>
+    static void encode(uint8_t*& cursor, size_t stringCapacity, const T& argument)
+    {
+        if constexpr (isString<T>)
+        {
+            std::string_view string = argument;
+            auto length = static_cast<uint32_t>(std::min(string.size(), stringCapacity));
+            std::memcpy(cursor, &length, sizeof(uint32_t));
+            std::memcpy(cursor + sizeof(uint32_t), string.data(), length);
+            if (length < string.size() && length >= TRUNCATION_MARKER.size())
+                std::memcpy(cursor + sizeof(uint32_t) + length - TRUNCATION_MARKER.size(), TRUNCATION_MARKER.data(), TRUNCATION_MARKER.size());
+            cursor += sizeof(uint32_t) + length;
+        }
+        else
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "log arguments must be strings or trivially copyable");
+            std::memcpy(cursor, &argument, sizeof(T));
+            cursor += sizeof(T);
+        }
+    }
+
+    template<typename T>
+    static T decode(const uint8_t*& cursor)
+    {
+        if constexpr (std::is_same_v<T, std::string_view>)
+        {
+            uint32_t length;
+            std::memcpy(&length, cursor, sizeof(uint32_t));
+            std::string_view string(reinterpret_cast<const char*>(cursor + sizeof(uint32_t)), length);
+            cursor += sizeof(uint32_t) + length;
+            return string;
+        }
+        else
+        {
+            T value;
+            std::memcpy(&value, cursor, sizeof(T));
+            cursor += sizeof(T);
+            return value;
+        }
+    }
+
+    // runs on the background thread
+    template<typename... Args>
+    static void formatRecord(const uint8_t* arguments, const char* format, std::string& message)
+    {
+        //> braced initialization decodes the arguments in order
+        std::tuple<Args...> values{decode<Args>(arguments)...};
+        try
+        {
+            message = std::apply([format](const auto&... value) {
+                return std::vformat(format, std::make_format_args(value...));
+            }, values);
+        }
+        catch (const std::format_error& error)
+        {
+            message = std::string("invalid log format \"") + format + "\": " + error.what();
+        }
+    }
+
+    static void push(const uint8_t* record, uint32_t size);
+    static void registerSite(LogSite& site, LogSeverity severity, LogCategory category, const char* format);
+};
+
+#define ARCTIC_LOG(severity, category, ...)                                           \
+    do                                                                                \
+    {                                                                                 \
+        if constexpr (static_cast<int>(severity) >= ARCTIC_LOG_MIN_SEVERITY)          \
+        {                                                                             \
+            if (Logger::IsEnabled(severity, category))                                \
+            {                                                                         \
+                static LogSite arcticLogSite;                                         \
+                Logger::Write(arcticLogSite, severity, category, __VA_ARGS__);        \
+            }                                                                         \
+        }                                                                             \
+    } while (false)
+
+// "ARCTIC_LOG_ERROR(Vulkan, "failed to create {}!", name);"
+#define ARCTIC_LOG_DEBUG(category, ...) ARCTIC_LOG(LogSeverity::Debug, LogCategory::category, __VA_ARGS__)
+#define ARCTIC_LOG_INFO(category, ...) ARCTIC_LOG(LogSeverity::Info, LogCategory::category, __VA_ARGS__)
+#define ARCTIC_LOG_WARNING(category, ...) ARCTIC_LOG(LogSeverity::Warning, LogCategory::category, __VA_ARGS__)
+#define ARCTIC_LOG_ERROR(category, ...) ARCTIC_LOG(LogSeverity::Error, LogCategory::category, __VA_ARGS__)
+
+#endif //ARCTIC_LOGGER_H
@@ -0,0 +1,31 @@
+#ifndef ARCTIC_RADIX_SORT_H
+#define ARCTIC_RADIX_SORT_H
+
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+// stable lsd radix sort of 64-bit keys with a 32-bit payload (8 passes of 8 bits)
+//> passes where all keys share the same digit are skipped, so keys using few bits are cheap
+//> large inputs are split into blocks: each block is counted and scattered on its own worker
+//> scratch memory is kept between calls, sorting the same amount every frame does not allocate
+class RadixSorter
+{
+public:
+    static constexpr uint32_t PARALLEL_THRESHOLD = 16384; // below this count the sort runs on the calling thread
+
+    void Sort(uint64_t* keys, uint32_t* values, uint32_t count, JobSystem* jobSystem = nullptr);
+
+private:
+    static constexpr uint32_t DIGIT_BITS = 8;
+    static constexpr uint32_t BUCKET_COUNT = 1u << DIGIT_BITS;
+    static constexpr uint32_t PASS_COUNT = 64 / DIGIT_BITS;
+    static constexpr uint32_t MAX_BLOCK_COUNT = 64;
+
+    std::vector<uint64_t> scratchKeys;
+    std::vector<uint32_t> scratchValues;
+    std::vector<uint32_t> blockOffsets; // per block & bucket
+};
+
+#endif //ARCTIC_RADIX_SORT_H
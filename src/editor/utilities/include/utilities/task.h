@@ -0,0 +1,151 @@
+#ifndef ARCTIC_TASK_H
+#define ARCTIC_TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+// lazily started coroutine returning a value
+//> starts when awaited, the awaiting coroutine is resumed on the thread that finishes the task
+//> "Task<bool> load() { co_await jobSystem.SwitchTo(JobQueue::IO); ... co_return true; }"
+template<typename T>
+class Task;
+
+namespace TaskDetail
+{
+    // resumes the awaiting coroutine (symmetric transfer, no stack growth)
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept {
+            return false;
+        }
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+            auto continuation = handle.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    struct PromiseBase
+    {
+        std::coroutine_handle<> continuation;
+
+        std::suspend_always initial_suspend() const noexcept {
+            return {};
+        }
+        FinalAwaiter final_suspend() const noexcept {
+            return {};
+        }
+        void unhandled_exception() const noexcept {
+            std::terminate(); // exceptions are disabled
+        }
+    };
+
+    template<typename T>
+    struct Promise : PromiseBase
+    {
+        std::optional<T> value;
+
+        Task<T> get_return_object();
+        void return_value(T result) {
+            value = std::move(result);
+        }
+        T TakeValue() {
+            return std::move(*value);
+        }
+    };
+
+    template<>
+    struct Promise<void> : PromiseBase
+    {
+        Task<void> get_return_object();
+        void return_void() const noexcept {}
+        void TakeValue() const noexcept {}
+    };
+}
+
+template<typename T = void>
+class Task
+{
+public:
+    using promise_type = TaskDetail::Promise<T>;
+
+    Task() = default;
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle)
+                handle.destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task()
+    {
+        if (handle)
+            handle.destroy();
+    }
+
+    bool await_ready() const noexcept {
+        return handle.done();
+    }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+    T await_resume() {
+        return handle.promise().TakeValue();
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+};
+
+template<typename T>
+Task<T> TaskDetail::Promise<T>::get_return_object()
+{
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskDetail::Promise<void>::get_return_object()
+{
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+// runs a task without anyone awaiting it
+//> the coroutine frame destroys itself when the task is finished
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() const noexcept {
+            return {};
+        }
+        std::suspend_never initial_suspend() const noexcept {
+            return {};
+        }
+        std::suspend_never final_suspend() const noexcept {
+            return {};
+        }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept {
+            std::terminate();
+        }
+    };
+};
+
+template<typename T>
+DetachedTask RunDetached(Task<T> task)
+{
+    co_await task;
+}
+
+#endif //ARCTIC_TASK_H
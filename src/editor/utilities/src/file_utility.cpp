@@ -2,6 +2,15 @@
 #include <fstream>
 #include <filesystem>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace fs = std::filesystem;
 
 bool FileUtility::ReadBinaryFile(const std::string& path, std::vector<char>& buffer)
@@ -27,4 +36,81 @@ bool FileUtility::ReadBinaryFile(const std::string& path, std::vector<char>& buf
     file.close();
 
     return true;
-}
\ No newline at end of file
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+
+#ifdef _WIN32
+    // open file
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    fileHandle = file;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        Close();
+        return false;
+    }
+
+    // map view
+    //> write copy: the pages stay shared with the file cache until they are written
+    mappingHandle = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mappingHandle == nullptr)
+    {
+        Close();
+        return false;
+    }
+    data = static_cast<char*>(MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0));
+    if (data == nullptr)
+    {
+        Close();
+        return false;
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    // open file
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat fileStat{};
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(file);
+        return false;
+    }
+
+    // map view
+    //> private: written pages are copied, the descriptor is not needed once mapped
+    void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+    close(file);
+    if (view == MAP_FAILED)
+        return false;
+    data = static_cast<char*>(view);
+    size = static_cast<size_t>(fileStat.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+    if (data != nullptr)
+        UnmapViewOfFile(data);
+    if (mappingHandle != nullptr)
+        CloseHandle(mappingHandle);
+    if (fileHandle != nullptr)
+        CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    if (data != nullptr)
+        munmap(data, size);
+#endif
+    data = nullptr;
+    size = 0;
+}
@@ -0,0 +1,126 @@
+#include "utilities/job_system.h"
+#include <algorithm>
+#include <memory>
+
+void JobSystem::Initialize(uint32_t workerThreadCount, uint32_t ioThreadCount)
+{
+    if (workerThreadCount == 0)
+        workerThreadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+    isRunning = true;
+
+    // start threads
+    const uint32_t threadCounts[] = {workerThreadCount, std::max(ioThreadCount, 1u)};
+    for (size_t i = 0; i < queues.size(); ++i)
+    {
+        Queue& queue = queues[i];
+        for (uint32_t t = 0; t < threadCounts[i]; ++t)
+            queue.threads.emplace_back([this, &queue]() { threadLoop(queue); });
+    }
+}
+
+void JobSystem::Shutdown()
+{
+    // wake up all threads
+    //> jobs still queued are finished before the threads exit
+    isRunning = false;
+    for (auto& queue : queues)
+    {
+        {
+            std::lock_guard lock(queue.mutex);
+        }
+        queue.condition.notify_all();
+    }
+
+    // join threads
+    for (auto& queue : queues)
+    {
+        for (auto& thread : queue.threads)
+            thread.join();
+        queue.threads.clear();
+    }
+}
+
+void JobSystem::Schedule(Job job, JobQueue queueType)
+{
+    Queue& queue = queues[static_cast<size_t>(queueType)];
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    queue.condition.notify_one();
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t, uint32_t)>& func)
+{
+    if (count == 0)
+        return;
+
+    batchSize = std::max(batchSize, 1u);
+    const uint32_t batchCount = (count + batchSize - 1) / batchSize;
+
+    // run inline: a single batch or no workers
+    if (batchCount == 1 || GetThreadCount(JobQueue::Worker) == 0)
+    {
+        func(0, count);
+        return;
+    }
+
+    // shared state
+    //> helper jobs may start after the loop is finished, they only touch the state (kept alive by the pointer)
+    struct State
+    {
+        std::atomic<uint32_t> nextBatch = 0;
+        std::atomic<uint32_t> doneBatchCount = 0;
+        uint32_t count = 0;
+        uint32_t batchSize = 0;
+        uint32_t batchCount = 0;
+        const std::function<void(uint32_t, uint32_t)>* func = nullptr;
+    };
+    auto state = std::make_shared<State>();
+    state->count = count;
+    state->batchSize = batchSize;
+    state->batchCount = batchCount;
+    state->func = &func;
+
+    auto runBatches = [](State& state)
+    {
+        uint32_t batch;
+        while ((batch = state.nextBatch.fetch_add(1, std::memory_order_relaxed)) < state.batchCount)
+        {
+            uint32_t begin = batch * state.batchSize;
+            uint32_t end = std::min(begin + state.batchSize, state.count);
+            (*state.func)(begin, end);
+            state.doneBatchCount.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    // schedule helpers
+    //> one less than batches, the calling thread takes a share as well
+    uint32_t helperCount = std::min(batchCount - 1, GetThreadCount(JobQueue::Worker));
+    for (uint32_t i = 0; i < helperCount; ++i)
+        Schedule([state, runBatches]() { runBatches(*state); });
+
+    // help & wait
+    runBatches(*state);
+    while (state->doneBatchCount.load(std::memory_order_acquire) < batchCount)
+        std::this_thread::yield();
+}
+
+void JobSystem::threadLoop(Queue& queue)
+{
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock lock(queue.mutex);
+            queue.condition.wait(lock, [this, &queue]() { return !isRunning || !queue.jobs.empty(); });
+            if (queue.jobs.empty())
+                return;
+
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+        }
+        job();
+    }
+}
@@ -0,0 +1,290 @@
+#include "utilities/logger.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::array<const char*, static_cast<size_t>(LogSeverity::Count)> SEVERITY_NAMES = {
+            "debug", "info", "warning", "error"
+    };
+    constexpr std::array<const char*, static_cast<size_t>(LogCategory::Count)> CATEGORY_NAMES = {
+            "general", "vulkan", "validation", "assets", "capture", "cook"
+    };
+    constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(5);
+
+    // single producer (the owning thread), single consumer (whoever holds the drain lock)
+    //> positions grow monotonically, records wrap around the end of the buffer
+    struct Ring
+    {
+        alignas(64) std::atomic<uint64_t> head = 0; // written by the producer
+        alignas(64) std::atomic<uint64_t> tail = 0; // written by the consumer
+        std::atomic<uint64_t> writtenCount = 0;
+        std::atomic<uint64_t> droppedCount = 0;
+        std::array<uint8_t, Logger::RING_SIZE> data{};
+
+        void write(uint64_t position, const uint8_t* source, uint32_t size)
+        {
+            auto offset = static_cast<uint32_t>(position % Logger::RING_SIZE);
+            uint32_t first = std::min(size, Logger::RING_SIZE - offset);
+            std::memcpy(data.data() + offset, source, first);
+            std::memcpy(data.data(), source + first, size - first);
+        }
+        void read(uint64_t position, uint8_t* destination, uint32_t size) const
+        {
+            auto offset = static_cast<uint32_t>(position % Logger::RING_SIZE);
+            uint32_t first = std::min(size, Logger::RING_SIZE - offset);
+            std::memcpy(destination, data.data() + offset, first);
+            std::memcpy(destination + first, data.data(), size - first);
+        }
+    };
+}
+
+// owns the rings & the background thread, started by the first log statement
+//> rings are kept after their thread exits, the engine's threads live as long as the process
+class LogBackend
+{
+public:
+    ~LogBackend()
+    {
+        {
+            std::lock_guard lock(threadMutex);
+            isRunning = false;
+        }
+        condition.notify_one();
+        if (thread.joinable())
+            thread.join();
+        drain();
+        reportSuppressed();
+    }
+
+    Ring* registerThread()
+    {
+        std::lock_guard lock(ringsMutex);
+        rings.push_back(std::make_unique<Ring>());
+        if (!thread.joinable())
+        {
+            isRunning = true;
+            thread = std::thread([this]() { threadLoop(); });
+        }
+        return rings.back().get();
+    }
+
+    void wake() {
+        condition.notify_one();
+    }
+
+    void registerSite(LogSite& site, LogSeverity severity, LogCategory category, const char* format)
+    {
+        std::lock_guard lock(sitesMutex);
+        sites.push_back({&site, severity, category, format});
+    }
+
+    // formats & prints the records of all rings
+    void drain()
+    {
+        std::lock_guard drainLock(drainMutex);
+
+        std::vector<Ring*> ringsSnapshot;
+        {
+            std::lock_guard lock(ringsMutex);
+            for (const auto& ring : rings)
+                ringsSnapshot.push_back(ring.get());
+        }
+
+        for (Ring* ring : ringsSnapshot)
+        {
+            uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+            uint64_t head = ring->head.load(std::memory_order_acquire);
+            while (tail < head)
+            {
+                alignas(8) uint8_t record[Logger::MAX_RECORD_SIZE];
+                uint32_t size;
+                ring->read(tail, reinterpret_cast<uint8_t*>(&size), sizeof(uint32_t));
+                ring->read(tail, record, size);
+                tail += size;
+                formatRecord(record);
+            }
+            //> release the space after the records were copied out
+            ring->tail.store(tail, std::memory_order_release);
+        }
+
+        if (!output.empty())
+        {
+            std::fwrite(output.data(), 1, output.size(), stdout);
+            std::fflush(stdout);
+            output.clear();
+        }
+    }
+
+    Logger::Stats getStats()
+    {
+        std::lock_guard lock(ringsMutex);
+
+        Logger::Stats stats{};
+        for (const auto& ring : rings)
+        {
+            stats.writtenCount += ring->writtenCount.load(std::memory_order_relaxed);
+            stats.droppedCount += ring->droppedCount.load(std::memory_order_relaxed);
+        }
+        stats.suppressedCount = suppressedCount.load(std::memory_order_relaxed);
+        stats.threadCount = static_cast<uint32_t>(rings.size());
+        return stats;
+    }
+
+private:
+    std::mutex ringsMutex;
+    std::vector<std::unique_ptr<Ring>> rings;
+
+    std::mutex threadMutex;
+    std::condition_variable condition;
+    std::thread thread;
+    bool isRunning = false;
+
+    // sites that suppressed messages
+    struct Site
+    {
+        LogSite* site;
+        LogSeverity severity;
+        LogCategory category;
+        const char* format;
+    };
+    std::mutex sitesMutex;
+    std::vector<Site> sites;
+
+    // consumer state
+    std::mutex drainMutex;
+    std::string output;
+    std::string message;
+    std::atomic<uint64_t> suppressedCount = 0;
+
+    void threadLoop()
+    {
+        std::unique_lock lock(threadMutex);
+        while (isRunning)
+        {
+            condition.wait_for(lock, FLUSH_INTERVAL);
+            lock.unlock();
+            drain();
+            lock.lock();
+        }
+    }
+
+    // counts of the last windows, no later message of their site reported them
+    //> "<severity>: <category>: <count> similar messages suppressed: "<format>""
+    void reportSuppressed()
+    {
+        std::lock_guard drainLock(drainMutex);
+        std::lock_guard lock(sitesMutex);
+        for (const Site& site : sites)
+        {
+            uint32_t count = site.site->suppressedCount.exchange(0, std::memory_order_relaxed);
+            if (count == 0)
+                continue;
+            output += std::format("{}: {}: {} similar messages suppressed: \"{}\"\n",
+                                  SEVERITY_NAMES[static_cast<size_t>(site.severity)],
+                                  CATEGORY_NAMES[static_cast<size_t>(site.category)],
+                                  count,
+                                  site.format);
+            suppressedCount.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        if (!output.empty())
+        {
+            std::fwrite(output.data(), 1, output.size(), stdout);
+            std::fflush(stdout);
+            output.clear();
+        }
+    }
+
+    // "<severity>: <category>: <message>"
+    void formatRecord(const uint8_t* record)
+    {
+        Logger::RecordHeader header;
+        std::memcpy(&header, record, sizeof(Logger::RecordHeader));
+
+        header.formatter(record + sizeof(Logger::RecordHeader), header.format, message);
+        output += SEVERITY_NAMES[static_cast<size_t>(header.severity)];
+        output += ": ";
+        output += CATEGORY_NAMES[static_cast<size_t>(header.category)];
+        output += ": ";
+        output += message;
+        if (header.suppressedCount > 0)
+        {
+            output += std::format(" ({} similar messages suppressed)", header.suppressedCount);
+            suppressedCount.fetch_add(header.suppressedCount, std::memory_order_relaxed);
+        }
+        output += '\n';
+    }
+};
+
+namespace
+{
+    LogBackend backend;
+}
+
+void Logger::SetMinSeverity(LogSeverity severity)
+{
+    for (auto& minSeverity : minSeverities)
+        minSeverity.store(static_cast<uint8_t>(severity), std::memory_order_relaxed);
+}
+
+void Logger::SetMinSeverity(LogCategory category, LogSeverity severity)
+{
+    minSeverities[static_cast<size_t>(category)].store(static_cast<uint8_t>(severity), std::memory_order_relaxed);
+}
+
+void Logger::push(const uint8_t* record, uint32_t size)
+{
+    thread_local Ring* ring = backend.registerThread();
+
+    // drop when full, the producer never waits on the consumer
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    uint64_t tail = ring->tail.load(std::memory_order_acquire);
+    if (head + size - tail > RING_SIZE)
+    {
+        ring->droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ring->write(head, record, size);
+    ring->head.store(head + size, std::memory_order_release);
+    ring->writtenCount.fetch_add(1, std::memory_order_relaxed);
+
+    // errors are printed without waiting for the next flush interval
+    LogSeverity severity;
+    std::memcpy(&severity, record + offsetof(RecordHeader, severity), sizeof(LogSeverity));
+    if (severity == LogSeverity::Error)
+        backend.wake();
+}
+
+void Logger::Flush()
+{
+    backend.drain();
+}
+
+void Logger::registerSite(LogSite& site, LogSeverity severity, LogCategory category, const char* format)
+{
+    backend.registerSite(site, severity, category, format);
+}
+
+Logger::Stats Logger::GetStats()
+{
+    return backend.getStats();
+}
+
+void Logger::PrintStats()
+{
+    Stats stats = GetStats();
+    std::cout << "info: log:" << std::endl;
+    std::cout << std::format("\twritten {}, dropped {}, suppressed {}, threads {}",
+                             stats.writtenCount,
+                             stats.droppedCount,
+                             stats.suppressedCount,
+                             stats.threadCount) << std::endl;
+}
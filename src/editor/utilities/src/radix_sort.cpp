@@ -0,0 +1,97 @@
+#include "utilities/radix_sort.h"
+#include "utilities/job_system.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+void RadixSorter::Sort(uint64_t* keys, uint32_t* values, uint32_t count, JobSystem* jobSystem)
+{
+    if (count < 2)
+        return;
+
+    scratchKeys.resize(count);
+    scratchValues.resize(count);
+
+    // split into blocks
+    //> one block per thread, the calling thread takes one as well
+    uint32_t blockCount = 1;
+    if (jobSystem != nullptr && count >= PARALLEL_THRESHOLD)
+        blockCount = std::min(jobSystem->GetThreadCount(JobQueue::Worker) + 1, MAX_BLOCK_COUNT);
+    const uint32_t blockSize = (count + blockCount - 1) / blockCount;
+    blockOffsets.resize(static_cast<size_t>(blockCount) * BUCKET_COUNT);
+
+    auto forEachBlock = [&](const std::function<void(uint32_t block, uint32_t begin, uint32_t end)>& func)
+    {
+        auto runBlocks = [&](uint32_t blockBegin, uint32_t blockEnd)
+        {
+            for (uint32_t block = blockBegin; block < blockEnd; ++block)
+                func(block, block * blockSize, std::min((block + 1) * blockSize, count));
+        };
+
+        if (blockCount == 1)
+            runBlocks(0, 1);
+        else
+            jobSystem->ParallelFor(blockCount, 1, runBlocks);
+    };
+
+    uint64_t* sourceKeys = keys;
+    uint32_t* sourceValues = values;
+    uint64_t* targetKeys = scratchKeys.data();
+    uint32_t* targetValues = scratchValues.data();
+
+    for (uint32_t pass = 0; pass < PASS_COUNT; ++pass)
+    {
+        const uint32_t shift = pass * DIGIT_BITS;
+
+        // count digits per block
+        forEachBlock([&](uint32_t block, uint32_t begin, uint32_t end)
+        {
+            uint32_t* histogram = blockOffsets.data() + static_cast<size_t>(block) * BUCKET_COUNT;
+            std::memset(histogram, 0, BUCKET_COUNT * sizeof(uint32_t));
+            for (uint32_t i = begin; i < end; ++i)
+                ++histogram[(sourceKeys[i] >> shift) & (BUCKET_COUNT - 1)];
+        });
+
+        // prefix sum: bucket major, block minor (keeps the sort stable)
+        //> a pass where every key has the same digit would only copy, it is skipped
+        uint32_t offset = 0;
+        bool isSkipped = false;
+        for (uint32_t bucket = 0; bucket < BUCKET_COUNT && !isSkipped; ++bucket)
+        {
+            uint32_t bucketCount = 0;
+            for (uint32_t block = 0; block < blockCount; ++block)
+            {
+                uint32_t& blockOffset = blockOffsets[static_cast<size_t>(block) * BUCKET_COUNT + bucket];
+                uint32_t blockCountInBucket = blockOffset;
+                blockOffset = offset;
+                offset += blockCountInBucket;
+                bucketCount += blockCountInBucket;
+            }
+            isSkipped = bucketCount == count;
+        }
+        if (isSkipped)
+            continue;
+
+        // scatter
+        forEachBlock([&](uint32_t block, uint32_t begin, uint32_t end)
+        {
+            uint32_t* blockOffset = blockOffsets.data() + static_cast<size_t>(block) * BUCKET_COUNT;
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                uint32_t target = blockOffset[(sourceKeys[i] >> shift) & (BUCKET_COUNT - 1)]++;
+                targetKeys[target] = sourceKeys[i];
+                targetValues[target] = sourceValues[i];
+            }
+        });
+
+        std::swap(sourceKeys, targetKeys);
+        std::swap(sourceValues, targetValues);
+    }
+
+    // result ended in scratch: copy back
+    if (sourceKeys != keys)
+    {
+        std::memcpy(keys, sourceKeys, count * sizeof(uint64_t));
+        std::memcpy(values, sourceValues, count * sizeof(uint32_t));
+    }
+}
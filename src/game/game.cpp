@@ -1,12 +1,136 @@
 #include "engine/arctic_engine.h"
+#include <charconv>
+#include <cmath>
+#include <csignal>
+#include <format>
 #include <iostream>
+#include <string>
+#include <string_view>
 
-int main()
+namespace
 {
+    // the whole argument has to be a number in the range of 'T'
+    template<typename T>
+    bool parseNumber(std::string_view argument, T& value)
+    {
+        auto [end, error] = std::from_chars(argument.data(), argument.data() + argument.size(), value);
+        return error == std::errc() && end == argument.data() + argument.size();
+    }
+}
+
+#ifdef ARCTIC_SERVER
+
+namespace
+{
+    ArcticEngine* runningEngine = nullptr;
+
+    void onStopSignal(int)
+    {
+        if (runningEngine != nullptr)
+            runningEngine->requestStop();
+    }
+
+    void printUsage()
+    {
+        std::cout << "usage: ArcticGame [--ticks <count>] [--tick-rate <hz>] [--scene <file>]" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // headless server: --ticks <count> --tick-rate <hz> --scene <file>
+    uint64_t tickLimit = 0;
+    double tickRate = ArcticEngine::DEFAULT_TICK_RATE;
+    std::string scenePath;
+    for (int i = 1; i < argc; i += 2)
+    {
+        std::string_view argument = argv[i];
+        if (argument != "--ticks" && argument != "--tick-rate" && argument != "--scene")
+        {
+            std::cout << std::format("error: game: unknown argument \"{}\"!", argument) << std::endl;
+            printUsage();
+            return 1;
+        }
+        if (i + 1 >= argc)
+        {
+            std::cout << std::format("error: game: missing value of {}!", argument) << std::endl;
+            printUsage();
+            return 1;
+        }
+
+        std::string_view value = argv[i + 1];
+        bool isValid = true;
+        if (argument == "--ticks")
+            isValid = parseNumber(value, tickLimit);
+        else if (argument == "--tick-rate")
+            isValid = parseNumber(value, tickRate) && std::isfinite(tickRate) && tickRate > 0.0;
+        else
+            scenePath = value;
+
+        if (!isValid)
+        {
+            std::cout << std::format("error: game: invalid value \"{}\" of {}!", value, argument) << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    ArcticEngine engine;
+    engine.initialize(tickRate);
+    if (!scenePath.empty() && !engine.loadScene(scenePath))
+    {
+        engine.cleanup();
+        return 1;
+    }
+
+    // stop on ctrl+c
+    runningEngine = &engine;
+    std::signal(SIGINT, onStopSignal);
+    std::signal(SIGTERM, onStopSignal);
+
+    engine.run(tickLimit);
+    engine.printStats();
+
+    runningEngine = nullptr;
+    engine.cleanup();
+
+    return 0;
+}
+
+#else
+
+int main(int argc, char* argv[])
+{
+    // capture frames: --capture <file> <frames>
+    std::string capturePath;
+    uint32_t captureFrameCount = 0;
+    if (argc > 1)
+    {
+        if (argc != 4 || std::string_view(argv[1]) != "--capture" || !parseNumber(std::string_view(argv[3]), captureFrameCount))
+        {
+            std::cout << "error: game: invalid arguments!" << std::endl;
+            std::cout << "usage: ArcticGame [--capture <file> <frames>]" << std::endl;
+            return 1;
+        }
+        capturePath = argv[2];
+    }
+
     ArcticEngine engine;
     engine.initialize();
+
+    // particle fountain
+    ParticleEmitter fountain;
+    fountain.velocity[1] = 3.0f;
+    uint32_t particles = engine.createParticleSystem("fountain", 64 * 1024, fountain);
+
+    if (!capturePath.empty())
+        engine.capture(capturePath, captureFrameCount);
+
     engine.run();
+    engine.destroyParticleSystem(particles);
     engine.cleanup();
 
     return 0;
 }
+
+#endif
@@ -0,0 +1,46 @@
+#include "engine/arctic_engine.h"
+#include <charconv>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "usage: ArcticReplay <capture file> [iterations]" << std::endl;
+    }
+}
+
+// replays a capture made with 'ArcticGame --capture <file> <frames>'
+//> usage: ArcticReplay <file> [iterations]
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::string path = argv[1];
+    uint32_t iterations = 1;
+    if (argc > 2)
+    {
+        //> the whole argument has to be a positive number that fits 32 bits
+        std::string_view argument = argv[2];
+        auto [end, error] = std::from_chars(argument.data(), argument.data() + argument.size(), iterations);
+        if (error != std::errc() || end != argument.data() + argument.size() || iterations == 0)
+        {
+            std::cout << std::format("error: replay: invalid iterations \"{}\"!", argument) << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    ArcticEngine engine;
+    if (!engine.replay(path, iterations))
+        return 1;
+
+    return 0;
+}